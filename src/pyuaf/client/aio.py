@@ -0,0 +1,323 @@
+"""
+asyncio support for pyuaf (Python >= 3.5).
+
+The asynchronous services of a :class:`~pyuaf.client.Client` deliver their results by calling
+Python functions from threads of the UAF (or of the SDK). The classes of this module hand these
+results over to an asyncio event loop (via ``loop.call_soon_threadsafe``), so that a single
+asyncio thread can await thousands of concurrent requests::
+
+    client = pyuaf.client.Client(settings)
+    aioClient = pyuaf.client.aio.AsyncioClient(client)
+
+    async def poll(addresses):
+        while True:
+            result = await aioClient.read(addresses)
+            ...
+
+    async def monitor(addresses):
+        async with aioClient.monitorData(addresses) as stream:
+            async for notification in stream:
+                ...
+"""
+
+import asyncio
+import sys
+
+import pyuaf
+
+
+def __setFutureResult__(future, result):
+    """
+    Hidden function to resolve a future (called by the event loop).
+    """
+    if not future.done():
+        future.set_result(result)
+
+
+def __putNotification__(stream, notification):
+    """
+    Hidden function to queue a notification into a stream (called by the event loop).
+    """
+    if not stream.closed:
+        stream.__queue__.put_nowait(notification)
+
+
+def __createQueue__(loop):
+    """
+    Hidden function to create an unbounded asyncio.Queue (which needs an explicit loop only on
+    old Pythons).
+    """
+    if sys.version_info < (3, 8):
+        return asyncio.Queue(loop=loop)
+    else:
+        return asyncio.Queue()
+
+
+# the item that marks the end of a stream
+__END_OF_STREAM__ = object()
+
+
+class NotificationStream(object):
+    """
+    A NotificationStream is an asynchronous iterator over the notifications of the monitored
+    items that it created.
+
+    You don't create a NotificationStream yourself, you get it from
+    :meth:`~pyuaf.client.aio.AsyncioClient.monitorData` or
+    :meth:`~pyuaf.client.aio.AsyncioClient.monitorEvents`.
+
+    Closing the stream (explicitly via :meth:`close`, or at the end of an ``async with`` block)
+    stops the delivery of the notifications to the event loop. The monitored items themselves
+    are not deleted from the server.
+    """
+
+    def __init__(self, aioClient, maxQueueSize):
+        self.__aioClient__ = aioClient
+        self.__queue__     = __createQueue__(aioClient.loop)
+        self.maxQueueSize  = maxQueueSize
+        self.closed        = False
+        self.result        = None
+        self.clientHandles = []
+        self.dropped       = 0
+
+    def __callback__(self):
+        """
+        Hidden method to create a notification callback (called by the threads of the UAF).
+        """
+        loop = self.__aioClient__.loop
+        def callback(notification):
+            if self.closed:
+                return
+            if self.maxQueueSize > 0 and self.__queue__.qsize() >= self.maxQueueSize:
+                # don't block the threads of the UAF: drop the notification instead
+                self.dropped += 1
+                return
+            try:
+                loop.call_soon_threadsafe(__putNotification__, self, notification)
+            except RuntimeError:
+                pass # the event loop is closed, nothing we can do at this point!
+        return callback
+
+    def close(self):
+        """
+        Stop the delivery of notifications to this stream.
+
+        The notifications that were already queued can still be consumed, after which the
+        iteration stops. Must be called by the thread of the event loop.
+        """
+        if not self.closed:
+            self.closed = True
+            self.__queue__.put_nowait(__END_OF_STREAM__)
+
+    def qsize(self):
+        """
+        Get the number of notifications that are waiting to be consumed (approximately).
+
+        :rtype: ``int``
+        """
+        return self.__queue__.qsize()
+
+    def __aiter__(self):
+        return self
+
+    async def __anext__(self):
+        notification = await self.__queue__.get()
+        if notification is __END_OF_STREAM__:
+            # leave the marker for any other consumer of the stream
+            self.__queue__.put_nowait(__END_OF_STREAM__)
+            raise StopAsyncIteration
+        return notification
+
+    async def __aenter__(self):
+        return self
+
+    async def __aexit__(self, excType, exc, tb):
+        self.close()
+
+
+class AsyncioClient(object):
+    """
+    An AsyncioClient wraps a :class:`~pyuaf.client.Client`, and exposes its asynchronous
+    services as coroutines that can be awaited by an asyncio event loop.
+
+    No pyuaf lock or queue is involved when a result is handed over: the thread of the UAF that
+    receives the result copies it, and lets the event loop resolve the future that the coroutine
+    is awaiting (via ``loop.call_soon_threadsafe``).
+
+    Errors are raised by the coroutines in the same way as by the synchronous methods of
+    :class:`~pyuaf.client.Client` (i.e. as :class:`~pyuaf.util.errors.UafError` exceptions).
+
+    :param client: The client that will process the requests.
+    :type  client: :class:`~pyuaf.client.Client`
+    :param loop: The event loop that will resolve the futures (default: the current event loop).
+    """
+
+    def __init__(self, client, loop=None):
+        self.client = client
+        self.loop   = loop if loop is not None else asyncio.get_event_loop()
+
+    def __resultCallback__(self, future):
+        """
+        Hidden method to create a result callback (called by the threads of the UAF) that
+        resolves the given future.
+        """
+        loop = self.loop
+        def callback(result):
+            # create a copy using the C++ copy constructor,
+            # so that the instance may be used after the callback has returned:
+            result = type(result)(result)
+            try:
+                loop.call_soon_threadsafe(__setFutureResult__, future, result)
+            except RuntimeError:
+                pass # the event loop is closed, nothing we can do at this point!
+        return callback
+
+    async def read(self, addresses, attributeId=pyuaf.util.attributeids.Value, **kwargs):
+        """
+        Read a number of node attributes asynchronously.
+
+        See :meth:`pyuaf.client.Client.beginRead` for the arguments.
+
+        :return: The result of the read request.
+        :rtype:  :class:`~pyuaf.client.results.ReadResult`
+        :raise pyuaf.util.errors.UafError:
+             Base exception, catch this to handle any UAF errors.
+        """
+        future = self.loop.create_future()
+        self.client.beginRead(addresses, attributeId, self.__resultCallback__(future), **kwargs)
+        result = await future
+        return result
+
+    async def write(self, addresses, data, attributeId=pyuaf.util.attributeids.Value, **kwargs):
+        """
+        Write a number of node attributes asynchronously.
+
+        See :meth:`pyuaf.client.Client.beginWrite` for the arguments.
+
+        :return: The result of the write request.
+        :rtype:  :class:`~pyuaf.client.results.WriteResult`
+        :raise pyuaf.util.errors.UafError:
+             Base exception, catch this to handle any UAF errors.
+        """
+        future = self.loop.create_future()
+        self.client.beginWrite(addresses, data, attributeId, self.__resultCallback__(future),
+                               **kwargs)
+        result = await future
+        return result
+
+    async def call(self, objectAddress, methodAddress, inputArgs=[], **kwargs):
+        """
+        Invoke a remote method call asynchronously.
+
+        See :meth:`pyuaf.client.Client.beginCall` for the arguments.
+
+        :return: The result of the method call request.
+        :rtype:  :class:`~pyuaf.client.results.MethodCallResult`
+        :raise pyuaf.util.errors.UafError:
+             Base exception, catch this to handle any UAF errors.
+        """
+        future = self.loop.create_future()
+        self.client.beginCall(objectAddress, methodAddress, inputArgs,
+                              self.__resultCallback__(future), **kwargs)
+        result = await future
+        return result
+
+    async def browse(self, addresses, **kwargs):
+        r"""
+        Browse a number of nodes asynchronously.
+
+        :param addresses: A single address or a list of addresses of the nodes to browse.
+        :type  addresses: :class:`~pyuaf.util.Address` or a ``list`` of :class:`~pyuaf.util.Address`
+        :param kwargs: The following \*\*kwargs are available (see :ref:`note-client-kwargs`):
+
+           - clientConnectionId: (type: ``int``)
+           - sessionSettings (type: :class:`~pyuaf.client.settings.SessionSettings`)
+           - serviceSettings (type: :class:`~pyuaf.client.settings.BrowseSettings`)
+           - translateSettings (type: :class:`~pyuaf.client.settings.TranslateBrowsePathsToNodeIdsSettings`)
+
+        :return: The result of the browse request.
+        :rtype:  :class:`~pyuaf.client.results.BrowseResult`
+        :raise pyuaf.util.errors.UafError:
+             Base exception, catch this to handle any UAF errors.
+        """
+        if type(addresses) == pyuaf.util.Address:
+            addresses = [addresses]
+
+        request = pyuaf.client.requests.AsyncBrowseRequest(
+                        [pyuaf.client.requests.BrowseRequestTarget(a) for a in addresses],
+                        **kwargs)
+        result = await self.processRequest(request)
+        return result
+
+    async def processRequest(self, request):
+        """
+        Process a fully specified asynchronous request.
+
+        :param request: Any asynchronous session request, e.g. an
+                        :class:`~pyuaf.client.requests.AsyncReadRequest` or an
+                        :class:`~pyuaf.client.requests.AsyncBrowseRequest`.
+        :return: The corresponding result, e.g. a :class:`~pyuaf.client.results.ReadResult` or a
+                 :class:`~pyuaf.client.results.BrowseResult`.
+        :raise pyuaf.util.errors.UafError:
+             Base exception, catch this to handle any UAF errors.
+        """
+        future = self.loop.create_future()
+        self.client.processRequest(request, self.__resultCallback__(future))
+        result = await future
+        return result
+
+    def monitorData(self, addresses, maxQueueSize=0, **kwargs):
+        r"""
+        Create one or more monitored data items, and get their notifications as a stream.
+
+        See :meth:`pyuaf.client.Client.createMonitoredData` for the addresses and \*\*kwargs.
+
+        The notifications of all items end up in the same stream, in the order in which they
+        were received. Use their clientHandle to tell them apart (the clientHandles of the items
+        are stored in the clientHandles attribute of the stream).
+
+        :param maxQueueSize: If greater than 0, notifications that arrive while maxQueueSize
+                             notifications are still waiting to be consumed, are dropped (and
+                             counted by the 'dropped' attribute of the stream).
+        :type  maxQueueSize: ``int``
+        :return: An asynchronous iterator over the :class:`~pyuaf.client.DataChangeNotification`
+                 instances.
+        :rtype:  :class:`~pyuaf.client.aio.NotificationStream`
+        :raise pyuaf.util.errors.UafError:
+             Base exception, catch this to handle any UAF errors.
+        """
+        if type(addresses) == pyuaf.util.Address:
+            addresses = [addresses]
+
+        stream = NotificationStream(self, maxQueueSize)
+        callback = stream.__callback__()
+        stream.result = self.client.createMonitoredData(addresses,
+                                                        [callback] * len(addresses),
+                                                        **kwargs)
+        stream.clientHandles = [target.clientHandle for target in stream.result.targets]
+        return stream
+
+    def monitorEvents(self, addresses, eventFilter=None, maxQueueSize=0, **kwargs):
+        r"""
+        Create one or more monitored event items, and get their notifications as a stream.
+
+        See :meth:`pyuaf.client.Client.createMonitoredEvents` for the addresses, eventFilter
+        and \*\*kwargs, and :meth:`monitorData` for the maxQueueSize.
+
+        :return: An asynchronous iterator over the :class:`~pyuaf.client.EventNotification`
+                 instances.
+        :rtype:  :class:`~pyuaf.client.aio.NotificationStream`
+        :raise pyuaf.util.errors.UafError:
+             Base exception, catch this to handle any UAF errors.
+        """
+        if type(addresses) == pyuaf.util.Address:
+            addresses = [addresses]
+
+        stream = NotificationStream(self, maxQueueSize)
+        callback = stream.__callback__()
+        stream.result = self.client.createMonitoredEvents(addresses,
+                                                          eventFilter,
+                                                          [callback] * len(addresses),
+                                                          **kwargs)
+        stream.clientHandles = [target.clientHandle for target in stream.result.targets]
+        return stream
@@ -24,9 +24,252 @@
 
 from pyuaf.client.requests import __getElementFromKwargs__
 
+
+class __CallbackDispatcher__(object):
+    """
+    Hidden class to call user callbacks from a fixed pool of worker threads.
+    
+    Each callback is queued together with a key (e.g. a ClientHandle). All callbacks that are 
+    queued with the same key are handled by the same worker thread, so they are guaranteed to be
+    called in the same order as they were dispatched.
+    """
+    
+    def __init__(self, noOfThreads):
+        self.__queues__  = []
+        self.__threads__ = []
+        
+        for i in range(max(1, int(noOfThreads))):
+            q = queue.Queue()
+            t = threading.Thread(target=self.__work__, args=[q], name="pyuaf-callbacks-%d" %i)
+            t.daemon = True
+            self.__queues__.append(q)
+            self.__threads__.append(t)
+            t.start()
+    
+    
+    def noOfThreads(self):
+        return len(self.__threads__)
+    
+    
+    def dispatch(self, key, callback, args):
+        """
+        Queue the callback, to be called with the given arguments by the worker thread for the key.
+        """
+        self.__queues__[hash(key) % len(self.__queues__)].put((callback, args))
+    
+    
+    def stop(self, timeout=None):
+        """
+        Stop the worker threads, after they have handled all callbacks that are already queued.
+        """
+        for q in self.__queues__:
+            q.put(None)
+        
+        for t in self.__threads__:
+            # a callback may be the one that deletes the client, so don't join ourselves 
+            if t is not threading.current_thread():
+                t.join(timeout)
+    
+    
+    def __work__(self, q):
+        while True:
+            item = q.get()
+            
+            if item is None:
+                return
+            
+            callback, args = item
+            
+            try:
+                callback(*args)
+            except:
+                # exception raised by the user, nothing we can do but print it (like an 
+                # unhandled exception of a thread would do)
+                traceback.print_exc()
+
+
+def __bytesToArray__(data, typecode, dtype):
+    """
+    Hidden function to interpret the given bytearray as a numpy array (if numpy is available)
+    or as an array.array (if not).
+    """
+    if numpy is not None:
+        return numpy.frombuffer(data, dtype=dtype)
+    else:
+        a = array.array(typecode)
+        if hasattr(a, "frombytes"):
+            a.frombytes(bytes(data)) # Python 3
+        else:
+            a.fromstring(str(data))  # Python 2
+        return a
+
+
+class DataChangeBatch(object):
+    """
+    A DataChangeBatch holds all data change notifications of a single publish response, as 
+    parallel arrays ("columns").
+    
+    The i-th element of each column belongs to the i-th notification. The numeric columns are 
+    ``numpy.ndarray`` instances if numpy is available, or ``array.array`` instances if not. 
+    They are converted only when you access them for the first time, and each conversion consists 
+    of a single memory copy.
+    
+    DataChangeBatch instances are only created for subscriptions that were created with
+    :attr:`~pyuaf.client.settings.SubscriptionSettings.batchDataChanges` set to True.
+    """
+    
+    def __init__(self, batch):
+        # create a copy using the C++ copy constructor, 
+        # so that the instance may be stored on the python level:
+        self.__batch__   = DataChangeNotificationBatch(batch)
+        self.__columns__ = {}
+        
+        self.clientConnectionId       = self.__batch__.clientConnectionId
+        self.clientSubscriptionHandle = self.__batch__.clientSubscriptionHandle
+    
+    def __column__(self, name, typecode, dtype):
+        try:
+            return self.__columns__[name]
+        except KeyError:
+            column = __bytesToArray__(getattr(self.__batch__, "__%sBytes__" %name)(), typecode, dtype)
+            self.__columns__[name] = column
+            return column
+    
+    def __len__(self):
+        return int(self.__batch__.size())
+    
+    def __str__(self):
+        return str(self.__batch__)
+    
+    @property
+    def clientHandles(self):
+        """ The ClientHandles of the monitored items (``uint32``). """
+        return self.__column__("clientHandles", "I", "uint32")
+    
+    @property
+    def statusCodes(self):
+        """ The OPC UA status codes of the data values (``uint32``). """
+        return self.__column__("statusCodes", "I", "uint32")
+    
+    @property
+    def sourceTimestamps(self):
+        """ The source timestamps, in seconds since the epoch (``float64``, 0.0 if not provided). """
+        return self.__column__("sourceTimestamps", "d", "float64")
+    
+    @property
+    def serverTimestamps(self):
+        """ The server timestamps, in seconds since the epoch (``float64``, 0.0 if not provided). """
+        return self.__column__("serverTimestamps", "d", "float64")
+    
+    @property
+    def numericValues(self):
+        """ The numeric scalar values as ``float64`` (NaN for values of any other type). """
+        return self.__column__("numericValues", "d", "float64")
+    
+    @property
+    def values(self):
+        """ The values as a ``list`` of the usual pyuaf data types (converted one by one!). """
+        try:
+            return self.__columns__["values"]
+        except KeyError:
+            values = [ self.__batch__.values[i] for i in range(len(self)) ]
+            self.__columns__["values"] = values
+            return values
+
+
+class EventBatch(object):
+    """
+    An EventBatch holds all events of a single monitored item that were received in a single 
+    publish response, as columns: one column per field of the 
+    :attr:`~pyuaf.util.EventFilter.selectClauses` of the monitored item.
+    
+    The fields are described by the :class:`~pyuaf.client.EventSchema` of the monitored item,
+    which was compiled once when the monitored item was created. Use :meth:`column` to get the 
+    values of a single field of all events:
+    
+     - numeric fields (numbers, booleans, DateTimes as seconds since the epoch and 
+       StatusCodes) are returned as a ``numpy.ndarray`` if numpy is available, or as an 
+       ``array.array`` if not. They are converted only when you access them for the first time,
+       and this conversion consists of a single memory copy. Missing values are NaN.
+     - textual fields (Strings, LocalizedTexts and QualifiedNames) are returned as a 
+       ``list`` of ``str``.
+     - all other fields are returned as a ``list`` of the usual pyuaf data types.
+    
+    EventBatch instances are only created for subscriptions that were created with
+    :attr:`~pyuaf.client.settings.SubscriptionSettings.batchEvents` set to True.
+    """
+    
+    def __init__(self, batch):
+        # create a copy using the C++ copy constructor, 
+        # so that the instance may be stored on the python level:
+        self.__batch__   = EventNotificationBatch(batch)
+        self.__columns__ = {}
+        self.__numericValues__ = None
+        
+        self.clientConnectionId       = self.__batch__.clientConnectionId
+        self.clientSubscriptionHandle = self.__batch__.clientSubscriptionHandle
+        self.clientHandle             = self.__batch__.clientHandle
+        self.schema                   = self.__batch__.schema
+    
+    def __len__(self):
+        return int(self.__batch__.size())
+    
+    def __str__(self):
+        return str(self.__batch__)
+    
+    def __getitem__(self, fieldNameOrIndex):
+        return self.column(fieldNameOrIndex)
+    
+    @property
+    def fieldNames(self):
+        """ The names of the fields, in the order of the select clauses (``list`` of ``str``). """
+        return [ self.schema.fieldName(i) for i in range(self.schema.fieldCount()) ]
+    
+    def column(self, fieldNameOrIndex):
+        """
+        Get the values of a single field, for all events of the batch.
+        
+        :param fieldNameOrIndex: The name of the field (see :attr:`fieldNames`) or its index.
+        :type  fieldNameOrIndex: ``str`` or ``int``
+        :return: A ``numpy.ndarray`` (or ``array.array``) for numeric fields, or a ``list`` for 
+                 all other fields.
+        :raise KeyError: if the field is unknown.
+        """
+        if isinstance(fieldNameOrIndex, str):
+            fieldIndex = self.schema.fieldIndex(fieldNameOrIndex)
+        else:
+            fieldIndex = int(fieldNameOrIndex)
+        
+        if fieldIndex < 0 or fieldIndex >= self.schema.fieldCount():
+            raise KeyError(fieldNameOrIndex)
+        
+        try:
+            return self.__columns__[fieldIndex]
+        except KeyError:
+            pass
+        
+        noOfEvents  = len(self)
+        columnType  = self.schema.columnType(fieldIndex)
+        start       = self.schema.columnIndex(fieldIndex) * noOfEvents
+        
+        if columnType == EventSchema.ColumnType_Numeric:
+            if self.__numericValues__ is None:
+                self.__numericValues__ = __bytesToArray__(self.__batch__.__numericValuesBytes__(), 
+                                                          "d", 
+                                                          "float64")
+            column = self.__numericValues__[start : start + noOfEvents]
+        elif columnType == EventSchema.ColumnType_String:
+            column = [ self.__batch__.stringValues[i] for i in range(start, start + noOfEvents) ]
+        else:
+            column = [ self.__batch__.values[i] for i in range(start, start + noOfEvents) ]
+        
+        self.__columns__[fieldIndex] = column
+        return column
+
+
 class Client(ClientBase):
     
-    def __init__(self, settings=None, loggingCallback=None):
+    def __init__(self, settings=None, loggingCallback=None, callbackThreads=4):
         """
         Construct a UAF client.
         
@@ -44,7 +287,16 @@ class Client(ClientBase):
         :param callback: A callback function for the logging. This function should have one 
                          input argument, which you should call "msg" or so,
                          because this argument is of type :class:`pyuaf.util.LogMessage`.
+        :param callbackThreads: The number of worker threads that call the notification and status 
+                                callback functions that you registered. All callbacks for the same 
+                                ClientHandle (or the same session or subscription, in case of 
+                                status callbacks) are called by the same thread, so they are 
+                                called in the same order as they were received.
+        :type  callbackThreads: ``int``
         """
+        # define the worker threads that will call the callbacks registered by the user
+        self.__callbackDispatcher__ = __CallbackDispatcher__(callbackThreads)
+        
         # define the logging, untrustedCertificate and connectError callbacks
         self.__loggingCallback__ = loggingCallback
         self.__untrustedCertificateCallback__ = None
@@ -52,9 +304,12 @@ class Client(ClientBase):
         
         # define some more callbacks to receive status changes
         self.__connectionCallbacks__ = []
+        self.__serversChangedCallbacks__ = []
         self.__subscriptionCallbacks__ = []
         self.__notificationsMissingCallbacks__ = []
         self.__keepAliveCallbacks__ = []
+        self.__dataChangeBatchCallbacks__ = []
+        self.__eventBatchCallbacks__ = []
         
         # initialize the base class
         if settings is None:
@@ -66,6 +321,10 @@ class Client(ClientBase):
         self.__asyncReadCallbacks__ = dict()
         self.__asyncWriteCallbacks__ = dict()
         self.__asyncCallCallbacks__ = dict()
+        self.__asyncBrowseCallbacks__ = dict()
+        self.__asyncBrowseNextCallbacks__ = dict()
+        self.__asyncTranslateBrowsePathsToNodeIdsCallbacks__ = dict()
+        self.__asyncHistoryReadRawModifiedCallbacks__ = dict()
         self.__dataNotificationCallbacks__ = dict()
         self.__eventNotificationCallbacks__ = dict()
         # define the corresponding locks (to make sure we can register the callback
@@ -73,6 +332,10 @@ class Client(ClientBase):
         self.__asyncReadLock__ = threading.Lock()
         self.__asyncWriteLock__ = threading.Lock()
         self.__asyncCallLock__ = threading.Lock()
+        self.__asyncBrowseLock__ = threading.Lock()
+        self.__asyncBrowseNextLock__ = threading.Lock()
+        self.__asyncTranslateBrowsePathsToNodeIdsLock__ = threading.Lock()
+        self.__asyncHistoryReadRawModifiedLock__ = threading.Lock()
         self.__dataNotificationLock__ = threading.Lock()
         self.__eventNotificationLock__ = threading.Lock()
     
@@ -81,8 +344,8 @@ class Client(ClientBase):
         # first disconnect all sessions, to avoid memory problems when the client
         # is garbage collected before any ongoing callback threads are fired!
         self.manuallyDisconnectAllSessions()
-        # wait some time for any ongoing callback threads to be fired
-        time.sleep(0.1)
+        # wait some time for any queued callbacks to be fired
+        self.__callbackDispatcher__.stop(timeout=1.0)
         ClientBase.__del__(self)
     
     
@@ -217,6 +480,178 @@ class Client(ClientBase):
         """
         pass
     
+    def __dispatch_browseComplete__(self, result):
+        """
+        Dispatch the result of the asynchronous request either to a virtual browseComplete function,
+        or to a callback function (if one is found for the given requestHandle).
+        """
+        try:
+            self.__asyncBrowseLock__.acquire()
+            f = self.__asyncBrowseCallbacks__.pop(result.requestHandle)
+        except:
+            f = None
+        finally:
+            self.__asyncBrowseLock__.release()
+        
+        if f is None:
+            try:
+                self.browseComplete(result)
+            except:
+                pass # nothing we can do at this point!
+        else:
+            try:
+                f(result)
+            except:
+                pass # nothing we can do at this point!
+                
+    def browseComplete(self, result):
+        """
+        Override this method to catch the result of asynchronous browse requests.
+        
+        This method will only be called by the UAF if you didn't provide an "external" callback
+        function already when you began the asynchronous request.
+        
+        In other words, there are two ways how you can catch the result of asynchronous browse requests:
+        
+         - either by calling :meth:`~pyuaf.client.Client.processRequest` *without* providing an external callback function
+           via the 'resultCallback' argument --> then you need to override :meth:`~pyuaf.client.Client.browseComplete`
+         - or by calling :meth:`~pyuaf.client.Client.processRequest` *with* providing an external callback function
+           via the 'resultCallback' argument --> then only the external callback function will be called.
+        
+        :param result: The asynchronously received browse result.
+        :type  result: :class:`~pyuaf.client.results.BrowseResult`
+        """
+        pass
+    
+    def __dispatch_browseNextComplete__(self, result):
+        """
+        Dispatch the result of the asynchronous request either to a virtual browseNextComplete function,
+        or to a callback function (if one is found for the given requestHandle).
+        """
+        try:
+            self.__asyncBrowseNextLock__.acquire()
+            f = self.__asyncBrowseNextCallbacks__.pop(result.requestHandle)
+        except:
+            f = None
+        finally:
+            self.__asyncBrowseNextLock__.release()
+        
+        if f is None:
+            try:
+                self.browseNextComplete(result)
+            except:
+                pass # nothing we can do at this point!
+        else:
+            try:
+                f(result)
+            except:
+                pass # nothing we can do at this point!
+                
+    def browseNextComplete(self, result):
+        """
+        Override this method to catch the result of asynchronous BrowseNext requests.
+        
+        This method will only be called by the UAF if you didn't provide an "external" callback
+        function already when you began the asynchronous request.
+        
+        In other words, there are two ways how you can catch the result of asynchronous BrowseNext requests:
+        
+         - either by calling :meth:`~pyuaf.client.Client.processRequest` *without* providing an external callback function
+           via the 'resultCallback' argument --> then you need to override :meth:`~pyuaf.client.Client.browseNextComplete`
+         - or by calling :meth:`~pyuaf.client.Client.processRequest` *with* providing an external callback function
+           via the 'resultCallback' argument --> then only the external callback function will be called.
+        
+        :param result: The asynchronously received browse next result.
+        :type  result: :class:`~pyuaf.client.results.BrowseNextResult`
+        """
+        pass
+    
+    def __dispatch_translateBrowsePathsToNodeIdsComplete__(self, result):
+        """
+        Dispatch the result of the asynchronous request either to a virtual translateBrowsePathsToNodeIdsComplete function,
+        or to a callback function (if one is found for the given requestHandle).
+        """
+        try:
+            self.__asyncTranslateBrowsePathsToNodeIdsLock__.acquire()
+            f = self.__asyncTranslateBrowsePathsToNodeIdsCallbacks__.pop(result.requestHandle)
+        except:
+            f = None
+        finally:
+            self.__asyncTranslateBrowsePathsToNodeIdsLock__.release()
+        
+        if f is None:
+            try:
+                self.translateBrowsePathsToNodeIdsComplete(result)
+            except:
+                pass # nothing we can do at this point!
+        else:
+            try:
+                f(result)
+            except:
+                pass # nothing we can do at this point!
+                
+    def translateBrowsePathsToNodeIdsComplete(self, result):
+        """
+        Override this method to catch the result of asynchronous TranslateBrowsePathsToNodeIds requests.
+        
+        This method will only be called by the UAF if you didn't provide an "external" callback
+        function already when you began the asynchronous request.
+        
+        In other words, there are two ways how you can catch the result of asynchronous TranslateBrowsePathsToNodeIds requests:
+        
+         - either by calling :meth:`~pyuaf.client.Client.processRequest` *without* providing an external callback function
+           via the 'resultCallback' argument --> then you need to override :meth:`~pyuaf.client.Client.translateBrowsePathsToNodeIdsComplete`
+         - or by calling :meth:`~pyuaf.client.Client.processRequest` *with* providing an external callback function
+           via the 'resultCallback' argument --> then only the external callback function will be called.
+        
+        :param result: The asynchronously received translation result.
+        :type  result: :class:`~pyuaf.client.results.TranslateBrowsePathsToNodeIdsResult`
+        """
+        pass
+    
+    def __dispatch_historyReadRawModifiedComplete__(self, result):
+        """
+        Dispatch the result of the asynchronous request either to a virtual historyReadRawModifiedComplete function,
+        or to a callback function (if one is found for the given requestHandle).
+        """
+        try:
+            self.__asyncHistoryReadRawModifiedLock__.acquire()
+            f = self.__asyncHistoryReadRawModifiedCallbacks__.pop(result.requestHandle)
+        except:
+            f = None
+        finally:
+            self.__asyncHistoryReadRawModifiedLock__.release()
+        
+        if f is None:
+            try:
+                self.historyReadRawModifiedComplete(result)
+            except:
+                pass # nothing we can do at this point!
+        else:
+            try:
+                f(result)
+            except:
+                pass # nothing we can do at this point!
+                
+    def historyReadRawModifiedComplete(self, result):
+        """
+        Override this method to catch the result of asynchronous HistoryReadRawModified requests.
+        
+        This method will only be called by the UAF if you didn't provide an "external" callback
+        function already when you began the asynchronous request.
+        
+        In other words, there are two ways how you can catch the result of asynchronous HistoryReadRawModified requests:
+        
+         - either by calling :meth:`~pyuaf.client.Client.processRequest` *without* providing an external callback function
+           via the 'resultCallback' argument --> then you need to override :meth:`~pyuaf.client.Client.historyReadRawModifiedComplete`
+         - or by calling :meth:`~pyuaf.client.Client.processRequest` *with* providing an external callback function
+           via the 'resultCallback' argument --> then only the external callback function will be called.
+        
+        :param result: The asynchronously received history read result.
+        :type  result: :class:`~pyuaf.client.results.HistoryReadRawModifiedResult`
+        """
+        pass
+    
     
     def __dispatch_dataChangesReceived__(self, dataNotifications):
         """
@@ -231,8 +666,7 @@ class Client(ClientBase):
             for notification in dataNotifications:
                 try:
                     f = self.__dataNotificationCallbacks__[notification.clientHandle]
-                    t = threading.Thread(target=f, args=[notification])
-                    t.start()
+                    self.__callbackDispatcher__.dispatch(notification.clientHandle, f, [notification])
                 except:
                     notificationsWithoutCallback.append(notification)
         finally:
@@ -271,6 +705,74 @@ class Client(ClientBase):
         pass
     
     
+    def __dispatch_dataChangeBatchReceived__(self, batch):
+        """
+        Hidden method to dispatch a DataChangeNotificationBatch to the registered batch callbacks
+        and to the dataChangeBatchReceived method.
+        """
+        batch = DataChangeBatch(batch)
+        
+        for dic in self.__dataChangeBatchCallbacks__:
+            
+            callback                     = dic["callback"]
+            onlyClientSubscriptionHandle = dic["onlyClientSubscriptionHandle"]
+            
+            if onlyClientSubscriptionHandle is None \
+                    or onlyClientSubscriptionHandle == batch.clientSubscriptionHandle:
+                self.__callbackDispatcher__.dispatch(batch.clientSubscriptionHandle, 
+                                                     callback, 
+                                                     [batch])
+        
+        # also call the Client.dataChangeBatchReceived method, which may be overridden by the user:
+        try:
+            self.dataChangeBatchReceived(batch)
+        except:
+            pass # exception raised by the user, nothing we can do!
+    
+    
+    def dataChangeBatchReceived(self, batch):
+        """
+        Override this method to catch the data changes of subscriptions that were created with 
+        :attr:`~pyuaf.client.settings.SubscriptionSettings.batchDataChanges` set to True.
+        
+        Such subscriptions deliver all notifications of a single publish response at once, 
+        as columns (client handles, status codes, timestamps, numeric values, ...), instead of
+        as separate :class:`~pyuaf.client.DataChangeNotification` instances. 
+        So neither :meth:`~pyuaf.client.Client.dataChangesReceived` nor the notificationCallbacks 
+        of :meth:`~pyuaf.client.Client.createMonitoredData` will be called for them.
+        
+        Alternatively, you can also register callback functions which you defined yourself, by
+        registering them using :meth:`pyuaf.client.Client.registerDataChangeBatchCallback`.
+        
+        :param batch: The received data changes.
+        :type  batch: :class:`~pyuaf.client.DataChangeBatch`
+        """
+        pass
+    
+    
+    def registerDataChangeBatchCallback(self, callback, onlyClientSubscriptionHandle=None):
+        """
+        Register a callback to receive the data changes of subscriptions that were created with 
+        :attr:`~pyuaf.client.settings.SubscriptionSettings.batchDataChanges` set to True.
+        
+        You can register multiple callbacks: all of them will be called.
+        The :meth:`pyuaf.client.Client.dataChangeBatchReceived` method (which you may override) 
+        will also always be called, regardless of the callbacks you register.
+        
+        :param callback:                A callback function. This function should have one input
+                                        argument of type :class:`pyuaf.client.DataChangeBatch`.
+        :param onlyClientSubscriptionHandle:  Optional argument: provide this argument if you don't 
+                                        want to receive the data changes of *all* subscriptions,
+                                        but only of the single subscription identified by the given
+                                        unique clientSubscriptionHandle.
+        :type onlyClientSubscriptionHandle: ``int``
+        """
+        dic = { "callback" : callback,
+                "onlyClientSubscriptionHandle" : onlyClientSubscriptionHandle }
+        
+        self.__dataChangeBatchCallbacks__.append(dic)
+    
+    
     def __dispatch_eventsReceived__(self, eventNotifications):
         """
         Dispatch the EventNofications either to a virtual dataChangesReceived function,
@@ -284,8 +786,7 @@ class Client(ClientBase):
             for notification in eventNotifications:
                 try:
                     f = self.__eventNotificationCallbacks__[notification.clientHandle]
-                    t = threading.Thread(target=f, args=[notification])
-                    t.start()
+                    self.__callbackDispatcher__.dispatch(notification.clientHandle, f, [notification])
                 except:
                     notificationsWithoutCallback.append(notification)
         finally:
@@ -325,6 +826,73 @@ class Client(ClientBase):
         pass
     
     
+    def __dispatch_eventBatchReceived__(self, batch):
+        """
+        Hidden method to dispatch an EventNotificationBatch to the registered batch callbacks
+        and to the eventBatchReceived method.
+        """
+        batch = EventBatch(batch)
+        
+        for dic in self.__eventBatchCallbacks__:
+            
+            callback                     = dic["callback"]
+            onlyClientSubscriptionHandle = dic["onlyClientSubscriptionHandle"]
+            
+            if onlyClientSubscriptionHandle is None \
+                    or onlyClientSubscriptionHandle == batch.clientSubscriptionHandle:
+                self.__callbackDispatcher__.dispatch(batch.clientHandle, callback, [batch])
+        
+        # also call the Client.eventBatchReceived method, which may be overridden by the user:
+        try:
+            self.eventBatchReceived(batch)
+        except:
+            pass # exception raised by the user, nothing we can do!
+    
+    
+    def eventBatchReceived(self, batch):
+        """
+        Override this method to catch the events of subscriptions that were created with 
+        :attr:`~pyuaf.client.settings.SubscriptionSettings.batchEvents` set to True.
+        
+        Such subscriptions deliver the events of a single publish response at once (one batch per
+        monitored item), as columns indexed by the :class:`~pyuaf.client.EventSchema` of the 
+        monitored item, instead of as separate :class:`~pyuaf.client.EventNotification` 
+        instances. So neither :meth:`~pyuaf.client.Client.eventsReceived` nor the 
+        notificationCallbacks of :meth:`~pyuaf.client.Client.createMonitoredEvents` will be 
+        called for them.
+        
+        Alternatively, you can also register callback functions which you defined yourself, by
+        registering them using :meth:`pyuaf.client.Client.registerEventBatchCallback`.
+        
+        :param batch: The received events.
+        :type  batch: :class:`~pyuaf.client.EventBatch`
+        """
+        pass
+    
+    
+    def registerEventBatchCallback(self, callback, onlyClientSubscriptionHandle=None):
+        """
+        Register a callback to receive the events of subscriptions that were created with 
+        :attr:`~pyuaf.client.settings.SubscriptionSettings.batchEvents` set to True.
+        
+        You can register multiple callbacks: all of them will be called.
+        The :meth:`pyuaf.client.Client.eventBatchReceived` method (which you may override) 
+        will also always be called, regardless of the callbacks you register.
+        
+        :param callback:                A callback function. This function should have one input
+                                        argument of type :class:`pyuaf.client.EventBatch`.
+        :param onlyClientSubscriptionHandle:  Optional argument: provide this argument if you don't 
+                                        want to receive the events of *all* subscriptions,
+                                        but only of the single subscription identified by the given
+                                        unique clientSubscriptionHandle.
+        :type onlyClientSubscriptionHandle: ``int``
+        """
+        dic = { "callback" : callback,
+                "onlyClientSubscriptionHandle" : onlyClientSubscriptionHandle }
+        
+        self.__eventBatchCallbacks__.append(dic)
+    
+    
     def __dispatch_logMessageReceived__(self, message):
         try:
             if self.__loggingCallback__ is None:
@@ -391,8 +959,7 @@ class Client(ClientBase):
                     doCall = False    
             
             if doCall:
-                t = threading.Thread(target=callback, args=[info])
-                t.start()
+                self.__callbackDispatcher__.dispatch(info.clientConnectionId, callback, [info])
         
         # also call the Client.connectionStatusChanged method, which may be overridden by the user:
         try:
@@ -449,6 +1016,62 @@ class Client(ClientBase):
         self.__connectionCallbacks__.append(dic)
     
     
+    def __dispatch_serversChanged__(self, appeared, disappeared, changed):
+        """
+        Hidden method to dispatch the changes of the discovered servers to the correct callback
+        methods.
+        """
+        # create copies using the C++ copy constructor, 
+        # so that the instances may be stored on the python level:
+        appeared    = pyuaf.util.ApplicationDescriptionVector(appeared)
+        disappeared = pyuaf.util.ApplicationDescriptionVector(disappeared)
+        changed     = pyuaf.util.ApplicationDescriptionVector(changed)
+        
+        for callback in self.__serversChangedCallbacks__:
+            self.__callbackDispatcher__.dispatch(0, callback, [appeared, disappeared, changed])
+        
+        # also call the Client.serversChanged method, which may be overridden by the user:
+        try:
+            self.serversChanged(appeared, disappeared, changed)
+        except:
+            pass # exception raised by the user, nothing we can do!
+    
+    
+    def serversChanged(self, appeared, disappeared, changed):
+        """
+        Override this method to receive the changes of the discovered servers.
+        
+        This method is only called for the servers that appeared, disappeared or changed during
+        the discovery, not for the servers that were simply discovered again.
+        
+        Alternatively, you can also register callback functions which you defined yourself, by
+        registering them using :meth:`pyuaf.client.Client.registerServersChangedCallback`.
+        
+        :param appeared:    The servers that were discovered for the first time.
+        :type  appeared:    :class:`~pyuaf.util.ApplicationDescriptionVector`
+        :param disappeared: The servers that are no longer discovered.
+        :type  disappeared: :class:`~pyuaf.util.ApplicationDescriptionVector`
+        :param changed:     The servers of which the description has changed.
+        :type  changed:     :class:`~pyuaf.util.ApplicationDescriptionVector`
+        """
+        pass
+    
+    
+    def registerServersChangedCallback(self, callback):
+        """
+        Register a callback to receive the changes of the discovered servers.
+        
+        You can register multiple callbacks: all of them will be called.
+        The :meth:`pyuaf.client.Client.serversChanged` method (which you may override) 
+        will also always be called, regardless of the callbacks you register.
+        
+        :param callback: A callback function. This function should have three input arguments
+                         (appeared, disappeared and changed), as described by
+                         :meth:`pyuaf.client.Client.serversChanged`.
+        """
+        self.__serversChangedCallbacks__.append(callback)
+    
+    
     def __dispatch_subscriptionStatusChanged__(self, info):
         """
         Hidden method to dispatch the changed subscription status information to the correct 
@@ -470,8 +1093,7 @@ class Client(ClientBase):
                     doCall = False
             
             if doCall:
-                t = threading.Thread(target=callback, args=[info])
-                t.start()
+                self.__callbackDispatcher__.dispatch(info.clientSubscriptionHandle, callback, [info])
         
         # also call the Client.subscriptionStatusChanged method, which may be overridden by the user:
         try:
@@ -537,8 +1159,9 @@ class Client(ClientBase):
                     doCall = False
             
             if doCall:
-                t = threading.Thread(target=callback, args=[info, previousSequenceNumber, newSequenceNumber])
-                t.start()
+                self.__callbackDispatcher__.dispatch(info.clientSubscriptionHandle, 
+                                                     callback, 
+                                                     [info, previousSequenceNumber, newSequenceNumber])
         
         # also call the Client.notificationsMissing method, which may be overridden by the user:
         try:
@@ -551,6 +1174,13 @@ class Client(ClientBase):
         """
         Override this method to handle missing notifications.
         
+        If the subscription was created with 
+        :attr:`~pyuaf.client.settings.SubscriptionSettings.republishMissingNotifications` set to
+        True, this method is only called if some of the missing notifications could not be 
+        recovered. The statistics of the info argument (e.g. 
+        :attr:`~pyuaf.client.SubscriptionInformation.noOfRecoveredNotifications`) tell you how 
+        many notifications were missing and recovered.
+        
         Alternatively, you can also register callback functions which you defined yourself, by
         registering them using :meth:`pyuaf.client.Client.registerNotificationsMissingCallback`.
         
@@ -619,8 +1249,9 @@ class Client(ClientBase):
                     doCall = False
             
             if doCall:
-                t = threading.Thread(target=callback, args=[notification])
-                t.start()
+                self.__callbackDispatcher__.dispatch(notification.clientSubscriptionHandle, 
+                                                     callback, 
+                                                     [notification])
         
         # also call the Client.keepAliveReceived method, which may be overridden by the user:
         try:
@@ -1155,6 +1786,27 @@ class Client(ClientBase):
        ClientBase.manuallyDisconnectAllSessions(self)
     
     
+    def waitUntilReady(self, timeoutSec):
+       """
+       Wait until the sessions to the pre-connected servers are connected.
+       
+       The servers of :attr:`~pyuaf.client.settings.ClientSettings.preConnectServerUris` (and all 
+       discovered servers, if :attr:`~pyuaf.client.settings.ClientSettings.preConnectAllDiscoveredServers`
+       is True) are connected in the background right after the settings are set, so that the 
+       first requests don't need to wait for the discovery and the connection. This method allows 
+       you to wait until this has happened, e.g. before your application reports that it's ready.
+       
+       :param timeoutSec: The maximum time to wait, in seconds (0.0 to only check).
+       :type timeoutSec: ``float``
+       :raise pyuaf.util.errors.ClientNotReadyError:
+            Raised in case the pre-connected sessions are still not connected when the timeout 
+            expires.
+       :raise pyuaf.util.errors.UafError:
+            Base exception, catch this to handle any other errors.
+       """
+       ClientBase.waitUntilReady(self, timeoutSec).test()
+    
+    
     def manuallySubscribe(self, clientConnectionId, subscriptionSettings=None):
        """
        Create a subscription manually.
@@ -2263,6 +2915,8 @@ class Client(ClientBase):
                             use the generic :meth:`~pyuaf.client.Client.processRequest` method
                             with a :class:`~pyuaf.client.requests.CreateMonitoredEventsRequest` as 
                             argument. Leave None for defaults.
+                            Use its whereClause to let the server filter the events (e.g. by 
+                            type or severity), instead of filtering them in the callbacks.
         :type  eventFilter: :class:`~pyuaf.util.EventFilter` 
         :param notificationCallbacks: A list of callback functions (one for each node to be monitored).
                                       These callback functions should have a single argument, which
@@ -2511,14 +3165,85 @@ class Client(ClientBase):
                                               results)
         status.test()
         return results
+    
+    
+    def modifyMonitoredItems(self, clientHandles, settings, serviceSettings=None):
+        """
+        Modify the sampling interval, queue size, discardOldest flag and filter of the specified
+        monitored items, without deleting and re-creating them.
+        
+        The monitored items that belong to the same subscription are modified by a single 
+        ModifyMonitoredItems service call. The settings of the monitored items (as returned by 
+        :meth:`~pyuaf.client.Client.monitoredItemInformation`) and the persistent requests that 
+        created them are updated too, so the new settings are also used when the monitored items
+        must be re-created (e.g. after the server was restarted).
+        
+        The kind (data or event) of each of the new settings must match the kind of the monitored 
+        item. So the easiest way is to start from the current settings, as shown below.
+        
+        Example:
+        
+        .. doctest::
+        
+            >>> import pyuaf
+            >>> from pyuaf.util.errors import UafError
+            >>> from pyuaf.client import Client
+            >>> 
+            >>> myClient = Client("myClient", ["opc.tcp://localhost:4841"])
+            >>>
+            >>> # ... create some monitored items and store their clientHandles ...
+            >>>
+            >>> def adaptSamplingInterval(clientHandles, samplingIntervalSec):
+            ...     settings = []
+            ...     for clientHandle in clientHandles:
+            ...         info = myClient.monitoredItemInformation(clientHandle)
+            ...         info.settings.samplingIntervalSec = samplingIntervalSec
+            ...         settings.append(info.settings)
+            ...     try:
+            ...         statuses = myClient.modifyMonitoredItems(clientHandles, settings)
+            ...         for i in range(len(statuses)):
+            ...             if not statuses[i].isGood():
+            ...                 print("Could not modify item %d: %s" %(clientHandles[i], statuses[i])) 
+            ...     except UafError, e:
+            ...         print("Couldn't modify the monitored items: %s" %e)
+            
+        
+        :param clientHandles:    List of client handles of the monitored items you want to change.
+        :type  clientHandles:    ``list`` of ``int``
+        :param settings:         New settings, one for each client handle.
+        :type  settings:         ``list`` of :class:`~pyuaf.client.settings.MonitoredItemSettings`
+                                 or a :class:`~pyuaf.client.settings.MonitoredItemSettingsVector`
+        :param serviceSettings:  The service settings to be used (leave None for the 
+                                 :attr:`~pyuaf.client.settings.ClientSettings.defaultModifyMonitoredItemsSettings`).
+        :type  serviceSettings:  :class:`pyuaf.client.settings.ServiceSettings`
+        :return:                 A list of statuses, one for each client handle.
+        :rtype:                  :class:`~pyuaf.util.StatusVector`.
+        :raise pyuaf.util.errors.InvalidRequestError:
+             Raised in case the number of settings does not match the number of client handles.
+        :raise pyuaf.util.errors.UafError:
+             Base exception, catch this to handle any UAF errors.
+        """
+        results = pyuaf.util.StatusVector()
+        status = ClientBase.modifyMonitoredItems(self, 
+                                                 clientHandles, 
+                                                 settings, 
+                                                 serviceSettings, 
+                                                 results)
+        status.test()
+        return results
         
             
     def structureDefinition(self, dataTypeId):
         """
         Get a structure definition for the given datatype NodeId.
         
-        :param dataTypeId:    NodeId of the datatype.
-        :type  dataTypeId:    :class:`~pyuaf.util.NodeId`.
+        The definitions are cached per server, until the NamespaceArray of the server changes
+        (see also :attr:`~pyuaf.client.settings.ClientSettings.prefetchStructureDefinitions`).
+        If an ExpandedNodeId with a server URI is given, only the sessions to this server are
+        asked for the definition.
+        
+        :param dataTypeId:    NodeId (or ExpandedNodeId) of the datatype.
+        :type  dataTypeId:    :class:`~pyuaf.util.NodeId` or :class:`~pyuaf.util.ExpandedNodeId`.
         :return:              The definition of this datatype. 
         :rtype:               :class:`~pyuaf.util.StructureDefinition`.
         :raise pyuaf.util.errors.DefinitionNotFoundError:
@@ -2530,6 +3255,18 @@ class Client(ClientBase):
         status = ClientBase.structureDefinition(self, dataTypeId, result)
         status.test()
         return result
+    
+    
+    def noOfCachedStructureDefinitions(self, serverUri):
+        """
+        Get the number of structure definitions that are currently cached for a server.
+        
+        :param serverUri: The URI of the server.
+        :type  serverUri: ``str``
+        :return:          The number of cached definitions (e.g. after they were prefetched).
+        :rtype:           ``int``
+        """
+        return ClientBase.noOfCachedStructureDefinitions(self, serverUri)
         
         
         
@@ -2626,6 +3363,14 @@ class Client(ClientBase):
             result = pyuaf.client.results.HistoryReadRawModifiedResult()
         elif type(request) == pyuaf.client.requests.AsyncMethodCallRequest:
             result = pyuaf.client.results.AsyncMethodCallResult()
+        elif type(request) == pyuaf.client.requests.AsyncBrowseRequest:
+            result = pyuaf.client.results.AsyncBrowseResult()
+        elif type(request) == pyuaf.client.requests.AsyncBrowseNextRequest:
+            result = pyuaf.client.results.AsyncBrowseNextResult()
+        elif type(request) == pyuaf.client.requests.AsyncTranslateBrowsePathsToNodeIdsRequest:
+            result = pyuaf.client.results.AsyncTranslateBrowsePathsToNodeIdsResult()
+        elif type(request) == pyuaf.client.requests.AsyncHistoryReadRawModifiedRequest:
+            result = pyuaf.client.results.AsyncHistoryReadRawModifiedResult()
         elif type(request) == pyuaf.client.requests.CreateMonitoredDataRequest:
             result = pyuaf.client.results.CreateMonitoredDataResult()
         elif type(request) == pyuaf.client.requests.CreateMonitoredEventsRequest:
@@ -2641,6 +3386,14 @@ class Client(ClientBase):
                 self.__asyncWriteLock__.acquire()
             elif type(request) == pyuaf.client.requests.AsyncMethodCallRequest:
                 self.__asyncCallLock__.acquire()
+            elif type(request) == pyuaf.client.requests.AsyncBrowseRequest:
+                self.__asyncBrowseLock__.acquire()
+            elif type(request) == pyuaf.client.requests.AsyncBrowseNextRequest:
+                self.__asyncBrowseNextLock__.acquire()
+            elif type(request) == pyuaf.client.requests.AsyncTranslateBrowsePathsToNodeIdsRequest:
+                self.__asyncTranslateBrowsePathsToNodeIdsLock__.acquire()
+            elif type(request) == pyuaf.client.requests.AsyncHistoryReadRawModifiedRequest:
+                self.__asyncHistoryReadRawModifiedLock__.acquire()
             
             try:
                 # also acquire the locks in case of monitored item callbacks
@@ -2674,6 +3427,14 @@ class Client(ClientBase):
                         self.__asyncWriteCallbacks__[result.requestHandle] = resultCallback
                     elif type(request) == pyuaf.client.requests.AsyncMethodCallRequest:
                         self.__asyncCallCallbacks__[result.requestHandle] = resultCallback
+                    elif type(request) == pyuaf.client.requests.AsyncBrowseRequest:
+                        self.__asyncBrowseCallbacks__[result.requestHandle] = resultCallback
+                    elif type(request) == pyuaf.client.requests.AsyncBrowseNextRequest:
+                        self.__asyncBrowseNextCallbacks__[result.requestHandle] = resultCallback
+                    elif type(request) == pyuaf.client.requests.AsyncTranslateBrowsePathsToNodeIdsRequest:
+                        self.__asyncTranslateBrowsePathsToNodeIdsCallbacks__[result.requestHandle] = resultCallback
+                    elif type(request) == pyuaf.client.requests.AsyncHistoryReadRawModifiedRequest:
+                        self.__asyncHistoryReadRawModifiedCallbacks__[result.requestHandle] = resultCallback
                 
                 return result
             finally:
@@ -2691,6 +3452,14 @@ class Client(ClientBase):
                 self.__asyncWriteLock__.release()
             elif type(request) == pyuaf.client.requests.AsyncMethodCallRequest:
                 self.__asyncCallLock__.release()
+            elif type(request) == pyuaf.client.requests.AsyncBrowseRequest:
+                self.__asyncBrowseLock__.release()
+            elif type(request) == pyuaf.client.requests.AsyncBrowseNextRequest:
+                self.__asyncBrowseNextLock__.release()
+            elif type(request) == pyuaf.client.requests.AsyncTranslateBrowsePathsToNodeIdsRequest:
+                self.__asyncTranslateBrowsePathsToNodeIdsLock__.release()
+            elif type(request) == pyuaf.client.requests.AsyncHistoryReadRawModifiedRequest:
+                self.__asyncHistoryReadRawModifiedLock__.release()
 
 
 #### END OF INCLUDED PYTHON FILE
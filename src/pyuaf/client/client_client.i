@@ -60,7 +60,10 @@
 #include "uaf/client/results/results.h"
 #include "uaf/client/subscriptions/monitoreditemnotification.h"
 #include "uaf/client/subscriptions/datachangenotification.h"
+#include "uaf/client/subscriptions/datachangenotificationbatch.h"
 #include "uaf/client/subscriptions/eventnotification.h"
+#include "uaf/client/subscriptions/eventschema.h"
+#include "uaf/client/subscriptions/eventnotificationbatch.h"
 #include "uaf/client/subscriptions/keepalivenotification.h"
 #include "uaf/client/subscriptions/subscriptioninformation.h"
 #include "uaf/client/subscriptions/monitoreditemstates.h"
@@ -74,6 +77,16 @@
 %pythoncode %{
 import threading
 import time
+import traceback
+import array
+try:
+    import numpy
+except ImportError:
+    numpy = None
+try:
+    import Queue as queue   # Python 2
+except ImportError:
+    import queue            # Python 3
 %}
 
 
@@ -109,6 +122,7 @@ import time
 %import(module="pyuaf.util.serverstates")            "pyuaf/util/util_serverstates.i"
 %import(module="pyuaf.util.messagesecuritymodes")    "pyuaf/util/util_messagesecuritymodes.i"
 %import(module="pyuaf.util.monitoringmodes")         "pyuaf/util/util_monitoringmodes.i"
+%import(module="pyuaf.util.filteroperators")         "pyuaf/util/util_filteroperators.i"
 %import(module="pyuaf.util.browsedirections")        "pyuaf/util/util_browsedirections.i"
 %import(module="pyuaf.util.nodeclasses")             "pyuaf/util/util_nodeclasses.i"
 %import(module="pyuaf.util.timestampstoreturn")      "pyuaf/util/util_timestampstoreturn.i"
@@ -133,13 +147,47 @@ import time
 
 
 // before including any classes in a generic way, specify the "special treatments" of certain classes:
+
+// The columns of a DataChangeNotificationBatch can be copied at once (i.e. with a single memcpy)
+// into a Python bytearray, which can then be interpreted by numpy.frombuffer() or array.array
+// without converting the elements one by one.
+%define BATCH_COLUMN_TO_BYTEARRAY(COLUMN)
+    PyObject* __##COLUMN##Bytes__() const
+    {
+        if ($self->COLUMN.empty())
+            return PyByteArray_FromStringAndSize(NULL, 0);
+        return PyByteArray_FromStringAndSize(
+                (const char*) &$self->COLUMN[0],
+                $self->COLUMN.size() * sizeof($self->COLUMN[0]));
+    }
+%enddef
+
+%extend uaf::DataChangeNotificationBatch {
+    BATCH_COLUMN_TO_BYTEARRAY(clientHandles)
+    BATCH_COLUMN_TO_BYTEARRAY(statusCodes)
+    BATCH_COLUMN_TO_BYTEARRAY(sourceTimestamps)
+    BATCH_COLUMN_TO_BYTEARRAY(serverTimestamps)
+    BATCH_COLUMN_TO_BYTEARRAY(numericValues)
+}
+
+%extend uaf::EventNotificationBatch {
+    BATCH_COLUMN_TO_BYTEARRAY(numericValues)
+}
+
 %rename(__dispatch_readComplete__)                          uaf::ClientInterface::readComplete;
 %rename(__dispatch_writeComplete__)                         uaf::ClientInterface::writeComplete;
 %rename(__dispatch_callComplete__)                          uaf::ClientInterface::callComplete;
+%rename(__dispatch_browseComplete__)                        uaf::ClientInterface::browseComplete;
+%rename(__dispatch_browseNextComplete__)                    uaf::ClientInterface::browseNextComplete;
+%rename(__dispatch_translateBrowsePathsToNodeIdsComplete__) uaf::ClientInterface::translateBrowsePathsToNodeIdsComplete;
+%rename(__dispatch_historyReadRawModifiedComplete__)        uaf::ClientInterface::historyReadRawModifiedComplete;
 %rename(__dispatch_dataChangesReceived__)                   uaf::ClientInterface::dataChangesReceived;
+%rename(__dispatch_dataChangeBatchReceived__)               uaf::ClientInterface::dataChangeBatchReceived;
 %rename(__dispatch_eventsReceived__)                        uaf::ClientInterface::eventsReceived;
+%rename(__dispatch_eventBatchReceived__)                    uaf::ClientInterface::eventBatchReceived;
 %rename(__dispatch_keepAliveReceived__)                     uaf::ClientInterface::keepAliveReceived;
 %rename(__dispatch_connectionStatusChanged__)               uaf::ClientInterface::connectionStatusChanged;
+%rename(__dispatch_serversChanged__)                        uaf::ClientInterface::serversChanged;
 %rename(__dispatch_subscriptionStatusChanged__)             uaf::ClientInterface::subscriptionStatusChanged;
 %rename(__dispatch_notificationsMissing__)                  uaf::ClientInterface::notificationsMissing;
 %rename(__dispatch_untrustedServerCertificateReceived__)    uaf::ClientInterface::untrustedServerCertificateReceived;
@@ -152,6 +200,9 @@ UAF_WRAP_CLASS("uaf/client/subscriptions/monitorediteminformation.h"  , uaf , Mo
 UAF_WRAP_CLASS("uaf/client/subscriptions/monitoreditemnotification.h" , uaf , MonitoredItemNotification , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.client, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/client/subscriptions/datachangenotification.h"    , uaf , DataChangeNotification    , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.client, DataChangeNotificationVector)
 UAF_WRAP_CLASS("uaf/client/subscriptions/eventnotification.h"         , uaf , EventNotification         , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.client, EventNotificationVector)
+UAF_WRAP_CLASS("uaf/client/subscriptions/datachangenotificationbatch.h", uaf , DataChangeNotificationBatch, COPY_YES, TOSTRING_YES, COMP_NO, pyuaf.client, VECTOR_NO)
+UAF_WRAP_CLASS("uaf/client/subscriptions/eventschema.h"               , uaf , EventSchema               , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.client, VECTOR_NO)
+UAF_WRAP_CLASS("uaf/client/subscriptions/eventnotificationbatch.h"    , uaf , EventNotificationBatch    , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.client, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/client/subscriptions/keepalivenotification.h"     , uaf , KeepAliveNotification     , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.client, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/client/sessions/sessioninformation.h"             , uaf , SessionInformation        , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.client, SessionInformationVector)
 UAF_WRAP_CLASS("uaf/client/clientinterface.h"                         , uaf , ClientInterface           , COPY_NO,  TOSTRING_NO,  COMP_NO,  pyuaf.client, VECTOR_NO)
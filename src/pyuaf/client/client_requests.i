@@ -56,6 +56,7 @@
 // import the necessary dependencies from pyuaf.util
 %import(module="pyuaf.util.attributeids")       "pyuaf/util/util_attributeids.i"
 %import(module="pyuaf.util.monitoringmodes")    "pyuaf/util/util_monitoringmodes.i"
+%import(module="pyuaf.util.filteroperators")    "pyuaf/util/util_filteroperators.i"
 %import(module="pyuaf.util.primitives")         "pyuaf/util/util_primitives.i"
 %import(module="pyuaf.util.browsedirections")   "pyuaf/util/util_browsedirections.i"
 %import(module="pyuaf.util.nodeclasses")        "pyuaf/util/util_nodeclasses.i"
@@ -185,6 +186,10 @@ CREATE_UAF_SYNC_SESSIONREQUEST(HistoryReadRawModified)
 CREATE_UAF_ASYNC_SESSIONREQUEST(Read)
 CREATE_UAF_ASYNC_SESSIONREQUEST(Write)
 CREATE_UAF_ASYNC_SESSIONREQUEST(MethodCall)
+CREATE_UAF_ASYNC_SESSIONREQUEST(TranslateBrowsePathsToNodeIds)
+CREATE_UAF_ASYNC_SESSIONREQUEST(Browse)
+CREATE_UAF_ASYNC_SESSIONREQUEST(BrowseNext)
+CREATE_UAF_ASYNC_SESSIONREQUEST(HistoryReadRawModified)
 
 
 // define a macro to create synchronous subscription requests
@@ -51,6 +51,7 @@
 // import the necessary dependencies from pyuaf.util
 %import(module="pyuaf.util.attributeids")       "pyuaf/util/util_attributeids.i"
 %import(module="pyuaf.util.monitoringmodes")    "pyuaf/util/util_monitoringmodes.i"
+%import(module="pyuaf.util.filteroperators")    "pyuaf/util/util_filteroperators.i"
 %import(module="pyuaf.util.primitives")         "pyuaf/util/util_primitives.i"
 %import(module="pyuaf.util.browsedirections")   "pyuaf/util/util_browsedirections.i"
 %import(module="pyuaf.util.nodeclasses")        "pyuaf/util/util_nodeclasses.i"
@@ -123,6 +124,10 @@ CREATE_UAF_SYNC_SESSIONRESULT(HistoryReadRawModified)
 CREATE_UAF_ASYNC_SESSIONRESULT(Read)
 CREATE_UAF_ASYNC_SESSIONRESULT(Write)
 CREATE_UAF_ASYNC_SESSIONRESULT(MethodCall)
+CREATE_UAF_ASYNC_SESSIONRESULT(TranslateBrowsePathsToNodeIds)
+CREATE_UAF_ASYNC_SESSIONRESULT(Browse)
+CREATE_UAF_ASYNC_SESSIONRESULT(BrowseNext)
+CREATE_UAF_ASYNC_SESSIONRESULT(HistoryReadRawModified)
 
 
 // define a macro to create synchronous subscription results
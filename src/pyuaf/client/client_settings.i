@@ -70,6 +70,7 @@
 %import(module="pyuaf.util.securitypolicies")       "pyuaf/util/util_securitypolicies.i"
 %import(module="pyuaf.util.serverstates")           "pyuaf/util/util_serverstates.i"
 %import(module="pyuaf.util.monitoringmodes")        "pyuaf/util/util_monitoringmodes.i"
+%import(module="pyuaf.util.filteroperators")        "pyuaf/util/util_filteroperators.i"
 %import(module="pyuaf.util.browsedirections")       "pyuaf/util/util_browsedirections.i"
 %import(module="pyuaf.util.nodeclasses")            "pyuaf/util/util_nodeclasses.i"
 %import(module="pyuaf.util.timestampstoreturn")     "pyuaf/util/util_timestampstoreturn.i"
@@ -95,7 +96,7 @@ UAF_WRAP_CLASS("uaf/client/settings/servicesettings.h"                       , u
 UAF_WRAP_CLASS("uaf/client/settings/sessionsecuritysettings.h"               , uaf , SessionSecuritySettings               , COPY_YES, TOSTRING_YES, COMP_YES,  pyuaf.client.settings, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/client/settings/sessionsettings.h"                       , uaf , SessionSettings                       , COPY_YES, TOSTRING_YES, COMP_YES,  pyuaf.client.settings, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/client/settings/subscriptionsettings.h"                  , uaf , SubscriptionSettings                  , COPY_YES, TOSTRING_YES, COMP_YES,  pyuaf.client.settings, VECTOR_NO)
-UAF_WRAP_CLASS("uaf/client/settings/monitoreditemsettings.h"                 , uaf , MonitoredItemSettings                 , COPY_YES, TOSTRING_YES, COMP_YES,  pyuaf.client.settings, VECTOR_NO)
+UAF_WRAP_CLASS("uaf/client/settings/monitoreditemsettings.h"                 , uaf , MonitoredItemSettings                 , COPY_YES, TOSTRING_YES, COMP_YES,  pyuaf.client.settings, MonitoredItemSettingsVector)
 UAF_WRAP_CLASS("uaf/client/settings/readsettings.h"                          , uaf , ReadSettings                          , COPY_YES, TOSTRING_YES, COMP_YES,  pyuaf.client.settings, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/client/settings/writesettings.h"                         , uaf , WriteSettings                         , COPY_YES, TOSTRING_YES, COMP_YES,  pyuaf.client.settings, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/client/settings/historyreadrawmodifiedsettings.h"        , uaf , HistoryReadRawModifiedSettings        , COPY_YES, TOSTRING_YES, COMP_YES,  pyuaf.client.settings, VECTOR_NO)
@@ -50,6 +50,345 @@
 
 
 
+// =================================================================================================
+// Buffer protocol support
+// =================================================================================================
+//
+// Any object that exposes a C-contiguous numeric buffer (a numpy.ndarray, an array.array, a
+// memoryview, ...) is converted to a Variant without creating a Python object per element:
+// one-dimensional buffers become arrays, multi-dimensional buffers become matrices.
+// The other way around, numeric arrays and matrices are converted to numpy arrays (or to
+// array.array instances if numpy isn't available) in one pass, but only if this was enabled by
+// pyuaf.util.setNumericArraysEnabled(True), since the default behavior is to return lists of
+// pyuaf.util.primitives instances.
+
+
+/**
+ * Get the OPC UA type that corresponds to the format and item size of a Python buffer, or
+ * uaf::opcuatypes::Null if the buffer can not be converted.
+ */
+uaf::opcuatypes::OpcUaType bufferFormatToOpcUaType(const char* format, Py_ssize_t itemSize)
+{
+    // no format means unsigned bytes
+    if (format == NULL)
+        format = "B";
+
+    // only accept the native byte order
+    const uint16_t one = 1;
+    bool littleEndian = (*((const uint8_t*)&one) == 1);
+    if (format[0] == '@' || format[0] == '=' || (format[0] == '<' && littleEndian))
+        format++;
+
+    // only accept single items (no structures)
+    if (format[0] == '\0' || format[1] != '\0')
+        return uaf::opcuatypes::Null;
+
+    switch (format[0])
+    {
+        case '?':
+            return itemSize == 1 ? uaf::opcuatypes::Boolean : uaf::opcuatypes::Null;
+        case 'f':
+            return itemSize == 4 ? uaf::opcuatypes::Float : uaf::opcuatypes::Null;
+        case 'd':
+            return itemSize == 8 ? uaf::opcuatypes::Double : uaf::opcuatypes::Null;
+        case 'b': case 'h': case 'i': case 'l': case 'q':
+            if      (itemSize == 1) return uaf::opcuatypes::SByte;
+            else if (itemSize == 2) return uaf::opcuatypes::Int16;
+            else if (itemSize == 4) return uaf::opcuatypes::Int32;
+            else if (itemSize == 8) return uaf::opcuatypes::Int64;
+            else                    return uaf::opcuatypes::Null;
+        case 'B': case 'H': case 'I': case 'L': case 'Q':
+            if      (itemSize == 1) return uaf::opcuatypes::Byte;
+            else if (itemSize == 2) return uaf::opcuatypes::UInt16;
+            else if (itemSize == 4) return uaf::opcuatypes::UInt32;
+            else if (itemSize == 8) return uaf::opcuatypes::UInt64;
+            else                    return uaf::opcuatypes::Null;
+        default:
+            return uaf::opcuatypes::Null;
+    }
+}
+
+
+/**
+ * Get a C-contiguous numeric buffer of the given Python object.
+ * If true is returned, the buffer must be released by PyBuffer_Release().
+ */
+bool getNumericBuffer(PyObject* pyObject, Py_buffer& view, uaf::opcuatypes::OpcUaType& type)
+{
+    if (!PyObject_CheckBuffer(pyObject))
+        return false;
+
+    if (PyObject_GetBuffer(pyObject, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0)
+    {
+        // e.g. a non-contiguous numpy array: let the sequence conversion handle it
+        PyErr_Clear();
+        return false;
+    }
+
+    type = bufferFormatToOpcUaType(view.format, view.itemsize);
+
+    if (type == uaf::opcuatypes::Null)
+    {
+        PyBuffer_Release(&view);
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+ * Check if the given Python object exposes a numeric buffer that can be converted to a Variant.
+ */
+bool isNumericBuffer(PyObject* pyObject)
+{
+    Py_buffer view;
+    uaf::opcuatypes::OpcUaType type;
+    if (getNumericBuffer(pyObject, view, type))
+    {
+        PyBuffer_Release(&view);
+        return true;
+    }
+    return false;
+}
+
+
+#define BUFFER_TO_VARIANT_CASE(TYPE, CTYPE, VECTYPE, SDKTYPE, VIEW, LENGTH, VARIANT)                \
+    case uaf::opcuatypes::TYPE:                                                                     \
+    {                                                                                               \
+        const CTYPE* data = (const CTYPE*) VIEW.buf;                                                \
+        if (VIEW.ndim == 0)                                                                         \
+        {                                                                                           \
+            VARIANT.set##TYPE(data[0]);                                                             \
+        }                                                                                           \
+        else if (VIEW.ndim == 1)                                                                    \
+        {                                                                                           \
+            VARIANT.set##TYPE##Array(std::vector<VECTYPE>(data, data + LENGTH));                    \
+        }                                                                                           \
+        else                                                                                        \
+        {                                                                                           \
+            Ua##TYPE##Array uaElements;                                                             \
+            uaElements.resize(LENGTH);                                                              \
+            for (Py_ssize_t i = 0; i < LENGTH; i++)                                                 \
+                uaElements[i] = data[i];                                                            \
+            UaInt32Array uaDimensions;                                                              \
+            uaDimensions.resize(VIEW.ndim);                                                         \
+            for (int dim = 0; dim < VIEW.ndim; dim++)                                               \
+                uaDimensions[dim] = (OpcUa_Int32) VIEW.shape[dim];                                  \
+            UaVariant uaVariant;                                                                    \
+            uaVariant.set##SDKTYPE##Matrix(uaElements, uaDimensions);                               \
+            VARIANT.fromSdk(uaVariant);                                                             \
+        }                                                                                           \
+        break;                                                                                      \
+    }
+
+
+/**
+ * Convert a numeric buffer (obtained by getNumericBuffer) to a variant.
+ */
+void numericBufferToUafVariant(const Py_buffer& view,
+                               uaf::opcuatypes::OpcUaType type,
+                               uaf::Variant& variant)
+{
+    Py_ssize_t length = view.len / view.itemsize;
+
+    switch (type)
+    {
+        // booleans are stored as bytes by numpy and by the struct module
+        BUFFER_TO_VARIANT_CASE(Boolean, uint8_t,  bool,     Bool,   view, length, variant)
+        BUFFER_TO_VARIANT_CASE(SByte,   int8_t,   int8_t,   SByte,  view, length, variant)
+        BUFFER_TO_VARIANT_CASE(Byte,    uint8_t,  uint8_t,  Byte,   view, length, variant)
+        BUFFER_TO_VARIANT_CASE(Int16,   int16_t,  int16_t,  Int16,  view, length, variant)
+        BUFFER_TO_VARIANT_CASE(UInt16,  uint16_t, uint16_t, UInt16, view, length, variant)
+        BUFFER_TO_VARIANT_CASE(Int32,   int32_t,  int32_t,  Int32,  view, length, variant)
+        BUFFER_TO_VARIANT_CASE(UInt32,  uint32_t, uint32_t, UInt32, view, length, variant)
+        BUFFER_TO_VARIANT_CASE(Int64,   int64_t,  int64_t,  Int64,  view, length, variant)
+        BUFFER_TO_VARIANT_CASE(UInt64,  uint64_t, uint64_t, UInt64, view, length, variant)
+        BUFFER_TO_VARIANT_CASE(Float,   float,    float,    Float,  view, length, variant)
+        BUFFER_TO_VARIANT_CASE(Double,  double,   double,   Double, view, length, variant)
+        default:
+            variant.clear();
+            break;
+    }
+}
+
+
+/**
+ * Get the function that converts raw data to a numeric array, or NULL if the user didn't enable
+ * numeric arrays via pyuaf.util.setNumericArraysEnabled(True).
+ * The returned reference is borrowed.
+ */
+PyObject* getNumericArrayFactory()
+{
+    PyObject* modules = PyImport_GetModuleDict();
+    PyObject* utilModule = PyDict_GetItemString(modules, "pyuaf.util");
+    if (utilModule == NULL)
+        return NULL;
+
+    PyObject* factory = PyObject_GetAttrString(utilModule, "__numericArrayFactory__");
+    if (factory == NULL)
+    {
+        PyErr_Clear();
+        return NULL;
+    }
+
+    // the module keeps a reference, so we may return a borrowed one
+    Py_DECREF(factory);
+    return factory == Py_None ? NULL : factory;
+}
+
+
+/**
+ * Copy the elements of an array (a std::vector or an SDK array) into a new Python bytearray.
+ */
+template<typename CTYPE, typename ARRAY>
+PyObject* newByteArray(const ARRAY& array, Py_ssize_t length)
+{
+    PyObject* data = PyByteArray_FromStringAndSize(NULL, length * sizeof(CTYPE));
+    if (data != NULL)
+    {
+        CTYPE* buffer = (CTYPE*) PyByteArray_AS_STRING(data);
+        for (Py_ssize_t i = 0; i < length; i++)
+            buffer[i] = array[i];
+    }
+    return data;
+}
+
+
+/**
+ * Call the numeric array factory. Returns 1 if the array was created, 0 if the factory refused
+ * (e.g. a matrix when numpy is not available), and -1 if an exception was raised.
+ * The data and shape references are stolen.
+ */
+int callNumericArrayFactory(PyObject* factory,
+                            PyObject* data,
+                            const char* typeName,
+                            PyObject* shape,
+                            PyObject*& pyObject)
+{
+    if (data == NULL)
+    {
+        Py_XDECREF(shape);
+        return -1;
+    }
+
+    if (shape == NULL)
+    {
+        Py_INCREF(Py_None);
+        shape = Py_None;
+    }
+
+    PyObject* result = PyObject_CallFunction(factory, (char*)"OsO", data, typeName, shape);
+    Py_DECREF(data);
+    Py_DECREF(shape);
+
+    if (result == NULL)
+        return -1;
+
+    if (result == Py_None)
+    {
+        Py_DECREF(result);
+        return 0;
+    }
+
+    pyObject = result;
+    return 1;
+}
+
+
+#define CREATE_NUMERIC_ARRAY_CASE(TYPE, CTYPE, VARIANT, FACTORY, PYOBJECT)                         \
+    case uaf::opcuatypes::TYPE:                                                                    \
+    {                                                                                              \
+        std::vector<CTYPE> vec;                                                                    \
+        VARIANT.to##TYPE##Array(vec);                                                              \
+        return callNumericArrayFactory(FACTORY,                                                    \
+                                       newByteArray<CTYPE>(vec, vec.size()),                       \
+                                       #TYPE, NULL, PYOBJECT);                                     \
+    }
+
+
+#define CREATE_NUMERIC_MATRIX_CASE(TYPE, SDKTYPE, CTYPE, LENGTH, UAVARIANT, FACTORY, PYOBJECT)     \
+    case OpcUaType_##TYPE:                                                                         \
+    {                                                                                              \
+        Ua##TYPE##Array uaElements;                                                                \
+        UaInt32Array uaDimensions;                                                                 \
+        if (OpcUa_IsNotGood(UAVARIANT.to##SDKTYPE##Matrix(uaElements, uaDimensions)))              \
+            return 0;                                                                              \
+        PyObject* shape = PyTuple_New(uaDimensions.length());                                      \
+        for (OpcUa_UInt32 dim = 0; dim < uaDimensions.length(); dim++)                             \
+            PyTuple_SetItem(shape, dim, PyInt_FromLong(uaDimensions[dim]));                        \
+        return callNumericArrayFactory(FACTORY,                                                    \
+                                       newByteArray<CTYPE>(uaElements, uaElements.LENGTH()),       \
+                                       #TYPE, shape, PYOBJECT);                                    \
+    }
+
+
+/**
+ * Convert a numeric array or matrix variant to a numeric Python array, if enabled.
+ * Returns 1 if the array was created, 0 if the default conversion should be used instead,
+ * and -1 if an exception was raised.
+ */
+int uafVariantToNumericArray(const uaf::Variant& variant, PyObject*& pyObject)
+{
+    PyObject* factory = getNumericArrayFactory();
+    if (factory == NULL)
+        return 0;
+
+    if (variant.isArray())
+    {
+        switch (variant.type())
+        {
+            case uaf::opcuatypes::Boolean:
+            {
+                // std::vector<bool> is not contiguous, so it is copied as uint8_t values
+                std::vector<bool> vec;
+                variant.toBooleanArray(vec);
+                return callNumericArrayFactory(factory,
+                                               newByteArray<uint8_t>(vec, vec.size()),
+                                               "Boolean", NULL, pyObject);
+            }
+            CREATE_NUMERIC_ARRAY_CASE(SByte,  int8_t,   variant, factory, pyObject)
+            CREATE_NUMERIC_ARRAY_CASE(Byte,   uint8_t,  variant, factory, pyObject)
+            CREATE_NUMERIC_ARRAY_CASE(Int16,  int16_t,  variant, factory, pyObject)
+            CREATE_NUMERIC_ARRAY_CASE(UInt16, uint16_t, variant, factory, pyObject)
+            CREATE_NUMERIC_ARRAY_CASE(Int32,  int32_t,  variant, factory, pyObject)
+            CREATE_NUMERIC_ARRAY_CASE(UInt32, uint32_t, variant, factory, pyObject)
+            CREATE_NUMERIC_ARRAY_CASE(Int64,  int64_t,  variant, factory, pyObject)
+            CREATE_NUMERIC_ARRAY_CASE(UInt64, uint64_t, variant, factory, pyObject)
+            CREATE_NUMERIC_ARRAY_CASE(Float,  float,    variant, factory, pyObject)
+            CREATE_NUMERIC_ARRAY_CASE(Double, double,   variant, factory, pyObject)
+            default:
+                return 0;
+        }
+    }
+    else if (variant.isMatrix())
+    {
+        UaVariant uaVariant;
+        variant.toSdk(uaVariant);
+
+        switch (uaVariant.type())
+        {
+            CREATE_NUMERIC_MATRIX_CASE(Boolean, Bool,   uint8_t,  length, uaVariant, factory, pyObject)
+            CREATE_NUMERIC_MATRIX_CASE(SByte,   SByte,  int8_t,   length, uaVariant, factory, pyObject)
+            CREATE_NUMERIC_MATRIX_CASE(Byte,    Byte,   uint8_t,  size,   uaVariant, factory, pyObject)
+            CREATE_NUMERIC_MATRIX_CASE(Int16,   Int16,  int16_t,  length, uaVariant, factory, pyObject)
+            CREATE_NUMERIC_MATRIX_CASE(UInt16,  UInt16, uint16_t, length, uaVariant, factory, pyObject)
+            CREATE_NUMERIC_MATRIX_CASE(Int32,   Int32,  int32_t,  length, uaVariant, factory, pyObject)
+            CREATE_NUMERIC_MATRIX_CASE(UInt32,  UInt32, uint32_t, length, uaVariant, factory, pyObject)
+            CREATE_NUMERIC_MATRIX_CASE(Int64,   Int64,  int64_t,  length, uaVariant, factory, pyObject)
+            CREATE_NUMERIC_MATRIX_CASE(UInt64,  UInt64, uint64_t, length, uaVariant, factory, pyObject)
+            CREATE_NUMERIC_MATRIX_CASE(Float,   Float,  float,    length, uaVariant, factory, pyObject)
+            CREATE_NUMERIC_MATRIX_CASE(Double,  Double, double,   length, uaVariant, factory, pyObject)
+            default:
+                return 0;
+        }
+    }
+
+    return 0;
+}
+
+
+
 void checkPyObject(PyObject*& pyObject, int& RESULT)
 {
         if (PyBool_Check(pyObject))
@@ -60,6 +399,8 @@ void checkPyObject(PyObject*& pyObject, int& RESULT)
             RESULT = 1;
         else if (PyByteArray_Check(pyObject))
             RESULT = 1;
+        else if (isNumericBuffer(pyObject))
+            RESULT = 1;
         else if (PySequence_Check(pyObject))
         {
             bool allGood = true;
@@ -308,6 +649,8 @@ void checkPyObject(PyObject*& pyObject, int& RESULT)
 bool pyObjectToUafVariant(PyObject*& pyObject, uaf::Variant& variant)
 {
     void *ptr;
+    Py_buffer view;
+    uaf::opcuatypes::OpcUaType bufferType;
     if (pyObject == Py_None)
     {
         variant.clear();
@@ -336,6 +679,11 @@ bool pyObjectToUafVariant(PyObject*& pyObject, uaf::Variant& variant)
         Py_ssize_t length = PyByteArray_Size(pyObject);
         variant.setByteString((uint8_t*)data, length);
     }
+    else if (PyObject_CheckBuffer(pyObject) && getNumericBuffer(pyObject, view, bufferType))
+    {
+        numericBufferToUafVariant(view, bufferType, variant);
+        PyBuffer_Release(&view);
+    }
     else if (PySequence_Check(pyObject))
     {
         Py_ssize_t length = PySequence_Size(pyObject);
@@ -532,13 +880,25 @@ bool uafVariantToPyObject(uaf::Variant& variant, PyObject*& pyObject)
         Py_INCREF(Py_None);
         pyObject = Py_None;
     }
-    else if (variant.isArray())
-    {
-        CREATE_ARRAYOBJECT(variant, pyObject)
-    }
-    else if (variant.isMatrix())
+    else if (variant.isArray() || variant.isMatrix())
     {
-        CREATE_MATRIXOBJECT(variant, pyObject)
+        int numericArrayCreated = uafVariantToNumericArray(variant, pyObject);
+
+        if (numericArrayCreated < 0)
+        {
+            return false;
+        }
+        else if (numericArrayCreated == 0)
+        {
+            if (variant.isArray())
+            {
+                CREATE_ARRAYOBJECT(variant, pyObject)
+            }
+            else
+            {
+                CREATE_MATRIXOBJECT(variant, pyObject)
+            }
+        }
     }
     else
     {
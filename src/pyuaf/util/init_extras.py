@@ -24,5 +24,78 @@ def convert_uint32_to_int32(uint32):
 def convert_int32_to_uint32(int32):
     return int(int32 & 0xffffffff)
 
+
+import array as __array__
+try:
+    import numpy as __numpy__
+except ImportError:
+    __numpy__ = None
+
+
+# OPC UA type name: (array.array typecode, numpy dtype, item size in bytes)
+__NUMERIC_ARRAY_TYPES__ = { "Boolean" : ("B", "bool",    1),
+                            "SByte"   : ("b", "int8",    1),
+                            "Byte"    : ("B", "uint8",   1),
+                            "Int16"   : ("h", "int16",   2),
+                            "UInt16"  : ("H", "uint16",  2),
+                            "Int32"   : ("i", "int32",   4),
+                            "UInt32"  : ("I", "uint32",  4),
+                            "Int64"   : ("q", "int64",   8),
+                            "UInt64"  : ("Q", "uint64",  8),
+                            "Float"   : ("f", "float32", 4),
+                            "Double"  : ("d", "float64", 8) }
+
+
+def __createNumericArray__(data, typeName, shape):
+    """
+    Called by the Variant typemap to convert the raw data (a bytearray) of a numeric array or
+    matrix. Returns None if the default conversion must be used instead.
+    """
+    typecode, dtype, itemsize = __NUMERIC_ARRAY_TYPES__[typeName]
+    
+    if __numpy__ is not None:
+        # no copy: the numpy array is a view on the bytearray
+        ret = __numpy__.frombuffer(data, dtype=dtype)
+        if shape is not None:
+            ret = ret.reshape(shape)
+        return ret
+    elif shape is not None:
+        # matrices can only be represented by numpy arrays
+        return None
+    
+    try:
+        ret = __array__.array(typecode)
+    except ValueError:
+        # e.g. the "q" and "Q" typecodes are not supported by Python 2
+        return None
+    
+    if ret.itemsize != itemsize:
+        return None
+    
+    if hasattr(ret, "frombytes"):
+        ret.frombytes(bytes(data))
+    else:
+        ret.fromstring(bytes(data))
+    return ret
+
+
+__numericArrayFactory__ = None
+
+
+def setNumericArraysEnabled(enabled):
+    """
+    Return numeric arrays and matrices as numpy arrays (or as array.array instances if numpy
+    is not available) instead of as lists of pyuaf.util.primitives instances.
+    """
+    global __numericArrayFactory__
+    __numericArrayFactory__ = __createNumericArray__ if enabled else None
+
+
+def numericArraysEnabled():
+    """
+    Check if numeric arrays and matrices are returned as numpy arrays (or array.array instances).
+    """
+    return __numericArrayFactory__ is not None
+
 ################################### END OF INCLUDED PYTHON FILE ####################################
 %}
@@ -0,0 +1,502 @@
+"""
+Code generator for typed C++ structs, based on the StructureDefinitions of a server.
+
+Structures that are exchanged at a high rate don't need to go through the generic
+:class:`~pyuaf.util.GenericStructureValue` path: this module generates a plain C++ struct for
+each structured DataType, with a binary encoder and decoder (based on ``uaf/util/binarycodec.h``)
+and conversions from/to :class:`~pyuaf.util.ExtensionObject` and Variant.
+
+The definitions can be fetched from a server (via
+:meth:`pyuaf.client.Client.structureDefinition`), or read from a JSON file that was dumped
+before::
+
+    # fetch the definitions from a server, dump them, and generate a header:
+    python -m pyuaf.util.structgen --discovery-url opc.tcp://localhost:48010 \\
+                                   --server-uri urn:UnifiedAutomation:UaServerCpp \\
+                                   --datatype "ns=2;i=3002" \\
+                                   --dump definitions.json --output demotypes.h
+
+    # generate the header again from the dumped definitions (no server needed):
+    python -m pyuaf.util.structgen --definitions definitions.json --output demotypes.h
+
+The dumped JSON file contains a list of definitions, such as::
+
+    [ { "name"             : "Vector",
+        "namespaceUri"     : "http://www.unifiedautomation.com/DemoServer/",
+        "dataTypeId"       : { "namespaceIndex" : 2, "identifier" : 3002 },
+        "binaryEncodingId" : { "namespaceIndex" : 2, "identifier" : 5054 },
+        "fields"           : [ { "name" : "X", "valueType" : "Double", "isArray" : false }, ... ] } ]
+
+A field of a structured type has valueType "ExtensionObject", and refers to the "dataTypeId" of
+another definition in the same file.
+
+The generated code identifies the binary encoding by the "namespaceUri" of the definition (the
+"namespaceIndex" is only valid for the server at the time of the dump), so the structs keep
+working when the server changes the order of its NamespaceArray. Decoding fails (with a
+WrongTypeError) if an ExtensionObject has another encoding, or if its body doesn't have exactly
+the encoded size of the struct.
+
+Only the built-in types listed in CPP_TYPES (and nested structures) are supported.
+Unions are not supported.
+"""
+
+import json
+import re
+import sys
+
+
+# the C++ type and default value per supported OPC UA built-in type
+CPP_TYPES = { "Boolean"    : ("bool"           , "false"),
+              "SByte"      : ("int8_t"         , "0"),
+              "Byte"       : ("uint8_t"        , "0"),
+              "Int16"      : ("int16_t"        , "0"),
+              "UInt16"     : ("uint16_t"       , "0"),
+              "Int32"      : ("int32_t"        , "0"),
+              "UInt32"     : ("uint32_t"       , "0"),
+              "Int64"      : ("int64_t"        , "0"),
+              "UInt64"     : ("uint64_t"       , "0"),
+              "Float"      : ("float"          , "0.0f"),
+              "Double"     : ("double"         , "0.0"),
+              "String"     : ("std::string"    , None),
+              "DateTime"   : ("uaf::DateTime"  , None),
+              "ByteString" : ("uaf::ByteString", None),
+              "StatusCode" : ("uint32_t"       , "0") }
+
+# the C++ keywords that can't be used as field names
+CPP_KEYWORDS = set(["and", "auto", "bool", "break", "case", "catch", "char", "class", "const",
+                    "continue", "default", "delete", "do", "double", "else", "enum", "explicit",
+                    "export", "extern", "false", "float", "for", "friend", "goto", "if", "inline",
+                    "int", "long", "mutable", "namespace", "new", "not", "operator", "or",
+                    "private", "protected", "public", "register", "return", "short", "signed",
+                    "sizeof", "static", "struct", "switch", "template", "this", "throw", "true",
+                    "try", "typedef", "typeid", "typename", "union", "unsigned", "using",
+                    "virtual", "void", "volatile", "while"])
+
+
+class StructGenError(Exception):
+    """
+    Raised when a definition can't be converted into a C++ struct.
+    """
+    pass
+
+
+
+def nodeIdToDict(nodeId):
+    """
+    Convert a :class:`~pyuaf.util.NodeId` into a dictionary (as stored in the JSON file).
+    """
+    import pyuaf
+    identifier = nodeId.identifier()
+    if identifier.type == pyuaf.util.nodeididentifiertypes.Identifier_Numeric:
+        value = identifier.idNumeric
+    elif identifier.type == pyuaf.util.nodeididentifiertypes.Identifier_String:
+        value = identifier.idString
+    else:
+        raise StructGenError("Only numeric and string NodeIds are supported: %s" %nodeId)
+    return { "namespaceIndex" : nodeId.nameSpaceIndex(), "identifier" : value }
+
+
+def parseNodeId(text):
+    """
+    Parse a NodeId of the form "ns=2;i=3002" or "ns=2;s=SomeName" into a dictionary.
+    """
+    match = re.match(r"^(?:ns=(\d+);)?([is])=(.+)$", text)
+    if match is None:
+        raise StructGenError("Invalid NodeId '%s' (expected e.g. 'ns=2;i=3002')" %text)
+    namespaceIndex = int(match.group(1) or 0)
+    if match.group(2) == "i":
+        return { "namespaceIndex" : namespaceIndex, "identifier" : int(match.group(3)) }
+    else:
+        return { "namespaceIndex" : namespaceIndex, "identifier" : match.group(3) }
+
+
+def dictToNodeId(d):
+    """
+    Convert a dictionary (as stored in the JSON file) into a :class:`~pyuaf.util.NodeId`.
+    """
+    import pyuaf
+    return pyuaf.util.NodeId(d["identifier"], d["namespaceIndex"])
+
+
+def definitionToDict(definition):
+    """
+    Convert a :class:`~pyuaf.util.StructureDefinition` into a dictionary (as stored in the
+    JSON file).
+    """
+    import pyuaf
+    fields = []
+    for i in range(definition.childrenCount()):
+        child = definition.child(i)
+        field = { "name"      : child.name(),
+                  "valueType" : pyuaf.util.opcuatypes.toString(child.valueType()),
+                  "isArray"   : child.arrayType() == pyuaf.util.StructureField.ArrayType_Array }
+        if child.valueType() == pyuaf.util.opcuatypes.ExtensionObject:
+            field["dataTypeId"] = nodeIdToDict(child.typeId())
+        fields.append(field)
+
+    return { "name"             : definition.name(),
+             "namespaceUri"     : definition.getNamespace(),
+             "dataTypeId"       : nodeIdToDict(definition.dataTypeId()),
+             "binaryEncodingId" : nodeIdToDict(definition.binaryEncodingId()),
+             "isUnion"          : definition.isUnion(),
+             "fields"           : fields }
+
+
+def fetchDefinitions(client, serverUri, dataTypeIds):
+    """
+    Fetch the definitions of the given DataTypes (and of the structures they contain) from a
+    server.
+
+    :param client: The client to use.
+    :type  client: :class:`~pyuaf.client.Client`
+    :param serverUri: The URI of the server that owns the DataTypes.
+    :type  serverUri: ``str``
+    :param dataTypeIds: The DataTypes, as dictionaries (see :func:`parseNodeId`).
+    :type  dataTypeIds: ``list`` of ``dict``
+    :return: The definitions, as dictionaries (nested structures first).
+    :rtype: ``list`` of ``dict``
+    """
+    import pyuaf
+    definitions = []
+    todo = list(dataTypeIds)
+    done = []
+    while todo:
+        dataTypeId = todo.pop(0)
+        if dataTypeId in done:
+            continue
+        done.append(dataTypeId)
+        expandedNodeId = pyuaf.util.ExpandedNodeId(dictToNodeId(dataTypeId), serverUri)
+        definition = definitionToDict(client.structureDefinition(expandedNodeId))
+        definitions.append(definition)
+        for field in definition["fields"]:
+            if "dataTypeId" in field:
+                todo.append(field["dataTypeId"])
+    return sortDefinitions(definitions)
+
+
+def sortDefinitions(definitions):
+    """
+    Sort the definitions so that every structure comes after the structures it contains.
+    """
+    byId = dict((json.dumps(d["dataTypeId"], sort_keys=True), d) for d in definitions)
+    ordered = []
+    visiting = []
+
+    def visit(definition):
+        if definition in ordered:
+            return
+        if definition in visiting:
+            raise StructGenError("Structure %s contains itself" %definition["name"])
+        visiting.append(definition)
+        for field in definition["fields"]:
+            if "dataTypeId" in field:
+                key = json.dumps(field["dataTypeId"], sort_keys=True)
+                if key not in byId:
+                    raise StructGenError("Field %s of %s refers to an unknown structure %s"
+                                         %(field["name"], definition["name"], key))
+                visit(byId[key])
+        visiting.remove(definition)
+        ordered.append(definition)
+
+    for definition in definitions:
+        visit(definition)
+    return ordered
+
+
+def cppIdentifier(name):
+    """
+    Convert a name into a valid C++ identifier.
+    """
+    identifier = re.sub(r"\W", "_", name)
+    if identifier == "" or identifier[0].isdigit() or identifier in CPP_KEYWORDS:
+        identifier = "_" + identifier
+    return identifier
+
+
+def cppNodeId(d, namespaceUri):
+    """
+    Get the C++ expression that constructs a uaf::NodeId from a dictionary.
+
+    Only the standard namespace (0) is identified by its index, all others by the given URI.
+    """
+    if isinstance(d["identifier"], int):
+        identifier = "uint32_t(%d)" %d["identifier"]
+    else:
+        identifier = "std::string(%s)" %json.dumps(d["identifier"])
+
+    if d["namespaceIndex"] == 0:
+        return "uaf::NodeId(%s, uaf::NameSpaceIndex(0))" %identifier
+    elif namespaceUri:
+        return "uaf::NodeId(%s, std::string(%s))" %(identifier, json.dumps(namespaceUri))
+    else:
+        raise StructGenError("No namespaceUri for the NodeId %s" %json.dumps(d, sort_keys=True))
+
+
+def generateStruct(definition, structNames):
+    """
+    Generate the C++ code of a single struct.
+
+    :param definition: The definition, as a dictionary.
+    :param structNames: The C++ names of the structures that were generated already (per
+                        dataTypeId, serialized as JSON).
+    :return: The C++ code.
+    :rtype: ``str``
+    """
+    if definition.get("isUnion", False):
+        raise StructGenError("Union %s is not supported" %definition["name"])
+
+    name = cppIdentifier(definition["name"])
+    members = []
+    for field in definition["fields"]:
+        if field["valueType"] == "ExtensionObject":
+            cppType = structNames[json.dumps(field["dataTypeId"], sort_keys=True)]
+            default = None
+        elif field["valueType"] in CPP_TYPES:
+            cppType, default = CPP_TYPES[field["valueType"]]
+        else:
+            raise StructGenError("Field %s of %s has unsupported type %s"
+                                 %(field["name"], definition["name"], field["valueType"]))
+        if field.get("isArray", False):
+            cppType, default = "std::vector<%s >" %cppType, None
+        members.append((cppIdentifier(field["name"]), cppType, default))
+
+    idValue = definition["dataTypeId"]["identifier"]
+    encodingId = cppNodeId(definition["binaryEncodingId"], definition.get("namespaceUri"))
+    lines = []
+    lines.append("    /**")
+    lines.append("     * %s (DataType ns=%d;%s=%s)." %(definition["name"],
+                                                    definition["dataTypeId"]["namespaceIndex"],
+                                                    "i" if isinstance(idValue, int) else "s",
+                                                    idValue))
+    if definition.get("namespaceUri"):
+        lines.append("     * Namespace: %s" %definition["namespaceUri"])
+    lines.append("     */")
+    lines.append("    struct %s" %name)
+    lines.append("    {")
+    for member, cppType, default in members:
+        lines.append("        %s %s;" %(cppType, member))
+    lines.append("")
+
+    initializers = ["%s(%s)" %(member, default) for member, cppType, default in members
+                    if default is not None]
+    if initializers:
+        lines.append("        %s()" %name)
+        lines.append("        : " + (",\n          ".join(initializers)))
+        lines.append("        {}")
+        lines.append("")
+
+    lines.append("        /** The NodeId of the binary encoding (with the namespace URI, not the "
+                 "index). */")
+    lines.append("        static uaf::NodeId binaryEncodingId()")
+    lines.append("        {")
+    lines.append("            return %s;" %encodingId)
+    lines.append("        }")
+    lines.append("")
+    lines.append("        /** Check if the given NodeId is the binary encoding of this struct. */")
+    lines.append("        static bool isBinaryEncodingId(const uaf::NodeId& nodeId)")
+    lines.append("        {")
+    lines.append("            uaf::NodeId encodingId = binaryEncodingId();")
+    lines.append("            if (!(nodeId.identifier() == encodingId.identifier()))")
+    lines.append("                return false;")
+    lines.append("            else if (encodingId.hasNameSpaceUri())")
+    lines.append("                return    nodeId.hasNameSpaceUri()")
+    lines.append("                       && nodeId.nameSpaceUri() == encodingId.nameSpaceUri();")
+    lines.append("            else")
+    lines.append("                return nodeId.nameSpaceIndex() == encodingId.nameSpaceIndex();")
+    lines.append("        }")
+    lines.append("")
+    lines.append("        /** Encode the fields. */")
+    lines.append("        void encode(uaf::BinaryEncoder& encoder) const")
+    lines.append("        {")
+    for member, cppType, default in members:
+        lines.append("            encoder.write(%s);" %member)
+    lines.append("        }")
+    lines.append("")
+    lines.append("        /** Decode the fields (false if the encoded data is too short). */")
+    lines.append("        bool decode(uaf::BinaryDecoder& decoder)")
+    lines.append("        {")
+    if members:
+        lines.append("            return " + ("\n                && ".join(
+                        "decoder.read(%s)" %member for member, cppType, default in members)) + ";")
+    else:
+        lines.append("            return true;")
+    lines.append("        }")
+    lines.append("")
+    lines.append("        /** Convert to an ExtensionObject, reusing the given buffer. */")
+    lines.append("        void toExtensionObject(")
+    lines.append("                uaf::ExtensionObject&   extensionObject,")
+    lines.append("                std::vector<uint8_t>&   buffer,")
+    lines.append("                const uaf::NodeId&      encodingId = binaryEncodingId()) const")
+    lines.append("        {")
+    lines.append("            buffer.clear();")
+    lines.append("            uaf::BinaryEncoder encoder(buffer);")
+    lines.append("            encode(encoder);")
+    lines.append("            extensionObject.setBinaryBody(")
+    lines.append("                    encodingId,")
+    lines.append("                    buffer.empty() ? 0 : &buffer[0],")
+    lines.append("                    int32_t(buffer.size()));")
+    lines.append("        }")
+    lines.append("")
+    lines.append("        /** Convert to an ExtensionObject. */")
+    lines.append("        void toExtensionObject(uaf::ExtensionObject& extensionObject) const")
+    lines.append("        {")
+    lines.append("            std::vector<uint8_t> buffer;")
+    lines.append("            toExtensionObject(extensionObject, buffer);")
+    lines.append("        }")
+    lines.append("")
+    lines.append("        /** Decode a complete body (Bad if it has more or less bytes than the "
+                 "fields). */")
+    lines.append("        uaf::Status decode(const uint8_t* data, int32_t length)")
+    lines.append("        {")
+    lines.append("            uaf::Status ret;")
+    lines.append("            uaf::BinaryDecoder decoder(data, length);")
+    lines.append("            if (!decode(decoder))")
+    lines.append("                ret = uaf::WrongTypeError(\"The body is too short for a %s\");"
+                 %name)
+    lines.append("            else if (decoder.remaining() != 0)")
+    lines.append("                ret = uaf::WrongTypeError(\"The body is too long for a %s\");"
+                 %name)
+    lines.append("            else")
+    lines.append("                ret = uaf::statuscodes::Good;")
+    lines.append("            return ret;")
+    lines.append("        }")
+    lines.append("")
+    lines.append("        /** Convert from a binary encoded ExtensionObject. */")
+    lines.append("        uaf::Status fromExtensionObject(const uaf::ExtensionObject& "
+                 "extensionObject)")
+    lines.append("        {")
+    lines.append("            uaf::Status ret;")
+    lines.append("            const uint8_t* data = 0;")
+    lines.append("            int32_t length = 0;")
+    lines.append("            if (!isBinaryEncodingId(extensionObject.encodingTypeId))")
+    lines.append("                ret = uaf::WrongTypeError(\"The encoding is not the binary "
+                 "encoding of %s\");" %name)
+    lines.append("            else if (!extensionObject.binaryBody(data, length))")
+    lines.append("                ret = uaf::WrongTypeError(\"The ExtensionObject has no binary "
+                 "body\");")
+    lines.append("            else")
+    lines.append("                ret = decode(data, length);")
+    lines.append("            return ret;")
+    lines.append("        }")
+    lines.append("")
+    lines.append("        /** Convert to a Variant (holding an ExtensionObject). */")
+    lines.append("        void toVariant(uaf::Variant& variant) const")
+    lines.append("        {")
+    lines.append("            uaf::ExtensionObject extensionObject;")
+    lines.append("            toExtensionObject(extensionObject);")
+    lines.append("            variant.setExtensionObject(extensionObject);")
+    lines.append("        }")
+    lines.append("")
+    lines.append("        /** Convert from a Variant (holding a binary encoded ExtensionObject). */")
+    lines.append("        uaf::Status fromVariant(const uaf::Variant& variant)")
+    lines.append("        {")
+    lines.append("            uaf::ExtensionObject extensionObject;")
+    lines.append("            uaf::Status ret = variant.toExtensionObject(extensionObject);")
+    lines.append("            if (ret.isGood())")
+    lines.append("                ret = fromExtensionObject(extensionObject);")
+    lines.append("            return ret;")
+    lines.append("        }")
+    lines.append("    };")
+
+    structNames[json.dumps(definition["dataTypeId"], sort_keys=True)] = name
+    return "\n".join(lines)
+
+
+def generateHeader(definitions, namespace="uafgen", guard=None):
+    """
+    Generate a C++ header with a struct for each definition.
+
+    :param definitions: The definitions, as dictionaries.
+    :type  definitions: ``list`` of ``dict``
+    :param namespace: The C++ namespace of the structs.
+    :type  namespace: ``str``
+    :param guard: The include guard (default: derived from the namespace).
+    :type  guard: ``str``
+    :return: The C++ code.
+    :rtype: ``str``
+    """
+    if guard is None:
+        guard = "%s_STRUCTS_H_" %cppIdentifier(namespace).upper()
+
+    structNames = {}
+    structs = [generateStruct(d, structNames) for d in sortDefinitions(definitions)]
+
+    lines = []
+    lines.append("// Generated by pyuaf.util.structgen, do not edit.")
+    lines.append("")
+    lines.append("#ifndef %s" %guard)
+    lines.append("#define %s" %guard)
+    lines.append("")
+    lines.append("// STD")
+    lines.append("#include <string>")
+    lines.append("#include <vector>")
+    lines.append("#include <stdint.h>")
+    lines.append("// UAF")
+    lines.append("#include \"uaf/util/binarycodec.h\"")
+    lines.append("#include \"uaf/util/extensionobject.h\"")
+    lines.append("#include \"uaf/util/variant.h\"")
+    lines.append("#include \"uaf/util/nodeid.h\"")
+    lines.append("#include \"uaf/util/status.h\"")
+    lines.append("")
+    lines.append("")
+    lines.append("namespace %s" %cppIdentifier(namespace))
+    lines.append("{")
+    lines.append("")
+    lines.append("\n\n\n".join(structs))
+    lines.append("")
+    lines.append("}")
+    lines.append("")
+    lines.append("")
+    lines.append("#endif /* %s */" %guard)
+    lines.append("")
+    return "\n".join(lines)
+
+
+def main(argv=None):
+    """
+    Run the code generator from the command line (see the documentation of this module).
+    """
+    import argparse
+
+    parser = argparse.ArgumentParser(description="Generate typed C++ structs from the "
+                                                 "StructureDefinitions of a server.")
+    parser.add_argument("--definitions", help="JSON file with the dumped definitions")
+    parser.add_argument("--discovery-url", help="discovery URL to find the server")
+    parser.add_argument("--server-uri", help="URI of the server that owns the DataTypes")
+    parser.add_argument("--datatype", action="append", default=[],
+                        help="NodeId of a structured DataType, e.g. 'ns=2;i=3002' (repeatable)")
+    parser.add_argument("--dump", help="JSON file to dump the fetched definitions to")
+    parser.add_argument("--namespace", default="uafgen", help="C++ namespace of the structs")
+    parser.add_argument("--output", help="C++ header to write (default: stdout)")
+    args = parser.parse_args(argv)
+
+    if args.definitions:
+        with open(args.definitions) as f:
+            definitions = json.load(f)
+    elif args.discovery_url and args.server_uri and args.datatype:
+        import pyuaf
+        settings = pyuaf.client.settings.ClientSettings()
+        settings.applicationName = "structgen"
+        settings.discoveryUrls.append(args.discovery_url)
+        client = pyuaf.client.Client(settings)
+        definitions = fetchDefinitions(client,
+                                       args.server_uri,
+                                       [parseNodeId(d) for d in args.datatype])
+    else:
+        parser.error("give either --definitions, or --discovery-url, --server-uri and --datatype")
+
+    if args.dump:
+        with open(args.dump, "w") as f:
+            json.dump(definitions, f, indent=4, sort_keys=True)
+
+    header = generateHeader(definitions, args.namespace)
+
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(header)
+    else:
+        sys.stdout.write(header)
+
+
+if __name__ == "__main__":
+    main()
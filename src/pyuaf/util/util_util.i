@@ -32,6 +32,9 @@
 #include "uaf/util/datavalue.h"
 #include "uaf/util/endpointdescription.h"
 #include "uaf/util/eventfilter.h"
+#include "uaf/util/filteroperand.h"
+#include "uaf/util/contentfilterelement.h"
+#include "uaf/util/contentfilter.h"
 #include "uaf/util/logmessage.h"
 #include "uaf/util/logginginterface.h"
 #include "uaf/util/usertokenpolicy.h"
@@ -66,6 +69,7 @@
 #include "uaf/util/structuredefinition.h"
 #include "uaf/util/genericstructurevalue.h"
 #include "uaf/util/genericunionvalue.h"
+#include "uaf/util/structurelayout.h"
 #include "uaf/util/serveronnetwork.h"
 %}
 
@@ -84,6 +88,8 @@
 %template(StringVector) std::vector<std::string>;
 %template(UInt32Vector) std::vector<uint32_t>;
 %template(Int32Vector) std::vector<int32_t>;
+%template(DoubleVector) std::vector<double>;
+%template(Int64Vector) std::vector<int64_t>;
 
 
 // include the initializeUaf() function
@@ -115,6 +121,7 @@
 %import "pyuaf/util/util_securitypolicies.i" 
 %import "pyuaf/util/util_messagesecuritymodes.i" 
 %import "pyuaf/util/util_monitoringmodes.i" 
+%import "pyuaf/util/util_filteroperators.i" 
 %import "pyuaf/util/util_browsedirections.i" 
 %import "pyuaf/util/util_nodeclasses.i" 
 %import "pyuaf/util/util_timestampstoreturn.i" 
@@ -128,6 +135,8 @@
 %ignore extractServerUri(const Address& object, std::string& serverUri);
 %ignore operator>(const DateTime&, const DateTime&);
 %ignore uaf::DateTime::DateTime(const FILETIME& t);
+%ignore uaf::ExtensionObject::binaryBody;
+%ignore uaf::ExtensionObject::setBinaryBody;
 
 // The default SWIG output returned by uaf::Status::opcUaStatusCode() is a signed representation (Long) of an unsigned 32-bit integer.
 // The returned value (a Long which can only be positive) does not correspond bit-to-bit to the original OPC UA status codes, e.g. as found in
@@ -161,7 +170,6 @@ UAF_WRAP_CLASS("uaf/util/browsepath.h"             , uaf , BrowsePath
 UAF_WRAP_CLASS("uaf/util/serverarray.h"            , uaf , ServerArray             , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.util, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/util/simpleattributeoperand.h" , uaf , SimpleAttributeOperand  , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.util, SimpleAttributeOperandVector)
 UAF_WRAP_CLASS("uaf/util/datachangefilter.h"       , uaf , DataChangeFilter        , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.util, VECTOR_NO)
-UAF_WRAP_CLASS("uaf/util/eventfilter.h"            , uaf , EventFilter             , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.util, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/util/address.h"                , uaf , Address                 , COPY_NO,  TOSTRING_YES, COMP_YES, pyuaf.util, AddressVector)
 UAF_WRAP_CLASS("uaf/util/usertokenpolicy.h"        , uaf , UserTokenPolicy         , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.util, UserTokenPolicyVector)
 UAF_WRAP_CLASS("uaf/util/endpointdescription.h"    , uaf , EndpointDescription     , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.util, EndpointDescriptionVector)
@@ -231,8 +239,13 @@ class VectorIterator(object):
 
 // now include the classes that make use of the Variant typemap
 UAF_WRAP_CLASS("uaf/util/datavalue.h"              , uaf , DataValue               , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.util, DataValueVector)
+UAF_WRAP_CLASS("uaf/util/filteroperand.h"          , uaf , FilterOperand           , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.util, FilterOperandVector)
+UAF_WRAP_CLASS("uaf/util/contentfilterelement.h"   , uaf , ContentFilterElement    , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.util, ContentFilterElementVector)
+UAF_WRAP_CLASS("uaf/util/contentfilter.h"          , uaf , ContentFilter           , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.util, VECTOR_NO)
+UAF_WRAP_CLASS("uaf/util/eventfilter.h"            , uaf , EventFilter             , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.util, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/util/genericstructurevalue.h"  , uaf , GenericStructureValue   , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.util, GenericStructureVector)
 UAF_WRAP_CLASS("uaf/util/genericunionvalue.h"  	   , uaf , GenericUnionValue   	   , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.util, GenericUnionVector)
+UAF_WRAP_CLASS("uaf/util/structurelayout.h"        , uaf , StructureLayout         , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.util, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/util/matrix.h"                 , uaf , Matrix                  , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.util, VECTOR_NO)
 
 //UAF_WRAP_CLASS("uaf/util/variant.h"                 , uaf , Variant                  , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.util, VECTOR_NO)
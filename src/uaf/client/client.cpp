@@ -79,17 +79,45 @@ namespace uaf
     void Client::construct()
     {
         currentRequestHandle_ = 0;
-        doFinishThread_ = false;
 
         database_       = new Database(logger_->loggerFactory());
-        discoverer_     = new Discoverer(logger_->loggerFactory(), database_);
+        discoverer_     = new Discoverer(logger_->loggerFactory(), this, database_);
         sessionFactory_ = new SessionFactory(logger_->loggerFactory(), this, discoverer_, database_);
         resolver_       = new Resolver(logger_->loggerFactory(), sessionFactory_, database_);
-
-        logger_->debug("Now starting the thread to periodically check the requests");
-
-        // start the thread
-        start();
+        scheduler_      = new Scheduler(logger_->loggerFactory());
+
+        logger_->debug("Now starting the background tasks");
+
+        // each background task gets its own thread, so a slow server can only delay the task
+        // that is dealing with it
+        double interval = database_->clientSettings.discoveryIntervalSec;
+        discoveryTaskId_ = scheduler_->addTask(
+                "Discovery",
+                new ScheduledMemberTask<Client>(this, &Client::discoveryTask),
+                interval);
+        houseKeepingTaskId_ = scheduler_->addTask(
+                "HouseKeeping",
+                new ScheduledMemberTask<Client>(this, &Client::houseKeepingTask),
+                interval);
+        monitoredDataTaskId_ = scheduler_->addTask(
+                "MonitoredData",
+                new ScheduledMemberTask<Client>(this, &Client::monitoredDataTask),
+                interval);
+        monitoredEventsTaskId_ = scheduler_->addTask(
+                "MonitoredEvents",
+                new ScheduledMemberTask<Client>(this, &Client::monitoredEventsTask),
+                interval);
+        preConnectionTaskId_ = scheduler_->addTask(
+                "PreConnection",
+                new ScheduledMemberTask<Client>(this, &Client::preConnectionTask),
+                interval);
+        structureDefinitionsTaskId_ = scheduler_->addTask(
+                "StructureDefinitions",
+                new ScheduledMemberTask<Client>(this, &Client::structureDefinitionsTask),
+                interval);
+
+        // from now on, react immediately to the state changes of the sessions
+        sessionFactory_->setSessionStateListener(this);
 
         logger_->debug("The client has been constructed");
     }
@@ -101,12 +129,8 @@ namespace uaf
     {
         logger_->debug("Destructing the client");
 
-        // make sure the thread isn't doing anything
-        //UaMutexLocker locker(&threadStoppingMutex_);
-
-        doFinishThread_ = true;
-
-        wait();
+        // make sure the background tasks aren't doing anything
+        scheduler_->stop();
 
 
         delete resolver_;
@@ -121,6 +145,9 @@ namespace uaf
         delete database_;
         database_ = 0;
 
+        delete scheduler_;
+        scheduler_ = 0;
+
         delete logger_;
         logger_ = 0;
 
@@ -148,11 +175,28 @@ namespace uaf
         bool doFindServers = (settings.discoveryUrls != database_->clientSettings.discoveryUrls);
         database_->clientSettings = settings;
 
+        scheduler_->setInterval(discoveryTaskId_,             settings.discoveryIntervalSec);
+        scheduler_->setInterval(houseKeepingTaskId_,          settings.discoveryIntervalSec);
+        scheduler_->setInterval(monitoredDataTaskId_,         settings.discoveryIntervalSec);
+        scheduler_->setInterval(monitoredEventsTaskId_,       settings.discoveryIntervalSec);
+        scheduler_->setInterval(preConnectionTaskId_,         settings.discoveryIntervalSec);
+        scheduler_->setInterval(structureDefinitionsTaskId_,  settings.discoveryIntervalSec);
+
+        sessionFactory_->updateAsyncServiceThreads();
+
         if (doFindServers)
         {
             logger_->debug("The discoveryUrls were changed, so we rediscover the system");
             findServersNow();
         }
+
+        // connect to the pre-connected servers in the background
+        sessionFactory_->requestPreConnection();
+        scheduler_->trigger(preConnectionTaskId_);
+
+        // the already connected servers may have to be prefetched now
+        if (settings.prefetchStructureDefinitions)
+            scheduler_->trigger(structureDefinitionsTaskId_);
     }
 
 
@@ -175,7 +219,7 @@ namespace uaf
 
     // Get the servers that were found
     // =============================================================================================
-    const vector<ApplicationDescription>& Client::serversFound() const
+    vector<ApplicationDescription> Client::serversFound() const
     {
         return discoverer_->serversFound();
     }
@@ -235,6 +279,23 @@ namespace uaf
             const uaf::TranslateBrowsePathsToNodeIdsSettings*   translateSettings,
             const uaf::SessionSettings*                         sessionSettings,
             uaf::AsyncReadResult&                               result)
+    {
+        return beginRead(addresses, attributeId, clientConnectionId, serviceSettings,
+                         translateSettings, sessionSettings, NULL, result);
+    }
+
+
+    // Read a number of node attributes asynchronously, with a completion handler
+    //==============================================================================================
+    Status Client::beginRead(
+            const std::vector<uaf::Address>&                    addresses,
+            const uaf::attributeids::AttributeId                attributeId,
+            uaf::ClientConnectionId                             clientConnectionId,
+            const uaf::ReadSettings*                            serviceSettings,
+            const uaf::TranslateBrowsePathsToNodeIdsSettings*   translateSettings,
+            const uaf::SessionSettings*                         sessionSettings,
+            uaf::ReadCompletionHandler*                         completionHandler,
+            uaf::AsyncReadResult&                               result)
     {
         // log read request
         logger_->debug("Reading %d node attributes", addresses.size());
@@ -247,7 +308,7 @@ namespace uaf
             request.targets.push_back(ReadRequestTarget(*it, attributeId));
 
         // perform the read request
-        return processRequest(request, result);
+        return processRequest(request, completionHandler, result);
     }
 
 
@@ -296,6 +357,24 @@ namespace uaf
             const uaf::TranslateBrowsePathsToNodeIdsSettings*   translateSettings,
             const uaf::SessionSettings*                         sessionSettings,
             uaf::AsyncWriteResult&                              result)
+    {
+        return beginWrite(addresses, data, attributeId, clientConnectionId, serviceSettings,
+                          translateSettings, sessionSettings, NULL, result);
+    }
+
+
+    // Write a number of node attributes asynchronously, with a completion handler
+    //==============================================================================================
+    Status Client::beginWrite(
+            const std::vector<uaf::Address>&                    addresses,
+            const std::vector<uaf::Variant>&                    data,
+            const uaf::attributeids::AttributeId                attributeId,
+            uaf::ClientConnectionId                             clientConnectionId,
+            const uaf::WriteSettings*                           serviceSettings,
+            const uaf::TranslateBrowsePathsToNodeIdsSettings*   translateSettings,
+            const uaf::SessionSettings*                         sessionSettings,
+            uaf::WriteCompletionHandler*                        completionHandler,
+            uaf::AsyncWriteResult&                              result)
     {
         // log write request
         logger_->debug("Writing %d node attributes", addresses.size());
@@ -305,7 +384,11 @@ namespace uaf
 
         // check if the addresses and the data match
         if (addresses.size() != data.size())
+        {
+            if (completionHandler != NULL)
+                completionHandler->release();
             return uaf::DataDontMatchAddressesError();
+        }
 
         // reserve some space to speed up the adding of the targets
         request.targets.reserve(addresses.size());
@@ -315,7 +398,7 @@ namespace uaf
             request.targets.push_back(WriteRequestTarget(addresses[i], data[i], attributeId));
 
         // perform the write request
-        return processRequest(request, result);
+        return processRequest(request, completionHandler, result);
     }
 
 
@@ -360,6 +443,24 @@ namespace uaf
             const uaf::TranslateBrowsePathsToNodeIdsSettings*   translateSettings,
             const uaf::SessionSettings*                         sessionSettings,
             uaf::AsyncMethodCallResult&                         result)
+    {
+        return beginCall(objectAddress, methodAddress, inputArguments, clientConnectionId,
+                         serviceSettings, translateSettings, sessionSettings, NULL, result);
+    }
+
+
+    // Call a method asynchronously, with a completion handler
+    //==============================================================================================
+    Status Client::beginCall(
+            const uaf::Address&                                 objectAddress,
+            const uaf::Address&                                 methodAddress,
+            const std::vector<uaf::Variant>&                    inputArguments,
+            uaf::ClientConnectionId                             clientConnectionId,
+            const uaf::MethodCallSettings*                      serviceSettings,
+            const uaf::TranslateBrowsePathsToNodeIdsSettings*   translateSettings,
+            const uaf::SessionSettings*                         sessionSettings,
+            uaf::MethodCallCompletionHandler*                   completionHandler,
+            uaf::AsyncMethodCallResult&                         result)
     {
         AsyncMethodCallRequest request(0,
                                        clientConnectionId,
@@ -373,7 +474,7 @@ namespace uaf
         request.targets[0].inputArguments = inputArguments;
 
         // perform the write request
-        return processRequest(request, result);
+        return processRequest(request, completionHandler, result);
     }
 
 
@@ -668,6 +769,14 @@ namespace uaf
     }
 
 
+    // Wait until the pre-connected sessions are connected
+    //==============================================================================================
+    Status Client::waitUntilReady(double timeoutSec)
+    {
+        return sessionFactory_->waitUntilReady(timeoutSec);
+    }
+
+
     // Manual subscription
     //==============================================================================================
     Status Client::manuallySubscribe(
@@ -782,51 +891,140 @@ namespace uaf
     }
 
 
-    // Run the thread
+    // Modify the monitored items
     // =============================================================================================
-    void Client::run()
+    Status Client::modifyMonitoredItems(
+            const vector<ClientHandle>&             clientHandles,
+            const vector<MonitoredItemSettings>&    settings,
+            const ServiceSettings*                  serviceSettings,
+            vector<Status>&                         results)
     {
-        logger_->debug("Thread has started to periodically check the requests");
+        return sessionFactory_->modifyMonitoredItems(clientHandles,
+                                                     settings,
+                                                     serviceSettings,
+                                                     results);
+    }
 
-        // declare the current time and the time of the last actions
-        time_t currentTime;
-        time_t lastTime;
 
-        // initialize the time values
-        time(&currentTime);
-        time(&lastTime);
+    // Background task: discover the servers
+    // =============================================================================================
+    void Client::discoveryTask()
+    {
+        discoverer_->findServers();
 
+        // the newly discovered servers may have to be connected (and waitUntilReady() must wait
+        // for them)
+        if (database_->clientSettings.preConnectAllDiscoveredServers)
+        {
+            sessionFactory_->requestPreConnection();
+            scheduler_->trigger(preConnectionTaskId_);
+        }
+    }
 
-        double updateInterval;
 
-        while (!doFinishThread_)
+    // Background task: reconnect the disconnected sessions
+    // =============================================================================================
+    void Client::houseKeepingTask()
+    {
+        // the subscriptions that can't be transferred to the reconnected sessions must be
+        // created again
+        if (sessionFactory_->transferSubscriptions())
         {
-            updateInterval = database_->clientSettings.discoveryIntervalSec;
+            scheduler_->trigger(monitoredDataTaskId_);
+            scheduler_->trigger(monitoredEventsTaskId_);
+        }
 
-            msleep(100);
+        sessionFactory_->doHouseKeeping();
 
-            time(&currentTime);
+        // make sure the delayed reconnection attempts are not postponed until the next period
+        DateTime nextConnectionAttemptTime;
+        if (sessionFactory_->nextConnectionAttemptTime(nextConnectionAttemptTime))
+        {
+            int32_t delayMs = DateTime::now().msecsTo(nextConnectionAttemptTime);
+            scheduler_->triggerIn(houseKeepingTaskId_, delayMs > 0 ? delayMs / 1000.0 : 0.0);
+        }
+    }
 
-            if (difftime(currentTime, lastTime) > updateInterval)
-            {
-                logger_->debug("Now discovering the system and checking the persistent requests");
 
-                // update the lastTime
-                time(&lastTime);
+    // Background task: reconstruct the monitored data items
+    // =============================================================================================
+    void Client::monitoredDataTask()
+    {
+        processPersistedRequests(database_->createMonitoredDataRequestStore);
+    }
+
 
-                if (!doFinishThread_)
-                    discoverer_->findServers();
+    // Background task: reconstruct the monitored event items
+    // =============================================================================================
+    void Client::monitoredEventsTask()
+    {
+        processPersistedRequests(database_->createMonitoredEventsRequestStore);
+    }
 
-                if (!doFinishThread_)
-                    sessionFactory_->doHouseKeeping();
 
-                if (!doFinishThread_)
-                    processPersistedRequests(database_->createMonitoredDataRequestStore);
+    // Background task: connect the sessions of the pre-connected servers
+    // =============================================================================================
+    void Client::preConnectionTask()
+    {
+        ClientSettings settings = database_->clientSettings;
+        vector<string> serverUris = settings.preConnectServerUris;
 
-                if (!doFinishThread_)
-                    processPersistedRequests(database_->createMonitoredEventsRequestStore);
+        if (settings.preConnectAllDiscoveredServers)
+        {
+            vector<ApplicationDescription> servers = discoverer_->serversFound();
+            for (vector<ApplicationDescription>::const_iterator it = servers.begin();
+                    it != servers.end();
+                    ++it)
+            {
+                // don't create sessions to the discovery servers themselves
+                if (it->applicationType != uaf::applicationtypes::DiscoveryServer)
+                    serverUris.push_back(it->applicationUri);
             }
         }
+
+        sessionFactory_->preConnect(serverUris);
+
+        // don't wait for the next period to retry the sessions that could not be connected
+        if (!sessionFactory_->isReady())
+            scheduler_->trigger(houseKeepingTaskId_);
+    }
+
+
+    // Background task: prefetch the structure definitions of the connected servers
+    // =============================================================================================
+    void Client::structureDefinitionsTask()
+    {
+        if (database_->clientSettings.prefetchStructureDefinitions)
+            sessionFactory_->prefetchStructureDefinitions();
+    }
+
+
+    // A session has changed its state
+    // =============================================================================================
+    void Client::sessionStateChanged(
+            ClientConnectionId          clientConnectionId,
+            sessionstates::SessionState state)
+    {
+        if (state == sessionstates::Connected)
+        {
+            // the monitored items that could not be created before may be created now
+            logger_->debug("Session %d is connected, so the persisted requests are checked now",
+                           clientConnectionId);
+            scheduler_->trigger(monitoredDataTaskId_);
+            scheduler_->trigger(monitoredEventsTaskId_);
+
+            // the lost subscriptions are transferred by the house keeping
+            scheduler_->trigger(houseKeepingTaskId_);
+
+            if (database_->clientSettings.prefetchStructureDefinitions)
+                scheduler_->trigger(structureDefinitionsTaskId_);
+        }
+        else if (state == sessionstates::Disconnected)
+        {
+            logger_->debug("Session %d is disconnected, so the house keeping is done now",
+                           clientConnectionId);
+            scheduler_->trigger(houseKeepingTaskId_);
+        }
     }
 
 
@@ -846,6 +1044,17 @@ namespace uaf
         return processRequest<AsyncReadService>(request, result);
     }
 
+    // Process an AsyncReadRequest with a completion handler
+    // =============================================================================================
+    Status Client::processRequest(
+            const uaf::AsyncReadRequest&   request,
+            uaf::ReadCompletionHandler*    completionHandler,
+            uaf::AsyncReadResult&          result)
+    {
+        return processRequest<AsyncReadService>(
+                request, uaf::Mask(request.targets.size(), true), result, completionHandler);
+    }
+
 
     // Process a WriteRequest
     // =============================================================================================
@@ -861,6 +1070,17 @@ namespace uaf
         return processRequest<AsyncWriteService>(request, result);
     }
 
+    // Process an AsyncWriteRequest with a completion handler
+    // =============================================================================================
+    Status Client::processRequest(
+            const uaf::AsyncWriteRequest&  request,
+            uaf::WriteCompletionHandler*   completionHandler,
+            uaf::AsyncWriteResult&         result)
+    {
+        return processRequest<AsyncWriteService>(
+                request, uaf::Mask(request.targets.size(), true), result, completionHandler);
+    }
+
 
     // Process a MethodCallRequest
     // =============================================================================================
@@ -880,6 +1100,18 @@ namespace uaf
     }
 
 
+    // Process an AsyncMethodCallRequest with a completion handler
+    // =============================================================================================
+    Status Client::processRequest(
+            const uaf::AsyncMethodCallRequest&     request,
+            uaf::MethodCallCompletionHandler*      completionHandler,
+            uaf::AsyncMethodCallResult&            result)
+    {
+        return processRequest<uaf::AsyncMethodCallService>(
+                request, uaf::Mask(request.targets.size(), true), result, completionHandler);
+    }
+
+
     // Process a BrowseRequest
     // =============================================================================================
     Status Client::processRequest(const uaf::BrowseRequest& request, uaf::BrowseResult& result)
@@ -888,6 +1120,27 @@ namespace uaf
     }
 
 
+    // Process an AsyncBrowseRequest
+    // =============================================================================================
+    Status Client::processRequest(
+            const uaf::AsyncBrowseRequest&  request,
+            uaf::AsyncBrowseResult&         result)
+    {
+        return processRequest<uaf::AsyncBrowseService>(request, result);
+    }
+
+    // Process an AsyncBrowseRequest with a completion handler
+    // =============================================================================================
+    Status Client::processRequest(
+            const uaf::AsyncBrowseRequest&  request,
+            uaf::BrowseCompletionHandler*  completionHandler,
+            uaf::AsyncBrowseResult&         result)
+    {
+        return processRequest<uaf::AsyncBrowseService>(
+                request, uaf::Mask(request.targets.size(), true), result, completionHandler);
+    }
+
+
     // Process a BrowseNextRequest
     // =============================================================================================
     Status Client::processRequest(
@@ -898,6 +1151,27 @@ namespace uaf
     }
 
 
+    // Process an AsyncBrowseNextRequest
+    // =============================================================================================
+    Status Client::processRequest(
+            const uaf::AsyncBrowseNextRequest&  request,
+            uaf::AsyncBrowseNextResult&         result)
+    {
+        return processRequest<uaf::AsyncBrowseNextService>(request, result);
+    }
+
+    // Process an AsyncBrowseNextRequest with a completion handler
+    // =============================================================================================
+    Status Client::processRequest(
+            const uaf::AsyncBrowseNextRequest&  request,
+            uaf::BrowseNextCompletionHandler*  completionHandler,
+            uaf::AsyncBrowseNextResult&         result)
+    {
+        return processRequest<uaf::AsyncBrowseNextService>(
+                request, uaf::Mask(request.targets.size(), true), result, completionHandler);
+    }
+
+
     // Process a TranslateBrowsePathsToNodeIdsRequest
     // =============================================================================================
     Status Client::processRequest(
@@ -908,6 +1182,27 @@ namespace uaf
     }
 
 
+    // Process an AsyncTranslateBrowsePathsToNodeIdsRequest
+    // =============================================================================================
+    Status Client::processRequest(
+            const uaf::AsyncTranslateBrowsePathsToNodeIdsRequest&  request,
+            uaf::AsyncTranslateBrowsePathsToNodeIdsResult&         result)
+    {
+        return processRequest<uaf::AsyncTranslateBrowsePathsToNodeIdsService>(request, result);
+    }
+
+    // Process an AsyncTranslateBrowsePathsToNodeIdsRequest with a completion handler
+    // =============================================================================================
+    Status Client::processRequest(
+            const uaf::AsyncTranslateBrowsePathsToNodeIdsRequest&  request,
+            uaf::TranslateBrowsePathsToNodeIdsCompletionHandler*  completionHandler,
+            uaf::AsyncTranslateBrowsePathsToNodeIdsResult&         result)
+    {
+        return processRequest<uaf::AsyncTranslateBrowsePathsToNodeIdsService>(
+                request, uaf::Mask(request.targets.size(), true), result, completionHandler);
+    }
+
+
     // Process a CreateMonitoredDataRequest
     // =============================================================================================
     Status Client::processRequest(
@@ -938,6 +1233,27 @@ namespace uaf
     }
 
 
+    // Process an AsyncHistoryReadRawModifiedRequest
+    // =============================================================================================
+    Status Client::processRequest(
+            const uaf::AsyncHistoryReadRawModifiedRequest&  request,
+            uaf::AsyncHistoryReadRawModifiedResult&         result)
+    {
+        return processRequest<uaf::AsyncHistoryReadRawModifiedService>(request, result);
+    }
+
+    // Process an AsyncHistoryReadRawModifiedRequest with a completion handler
+    // =============================================================================================
+    Status Client::processRequest(
+            const uaf::AsyncHistoryReadRawModifiedRequest&  request,
+            uaf::HistoryReadRawModifiedCompletionHandler*  completionHandler,
+            uaf::AsyncHistoryReadRawModifiedResult&         result)
+    {
+        return processRequest<uaf::AsyncHistoryReadRawModifiedService>(
+                request, uaf::Mask(request.targets.size(), true), result, completionHandler);
+    }
+
+
     // Get a structure definition
     // =============================================================================================
     Status Client::structureDefinition(const uaf::NodeId &dataTypeId, uaf::StructureDefinition& definition)
@@ -946,6 +1262,27 @@ namespace uaf
     }
 
 
+    // Get a structure definition of a particular server
+    // =============================================================================================
+    Status Client::structureDefinition(
+            const uaf::ExpandedNodeId&  dataTypeId,
+            uaf::StructureDefinition&   definition)
+    {
+        return sessionFactory_->structureDefinition(
+                dataTypeId.hasServerUri() ? dataTypeId.serverUri() : string(),
+                dataTypeId.nodeId(),
+                definition);
+    }
+
+
+    // Get the number of cached structure definitions of a server
+    // =============================================================================================
+    uint32_t Client::noOfCachedStructureDefinitions(const string& serverUri)
+    {
+        return uint32_t(database_->structureDefinitionCache.size(serverUri));
+    }
+
+
     // Private template function implementation: assign a UAF handle
     // =============================================================================================
     template <typename _Service>
@@ -1026,7 +1363,8 @@ namespace uaf
     uaf::Status Client::processRequest(
             const typename _Service::Request&   request,
             const uaf::Mask&                    mask,
-            typename _Service::Result&          result)
+            typename _Service::Result&          result,
+            uaf::BaseCompletionHandler*         completionHandler)
     {
         // declare the return Status
         uaf::Status ret;
@@ -1071,7 +1409,13 @@ namespace uaf
         if (ret.isGood())
         {
             uaf::Mask resolvedMask = mask && result.getGoodTargetsMask();
-            ret = sessionFactory_->invokeRequest<_Service>(copiedRequest, resolvedMask, result);
+            ret = sessionFactory_->invokeRequest<_Service>(
+                    copiedRequest, resolvedMask, result, completionHandler);
+        }
+        // if the request was not invoked, the session factory did not take the completion handler
+        else if (completionHandler != NULL)
+        {
+            completionHandler->release();
         }
 
         // finally, update the overall status
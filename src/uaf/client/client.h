@@ -27,7 +27,6 @@
 #include <vector>
 #include <map>
 // SDK
-#include "uabase/uathread.h"
 #include "uabase/uamutex.h"
 #include "uabase/uadatetime.h"
 // UAF
@@ -39,7 +38,10 @@
 #include "uaf/client/database/database.h"
 #include "uaf/client/resolution/resolver.h"
 #include "uaf/client/sessions/sessionfactory.h"
+#include "uaf/client/scheduler.h"
 #include "uaf/client/clientservices.h"
+#include "uaf/client/completionhandler.h"
+#include "uaf/client/future.h"
 
 
 
@@ -52,7 +54,7 @@ namespace uaf
     *
     * @ingroup Client
     ***********************************************************************************************/
-    class UAF_EXPORT Client : private UaThread,
+    class UAF_EXPORT Client : private uaf::SessionStateListener,
                                public uaf::ClientInterface,
                                public uaf::LoggingInterface
     {
@@ -137,11 +139,14 @@ namespace uaf
 
 
         /**
-         * Get a const reference to the servers that were found.
+         * Get a copy of the servers that were found.
+         *
+         * During a discovery cycle, the servers of a discovery URL are added as soon as the
+         * discovery server has answered.
          *
          * @return  A vector of the application descriptions that were discovered.
          */
-        const std::vector<uaf::ApplicationDescription>& serversFound() const;
+        std::vector<uaf::ApplicationDescription> serversFound() const;
 
 
         /**
@@ -317,6 +322,69 @@ namespace uaf
                 uaf::AsyncMethodCallResult&                         result);
 
 
+#ifndef SWIG /* The completion handler overloads below are only available in C++. */
+
+        /**
+         * Read a number of node attributes asynchronously, and let a completion handler
+         * (e.g. the completionHandler() of a uaf::ReadFuture) receive the result.
+         *
+         * The handler is called right before ClientInterface::readComplete(), and it is always
+         * released exactly once (also when the request could not be invoked).
+         *
+         * @param completionHandler The handler of this particular request (may be NULL).
+         * @see beginRead() for the other parameters.
+         */
+        uaf::Status beginRead(
+                const std::vector<uaf::Address>&                    addresses,
+                const uaf::attributeids::AttributeId                attributeId,
+                uaf::ClientConnectionId                             clientConnectionId,
+                const uaf::ReadSettings*                            serviceSettings,
+                const uaf::TranslateBrowsePathsToNodeIdsSettings*   translateSettings,
+                const uaf::SessionSettings*                         sessionSettings,
+                uaf::ReadCompletionHandler*                         completionHandler,
+                uaf::AsyncReadResult&                               result);
+
+
+        /**
+         * Write a number of node attributes asynchronously, and let a completion handler
+         * (e.g. the completionHandler() of a uaf::WriteFuture) receive the result.
+         *
+         * @param completionHandler The handler of this particular request (may be NULL).
+         * @see beginWrite() for the other parameters.
+         */
+        uaf::Status beginWrite(
+                const std::vector<uaf::Address>&                    addresses,
+                const std::vector<uaf::Variant>&                    data,
+                const uaf::attributeids::AttributeId                attributeId,
+                uaf::ClientConnectionId                             clientConnectionId,
+                const uaf::WriteSettings*                           serviceSettings,
+                const uaf::TranslateBrowsePathsToNodeIdsSettings*   translateSettings,
+                const uaf::SessionSettings*                         sessionSettings,
+                uaf::WriteCompletionHandler*                        completionHandler,
+                uaf::AsyncWriteResult&                              result);
+
+
+        /**
+         * Call a single method asynchronously, and let a completion handler
+         * (e.g. the completionHandler() of a uaf::MethodCallFuture) receive the result.
+         *
+         * @param completionHandler The handler of this particular request (may be NULL).
+         * @see beginCall() for the other parameters.
+         */
+        uaf::Status beginCall(
+                const uaf::Address&                                 objectAddress,
+                const uaf::Address&                                 methodAddress,
+                const std::vector<uaf::Variant>&                    inputArguments,
+                uaf::ClientConnectionId                             clientConnectionId,
+                const uaf::MethodCallSettings*                      serviceSettings,
+                const uaf::TranslateBrowsePathsToNodeIdsSettings*   translateSettings,
+                const uaf::SessionSettings*                         sessionSettings,
+                uaf::MethodCallCompletionHandler*                   completionHandler,
+                uaf::AsyncMethodCallResult&                         result);
+
+#endif  /* SWIG */
+
+
         /**
          * Browse one or more nodes synchronously.
          *
@@ -603,6 +671,49 @@ namespace uaf
                 const uaf::AsyncReadRequest&   request,
                 uaf::AsyncReadResult&          result);
 
+#ifndef SWIG /* The completion handler overloads below are only available in C++. */
+
+        /**
+         * Process an asynchronous read request, with a completion handler for its result.
+         *
+         * @param request           The request.
+         * @param completionHandler The handler of this particular request (may be NULL).
+         * @param result            The result.
+         * @return                  The client-side status.
+         */
+        uaf::Status processRequest(
+                const uaf::AsyncReadRequest&   request,
+                uaf::ReadCompletionHandler*    completionHandler,
+                uaf::AsyncReadResult&          result);
+
+        /**
+         * Process an asynchronous write request, with a completion handler for its result.
+         *
+         * @param request           The request.
+         * @param completionHandler The handler of this particular request (may be NULL).
+         * @param result            The result.
+         * @return                  The client-side status.
+         */
+        uaf::Status processRequest(
+                const uaf::AsyncWriteRequest&  request,
+                uaf::WriteCompletionHandler*   completionHandler,
+                uaf::AsyncWriteResult&         result);
+
+        /**
+         * Process an asynchronous method call request, with a completion handler for its result.
+         *
+         * @param request           The request.
+         * @param completionHandler The handler of this particular request (may be NULL).
+         * @param result            The result.
+         * @return                  The client-side status.
+         */
+        uaf::Status processRequest(
+                const uaf::AsyncMethodCallRequest&     request,
+                uaf::MethodCallCompletionHandler*      completionHandler,
+                uaf::AsyncMethodCallResult&            result);
+
+#endif  /* SWIG */
+
         /**
          * Process a synchronous write request.
          *
@@ -660,6 +771,21 @@ namespace uaf
                 const uaf::BrowseRequest&   request,
                 uaf::BrowseResult&          result);
 
+        /**
+         * Process an asynchronous browse request.
+         *
+         * The result will be delivered to ClientInterface::browseComplete().
+         * Since the SDK cannot browse asynchronously, the request is invoked synchronously by a
+         * worker thread of the UAF.
+         *
+         * @param request   The request.
+         * @param result    The result.
+         * @return          The client-side status.
+         */
+        uaf::Status processRequest(
+                const uaf::AsyncBrowseRequest&  request,
+                uaf::AsyncBrowseResult&         result);
+
         /**
          * Process a synchronous BrowseNext request.
          *
@@ -671,6 +797,21 @@ namespace uaf
                 const uaf::BrowseNextRequest&   request,
                 uaf::BrowseNextResult&          result);
 
+        /**
+         * Process an asynchronous BrowseNext request.
+         *
+         * The result will be delivered to ClientInterface::browseNextComplete().
+         * Since the SDK cannot browse asynchronously, the request is invoked synchronously by a
+         * worker thread of the UAF.
+         *
+         * @param request   The request.
+         * @param result    The result.
+         * @return          The client-side status.
+         */
+        uaf::Status processRequest(
+                const uaf::AsyncBrowseNextRequest&  request,
+                uaf::AsyncBrowseNextResult&         result);
+
 
         /**
          * Process a synchronous TranslateBrowsePathsToNodeIdsRequest.
@@ -683,6 +824,21 @@ namespace uaf
                 const uaf::TranslateBrowsePathsToNodeIdsRequest&  request,
                 uaf::TranslateBrowsePathsToNodeIdsResult&         result);
 
+        /**
+         * Process an asynchronous TranslateBrowsePathsToNodeIdsRequest.
+         *
+         * The result will be delivered to ClientInterface::translateBrowsePathsToNodeIdsComplete().
+         * Since the SDK cannot translate browse paths asynchronously, the request is invoked
+         * synchronously by a worker thread of the UAF.
+         *
+         * @param request   The request.
+         * @param result    The result.
+         * @return          The client-side status.
+         */
+        uaf::Status processRequest(
+                const uaf::AsyncTranslateBrowsePathsToNodeIdsRequest&  request,
+                uaf::AsyncTranslateBrowsePathsToNodeIdsResult&         result);
+
         
         /**
          * Process a synchronous "create monitored data" request.
@@ -735,6 +891,79 @@ namespace uaf
                 const uaf::HistoryReadRawModifiedRequest&  request,
                 uaf::HistoryReadRawModifiedResult&         result);
 
+        /**
+         * Process an asynchronous HistoryReadRawModified request.
+         *
+         * The result will be delivered to ClientInterface::historyReadRawModifiedComplete().
+         * Note that the settings.maxAutoReadMore setting is ignored for asynchronous requests:
+         * the continuation points are always returned.
+         *
+         * @param request   The request.
+         * @param result    The result.
+         * @return          The client-side status.
+         */
+        uaf::Status processRequest(
+                const uaf::AsyncHistoryReadRawModifiedRequest&  request,
+                uaf::AsyncHistoryReadRawModifiedResult&         result);
+
+#ifndef SWIG /* The completion handler overloads below are only available in C++. */
+
+        /**
+         * Process an asynchronous browse request, with a completion handler for its result.
+         *
+         * @param request           The request.
+         * @param completionHandler The handler of this particular request (may be NULL).
+         * @param result            The result.
+         * @return                  The client-side status.
+         */
+        uaf::Status processRequest(
+                const uaf::AsyncBrowseRequest&  request,
+                uaf::BrowseCompletionHandler*   completionHandler,
+                uaf::AsyncBrowseResult&         result);
+
+        /**
+         * Process an asynchronous BrowseNext request, with a completion handler for its result.
+         *
+         * @param request           The request.
+         * @param completionHandler The handler of this particular request (may be NULL).
+         * @param result            The result.
+         * @return                  The client-side status.
+         */
+        uaf::Status processRequest(
+                const uaf::AsyncBrowseNextRequest&  request,
+                uaf::BrowseNextCompletionHandler*   completionHandler,
+                uaf::AsyncBrowseNextResult&         result);
+
+        /**
+         * Process an asynchronous TranslateBrowsePathsToNodeIdsRequest, with a completion handler
+         * for its result.
+         *
+         * @param request           The request.
+         * @param completionHandler The handler of this particular request (may be NULL).
+         * @param result            The result.
+         * @return                  The client-side status.
+         */
+        uaf::Status processRequest(
+                const uaf::AsyncTranslateBrowsePathsToNodeIdsRequest&      request,
+                uaf::TranslateBrowsePathsToNodeIdsCompletionHandler*       completionHandler,
+                uaf::AsyncTranslateBrowsePathsToNodeIdsResult&             result);
+
+        /**
+         * Process an asynchronous HistoryReadRawModified request, with a completion handler for
+         * its result.
+         *
+         * @param request           The request.
+         * @param completionHandler The handler of this particular request (may be NULL).
+         * @param result            The result.
+         * @return                  The client-side status.
+         */
+        uaf::Status processRequest(
+                const uaf::AsyncHistoryReadRawModifiedRequest&      request,
+                uaf::HistoryReadRawModifiedCompletionHandler*       completionHandler,
+                uaf::AsyncHistoryReadRawModifiedResult&             result);
+
+#endif  /* SWIG */
+
 
 
         ///@} //////////////////////////////////////////////////////////////////////////////////////
@@ -759,6 +988,32 @@ namespace uaf
         		uaf::StructureDefinition& definition);
 
 
+        /**
+         * Get the definition of a structured datatype of a particular server.
+         *
+         * Only the sessions to the server URI of the ExpandedNodeId are asked for the definition
+         * (or all sessions, if the ExpandedNodeId has no server URI). The definitions are cached
+         * per server, until the NamespaceArray of the server changes.
+         *
+         * @param dataTypeId    The ExpandedNodeId of the structured datatype.
+         * @param definition    Output parameter, the definition (if found).
+         * @return              DefinitionNotFoundError if no definition was found,
+         *                      Good otherwise.
+         */
+        uaf::Status structureDefinition(
+                const uaf::ExpandedNodeId&  dataTypeId,
+                uaf::StructureDefinition&   definition);
+
+
+        /**
+         * Get the number of structure definitions that are currently cached for a server.
+         *
+         * @param serverUri The URI of the server.
+         * @return          The number of cached definitions (e.g. after they were prefetched).
+         */
+        uint32_t noOfCachedStructureDefinitions(const std::string& serverUri);
+
+
         ///@} //////////////////////////////////////////////////////////////////////////////////////
         /**
          *  @name ManualConnection
@@ -872,6 +1127,23 @@ namespace uaf
         void manuallyDisconnectAllSessions();
 
 
+        /**
+         * Wait until the sessions to the pre-connected servers are connected.
+         *
+         * The servers of ClientSettings::preConnectServerUris (and all discovered servers, if
+         * ClientSettings::preConnectAllDiscoveredServers is true) are connected in the background
+         * right after the ClientSettings are set, so that the first requests don't need to wait
+         * for the discovery and the connection. This method allows you to wait until this has
+         * happened, e.g. before your application reports that it's ready to serve.
+         *
+         * @param timeoutSec    The maximum time to wait, in seconds (0.0 to only check).
+         * @return              Good if all pre-connected sessions are connected, or
+         *                      ClientNotReadyError if they are still not connected when the
+         *                      timeout expires.
+         */
+        uaf::Status waitUntilReady(double timeoutSec);
+
+
         ///@} //////////////////////////////////////////////////////////////////////////////////////
         /**
          *  @name SessionInformation
@@ -1052,6 +1324,34 @@ namespace uaf
                 std::vector<uaf::Status>&               results);
 
 
+        /**
+         * Modify the sampling interval, queue size, discardOldest flag and filter of the
+         * specified monitored items, without deleting and re-creating them.
+         *
+         * The monitored items of the same subscription are modified by a single
+         * ModifyMonitoredItems service call. The settings of the monitored items, and the
+         * persistent requests that created them, are updated too, so that the new settings are
+         * also applied when the monitored items need to be re-created (e.g. after a reconnection).
+         *
+         * The kind (data or event) of each of the new settings must match the kind of the
+         * monitored item, so you should use the settings returned by monitoredItemInformation()
+         * as a starting point.
+         *
+         * @param clientHandles     The ClientHandles of the monitored items to be affected.
+         * @param settings          The new settings (one for each ClientHandle).
+         * @param serviceSettings   The service settings to be used.
+         *                          Assign to NULL to use the defaultModifyMonitoredItemsSettings
+         *                          as configurable by the ClientSettings.
+         * @param results           A vector of statuses (one result for each ClientHandle).
+         * @return                  The immediate result of the service call.
+         */
+        uaf::Status modifyMonitoredItems(
+                const std::vector<uaf::ClientHandle>&           clientHandles,
+                const std::vector<uaf::MonitoredItemSettings>&  settings,
+                const uaf::ServiceSettings*                     serviceSettings,
+                std::vector<uaf::Status>&                       results);
+
+
     private:
 
         DISALLOW_COPY_AND_ASSIGN(Client);
@@ -1071,8 +1371,16 @@ namespace uaf
         /** The shared database of the client. */
         uaf::Database* database_;
 
-        /** The flag to finish the run() method of the thread during destruction of the client. */
-        bool doFinishThread_;
+        /** The scheduler of the background tasks (discovery, reconnection, ...). */
+        uaf::Scheduler* scheduler_;
+
+        /** The ids of the background tasks. */
+        uint32_t discoveryTaskId_;
+        uint32_t houseKeepingTaskId_;
+        uint32_t monitoredDataTaskId_;
+        uint32_t monitoredEventsTaskId_;
+        uint32_t preConnectionTaskId_;
+        uint32_t structureDefinitionsTaskId_;
 
         /** The current request handle (only to be incremented when requestHandleMutex_ is locked). */
         uaf::RequestHandle currentRequestHandle_;
@@ -1081,9 +1389,43 @@ namespace uaf
         UaMutex requestHandleMutex_;
 
         /**
-         * Run method of the thread.
+         * Background task: discover the servers.
+         */
+        void discoveryTask();
+
+        /**
+         * Background task: transfer the lost subscriptions, and reconnect the disconnected
+         * sessions.
          */
-        void run();
+        void houseKeepingTask();
+
+        /**
+         * Background task: reconstruct the monitored data items that could not be created.
+         */
+        void monitoredDataTask();
+
+        /**
+         * Background task: reconstruct the monitored event items that could not be created.
+         */
+        void monitoredEventsTask();
+
+        /**
+         * Background task: connect the sessions of the pre-connected servers.
+         */
+        void preConnectionTask();
+
+        /**
+         * Background task: prefetch the structure definitions of the connected servers.
+         */
+        void structureDefinitionsTask();
+
+        /**
+         * Trigger the background tasks when a session changes its state (implemented from
+         * uaf::SessionStateListener, called by the SDK).
+         */
+        void sessionStateChanged(
+                uaf::ClientConnectionId             clientConnectionId,
+                uaf::sessionstates::SessionState    state);
 
 
         /**
@@ -1169,13 +1511,16 @@ namespace uaf
          * @param request   The request to be processed.
          * @param mask      The mask, specifying the targets that need to be processed.
          * @param result    The result to be updated.
+         * @param completionHandler  Optional handler for the result of an asynchronous request.
+         *                  It is released by this function if the request cannot be invoked.
          * @return          The client-side status.
          */
         template<typename _Service>
         uaf::Status processRequest(
                 const typename _Service::Request&   request,
                 const uaf::Mask&                    mask,
-                typename _Service::Result&          result);
+                typename _Service::Result&          result,
+                uaf::BaseCompletionHandler*         completionHandler = NULL);
         // Private template functions can be implemented in the CPP file (keeps the header clean!)
 
 #endif  /* SWIG (the section above is not visible by the SWIG preprocessor) */
@@ -27,11 +27,14 @@
 // SDK
 // UAF
 #include "uaf/util/pkicertificate.h"
+#include "uaf/util/applicationdescription.h"
 #include "uaf/util/sdkstatus.h"
 #include "uaf/client/results/results.h"
 #include "uaf/client/sessions/sessioninformation.h"
 #include "uaf/client/subscriptions/datachangenotification.h"
+#include "uaf/client/subscriptions/datachangenotificationbatch.h"
 #include "uaf/client/subscriptions/eventnotification.h"
+#include "uaf/client/subscriptions/eventnotificationbatch.h"
 #include "uaf/client/subscriptions/keepalivenotification.h"
 #include "uaf/client/subscriptions/subscriptioninformation.h"
 
@@ -75,6 +78,10 @@ namespace uaf
         /**
          * Override this method to handle missing notifications.
          *
+         * If uaf::SubscriptionSettings::republishMissingNotifications is true, this method is only
+         * called if some of the missing notifications could not be recovered.
+         * The statistics of info tell you how many notifications were missing and recovered.
+         *
          * @param info                      Information about the subscription that has missing
          *                                  notifications.
          * @param previousSequenceNumber    The sequence number before the notifications were lost.
@@ -86,6 +93,22 @@ namespace uaf
                 uint32_t newSequenceNumber) {}
 
 
+        /**
+         * Override this method to handle changes of the discovered servers.
+         *
+         * This method is called by the discovery threads, only for the servers that appeared,
+         * disappeared or changed (so not for the servers that were simply discovered again).
+         *
+         * @param appeared      The servers that were discovered for the first time.
+         * @param disappeared   The servers that are no longer discovered.
+         * @param changed       The servers of which the description has changed.
+         */
+        virtual void serversChanged(
+                const std::vector<uaf::ApplicationDescription>& appeared,
+                const std::vector<uaf::ApplicationDescription>& disappeared,
+                const std::vector<uaf::ApplicationDescription>& changed) {}
+
+
         /**
          * Override this method to handle the results of asynchronous read requests.
          *
@@ -110,6 +133,41 @@ namespace uaf
         virtual void callComplete(const uaf::MethodCallResult& result) {}
 
 
+        /**
+         * Override this method to handle the results of asynchronous browse requests.
+         *
+         * @param result    Browse result.
+         */
+        virtual void browseComplete(const uaf::BrowseResult& result) {}
+
+
+        /**
+         * Override this method to handle the results of asynchronous browse next requests.
+         *
+         * @param result    BrowseNext result.
+         */
+        virtual void browseNextComplete(const uaf::BrowseNextResult& result) {}
+
+
+        /**
+         * Override this method to handle the results of asynchronous
+         * TranslateBrowsePathsToNodeIds requests.
+         *
+         * @param result    TranslateBrowsePathsToNodeIds result.
+         */
+        virtual void translateBrowsePathsToNodeIdsComplete(
+                const uaf::TranslateBrowsePathsToNodeIdsResult& result) {}
+
+
+        /**
+         * Override this method to handle the results of asynchronous history read requests.
+         *
+         * @param result    HistoryReadRawModified result.
+         */
+        virtual void historyReadRawModifiedComplete(
+                const uaf::HistoryReadRawModifiedResult& result) {}
+
+
         /**
          * Override this method to handle events.
          *
@@ -118,6 +176,16 @@ namespace uaf
         virtual void eventsReceived(std::vector<uaf::EventNotification> notifications) {}
 
 
+        /**
+         * Override this method to handle the events of subscriptions that have the
+         * uaf::SubscriptionSettings::batchEvents flag set. It's called once per monitored item
+         * per publish response. For these subscriptions, eventsReceived() will not be called.
+         *
+         * @param batch     All events of a single monitored item in a single publish response.
+         */
+        virtual void eventBatchReceived(const uaf::EventNotificationBatch& batch) {}
+
+
         /**
          * Override this method to handle data changes.
          *
@@ -126,6 +194,16 @@ namespace uaf
         virtual void dataChangesReceived(std::vector<uaf::DataChangeNotification> notifications) {}
 
 
+        /**
+         * Override this method to handle data changes of subscriptions that have the
+         * uaf::SubscriptionSettings::batchDataChanges flag set. For these subscriptions,
+         * dataChangesReceived() will not be called.
+         *
+         * @param batch     All data change notifications of a single publish response.
+         */
+        virtual void dataChangeBatchReceived(const uaf::DataChangeNotificationBatch& batch) {}
+
+
         /**
          * Override this method to handle keep alive notifications.
          *
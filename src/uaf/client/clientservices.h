@@ -97,6 +97,10 @@ namespace uaf
     DEFINE_ASYNC_SERVICE(Read)
     DEFINE_ASYNC_SERVICE(Write)
     DEFINE_ASYNC_SERVICE(MethodCall)
+    DEFINE_ASYNC_SERVICE(TranslateBrowsePathsToNodeIds)
+    DEFINE_ASYNC_SERVICE(Browse)
+    DEFINE_ASYNC_SERVICE(BrowseNext)
+    DEFINE_ASYNC_SERVICE(HistoryReadRawModified)
     DEFINE_ASYNC_SERVICE(CreateMonitoredData)
     DEFINE_ASYNC_SERVICE(CreateMonitoredEvents)
 }
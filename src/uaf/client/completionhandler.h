@@ -0,0 +1,134 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_COMPLETIONHANDLER_H_
+#define UAF_COMPLETIONHANDLER_H_
+
+
+// STD
+// SDK
+// UAF
+#include "uaf/client/clientexport.h"
+#include "uaf/client/results/results.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * The untyped base class of all uaf::CompletionHandler instances.
+    *
+    * A completion handler can be given to an asynchronous request (such as
+    * uaf::Client::beginRead), and is stored by the session factory next to the transaction id of
+    * the request. When the asynchronous result arrives, the handler of that particular request is
+    * called directly (in addition to the global uaf::ClientInterface callbacks).
+    *
+    * @ingroup Client
+    ***********************************************************************************************/
+    class UAF_EXPORT BaseCompletionHandler
+    {
+    public:
+
+
+        /**
+         * Virtual destructor.
+         */
+        virtual ~BaseCompletionHandler() {}
+
+
+        /**
+         * Called exactly once, when the UAF no longer needs the handler: either after complete()
+         * was called, or without any complete() call at all if the asynchronous request could
+         * not be invoked.
+         *
+         * Override this method to delete a handler that was allocated on the heap
+         * (e.g. "delete this;"). By default, nothing happens, so the handler must stay valid until
+         * this method is called.
+         */
+        virtual void release() {}
+    };
+
+
+
+    /*******************************************************************************************//**
+    * A uaf::CompletionHandler receives the result of one particular asynchronous request.
+    *
+    * @tparam _Result  The result type, e.g. uaf::ReadResult.
+    *
+    * @ingroup Client
+    ***********************************************************************************************/
+    template<typename _Result>
+    class CompletionHandler : public uaf::BaseCompletionHandler
+    {
+    public:
+
+
+        /** Public typedef for the type of the result. */
+        typedef _Result ResultType;
+
+
+        /**
+         * Virtual destructor.
+         */
+        virtual ~CompletionHandler() {}
+
+
+        /**
+         * Implement this method to handle the result of the asynchronous request.
+         *
+         * It is called by the thread of the SDK that received the response, right before the
+         * corresponding uaf::ClientInterface callback (e.g. readComplete()) is called.
+         *
+         * @param result    The result of the asynchronous request.
+         */
+        virtual void complete(const _Result& result) = 0;
+    };
+
+
+    /** Handler for the result of an asynchronous read request. @ingroup Client */
+    typedef uaf::CompletionHandler<uaf::ReadResult>         ReadCompletionHandler;
+
+    /** Handler for the result of an asynchronous write request. @ingroup Client */
+    typedef uaf::CompletionHandler<uaf::WriteResult>        WriteCompletionHandler;
+
+    /** Handler for the result of an asynchronous method call request. @ingroup Client */
+    typedef uaf::CompletionHandler<uaf::MethodCallResult>   MethodCallCompletionHandler;
+
+    /** Handler for the result of an asynchronous browse request. @ingroup Client */
+    typedef uaf::CompletionHandler<uaf::BrowseResult>       BrowseCompletionHandler;
+
+    /** Handler for the result of an asynchronous BrowseNext request. @ingroup Client */
+    typedef uaf::CompletionHandler<uaf::BrowseNextResult>   BrowseNextCompletionHandler;
+
+    /** Handler for the result of an asynchronous TranslateBrowsePathsToNodeIds request.
+     *  @ingroup Client */
+    typedef uaf::CompletionHandler<uaf::TranslateBrowsePathsToNodeIdsResult>
+                                                            TranslateBrowsePathsToNodeIdsCompletionHandler;
+
+    /** Handler for the result of an asynchronous HistoryReadRawModified request.
+     *  @ingroup Client */
+    typedef uaf::CompletionHandler<uaf::HistoryReadRawModifiedResult>
+                                                            HistoryReadRawModifiedCompletionHandler;
+
+}
+
+
+#endif /* UAF_COMPLETIONHANDLER_H_ */
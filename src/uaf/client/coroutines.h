@@ -0,0 +1,584 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_COROUTINES_H_
+#define UAF_COROUTINES_H_
+
+
+/*
+ * This header is optional: it requires a compiler with C++20 coroutine support. When it is
+ * included by a translation unit that is compiled without coroutine support, it is empty.
+ * Nothing else in the UAF depends on it.
+ */
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#define UAF_COROUTINES_AVAILABLE 1
+
+
+// STD
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <vector>
+// SDK
+// UAF
+#include "uaf/util/status.h"
+#include "uaf/util/address.h"
+#include "uaf/util/variant.h"
+#include "uaf/util/attributeids.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/client.h"
+#include "uaf/client/completionhandler.h"
+#include "uaf/client/requests/requests.h"
+#include "uaf/client/results/results.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::CoroutineExecutor decides on which thread a suspended coroutine is resumed, once
+    * the result of its asynchronous request has arrived.
+    *
+    * Implement this interface to resume the coroutines on your own event loop or thread pool.
+    *
+    * @ingroup Client
+    ***********************************************************************************************/
+    class CoroutineExecutor
+    {
+    public:
+
+
+        /**
+         * Virtual destructor.
+         */
+        virtual ~CoroutineExecutor() {}
+
+
+        /**
+         * Resume the given coroutine (now, or later on another thread).
+         *
+         * This method is called by the thread of the SDK that received the response, so it
+         * should return quickly.
+         *
+         * @param handle    The handle of the suspended coroutine. It must be resumed exactly once.
+         */
+        virtual void execute(std::coroutine_handle<> handle) = 0;
+    };
+
+
+
+    /*******************************************************************************************//**
+    * A uaf::InlineExecutor resumes the coroutines immediately, on the thread of the SDK that
+    * received the response.
+    *
+    * This is the cheapest executor, but the coroutine then runs on an SDK thread until its next
+    * suspension point, so it should not block.
+    *
+    * @ingroup Client
+    ***********************************************************************************************/
+    class InlineExecutor : public uaf::CoroutineExecutor
+    {
+    public:
+
+
+        /**
+         * Resume the coroutine immediately.
+         *
+         * @param handle    The handle of the suspended coroutine.
+         */
+        virtual void execute(std::coroutine_handle<> handle) { handle.resume(); }
+
+
+        /**
+         * Get a shared instance (the executor has no state).
+         *
+         * @return  The shared instance.
+         */
+        static InlineExecutor& instance()
+        {
+            static InlineExecutor executor;
+            return executor;
+        }
+    };
+
+
+
+    /*******************************************************************************************//**
+    * A uaf::QueuedExecutor queues the coroutines, so that they can be resumed by the thread(s)
+    * of the application that call run() or poll().
+    *
+    * This allows a single application thread to drive thousands of concurrent coroutines.
+    *
+    * @ingroup Client
+    ***********************************************************************************************/
+    class QueuedExecutor : public uaf::CoroutineExecutor
+    {
+    public:
+
+
+        /**
+         * Queue the coroutine.
+         *
+         * @param handle    The handle of the suspended coroutine.
+         */
+        virtual void execute(std::coroutine_handle<> handle)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                queue_.push_back(handle);
+            }
+            condition_.notify_one();
+        }
+
+
+        /**
+         * Resume all coroutines that are queued right now, without waiting.
+         *
+         * @return  The number of resumed coroutines.
+         */
+        std::size_t poll()
+        {
+            std::size_t ret = 0;
+            std::coroutine_handle<> handle;
+            while (pop(handle, std::chrono::milliseconds(0)))
+            {
+                handle.resume();
+                ret++;
+            }
+            return ret;
+        }
+
+
+        /**
+         * Wait at most the given time for a queued coroutine, and resume it.
+         *
+         * @param timeout   The maximum time to wait.
+         * @return          True if a coroutine was resumed, false if the timeout expired.
+         */
+        bool runOne(std::chrono::milliseconds timeout)
+        {
+            std::coroutine_handle<> handle;
+            if (!pop(handle, timeout))
+                return false;
+            handle.resume();
+            return true;
+        }
+
+
+        /**
+         * Get the number of queued coroutines.
+         *
+         * @return  The number of coroutines that are waiting to be resumed.
+         */
+        std::size_t pending() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return queue_.size();
+        }
+
+
+    private:
+
+
+        // take the first coroutine from the queue
+        bool pop(std::coroutine_handle<>& handle, std::chrono::milliseconds timeout)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (!condition_.wait_for(lock, timeout, [this] { return !queue_.empty(); }))
+                return false;
+            handle = queue_.front();
+            queue_.pop_front();
+            return true;
+        }
+
+        mutable std::mutex                      mutex_;
+        std::condition_variable                 condition_;
+        std::deque<std::coroutine_handle<> >    queue_;
+    };
+
+
+
+    /*******************************************************************************************//**
+    * A uaf::ServiceAwaitable processes one asynchronous request when it is co_awaited, and
+    * resumes the awaiting coroutine (via a uaf::CoroutineExecutor) with the result.
+    *
+    * The awaitable is the completion handler of its own request: the coroutine is resumed only
+    * after both uaf::Client::processRequest() has returned and the UAF has released the handler,
+    * so the awaitable is never destroyed while the UAF can still access it.
+    *
+    * The result is always returned (there are no exceptions): if the request could not be
+    * processed, or no result arrived (e.g. because the session was disconnected), the
+    * overallStatus of the returned result tells you why. Note that asynchronous requests can't
+    * be split over several sessions: a request whose targets belong to different servers is
+    * rejected, and its result has an AsyncInvocationOnMultipleSessionsNotSupportedError as
+    * overallStatus. Keep the targets of a co_awaited request on a single server.
+    *
+    * You normally don't create awaitables yourself, but get them from a uaf::CoroutineClient.
+    *
+    * @tparam _Request  The asynchronous request type, e.g. uaf::AsyncReadRequest.
+    * @tparam _Result   The result type, e.g. uaf::ReadResult.
+    *
+    * @ingroup Client
+    ***********************************************************************************************/
+    template<typename _Request, typename _Result>
+    class ServiceAwaitable : public uaf::CompletionHandler<_Result>
+    {
+    public:
+
+
+        /**
+         * Construct an awaitable for the given request.
+         *
+         * @param client    The client that will process the request.
+         * @param request   The request (it is copied).
+         * @param executor  The executor that will resume the awaiting coroutine.
+         * @param status    If not Good, the request is not processed at all, and the awaiting
+         *                  coroutine gets a result with this status immediately.
+         */
+        ServiceAwaitable(
+                uaf::Client&                client,
+                const _Request&             request,
+                uaf::CoroutineExecutor&     executor,
+                const uaf::Status&          status = uaf::Status(uaf::statuscodes::Good))
+        : client_(client),
+          request_(request),
+          executor_(executor),
+          status_(status),
+          completed_(false),
+          pending_(2)
+        {}
+
+        // the UAF keeps a pointer to the awaitable, so it can't be copied or moved
+        ServiceAwaitable(const ServiceAwaitable&) = delete;
+        ServiceAwaitable& operator=(const ServiceAwaitable&) = delete;
+
+
+        /**
+         * Only ready (without suspending) if the request should not be processed at all.
+         */
+        bool await_ready() const { return status_.isNotGood(); }
+
+
+        /**
+         * Process the request, and suspend the coroutine until the result has arrived.
+         *
+         * @param handle    The handle of the awaiting coroutine.
+         * @return          False if the coroutine can continue immediately (because the handler
+         *                  was already released during the processing of the request).
+         */
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            handle_ = handle;
+            status_ = client_.processRequest(request_, this, asyncResult_);
+            return !arrive();
+        }
+
+
+        /**
+         * Get the result of the request.
+         *
+         * @return  The result.
+         */
+        _Result await_resume()
+        {
+            if (status_.isNotGood())
+                result_.overallStatus = status_;
+            else if (!completed_)
+            {
+                if (asyncResult_.overallStatus.isNotGood())
+                    result_.overallStatus = asyncResult_.overallStatus;
+                else
+                    result_.overallStatus = uaf::AsyncResultNotAvailableError();
+            }
+            return result_;
+        }
+
+
+    private:
+
+
+        // called by the SDK thread that received the response
+        virtual void complete(const _Result& result)
+        {
+            result_    = result;
+            completed_ = true;
+        }
+
+        // called exactly once by the UAF, after complete() (if the result arrived at all)
+        virtual void release()
+        {
+            if (arrive())
+                executor_.execute(handle_);
+        }
+
+        // returns true for the last of both parties (processRequest() and release()), which must
+        // then resume the coroutine
+        bool arrive() { return pending_.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+
+        uaf::Client&                                            client_;
+        _Request                                                request_;
+        uaf::CoroutineExecutor&                                 executor_;
+        uaf::Status                                             status_;
+        uaf::BaseSessionResult<uaf::AsyncResultTarget, true>    asyncResult_;
+        _Result                                                 result_;
+        bool                                                    completed_;
+        std::atomic<int>                                        pending_;
+        std::coroutine_handle<>                                 handle_;
+    };
+
+
+    /** Awaitable of an asynchronous read request. @ingroup Client */
+    typedef uaf::ServiceAwaitable<uaf::AsyncReadRequest,
+                                  uaf::ReadResult>                          ReadAwaitable;
+
+    /** Awaitable of an asynchronous write request. @ingroup Client */
+    typedef uaf::ServiceAwaitable<uaf::AsyncWriteRequest,
+                                  uaf::WriteResult>                         WriteAwaitable;
+
+    /** Awaitable of an asynchronous method call request. @ingroup Client */
+    typedef uaf::ServiceAwaitable<uaf::AsyncMethodCallRequest,
+                                  uaf::MethodCallResult>                    MethodCallAwaitable;
+
+    /** Awaitable of an asynchronous browse request. @ingroup Client */
+    typedef uaf::ServiceAwaitable<uaf::AsyncBrowseRequest,
+                                  uaf::BrowseResult>                        BrowseAwaitable;
+
+    /** Awaitable of an asynchronous BrowseNext request. @ingroup Client */
+    typedef uaf::ServiceAwaitable<uaf::AsyncBrowseNextRequest,
+                                  uaf::BrowseNextResult>                    BrowseNextAwaitable;
+
+    /** Awaitable of an asynchronous TranslateBrowsePathsToNodeIds request. @ingroup Client */
+    typedef uaf::ServiceAwaitable<uaf::AsyncTranslateBrowsePathsToNodeIdsRequest,
+                                  uaf::TranslateBrowsePathsToNodeIdsResult> TranslateBrowsePathsToNodeIdsAwaitable;
+
+    /** Awaitable of an asynchronous HistoryReadRawModified request. @ingroup Client */
+    typedef uaf::ServiceAwaitable<uaf::AsyncHistoryReadRawModifiedRequest,
+                                  uaf::HistoryReadRawModifiedResult>        HistoryReadRawModifiedAwaitable;
+
+
+
+    /*******************************************************************************************//**
+    * A uaf::CoroutineClient wraps a uaf::Client, and exposes its asynchronous services as
+    * awaitables, e.g.:
+    *
+    * @code
+    * uaf::DetachedTask poll(uaf::CoroutineClient& client, std::vector<uaf::Address> addresses)
+    * {
+    *     for (;;)
+    *     {
+    *         uaf::ReadResult result = co_await client.asyncRead(addresses);
+    *         ...
+    *     }
+    * }
+    * @endcode
+    *
+    * All coroutines that await the services of the same uaf::CoroutineClient are resumed by
+    * the same uaf::CoroutineExecutor. The wrapped client and the executor must outlive the
+    * uaf::CoroutineClient.
+    *
+    * @ingroup Client
+    ***********************************************************************************************/
+    class CoroutineClient
+    {
+    public:
+
+
+        /**
+         * Wrap a client.
+         *
+         * @param client    The client that will process the requests.
+         * @param executor  The executor that will resume the awaiting coroutines (by default
+         *                  they are resumed by the SDK threads that received the responses).
+         */
+        explicit CoroutineClient(
+                uaf::Client&            client,
+                uaf::CoroutineExecutor& executor = uaf::InlineExecutor::instance())
+        : client_(client),
+          executor_(executor)
+        {}
+
+
+        /**
+         * Get the wrapped client.
+         */
+        uaf::Client& client() { return client_; }
+
+
+        /**
+         * Get the executor that resumes the awaiting coroutines.
+         */
+        uaf::CoroutineExecutor& executor() { return executor_; }
+
+
+        /**
+         * Read a number of node attributes.
+         *
+         * @param addresses     The addresses of the nodes.
+         * @param attributeId   The attribute to read.
+         * @return              An awaitable, resulting in a uaf::ReadResult.
+         */
+        uaf::ReadAwaitable asyncRead(
+                const std::vector<uaf::Address>&    addresses,
+                uaf::attributeids::AttributeId      attributeId = uaf::attributeids::Value)
+        {
+            uaf::AsyncReadRequest request;
+            request.targets.reserve(addresses.size());
+            for (std::size_t i = 0; i < addresses.size(); i++)
+                request.targets.push_back(uaf::ReadRequestTarget(addresses[i], attributeId));
+            return uaf::ReadAwaitable(client_, request, executor_);
+        }
+
+
+        /**
+         * Write a number of node attributes.
+         *
+         * @param addresses     The addresses of the nodes.
+         * @param data          The data to write (one value per address).
+         * @param attributeId   The attribute to write.
+         * @return              An awaitable, resulting in a uaf::WriteResult.
+         */
+        uaf::WriteAwaitable asyncWrite(
+                const std::vector<uaf::Address>&    addresses,
+                const std::vector<uaf::Variant>&    data,
+                uaf::attributeids::AttributeId      attributeId = uaf::attributeids::Value)
+        {
+            uaf::AsyncWriteRequest request;
+            if (addresses.size() != data.size())
+                return uaf::WriteAwaitable(client_, request, executor_,
+                                           uaf::DataDontMatchAddressesError());
+
+            request.targets.reserve(addresses.size());
+            for (std::size_t i = 0; i < addresses.size(); i++)
+                request.targets.push_back(uaf::WriteRequestTarget(addresses[i], data[i], attributeId));
+            return uaf::WriteAwaitable(client_, request, executor_);
+        }
+
+
+        /**
+         * Call a single method.
+         *
+         * @param objectAddress     The address of the object in which context the method is called.
+         * @param methodAddress     The address of the method.
+         * @param inputArguments    The input arguments.
+         * @return                  An awaitable, resulting in a uaf::MethodCallResult.
+         */
+        uaf::MethodCallAwaitable asyncCall(
+                const uaf::Address&                 objectAddress,
+                const uaf::Address&                 methodAddress,
+                const std::vector<uaf::Variant>&    inputArguments)
+        {
+            uaf::AsyncMethodCallRequest request;
+            request.targets.push_back(
+                    uaf::MethodCallRequestTarget(objectAddress, methodAddress, inputArguments));
+            return uaf::MethodCallAwaitable(client_, request, executor_);
+        }
+
+
+        /**
+         * Browse a number of nodes.
+         *
+         * @param addresses     The addresses of the nodes to browse.
+         * @return              An awaitable, resulting in a uaf::BrowseResult.
+         */
+        uaf::BrowseAwaitable asyncBrowse(const std::vector<uaf::Address>& addresses)
+        {
+            uaf::AsyncBrowseRequest request;
+            request.targets.reserve(addresses.size());
+            for (std::size_t i = 0; i < addresses.size(); i++)
+                request.targets.push_back(uaf::BrowseRequestTarget(addresses[i]));
+            return uaf::BrowseAwaitable(client_, request, executor_);
+        }
+
+
+        /** Process a fully specified asynchronous read request. */
+        uaf::ReadAwaitable processRequest(const uaf::AsyncReadRequest& request)
+        { return uaf::ReadAwaitable(client_, request, executor_); }
+
+        /** Process a fully specified asynchronous write request. */
+        uaf::WriteAwaitable processRequest(const uaf::AsyncWriteRequest& request)
+        { return uaf::WriteAwaitable(client_, request, executor_); }
+
+        /** Process a fully specified asynchronous method call request. */
+        uaf::MethodCallAwaitable processRequest(const uaf::AsyncMethodCallRequest& request)
+        { return uaf::MethodCallAwaitable(client_, request, executor_); }
+
+        /** Process a fully specified asynchronous browse request. */
+        uaf::BrowseAwaitable processRequest(const uaf::AsyncBrowseRequest& request)
+        { return uaf::BrowseAwaitable(client_, request, executor_); }
+
+        /** Process a fully specified asynchronous BrowseNext request. */
+        uaf::BrowseNextAwaitable processRequest(const uaf::AsyncBrowseNextRequest& request)
+        { return uaf::BrowseNextAwaitable(client_, request, executor_); }
+
+        /** Process a fully specified asynchronous TranslateBrowsePathsToNodeIds request. */
+        uaf::TranslateBrowsePathsToNodeIdsAwaitable processRequest(
+                const uaf::AsyncTranslateBrowsePathsToNodeIdsRequest& request)
+        { return uaf::TranslateBrowsePathsToNodeIdsAwaitable(client_, request, executor_); }
+
+        /** Process a fully specified asynchronous HistoryReadRawModified request. */
+        uaf::HistoryReadRawModifiedAwaitable processRequest(
+                const uaf::AsyncHistoryReadRawModifiedRequest& request)
+        { return uaf::HistoryReadRawModifiedAwaitable(client_, request, executor_); }
+
+
+    private:
+
+        uaf::Client&            client_;
+        uaf::CoroutineExecutor& executor_;
+    };
+
+
+
+    /*******************************************************************************************//**
+    * A uaf::DetachedTask is the simplest possible coroutine type: the coroutine starts
+    * immediately, nobody waits for it, and its frame is destroyed when it finishes.
+    *
+    * Use it to start a "flow" (e.g. a polling loop) that awaits the services of a
+    * uaf::CoroutineClient. Coroutine libraries (with their own task types) can await the
+    * uaf::ServiceAwaitable instances just as well.
+    *
+    * @ingroup Client
+    ***********************************************************************************************/
+    struct DetachedTask
+    {
+        /** The promise type of the coroutine. */
+        struct promise_type
+        {
+            DetachedTask get_return_object() { return DetachedTask(); }
+            std::suspend_never initial_suspend() noexcept { return std::suspend_never(); }
+            std::suspend_never final_suspend() noexcept { return std::suspend_never(); }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+    };
+
+}
+
+
+#endif /* __cpp_impl_coroutine */
+
+#endif /* UAF_COROUTINES_H_ */
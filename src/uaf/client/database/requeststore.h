@@ -53,6 +53,7 @@ namespace uaf
         // typedefs
         typedef _Service                   ServiceType;
         typedef typename _Service::Request RequestType;
+        typedef typename _Service::RequestTarget RequestTargetType;
         typedef typename _Service::Result  ResultType;
 
 
@@ -143,6 +144,35 @@ namespace uaf
                 const uaf::Status&  status);
 
 
+        /**
+         * Get a target of a stored request.
+         *
+         * @param requestHandle     The handle of the stored request.
+         * @param targetRank        The rank of the target within the request.
+         * @param target            Output parameter: the stored target.
+         * @return                  Good if the target was found.
+         */
+        uaf::Status getRequestTarget(
+                uaf::RequestHandle  requestHandle,
+                std::size_t         targetRank,
+                RequestTargetType&  target);
+
+
+        /**
+         * Replace a target of a stored request (e.g. because the monitored item that was created
+         * by it has been modified), so that it will be re-processed with the new settings.
+         *
+         * @param requestHandle     The handle of the stored request.
+         * @param targetRank        The rank of the target within the request.
+         * @param target            The new target.
+         * @return                  Good if the target was found and replaced.
+         */
+        uaf::Status updateRequestTarget(
+                uaf::RequestHandle          requestHandle,
+                std::size_t                 targetRank,
+                const RequestTargetType&    target);
+
+
         /**
          * Update a stored item.
          *
@@ -317,6 +347,77 @@ namespace uaf
         return ret;
     }
 
+    // Get a target of a stored request
+    // =============================================================================================
+    template <typename _Service>
+    uaf::Status RequestStore<_Service>::getRequestTarget(
+            uaf::RequestHandle                                      requestHandle,
+            std::size_t                                             targetRank,
+            typename RequestStore<_Service>::RequestTargetType&     target)
+    {
+        uaf::Status ret;
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        typename ItemsMap::const_iterator iter = itemsMap_.find(requestHandle);
+
+        if (iter == itemsMap_.end())
+        {
+            ret = uaf::NoItemFoundForTheGivenRequestHandleError(requestHandle);
+        }
+        else if (targetRank >= iter->second.request.targets.size())
+        {
+            ret = uaf::TargetRankOutOfBoundsError(targetRank,
+                                                  iter->second.request.targets.size());
+        }
+        else
+        {
+            target = iter->second.request.targets[targetRank];
+            ret = uaf::statuscodes::Good;
+        }
+
+        return ret;
+    }
+
+
+    // Replace a target of a stored request
+    // =============================================================================================
+    template <typename _Service>
+    uaf::Status RequestStore<_Service>::updateRequestTarget(
+            uaf::RequestHandle                                          requestHandle,
+            std::size_t                                                 targetRank,
+            const typename RequestStore<_Service>::RequestTargetType&   target)
+    {
+        uaf::Status ret;
+
+        logger_->debug("Updating request %d target %d", requestHandle, targetRank);
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        typename ItemsMap::iterator iter = itemsMap_.find(requestHandle);
+
+        if (iter == itemsMap_.end())
+        {
+            ret = uaf::NoItemFoundForTheGivenRequestHandleError(requestHandle);
+        }
+        else if (targetRank >= iter->second.request.targets.size())
+        {
+            ret = uaf::TargetRankOutOfBoundsError(targetRank,
+                                                  iter->second.request.targets.size());
+        }
+        else
+        {
+            iter->second.request.targets[targetRank] = target;
+            ret = uaf::statuscodes::Good;
+        }
+
+        if (ret.isNotGood())
+            logger_->error(ret);
+
+        return ret;
+    }
+
+
     // Get a pointer to a result
     // =============================================================================================
     template <typename _Service>
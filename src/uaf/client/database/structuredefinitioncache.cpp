@@ -0,0 +1,194 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/database/structuredefinitioncache.h"
+
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::map;
+    using std::set;
+
+
+    // Constructor
+    // =============================================================================================
+    StructureDefinitionCache::StructureDefinitionCache(LoggerFactory* loggerFactory)
+    {
+        logger_ = new Logger(loggerFactory, "StructDefCache");
+        logger_->debug("The structure definition cache has been constructed");
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    StructureDefinitionCache::~StructureDefinitionCache()
+    {
+        logger_->debug("Destructing the structure definition cache");
+
+        clear();
+
+        delete logger_;
+        logger_ = 0;
+    }
+
+
+    // Remove all items from the cache
+    // =============================================================================================
+    void StructureDefinitionCache::clear()
+    {
+        logger_->info("Clearing the structure definition cache");
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        cache_.clear();
+        namespaceArrays_.clear();
+        prefetchedServerUris_.clear();
+    }
+
+
+    // Remove all items from the cache with the given server URI
+    // =============================================================================================
+    void StructureDefinitionCache::clear(const string& serverUri)
+    {
+        logger_->info("Clearing the cached structure definitions for ServerUri '%s'",
+                      serverUri.c_str());
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        clearServerUri(serverUri);
+    }
+
+
+    // Remove all items from the cache with the given server URI, without locking
+    // =============================================================================================
+    void StructureDefinitionCache::clearServerUri(const string& serverUri)
+    {
+        Cache::iterator it = cache_.begin();
+        while (it != cache_.end())
+        {
+            if (it->first.first == serverUri)
+                cache_.erase(it++); // post increment: erase the original iterator
+            else
+                ++it;
+        }
+
+        prefetchedServerUris_.erase(serverUri);
+    }
+
+
+    // Add a definition to the cache
+    // =============================================================================================
+    void StructureDefinitionCache::add(
+            const string&               serverUri,
+            const NodeId&               dataTypeId,
+            const StructureDefinition&  definition)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        cache_[Key(serverUri, dataTypeId)] = definition;
+    }
+
+
+    // Find a definition in the cache
+    // =============================================================================================
+    bool StructureDefinitionCache::find(
+            const string&           serverUri,
+            const NodeId&           dataTypeId,
+            StructureDefinition&    definition)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        Cache::const_iterator iter = cache_.find(Key(serverUri, dataTypeId));
+
+        bool found = (iter != cache_.end());
+
+        if (found)
+            definition = iter->second;
+
+        return found;
+    }
+
+
+    // Update the NamespaceArray of a server
+    // =============================================================================================
+    bool StructureDefinitionCache::updateNamespaceArray(
+            const string& serverUri,
+            const string& namespaceArray)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        NamespaceArrayMap::iterator iter = namespaceArrays_.find(serverUri);
+
+        bool changed = (iter == namespaceArrays_.end() || iter->second != namespaceArray);
+
+        if (changed)
+        {
+            logger_->debug("The NamespaceArray of ServerUri '%s' has changed, so its cached "
+                           "structure definitions are cleared", serverUri.c_str());
+            clearServerUri(serverUri);
+            namespaceArrays_[serverUri] = namespaceArray;
+        }
+
+        return changed;
+    }
+
+
+    // Get the number of cached definitions of a server
+    // =============================================================================================
+    size_t StructureDefinitionCache::size(const string& serverUri)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        size_t ret = 0;
+        for (Cache::const_iterator it = cache_.begin(); it != cache_.end(); ++it)
+        {
+            if (it->first.first == serverUri)
+                ret++;
+        }
+
+        return ret;
+    }
+
+
+    // Check if a server has been prefetched
+    // =============================================================================================
+    bool StructureDefinitionCache::isPrefetched(const string& serverUri)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        return prefetchedServerUris_.find(serverUri) != prefetchedServerUris_.end();
+    }
+
+
+    // Mark a server as prefetched
+    // =============================================================================================
+    void StructureDefinitionCache::setPrefetched(const string& serverUri)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        prefetchedServerUris_.insert(serverUri);
+    }
+
+
+}
@@ -0,0 +1,199 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_STRUCTUREDEFINITIONCACHE_H_
+#define UAF_STRUCTUREDEFINITIONCACHE_H_
+
+// STD
+#include <string>
+#include <map>
+#include <set>
+#include <utility>
+// SDK
+#include "uabase/uamutex.h"
+// UAF
+#include "uaf/util/nodeid.h"
+#include "uaf/util/status.h"
+#include "uaf/util/logger.h"
+#include "uaf/util/structuredefinition.h"
+#include "uaf/client/clientexport.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::StructureDefinitionCache stores the definitions of the structured DataTypes, per
+    * server.
+    *
+    * The entries are keyed by the server URI and the NodeId of the DataType (as known by the
+    * namespace index of that server), so that a definition only needs to be fetched once per
+    * server. The entries of a server are invalidated when its NamespaceArray changes.
+    *
+    * @ingroup ClientDatabase
+    ***********************************************************************************************/
+    class UAF_EXPORT StructureDefinitionCache
+    {
+    public:
+
+
+        /**
+         * Create a structure definition cache which logs to the specified logger factory.
+         *
+         * @param loggerFactory The logger factory to log to.
+         */
+        StructureDefinitionCache(uaf::LoggerFactory* loggerFactory);
+
+
+        /**
+         * Destruct the cache.
+         */
+        virtual ~StructureDefinitionCache();
+
+
+        /**
+         * Clear the cache.
+         */
+        void clear();
+
+
+        /**
+         * Remove all cached definitions that belong to the given server URI.
+         */
+        void clear(const std::string& serverUri);
+
+
+        /**
+         * Add a definition to the cache (an existing entry is replaced).
+         *
+         * @param serverUri     The URI of the server that owns the DataType.
+         * @param dataTypeId    The NodeId of the DataType (with the namespace index of the server).
+         * @param definition    The definition of the DataType.
+         */
+        void add(
+                const std::string&              serverUri,
+                const uaf::NodeId&              dataTypeId,
+                const uaf::StructureDefinition& definition);
+
+
+        /**
+         * Find the definition of a DataType in the cache.
+         *
+         * @param serverUri     The URI of the server that owns the DataType.
+         * @param dataTypeId    The NodeId of the DataType (with the namespace index of the server).
+         * @param definition    The found definition (if the DataType was cached of course).
+         * @return              True if the definition was found, false if not.
+         */
+        bool find(
+                const std::string&          serverUri,
+                const uaf::NodeId&          dataTypeId,
+                uaf::StructureDefinition&   definition);
+
+
+        /**
+         * Update the NamespaceArray of a server, and remove all cached definitions of that
+         * server if the NamespaceArray has changed (since the namespace indexes of the cached
+         * NodeIds may not be valid anymore).
+         *
+         * @param serverUri         The URI of the server.
+         * @param namespaceArray    The string representation of the NamespaceArray of the server.
+         * @return                  True if the NamespaceArray has changed.
+         */
+        bool updateNamespaceArray(const std::string& serverUri, const std::string& namespaceArray);
+
+
+        /**
+         * Get the number of cached definitions of a server.
+         *
+         * @param serverUri The URI of the server.
+         * @return          The number of definitions of this server in the cache.
+         */
+        std::size_t size(const std::string& serverUri);
+
+
+        /**
+         * Check if all structured DataTypes of a server have been prefetched.
+         *
+         * @param serverUri The URI of the server.
+         * @return          True if the server has been prefetched since its entries were cleared.
+         */
+        bool isPrefetched(const std::string& serverUri);
+
+
+        /**
+         * Mark all structured DataTypes of a server as prefetched.
+         *
+         * @param serverUri The URI of the server.
+         */
+        void setPrefetched(const std::string& serverUri);
+
+
+
+    private:
+
+
+        // no copying or assigning allowed
+        DISALLOW_COPY_AND_ASSIGN(StructureDefinitionCache);
+
+
+        // private typedefs
+
+
+        /** The key of a cached definition: the server URI and the NodeId of the DataType. */
+        typedef std::pair<std::string, uaf::NodeId> Key;
+
+        /** A cache stores the definitions per key. */
+        typedef std::map<Key, uaf::StructureDefinition> Cache;
+
+        /** The last known NamespaceArray (as a string) per server URI. */
+        typedef std::map<std::string, std::string> NamespaceArrayMap;
+
+
+        // private members
+
+
+        /** The logger of the cache. */
+        uaf::Logger* logger_;
+
+        /** The map containing the cached definitions. */
+        Cache cache_;
+
+        /** The map containing the last known NamespaceArrays. */
+        NamespaceArrayMap namespaceArrays_;
+
+        /** The server URIs of which all structured DataTypes have been prefetched. */
+        std::set<std::string> prefetchedServerUris_;
+
+        /** The mutex to safely manipulate the members. */
+        UaMutex mutex_;
+
+
+        /**
+         * Remove all cached definitions of a server (without locking the mutex).
+         */
+        void clearServerUri(const std::string& serverUri);
+
+    };
+
+}
+
+
+#endif /* UAF_STRUCTUREDEFINITIONCACHE_H_ */
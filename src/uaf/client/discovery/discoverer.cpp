@@ -27,14 +27,22 @@ namespace uaf
     using std::string;
     using std::stringstream;
     using std::map;
+    using std::set;
     using std::vector;
 
 
     // Constructor
     // =============================================================================================
-    Discoverer::Discoverer(LoggerFactory* loggerFactory, Database* database)
-    : database_(database),
-      findServersBusy_(false), findServersOnNetworkBusy_(false)
+    Discoverer::Discoverer(
+            LoggerFactory*      loggerFactory,
+            ClientInterface*    clientInterface,
+            Database*           database)
+    : clientInterface_(clientInterface),
+      database_(database),
+      findServersBusy_(false), findServersOnNetworkBusy_(false),
+      onNetworkJobBusy_(false),
+      noOfDiscoveryThreads_(0),
+      discoveryJobsSemaphore_(0, 0x7FFFFFFF)
     {
         logger_ = new Logger(loggerFactory, "Discoverer");
         logger_->info("The discoverer has been constructed");
@@ -82,89 +90,72 @@ namespace uaf
         }
         else
         {
+            // create a copy of the URLs
+            vector<string> discoveryUrls = database_->clientSettings.discoveryUrls;
+            bool onNetwork = database_->clientSettings.discoveryOnNetworkEnable;
 
-            if (database_->clientSettings.discoveryOnNetworkEnable)
-            {
-                findServersOnNetwork();
-            }
+            // forget the servers that were only reported by URLs that are no longer configured
+            removeUnconfiguredServers(discoveryUrls);
 
-            if (database_->clientSettings.discoveryUrls.size() > 0)
+            if (discoveryUrls.size() == 0 && !onNetwork)
             {
-                // store the results in a temporary variable, and copy this temporary variable to the
-                // serverDescriptions_ member when finished
-                vector<ApplicationDescription> serverDescriptions;
+                logger_->warning("Nothing to do: no discoveryUrls specified in the ClientConfig");
 
-                // set the call timeout
-                UaClientSdk::ServiceSettings serviceSettings;
-                serviceSettings.callTimeout = int32_t(
-                        database_->clientSettings.discoveryFindServersTimeoutSec * 1000);
+                // all done
+                ret = statuscodes::Good;
+            }
+            else
+            {
+                // queue the jobs of this cycle: the FindServersOnNetwork job first, since it may
+                // add new discovery URLs to the queue
+                discoveryJobsMutex_.lock();
 
-                UaClientSdk::ClientSecurityInfo clientSecurityInfo;
+                discoveryJobs_.clear();
+                onNetworkJobBusy_ = false;
 
-                // create a copy of the URLs
-                vector<string> discoveryUrls = database_->clientSettings.discoveryUrls;
+                if (onNetwork)
+                {
+                    DiscoveryJob job;
+                    job.onNetwork = true;
+                    discoveryJobs_.push_back(job);
+                    onNetworkJobBusy_ = true;
+                }
 
-                // store the statuses and the number of failures
-                size_t noOfErrors = 0;
-                vector<SdkStatus> sdkStatuses;
-                sdkStatuses.reserve(discoveryUrls.size());
-                // loop through the URLs
                 for (vector<string>::const_iterator iter = discoveryUrls.begin();
                      iter != discoveryUrls.end();
                      ++iter)
                 {
-                    string url(*iter);
-
-                    logger_->debug("Finding the servers for URL '%s' (timeout %dms)",
-                                   url.c_str(),
-                                   serviceSettings.callTimeout);
-
-                    // invoke the FindServers service for the current URL
-                    UaApplicationDescriptions desc;
-                    SdkStatus discoveryStatus = uaDiscovery_.findServers(
-                            serviceSettings,
-                            UaString(url.c_str()),
-                            clientSecurityInfo, // ToDo replace
-                            desc);
-
-					// store the status
-                    sdkStatuses.push_back(discoveryStatus);
+                    DiscoveryJob job;
+                    job.onNetwork = false;
+                    job.discoveryUrl = *iter;
+                    discoveryJobs_.push_back(job);
+                }
 
-					// if the service call went OK, process the result
-                    if (discoveryStatus.isGood())
-                    {
-                        // loop through the results
-                        for (uint32_t i=0; i<desc.length(); i++)
-                        {
-                            // create an UAF::ApplicationDescription from the SDK ApplicationDescription
-                            ApplicationDescription applicationDescription(desc[i]);
-                            serverDescriptions.push_back(applicationDescription);
-
-                            logger_->debug("Found server at URL '%s':", url.c_str());
-                            logger_->debug(applicationDescription.toString());
-                        }
-                    }
-                    else
-                    {
-                        noOfErrors++;
-                        logger_->error(discoveryStatus.toString());
-                    }
+                // the current thread processes the jobs too, so only start the remaining threads
+                noOfDiscoveryThreads_ = 1;
+                startDiscoveryWorkers();
 
-				}
+                logger_->debug("Processing %d discovery job(s) by %d thread(s)",
+                               int(discoveryUrls.size()) + (onNetwork ? 1 : 0),
+                               noOfDiscoveryThreads_);
 
-                // copy the temporary application descriptions to the class member
-                serverDescriptions_ = serverDescriptions;
+                discoveryJobsMutex_.unlock();
 
-			}
-            else
-            {
-                logger_->warning("Nothing to do: no discoveryUrls specified in the ClientConfig");
+                processDiscoveryJobs();
 
-                // clear the server descriptions
-                serverDescriptions_.clear();
+                // no more workers can be started once all jobs are done
+                vector<DiscoveryWorker*> workers;
+                discoveryJobsMutex_.lock();
+                workers.swap(discoveryWorkers_);
+                discoveryJobsMutex_.unlock();
 
-                // all done
-                ret = statuscodes::Good;
+                for (vector<DiscoveryWorker*>::iterator iter = workers.begin();
+                     iter != workers.end();
+                     ++iter)
+                {
+                    (*iter)->wait();
+                    delete *iter;
+                }
             }
 
             // reset the findServersBusy_ flag
@@ -177,9 +168,286 @@ namespace uaf
     }
 
 
+    // Remove the servers of discovery URLs that are no longer configured
+    // =============================================================================================
+    void Discoverer::removeUnconfiguredServers(const vector<string>& discoveryUrls)
+    {
+        set<string> configuredUrls(discoveryUrls.begin(), discoveryUrls.end());
+        vector<ApplicationDescription> appeared, disappeared, changed;
+
+        serversMutex_.lock();
+        ServerRegistry::iterator it = servers_.begin();
+        while (it != servers_.end())
+        {
+            map<string, DateTime>& lastSeen = it->second.lastSeen;
+            map<string, DateTime>::iterator urlIt = lastSeen.begin();
+            while (urlIt != lastSeen.end())
+            {
+                if (configuredUrls.find(urlIt->first) == configuredUrls.end())
+                    lastSeen.erase(urlIt++);
+                else
+                    ++urlIt;
+            }
+
+            if (lastSeen.empty())
+            {
+                disappeared.push_back(it->second.description);
+                servers_.erase(it++);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        serversMutex_.unlock();
+
+        notifyServersChanged(appeared, disappeared, changed);
+    }
+
+
+    // Process the jobs of a discovery cycle
+    // =============================================================================================
+    void Discoverer::processDiscoveryJobs()
+    {
+        // each thread has its own UaDiscovery instance
+        UaClientSdk::UaDiscovery uaDiscovery;
+
+        DiscoveryJob job;
+        while (takeDiscoveryJob(job))
+        {
+            if (job.onNetwork)
+            {
+                vector<string> newDiscoveryUrls;
+                findServersOnNetwork(newDiscoveryUrls);
+
+                // queue the new URLs, and wake up the threads that are waiting for them
+                discoveryJobsMutex_.lock();
+                for (vector<string>::const_iterator iter = newDiscoveryUrls.begin();
+                     iter != newDiscoveryUrls.end();
+                     ++iter)
+                {
+                    DiscoveryJob newJob;
+                    newJob.onNetwork = false;
+                    newJob.discoveryUrl = *iter;
+                    discoveryJobs_.push_back(newJob);
+                }
+                onNetworkJobBusy_ = false;
+                uint32_t noOfWaitingThreads = noOfDiscoveryThreads_ - 1;
+
+                // the new URLs are processed in parallel as well
+                startDiscoveryWorkers();
+
+                discoveryJobsMutex_.unlock();
+
+                if (noOfWaitingThreads > 0)
+                    discoveryJobsSemaphore_.post(noOfWaitingThreads);
+            }
+            else
+            {
+                findServersForUrl(uaDiscovery, job.discoveryUrl);
+            }
+        }
+    }
+
+
+    // Start additional threads for the queued jobs (not locked!)
+    // =============================================================================================
+    void Discoverer::startDiscoveryWorkers()
+    {
+        // start one thread per queued job, up to the configured maximum (in total)
+        uint32_t maxThreads = database_->clientSettings.discoveryMaxParallelRequests;
+        uint32_t noOfThreads = uint32_t(discoveryJobs_.size());
+        if (maxThreads > 0 && noOfThreads > maxThreads)
+            noOfThreads = maxThreads;
+
+        while (noOfDiscoveryThreads_ < noOfThreads)
+        {
+            DiscoveryWorker* worker = new DiscoveryWorker(this);
+            discoveryWorkers_.push_back(worker);
+            worker->start();
+            noOfDiscoveryThreads_++;
+        }
+    }
+
+
+    // Take the next job of a discovery cycle
+    // =============================================================================================
+    bool Discoverer::takeDiscoveryJob(DiscoveryJob& job)
+    {
+        while (true)
+        {
+            discoveryJobsMutex_.lock();
+
+            if (!discoveryJobs_.empty())
+            {
+                job = discoveryJobs_.front();
+                discoveryJobs_.pop_front();
+                discoveryJobsMutex_.unlock();
+                return true;
+            }
+            else if (!onNetworkJobBusy_)
+            {
+                discoveryJobsMutex_.unlock();
+                return false;
+            }
+
+            discoveryJobsMutex_.unlock();
+
+            // the FindServersOnNetwork job may still add new jobs, so wait for it
+            discoveryJobsSemaphore_.wait();
+        }
+    }
+
+
+    // Find the servers of a single discovery URL
+    // =============================================================================================
+    void Discoverer::findServersForUrl(
+            UaClientSdk::UaDiscovery&   uaDiscovery,
+            const string&               discoveryUrl)
+    {
+        // set the call timeout
+        UaClientSdk::ServiceSettings serviceSettings;
+        serviceSettings.callTimeout = int32_t(
+                database_->clientSettings.discoveryFindServersTimeoutSec * 1000);
+
+        UaClientSdk::ClientSecurityInfo clientSecurityInfo;
+
+        logger_->debug("Finding the servers for URL '%s' (timeout %dms)",
+                       discoveryUrl.c_str(),
+                       serviceSettings.callTimeout);
+
+        // invoke the FindServers service for the URL
+        UaApplicationDescriptions desc;
+        SdkStatus discoveryStatus = uaDiscovery.findServers(
+                serviceSettings,
+                UaString(discoveryUrl.c_str()),
+                clientSecurityInfo, // ToDo replace
+                desc);
+
+        vector<ApplicationDescription> appeared, disappeared, changed;
+
+        serversMutex_.lock();
+
+        DateTime now = DateTime::now();
+
+        if (discoveryStatus.isGood())
+        {
+            // the servers that are reported by this URL
+            set<string> serverUris;
+
+            for (uint32_t i=0; i<desc.length(); i++)
+            {
+                // create an UAF::ApplicationDescription from the SDK ApplicationDescription
+                ApplicationDescription applicationDescription(desc[i]);
+                serverUris.insert(applicationDescription.applicationUri);
+
+                logger_->debug("Found server at URL '%s':", discoveryUrl.c_str());
+                logger_->debug(applicationDescription.toString());
+
+                ServerRegistry::iterator it = servers_.find(applicationDescription.applicationUri);
+
+                if (it == servers_.end())
+                {
+                    RegisteredServer& server = servers_[applicationDescription.applicationUri];
+                    server.description = applicationDescription;
+                    server.lastSeen[discoveryUrl] = now;
+                    appeared.push_back(applicationDescription);
+                }
+                else
+                {
+                    if (it->second.description != applicationDescription)
+                    {
+                        it->second.description = applicationDescription;
+                        changed.push_back(applicationDescription);
+                    }
+                    it->second.lastSeen[discoveryUrl] = now;
+                }
+            }
+
+            // the servers that are no longer reported by this URL, are no longer seen by it
+            ServerRegistry::iterator it = servers_.begin();
+            while (it != servers_.end())
+            {
+                if (serverUris.find(it->first) == serverUris.end()
+                        && it->second.lastSeen.erase(discoveryUrl) > 0
+                        && it->second.lastSeen.empty())
+                {
+                    disappeared.push_back(it->second.description);
+                    servers_.erase(it++);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+        else
+        {
+            logger_->error(discoveryStatus.toString());
+
+            // the discovery server may be temporarily unavailable, so keep its servers until
+            // their time to live has expired
+            int32_t ttlMs = int32_t(database_->clientSettings.discoveryServerTimeToLiveSec * 1000);
+
+            ServerRegistry::iterator it = servers_.begin();
+            while (it != servers_.end())
+            {
+                map<string, DateTime>::iterator urlIt = it->second.lastSeen.find(discoveryUrl);
+
+                if (urlIt != it->second.lastSeen.end() && urlIt->second.msecsTo(now) >= ttlMs)
+                {
+                    it->second.lastSeen.erase(urlIt);
+
+                    if (it->second.lastSeen.empty())
+                    {
+                        logger_->debug("Server '%s' has expired", it->first.c_str());
+                        disappeared.push_back(it->second.description);
+                        servers_.erase(it++);
+                        continue;
+                    }
+                }
+
+                ++it;
+            }
+        }
+
+        serversMutex_.unlock();
+
+        // notify without holding the lock, so the client interface may call serversFound()
+        notifyServersChanged(appeared, disappeared, changed);
+    }
+
+
+    // Notify the client interface about the changed servers
+    // =============================================================================================
+    void Discoverer::notifyServersChanged(
+            const vector<ApplicationDescription>& appeared,
+            const vector<ApplicationDescription>& disappeared,
+            const vector<ApplicationDescription>& changed)
+    {
+        if (appeared.empty() && disappeared.empty() && changed.empty())
+            return;
+
+        logger_->debug("Servers changed: %d appeared, %d disappeared, %d changed",
+                       int(appeared.size()), int(disappeared.size()), int(changed.size()));
+
+        if (clientInterface_ != NULL)
+            clientInterface_->serversChanged(appeared, disappeared, changed);
+    }
+
+
 	// Get the discovery URL from the LDS-ME
     // =============================================================================================
 	Status Discoverer::findServersOnNetwork()
+    {
+        vector<string> newDiscoveryUrls;
+        return findServersOnNetwork(newDiscoveryUrls);
+    }
+
+
+	// Get the discovery URL from the LDS-ME
+    // =============================================================================================
+	Status Discoverer::findServersOnNetwork(vector<string>& newDiscoveryUrls)
     {
         Status ret;
 
@@ -272,6 +540,7 @@ namespace uaf
 						if(!isInside)
 						{
 							database_->clientSettings.discoveryUrls.push_back(UaString(servers[i].DiscoveryUrl).toUtf8());
+							newDiscoveryUrls.push_back(UaString(servers[i].DiscoveryUrl).toUtf8());
 							logger_->debug("Found server on network by localhost at URL '%s'.", serverUri.c_str());
 							logger_->debug("So update the discoveryUrls with '%s'.",UaString(&servers[i].DiscoveryUrl).toUtf8());
 						}
@@ -312,27 +581,28 @@ namespace uaf
     {
         Status ret;
 
-        std::vector<std::string> knownServerUris;
+        UaMutexLocker locker(&serversMutex_);
+
+        ServerRegistry::const_iterator found = servers_.find(serverUri);
 
-        std::vector<uaf::ApplicationDescription>::const_iterator it;
-        for (it = serverDescriptions_.begin(); it != serverDescriptions_.end(); ++it)
+        if (found != servers_.end())
         {
-            knownServerUris.push_back(it->applicationUri);
-            if (it->applicationUri == serverUri)
-            {
-                discoveryUrls = it->discoveryUrls;
+            discoveryUrls = found->second.description.discoveryUrls;
+
+            if (discoveryUrls.size() == 0)
+                ret = NoDiscoveryUrlsExposedByServerError(serverUri);
+            else
                 ret = statuscodes::Good;
-            }
         }
-
-        if (ret.isNotGood())
+        else
         {
+            // only build the list of known servers for the error
+            vector<string> knownServerUris;
+            for (ServerRegistry::const_iterator it = servers_.begin(); it != servers_.end(); ++it)
+                knownServerUris.push_back(it->first);
+
             ret = UnknownServerError(serverUri, knownServerUris);
         }
-        else if (discoveryUrls.size() == 0)
-        {
-            ret = NoDiscoveryUrlsExposedByServerError(serverUri);
-        }
 
         return ret;
     }
@@ -340,9 +610,17 @@ namespace uaf
 
     // Get all servers found
     // =============================================================================================
-    const vector<ApplicationDescription>& Discoverer::serversFound() const
+    vector<ApplicationDescription> Discoverer::serversFound() const
     {
-        return serverDescriptions_;
+        vector<ApplicationDescription> serverDescriptions;
+
+        UaMutexLocker locker(&serversMutex_);
+
+        serverDescriptions.reserve(servers_.size());
+        for (ServerRegistry::const_iterator it = servers_.begin(); it != servers_.end(); ++it)
+            serverDescriptions.push_back(it->second.description);
+
+        return serverDescriptions;
     }
 
     // Get all servers found on the network
@@ -410,7 +688,7 @@ namespace uaf
                         endpointDescriptions.push_back(
                                 EndpointDescription(uaEndpointDescriptions[i]));
                         logger_->debug(" - endpoint[%d]", i);
-                        logger_->debug(string("   ") + endpointDescriptions[i].toString("   "));
+                        logger_->debug(string("   ") + endpointDescriptions.back().toString("   "));
                     }
                 }
                 else
@@ -418,6 +696,17 @@ namespace uaf
                     ret = NoEndpointsProvidedByServerError();
                     logger_->error(ret.toString().c_str());
                 }
+
+                // refresh the cache
+                if (ret.isGood())
+                {
+                    UaMutexLocker locker(&endpointsCacheMutex_);
+                    CachedEndpoints& cached = endpointsCache_[discoveryUrl];
+                    cached.endpointDescriptions.assign(
+                            endpointDescriptions.end() - uaEndpointDescriptions.length(),
+                            endpointDescriptions.end());
+                    cached.time = DateTime::now();
+                }
             }
             else
             {
@@ -430,6 +719,43 @@ namespace uaf
 
 
 
+    // Get the endpoint descriptions from the cache if possible
+    // =============================================================================================
+    Status Discoverer::getCachedEndpoints(
+            const string&                   discoveryUrl,
+            vector<EndpointDescription>&    endpointDescriptions,
+            bool&                           fromCache)
+    {
+        fromCache = false;
+
+        int32_t ttlMs = int32_t(database_->clientSettings.discoveryEndpointsTimeToLiveSec * 1000);
+
+        if (ttlMs > 0)
+        {
+            UaMutexLocker locker(&endpointsCacheMutex_);
+
+            EndpointsCache::const_iterator it = endpointsCache_.find(discoveryUrl);
+
+            if (it != endpointsCache_.end() && it->second.time.msecsTo(DateTime::now()) < ttlMs)
+            {
+                logger_->debug("Using the %d cached endpoint(s) for '%s'",
+                               int(it->second.endpointDescriptions.size()),
+                               discoveryUrl.c_str());
+
+                endpointDescriptions.insert(endpointDescriptions.end(),
+                                            it->second.endpointDescriptions.begin(),
+                                            it->second.endpointDescriptions.end());
+                fromCache = true;
+            }
+        }
+
+        if (fromCache)
+            return statuscodes::Good;
+        else
+            return getEndpoints(discoveryUrl, endpointDescriptions);
+    }
+
+
 }
 
 
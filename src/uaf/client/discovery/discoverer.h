@@ -24,9 +24,15 @@
 
 // STD
 #include <vector>
+#include <deque>
+#include <map>
+#include <set>
 #include <string>
 #include <ctime>
 // SDK
+#include "uabase/uathread.h"
+#include "uabase/uamutex.h"
+#include "uabase/uasemaphore.h"
 #include "uaclient/uaclientsdk.h"
 #include "uaclient/uadiscovery.h"
 // UAF
@@ -36,7 +42,9 @@
 #include "uaf/util/applicationdescription.h"
 #include "uaf/util/serveronnetwork.h"
 #include "uaf/util/endpointdescription.h"
+#include "uaf/util/datetime.h"
 #include "uaf/client/clientexport.h"
+#include "uaf/client/clientinterface.h"
 #include "uaf/client/database/database.h"
 
 
@@ -47,6 +55,10 @@ namespace uaf
     /*******************************************************************************************//**
     * An uaf::Discoverer can discover OPC UA servers in the system.
     *
+    * The discovered servers are kept in a registry, indexed by their server URI. The result of
+    * each FindServers invocation is applied to this registry as a diff, and only the servers that
+    * appeared, disappeared or changed are reported to the uaf::ClientInterface.
+    *
     * @ingroup ClientDiscovery
     ***********************************************************************************************/
     class UAF_EXPORT Discoverer
@@ -55,10 +67,13 @@ namespace uaf
 
 
         /**
-         * Construct a Discoverer instance by providing a pointer to a logger factory and a client
-         * database.
+         * Construct a Discoverer instance by providing a pointer to a logger factory, a client
+         * interface (to report the changes of the discovered servers) and a client database.
          */
-        Discoverer(uaf::LoggerFactory *loggerFactory, uaf::Database* database);
+        Discoverer(
+                uaf::LoggerFactory*     loggerFactory,
+                uaf::ClientInterface*   clientInterface,
+                uaf::Database*          database);
 
 
         /**
@@ -70,6 +85,10 @@ namespace uaf
         /**
          * Update the server descriptions by calling the OPC UA FindServers service
          * on all configured discovery servers.
+         *
+         * The discovery servers are invoked concurrently (by at most
+         * ClientSettings::discoveryMaxParallelRequests threads), and the servers that are found
+         * become available as soon as their discovery server has answered.
          */
         uaf::Status findServers();
 
@@ -99,6 +118,8 @@ namespace uaf
          * Get the endpoint descriptions for a given server by calling the OPC UA
          * GetEndpoints service on the given URL.
          *
+         * The endpoint descriptions that were gotten successfully are also stored in the cache.
+         *
          * @param discoveryUrl          URL of the server to discover.
          * @param endpointDescriptions  Endpoint descriptions that will be fetched.
          * @return                      Status of the service call.
@@ -109,11 +130,29 @@ namespace uaf
 
 
         /**
-         * Get a const reference to the servers that were found.
+         * Get the endpoint descriptions for a given server from the cache, or by calling the
+         * OPC UA GetEndpoints service on the given URL if the cached endpoint descriptions are
+         * older than ClientSettings::discoveryEndpointsTimeToLiveSec.
+         *
+         * @param discoveryUrl          URL of the server to discover.
+         * @param endpointDescriptions  Endpoint descriptions that will be fetched.
+         * @param fromCache             Output parameter: true if the endpoint descriptions were
+         *                              taken from the cache.
+         * @return                      Good if the endpoint descriptions were found in the cache,
+         *                              or else the status of the service call.
+         */
+        uaf::Status getCachedEndpoints(
+                const std::string&                      discoveryUrl,
+                std::vector<uaf::EndpointDescription>&  endpointDescriptions,
+                bool&                                   fromCache);
+
+
+        /**
+         * Get a copy of the servers that were found.
          *
          * @return  A vector of the application descriptions that were discovered.
          */
-        const std::vector<uaf::ApplicationDescription>& serversFound() const;
+        std::vector<uaf::ApplicationDescription> serversFound() const;
 
 
         /**
@@ -130,8 +169,75 @@ namespace uaf
         DISALLOW_COPY_AND_ASSIGN(Discoverer);
 
 
+        // a thread that helps to process the jobs of a discovery cycle
+        class DiscoveryWorker : public UaThread
+        {
+        public:
+            DiscoveryWorker(uaf::Discoverer* discoverer) : discoverer_(discoverer) {}
+            void run() { discoverer_->processDiscoveryJobs(); }
+        private:
+            uaf::Discoverer* discoverer_;
+        };
+        friend class DiscoveryWorker;
+
+
+        // a single job of a discovery cycle: FindServersOnNetwork, or FindServers for one URL
+        struct DiscoveryJob
+        {
+            bool        onNetwork;
+            std::string discoveryUrl;
+        };
+
+
+        // invoke FindServersOnNetwork, and return the discoveryUrls that were added to the settings
+        uaf::Status findServersOnNetwork(std::vector<std::string>& newDiscoveryUrls);
+
+        // remove the servers that were only reported by URLs that are not in the given list
+        void removeUnconfiguredServers(const std::vector<std::string>& discoveryUrls);
+
+        // process discovery jobs until there are none left (called by all threads of a cycle)
+        void processDiscoveryJobs();
+
+        // start additional threads (up to the configured maximum) for the queued jobs (not locked!)
+        void startDiscoveryWorkers();
+
+        // get the next job of the current cycle, returns false if there are none left
+        bool takeDiscoveryJob(DiscoveryJob& job);
+
+        // invoke FindServers for a single URL, and apply the result to the registry
+        void findServersForUrl(UaClientSdk::UaDiscovery& uaDiscovery, const std::string& discoveryUrl);
+
+        // notify the client interface about the servers that appeared, disappeared or changed
+        void notifyServersChanged(
+                const std::vector<uaf::ApplicationDescription>& appeared,
+                const std::vector<uaf::ApplicationDescription>& disappeared,
+                const std::vector<uaf::ApplicationDescription>& changed);
+
+
+        // the endpoint descriptions of a discovery URL, and when they were gotten
+        struct CachedEndpoints
+        {
+            std::vector<uaf::EndpointDescription> endpointDescriptions;
+            uaf::DateTime                          time;
+        };
+        typedef std::map<std::string, CachedEndpoints> EndpointsCache;
+
+
+        // a server in the registry
+        struct RegisteredServer
+        {
+            // the latest description of the server
+            uaf::ApplicationDescription description;
+            // the discovery URLs that reported the server, and when they did so for the last time
+            std::map<std::string, uaf::DateTime> lastSeen;
+        };
+        typedef std::map<std::string, RegisteredServer> ServerRegistry;
+
+
         // the logger of the discoverer
         uaf::Logger* logger_;
+        // the interface to report the changes of the discovered servers to
+        uaf::ClientInterface* clientInterface_;
         // a pointer to the shared database
         uaf::Database* database_;
         // are we busy with findServers()?
@@ -140,8 +246,26 @@ namespace uaf
         // mutexes to change the internal state
         UaMutex findServersBusyMutex_;
         UaMutex findServersOnNetworkBusyMutex_;
-        // the latest application descriptions
-        std::vector<uaf::ApplicationDescription> serverDescriptions_;
+        // the jobs of the current discovery cycle
+        std::deque<DiscoveryJob> discoveryJobs_;
+        // is the FindServersOnNetwork job of the current cycle (which may add new jobs) busy?
+        bool onNetworkJobBusy_;
+        // the number of threads of the current cycle (including the calling thread), and the
+        // worker threads that were started for it
+        uint32_t noOfDiscoveryThreads_;
+        std::vector<DiscoveryWorker*> discoveryWorkers_;
+        // protects the above members
+        UaMutex discoveryJobsMutex_;
+        // posted when the FindServersOnNetwork job of the current cycle has finished
+        UaSemaphore discoveryJobsSemaphore_;
+        // the discovered servers, by server URI
+        ServerRegistry servers_;
+        // protects the registry
+        mutable UaMutex serversMutex_;
+        // the endpoint descriptions that were gotten, by discovery URL
+        EndpointsCache endpointsCache_;
+        // protects the endpoints cache
+        UaMutex endpointsCacheMutex_;
         // the latest server-on-network descriptions
         std::vector<uaf::ServerOnNetwork> serverOnNetworkDescriptions_;
         // UaDiscovery instance
@@ -0,0 +1,397 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_FUTURE_H_
+#define UAF_FUTURE_H_
+
+
+// STD
+#include <vector>
+// SDK
+#include "uabase/uamutex.h"
+#include "uabase/uasemaphore.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/status.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/completionhandler.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * The shared state of a uaf::Future.
+    *
+    * The state is reference counted: it is owned by all uaf::Future copies that point to it, and
+    * by the session factory as long as the asynchronous request is in flight. You never need to
+    * use this class directly.
+    *
+    * @tparam _Result  The result type, e.g. uaf::ReadResult.
+    *
+    * @ingroup Client
+    ***********************************************************************************************/
+    template<typename _Result>
+    class FutureState : public uaf::CompletionHandler<_Result>
+    {
+    public:
+
+
+        /**
+         * Create a new state, referenced once.
+         */
+        FutureState()
+        : semaphore_(0, 0x7FFFFFFF),
+          references_(1),
+          waiters_(0),
+          ready_(false),
+          abandoned_(false)
+        {}
+
+
+        /**
+         * Add a reference to the state.
+         */
+        void addReference()
+        {
+            UaMutexLocker locker(&mutex_);
+            references_++;
+        }
+
+
+        /**
+         * Remove a reference from the state, and delete it if no references are left.
+         */
+        void removeReference()
+        {
+            mutex_.lock();
+            bool deleteMe = (--references_ == 0);
+            mutex_.unlock();
+
+            if (deleteMe)
+                delete this;
+        }
+
+
+        /**
+         * Store the result, wake up the waiting threads and call the continuations.
+         *
+         * Implemented from uaf::CompletionHandler.
+         */
+        virtual void complete(const _Result& result)
+        {
+            Continuations continuations;
+            uint32_t      waiters;
+
+            mutex_.lock();
+            result_ = result;
+            ready_  = true;
+            continuations.swap(continuations_);
+            waiters = waiters_;
+            mutex_.unlock();
+
+            if (waiters > 0)
+                semaphore_.post(waiters);
+
+            for (typename Continuations::iterator it = continuations.begin();
+                 it != continuations.end(); ++it)
+            {
+                (*it)->complete(result);
+                (*it)->release();
+            }
+        }
+
+
+        /**
+         * Called by the session factory when it no longer needs the state.
+         *
+         * Implemented from uaf::BaseCompletionHandler.
+         */
+        virtual void release()
+        {
+            Continuations continuations;
+            uint32_t      waiters = 0;
+
+            mutex_.lock();
+            if (!ready_)
+            {
+                // the request could not be invoked, so no result will ever arrive
+                abandoned_ = true;
+                continuations.swap(continuations_);
+                waiters = waiters_;
+            }
+            mutex_.unlock();
+
+            if (waiters > 0)
+                semaphore_.post(waiters);
+
+            for (typename Continuations::iterator it = continuations.begin();
+                 it != continuations.end(); ++it)
+                (*it)->release();
+
+            removeReference();
+        }
+
+
+        /**
+         * Check if the result has arrived.
+         */
+        bool isReady()
+        {
+            UaMutexLocker locker(&mutex_);
+            return ready_;
+        }
+
+
+        /**
+         * Check if the result has arrived, or will never arrive.
+         */
+        bool isDone()
+        {
+            UaMutexLocker locker(&mutex_);
+            return ready_ || abandoned_;
+        }
+
+
+        /**
+         * Wait until the result has arrived (or will never arrive), or until the timeout expires.
+         */
+        bool wait(uint32_t timeoutMs)
+        {
+            mutex_.lock();
+            if (ready_ || abandoned_)
+            {
+                mutex_.unlock();
+                return ready_;
+            }
+            waiters_++;
+            mutex_.unlock();
+
+            semaphore_.timedWait(timeoutMs);
+
+            UaMutexLocker locker(&mutex_);
+            waiters_--;
+            return ready_;
+        }
+
+
+        /**
+         * Copy the result, if it has arrived.
+         */
+        uaf::Status get(_Result& result)
+        {
+            UaMutexLocker locker(&mutex_);
+            if (!ready_)
+                return uaf::AsyncResultNotAvailableError();
+            result = result_;
+            return uaf::statuscodes::Good;
+        }
+
+
+        /**
+         * Call the given handler when the result arrives, or immediately if it already arrived.
+         */
+        void then(uaf::CompletionHandler<_Result>* handler)
+        {
+            mutex_.lock();
+            bool ready     = ready_;
+            bool abandoned = abandoned_;
+            if (!ready && !abandoned)
+                continuations_.push_back(handler);
+            mutex_.unlock();
+
+            if (ready)
+                handler->complete(result_);
+            if (ready || abandoned)
+                handler->release();
+        }
+
+
+    private:
+
+        DISALLOW_COPY_AND_ASSIGN(FutureState);
+
+        // only removeReference() may delete the state
+        virtual ~FutureState() {}
+
+        typedef std::vector<uaf::CompletionHandler<_Result>*> Continuations;
+
+        UaMutex         mutex_;
+        UaSemaphore     semaphore_;
+        uint32_t        references_;
+        uint32_t        waiters_;
+        bool            ready_;
+        bool            abandoned_;
+        _Result         result_;
+        Continuations   continuations_;
+    };
+
+
+
+    /*******************************************************************************************//**
+    * A uaf::Future gives access to the result of an asynchronous request, once it has arrived.
+    *
+    * Pass the completionHandler() of a future to an asynchronous request, e.g.:
+    * @code
+    *   uaf::ReadFuture future;
+    *   uaf::AsyncReadResult asyncResult;
+    *   uaf::Status status = client.beginRead(addresses, attributeids::Value, 0, NULL, NULL, NULL,
+    *                                         future.completionHandler(), asyncResult);
+    *   ...
+    *   uaf::ReadResult result;
+    *   if (status.isGood() && future.wait(1000))
+    *       future.get(result);
+    * @endcode
+    *
+    * Copies of a future share the same result. A future may be destroyed before the result has
+    * arrived. Each future can only be passed to a single asynchronous request.
+    *
+    * @tparam _Result  The result type, e.g. uaf::ReadResult.
+    *
+    * @ingroup Client
+    ***********************************************************************************************/
+    template<typename _Result>
+    class Future
+    {
+    public:
+
+
+        /**
+         * Create a new future.
+         */
+        Future()
+        : state_(new uaf::FutureState<_Result>)
+        {}
+
+
+        /**
+         * Create a future that shares the result of another future.
+         */
+        Future(const Future<_Result>& other)
+        : state_(other.state_)
+        {
+            state_->addReference();
+        }
+
+
+        /**
+         * Share the result of another future.
+         */
+        Future<_Result>& operator=(const Future<_Result>& other)
+        {
+            if (state_ != other.state_)
+            {
+                other.state_->addReference();
+                state_->removeReference();
+                state_ = other.state_;
+            }
+            return *this;
+        }
+
+
+        /**
+         * Destruct the future (the result may still arrive afterwards, it will simply be dropped).
+         */
+        ~Future()
+        {
+            state_->removeReference();
+        }
+
+
+        /**
+         * Get the completion handler to pass to an asynchronous request.
+         *
+         * @return  A handler that is owned by the UAF until it is released.
+         */
+        uaf::CompletionHandler<_Result>* completionHandler()
+        {
+            state_->addReference();
+            return state_;
+        }
+
+
+        /**
+         * Check if the result has arrived.
+         *
+         * @return True if get() will succeed.
+         */
+        bool isReady() const { return state_->isReady(); }
+
+
+        /**
+         * Check if the future is finished: either the result has arrived, or it will never
+         * arrive because the request could not be invoked.
+         *
+         * @return True if waiting is no longer needed.
+         */
+        bool isDone() const { return state_->isDone(); }
+
+
+        /**
+         * Block the calling thread until the result has arrived, or the timeout has expired.
+         *
+         * @param timeoutMs Maximum time to wait, in milliseconds.
+         * @return          True if the result has arrived.
+         */
+        bool wait(uint32_t timeoutMs) { return state_->wait(timeoutMs); }
+
+
+        /**
+         * Get the result.
+         *
+         * @param result    Output parameter: the result, if it has arrived.
+         * @return          Good if the result was copied, AsyncResultNotAvailableError if not.
+         */
+        uaf::Status get(_Result& result) const { return state_->get(result); }
+
+
+        /**
+         * Chain a handler that must be called as soon as the result arrives.
+         *
+         * If the result has already arrived, the handler is called immediately by the calling
+         * thread. Otherwise it will be called by the thread that completes the future. In both
+         * cases, release() of the handler is called afterwards.
+         *
+         * @param handler   The handler to call.
+         */
+        void then(uaf::CompletionHandler<_Result>* handler) { state_->then(handler); }
+
+
+    private:
+
+        // the shared state
+        uaf::FutureState<_Result>* state_;
+    };
+
+
+    /** Future result of an asynchronous read request. @ingroup Client */
+    typedef uaf::Future<uaf::ReadResult>        ReadFuture;
+
+    /** Future result of an asynchronous write request. @ingroup Client */
+    typedef uaf::Future<uaf::WriteResult>       WriteFuture;
+
+    /** Future result of an asynchronous method call request. @ingroup Client */
+    typedef uaf::Future<uaf::MethodCallResult>  MethodCallFuture;
+
+}
+
+
+#endif /* UAF_FUTURE_H_ */
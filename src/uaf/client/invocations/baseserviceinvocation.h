@@ -127,7 +127,7 @@ namespace uaf
         std::vector<_ResultTarget>&         resultTargets()               { return resultTargets_; }
 
         /** Get the rank for each target. */
-        const std::vector<std::size_t>      ranks()                 const { return ranks_; }
+        const std::vector<std::size_t>&     ranks()                 const { return ranks_; }
 
         /** Is the request asynchronous? */
         bool                                asynchronous()          const { return asynchronous_; }
@@ -195,6 +195,20 @@ namespace uaf
         }
 
 
+        /** Provide the handle of the subscription of a single target, in case the targets of
+         *  the invocation were spread over several subscriptions. */
+        void setClientSubscriptionHandle(
+                std::size_t                     i,
+                uaf::ClientSubscriptionHandle   clientSubscriptionHandle)
+        {
+            if (targetSubscriptionHandles_.size() != resultTargets_.size())
+                targetSubscriptionHandles_.resize(
+                        resultTargets_.size(),
+                        subscriptionInformation_.clientSubscriptionHandle);
+            targetSubscriptionHandles_[i] = clientSubscriptionHandle;
+        }
+
+
         /** Set the relevant settings from the given request, for the given server URI. */
         void setServiceSettings(const _ServiceSettings& serviceSettings)
         {
@@ -416,7 +430,9 @@ namespace uaf
                     result.targets[rank].clientConnectionId
                         = sessionInformation_.clientConnectionId;
                     result.targets[rank].clientSubscriptionHandle
-                        = subscriptionInformation_.clientSubscriptionHandle;
+                        = i < targetSubscriptionHandles_.size()
+                            ? targetSubscriptionHandles_[i]
+                            : subscriptionInformation_.clientSubscriptionHandle;
                 }
                 else
                 {
@@ -711,6 +727,8 @@ namespace uaf
         uaf::SessionInformation    sessionInformation_;
         // some details about the subscription
         uaf::SubscriptionInformation subscriptionInformation_;
+        // the subscription of each target, if they were spread over several subscriptions
+        std::vector<uaf::ClientSubscriptionHandle> targetSubscriptionHandles_;
         // the level at which the service should be invoked
         uaf::InvocationLevel       invocationLevel_;
 
@@ -80,51 +80,219 @@ namespace uaf
                 uaCreateRequests_[i].RequestedParameters.DiscardOldest = discardOldest;
                 uaCreateRequests_[i].RequestedParameters.QueueSize = targets[i].queueSize;
 
-                UaEventFilter eventFilter;
-
-                size_t noOfSelectClauses = targets[i].eventFilter.selectClauses.size();
-
-                for (size_t clauseIndex = 0;
-                     clauseIndex < noOfSelectClauses && ret.isGood();
-                     clauseIndex++)
-                {
-                    // create an operand
-                    UaSimpleAttributeOperand operand;
-
-                    SimpleAttributeOperand selectClause;
-                    selectClause = targets[i].eventFilter.selectClauses[clauseIndex];
-
-                    // set the attribute ID
-                    operand.setAttributeId(selectClause.attributeId);
-
-                    // set the type definition ID
-                    OpcUa_NodeId typeId;
-                    ret = nameSpaceArray.fillOpcUaNodeId(selectClause.typeId, typeId);
-                    if (ret.isGood())
-                        operand.setTypeId(typeId);
-
-                    // set the browse path
-                    size_t noOfBrowseNames = selectClause.browsePath.size();
-                    for (size_t nameIndex = 0;
-                         nameIndex < noOfBrowseNames && ret.isGood();
-                         nameIndex++)
-                    {
-                        OpcUa_QualifiedName qualifiedName;
-                        ret = nameSpaceArray.fillOpcUaQualifiedName(
-                                selectClause.browsePath[nameIndex],
-                                qualifiedName);
-
-                        if (ret.isGood())
-                            operand.setBrowsePathElement(nameIndex, qualifiedName, noOfBrowseNames);
-                    }
-
-                    if (ret.isGood())
-                        eventFilter.setSelectClauseElement(clauseIndex, operand, noOfSelectClauses);
-                }
+                ret = fillSdkEventFilter(
+                        targets[i].eventFilter,
+                        nameSpaceArray,
+                        uaCreateRequests_[i].RequestedParameters.Filter);
+            }
+        }
+
+        return ret;
+    }
+
+
+    // Fill an SDK event filter
+    // =============================================================================================
+    Status CreateMonitoredEventsInvocation::fillSdkEventFilter(
+            const EventFilter&      eventFilter,
+            const NamespaceArray&   nameSpaceArray,
+            OpcUa_ExtensionObject&  uaFilter)
+    {
+        Status ret = statuscodes::Good;
+
+        UaEventFilter uaEventFilter;
+
+        size_t noOfSelectClauses = eventFilter.selectClauses.size();
+
+        for (size_t clauseIndex = 0;
+             clauseIndex < noOfSelectClauses && ret.isGood();
+             clauseIndex++)
+        {
+            // create an operand
+            UaSimpleAttributeOperand operand;
+
+            ret = fillSdkSimpleAttributeOperand(
+                    eventFilter.selectClauses[clauseIndex],
+                    nameSpaceArray,
+                    operand);
+
+            if (ret.isGood())
+                uaEventFilter.setSelectClauseElement(clauseIndex, operand, noOfSelectClauses);
+        }
+
+        // set the where clause, so that the server only reports the matching events
+        if (ret.isGood() && !eventFilter.whereClause.isEmpty())
+        {
+            UaContentFilter* whereClause = new UaContentFilter();
+
+            ret = fillSdkContentFilter(eventFilter.whereClause, nameSpaceArray, *whereClause);
+
+            // the event filter takes ownership of the where clause
+            if (ret.isGood())
+                uaEventFilter.setWhereClause(whereClause);
+            else
+                delete whereClause;
+        }
+
+        if (ret.isGood())
+            uaEventFilter.detachFilter(uaFilter);
+
+        return ret;
+    }
+
+
+
+    // Fill an SDK simple attribute operand
+    // =============================================================================================
+    Status CreateMonitoredEventsInvocation::fillSdkSimpleAttributeOperand(
+            const SimpleAttributeOperand&   operand,
+            const NamespaceArray&           nameSpaceArray,
+            UaSimpleAttributeOperand&       uaOperand)
+    {
+        Status ret;
+
+        // set the attribute ID
+        uaOperand.setAttributeId(operand.attributeId);
+
+        // set the type definition ID
+        OpcUa_NodeId typeId;
+        ret = nameSpaceArray.fillOpcUaNodeId(operand.typeId, typeId);
+        if (ret.isGood())
+            uaOperand.setTypeId(typeId);
+
+        // set the browse path
+        size_t noOfBrowseNames = operand.browsePath.size();
+        for (size_t nameIndex = 0; nameIndex < noOfBrowseNames && ret.isGood(); nameIndex++)
+        {
+            OpcUa_QualifiedName qualifiedName;
+            ret = nameSpaceArray.fillOpcUaQualifiedName(
+                    operand.browsePath[nameIndex],
+                    qualifiedName);
+
+            if (ret.isGood())
+                uaOperand.setBrowsePathElement(nameIndex, qualifiedName, noOfBrowseNames);
+        }
+
+        return ret;
+    }
+
+
+    // Fill an SDK filter operand
+    // =============================================================================================
+    Status CreateMonitoredEventsInvocation::fillSdkFilterOperand(
+            const FilterOperand&    operand,
+            size_t                  noOfElements,
+            const NamespaceArray&   nameSpaceArray,
+            UaFilterOperand*&       uaOperand)
+    {
+        Status ret;
+        uaOperand = 0;
+
+        if (operand.operandType == FilterOperand::OperandType_Element)
+        {
+            if (operand.elementIndex < noOfElements)
+            {
+                // the UAF filter has its root last, the OPC UA filter has its root first
+                UaElementOperand* uaElementOperand = new UaElementOperand();
+                uaElementOperand->setIndex(noOfElements - 1 - operand.elementIndex);
+                uaOperand = uaElementOperand;
+                ret = statuscodes::Good;
+            }
+            else
+            {
+                ret = InvalidContentFilterError(
+                        format("element %d does not exist", operand.elementIndex));
+            }
+        }
+        else if (operand.operandType == FilterOperand::OperandType_SimpleAttribute)
+        {
+            UaSimpleAttributeOperand* uaSimpleAttributeOperand = new UaSimpleAttributeOperand();
+            ret = fillSdkSimpleAttributeOperand(
+                    operand.simpleAttributeOperand,
+                    nameSpaceArray,
+                    *uaSimpleAttributeOperand);
+            uaOperand = uaSimpleAttributeOperand;
+        }
+        else
+        {
+            UaVariant uaValue;
+            NodeId nodeId;
+
+            // NodeIds may be given by namespace URI, so they must be resolved first
+            if (operand.value.type() == opcuatypes::NodeId && !operand.value.isArray())
+            {
+                OpcUa_NodeId opcUaNodeId;
+                OpcUa_NodeId_Initialize(&opcUaNodeId);
+                ret = operand.value.toNodeId(nodeId);
+                if (ret.isGood())
+                    ret = nameSpaceArray.fillOpcUaNodeId(nodeId, opcUaNodeId);
+                if (ret.isGood())
+                    uaValue.setNodeId(UaNodeId(opcUaNodeId));
+                OpcUa_NodeId_Clear(&opcUaNodeId);
+            }
+            else
+            {
+                operand.value.toSdk(uaValue);
+                ret = statuscodes::Good;
+            }
+
+            UaLiteralOperand* uaLiteralOperand = new UaLiteralOperand();
+            uaLiteralOperand->setLiteralValue(uaValue);
+            uaOperand = uaLiteralOperand;
+        }
+
+        return ret;
+    }
+
+
+    // Fill an SDK content filter
+    // =============================================================================================
+    Status CreateMonitoredEventsInvocation::fillSdkContentFilter(
+            const ContentFilter&    contentFilter,
+            const NamespaceArray&   nameSpaceArray,
+            UaContentFilter&        uaContentFilter)
+    {
+        Status ret = statuscodes::Good;
 
+        size_t noOfElements = contentFilter.elements.size();
+
+        for (size_t uaElementIndex = 0;
+             uaElementIndex < noOfElements && ret.isGood();
+             uaElementIndex++)
+        {
+            // the UAF filter has its root last, the OPC UA filter has its root first
+            const ContentFilterElement& element =
+                    contentFilter.elements[noOfElements - 1 - uaElementIndex];
+
+            UaContentFilterElement* uaElement = new UaContentFilterElement();
+            uaElement->setFilterOperator(filteroperators::fromUafToSdk(element.filterOperator));
+
+            size_t noOfOperands = element.filterOperands.size();
+
+            for (size_t operandIndex = 0;
+                 operandIndex < noOfOperands && ret.isGood();
+                 operandIndex++)
+            {
+                UaFilterOperand* uaOperand = 0;
+
+                ret = fillSdkFilterOperand(
+                        element.filterOperands[operandIndex],
+                        noOfElements,
+                        nameSpaceArray,
+                        uaOperand);
+
+                // the element takes ownership of the operand
                 if (ret.isGood())
-                    eventFilter.detachFilter(uaCreateRequests_[i].RequestedParameters.Filter);
+                    uaElement->setFilterOperand(operandIndex, uaOperand, noOfOperands);
+                else
+                    delete uaOperand;
             }
+
+            // the content filter takes ownership of the element
+            if (ret.isGood())
+                uaContentFilter.setContentFilterElement(uaElementIndex, uaElement, noOfElements);
+            else
+                delete uaElement;
         }
 
         return ret;
@@ -69,6 +69,21 @@ namespace uaf
         }
 
 
+        /**
+         * Fill the filter of an SDK monitored item (create or modify) request from a UAF event
+         * filter.
+         *
+         * @param eventFilter       The UAF event filter.
+         * @param nameSpaceArray    The namespace array of the server.
+         * @param uaFilter          The extension object to fill (an OpcUa_EventFilter).
+         * @return                  Good if the event filter could be converted.
+         */
+        static uaf::Status fillSdkEventFilter(
+                const uaf::EventFilter&     eventFilter,
+                const uaf::NamespaceArray&  nameSpaceArray,
+                OpcUa_ExtensionObject&      uaFilter);
+
+
     private:
 
 
@@ -116,6 +131,34 @@ namespace uaf
                 std::vector<uaf::CreateMonitoredEventsResultTarget>& targets);
 
 
+        /**
+         * Fill an SDK simple attribute operand (e.g. a select clause) from a UAF one.
+         */
+        static uaf::Status fillSdkSimpleAttributeOperand(
+                const uaf::SimpleAttributeOperand&  operand,
+                const uaf::NamespaceArray&          nameSpaceArray,
+                UaSimpleAttributeOperand&           uaOperand);
+
+
+        /**
+         * Fill an SDK filter operand from a UAF one. The operand is owned by the caller.
+         */
+        static uaf::Status fillSdkFilterOperand(
+                const uaf::FilterOperand&   operand,
+                std::size_t                 noOfElements,
+                const uaf::NamespaceArray&  nameSpaceArray,
+                UaFilterOperand*&           uaOperand);
+
+
+        /**
+         * Fill an SDK content filter (e.g. a where clause) from a UAF one.
+         */
+        static uaf::Status fillSdkContentFilter(
+                const uaf::ContentFilter&   contentFilter,
+                const uaf::NamespaceArray&  nameSpaceArray,
+                UaContentFilter&            uaContentFilter);
+
+
         // private data members used during the invocation
         OpcUa_TimestampsToReturn        uaTimeStamps_;
         ClientHandles                   clientHandles_;
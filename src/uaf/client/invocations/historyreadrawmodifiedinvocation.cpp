@@ -109,7 +109,8 @@ namespace uaf
             const NamespaceArray&                               nameSpaceArray,
             const ServerArray&                                  serverArray)
     {
-        return AsyncInvocationNotSupportedError();
+        // same as synchronous
+        return fromSyncUafToSdk(targets, settings, nameSpaceArray, serverArray);
     }
 
 
@@ -288,7 +289,22 @@ namespace uaf
             UaClientSdk::UaSession* uaSession,
             TransactionId           transactionId)
     {
-        return AsyncInvocationNotSupportedError();
+        Status ret;
+
+        // note that no automatic ReadMore can be done for asynchronous requests: the
+        // continuation points are simply returned to the user
+        SdkStatus sdkStatus = uaSession->beginHistoryReadRawModified(
+                uaServiceSettings_,
+                uaContext_,
+                uaNodesToRead_,
+                transactionId);
+
+        if (sdkStatus.isGood())
+            ret = uaf::statuscodes::Good;
+        else
+            ret = BeginHistoryReadRawModifiedInvocationError(sdkStatus);
+
+        return ret;
     }
 
 
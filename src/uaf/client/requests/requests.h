@@ -79,6 +79,10 @@ namespace uaf
     DEFINE_ASYNC_SESSIONREQUEST(Read)
     DEFINE_ASYNC_SESSIONREQUEST(Write)
     DEFINE_ASYNC_SESSIONREQUEST(MethodCall)
+    DEFINE_ASYNC_SESSIONREQUEST(TranslateBrowsePathsToNodeIds)
+    DEFINE_ASYNC_SESSIONREQUEST(Browse)
+    DEFINE_ASYNC_SESSIONREQUEST(BrowseNext)
+    DEFINE_ASYNC_SESSIONREQUEST(HistoryReadRawModified)
     DEFINE_ASYNC_SUBSCRIPTIONREQUEST(CreateMonitoredData)
     DEFINE_ASYNC_SUBSCRIPTIONREQUEST(CreateMonitoredEvents)
 }
@@ -80,6 +80,10 @@ namespace uaf
     DEFINE_ASYNC_SESSIONRESULT(Read)
     DEFINE_ASYNC_SESSIONRESULT(Write)
     DEFINE_ASYNC_SESSIONRESULT(MethodCall)
+    DEFINE_ASYNC_SESSIONRESULT(TranslateBrowsePathsToNodeIds)
+    DEFINE_ASYNC_SESSIONRESULT(Browse)
+    DEFINE_ASYNC_SESSIONRESULT(BrowseNext)
+    DEFINE_ASYNC_SESSIONRESULT(HistoryReadRawModified)
 
     // asynchronous subscription results
     DEFINE_ASYNC_SUBSCRIPTIONRESULT(CreateMonitoredData)
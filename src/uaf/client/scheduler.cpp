@@ -0,0 +1,277 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/scheduler.h"
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+
+
+    // the shortest interval of a task: shorter intervals (including 0) are raised to this
+    // minimum (which was also the cycle time of the former polling loop of the client), so
+    // that a task never keeps its thread spinning
+    static const int32_t MIN_INTERVAL_MS = 100;
+
+
+    // convert an interval in seconds to milliseconds
+    static int32_t toMs(double intervalSec)
+    {
+        if (intervalSec * 1000.0 <= MIN_INTERVAL_MS)
+            return MIN_INTERVAL_MS;
+        else if (intervalSec >= 2000000.0)
+            return 2000000000;
+        else
+            return int32_t(intervalSec * 1000.0);
+    }
+
+
+    // Scheduler
+    // =============================================================================================
+    Scheduler::Scheduler(LoggerFactory* loggerFactory)
+    {
+        logger_ = new Logger(loggerFactory, "Scheduler");
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    Scheduler::~Scheduler()
+    {
+        stop();
+
+        for (TaskThreads::iterator it = taskThreads_.begin(); it != taskThreads_.end(); ++it)
+            delete *it;
+        taskThreads_.clear();
+
+        delete logger_;
+        logger_ = 0;
+    }
+
+
+    // Add a task
+    // =============================================================================================
+    uint32_t Scheduler::addTask(const string& name, ScheduledTask* task, double intervalSec)
+    {
+        UaMutexLocker locker(&mutex_);
+
+        logger_->debug("Adding task '%s' (interval %.3fs)", name.c_str(), intervalSec);
+
+        TaskThread* taskThread = new TaskThread(logger_, name, task, intervalSec);
+        taskThreads_.push_back(taskThread);
+        taskThread->start();
+
+        return taskThreads_.size() - 1;
+    }
+
+
+    // Trigger a task
+    // =============================================================================================
+    void Scheduler::trigger(uint32_t taskId)
+    {
+        UaMutexLocker locker(&mutex_);
+
+        if (taskId < taskThreads_.size())
+            taskThreads_[taskId]->trigger();
+    }
+
+
+    // Trigger a task after a delay
+    // =============================================================================================
+    void Scheduler::triggerIn(uint32_t taskId, double delaySec)
+    {
+        UaMutexLocker locker(&mutex_);
+
+        if (taskId < taskThreads_.size())
+            taskThreads_[taskId]->triggerIn(delaySec);
+    }
+
+
+    // Change the interval of a task
+    // =============================================================================================
+    void Scheduler::setInterval(uint32_t taskId, double intervalSec)
+    {
+        UaMutexLocker locker(&mutex_);
+
+        if (taskId < taskThreads_.size())
+            taskThreads_[taskId]->setInterval(intervalSec);
+    }
+
+
+    // Stop all threads
+    // =============================================================================================
+    void Scheduler::stop()
+    {
+        // don't hold the mutex while waiting for the threads: the tasks may trigger each other
+        TaskThreads taskThreads;
+        mutex_.lock();
+        taskThreads = taskThreads_;
+        mutex_.unlock();
+
+        // first ask all threads to stop, so they can finish their current task in parallel
+        for (TaskThreads::iterator it = taskThreads.begin(); it != taskThreads.end(); ++it)
+            (*it)->stop();
+
+        for (TaskThreads::iterator it = taskThreads.begin(); it != taskThreads.end(); ++it)
+            (*it)->wait();
+    }
+
+
+    // TaskThread
+    // =============================================================================================
+    Scheduler::TaskThread::TaskThread(
+            Logger*         logger,
+            const string&   name,
+            ScheduledTask*  task,
+            double          intervalSec)
+    : logger_(logger),
+      name_(name),
+      task_(task),
+      intervalMs_(toMs(intervalSec)),
+      triggered_(false),
+      delayedTrigger_(false),
+      stopping_(false),
+      semaphore_(0, 0x7FFFFFFF)
+    {}
+
+
+    // Destructor
+    // =============================================================================================
+    Scheduler::TaskThread::~TaskThread()
+    {
+        delete task_;
+        task_ = 0;
+    }
+
+
+    // The loop of the thread
+    // =============================================================================================
+    void Scheduler::TaskThread::run()
+    {
+        DateTime lastExecution = DateTime::now();
+
+        while (true)
+        {
+            mutex_.lock();
+
+            if (stopping_)
+            {
+                mutex_.unlock();
+                break;
+            }
+
+            DateTime now = DateTime::now();
+            int32_t elapsedMs = lastExecution.msecsTo(now);
+            bool due = triggered_ || elapsedMs < 0 || elapsedMs >= intervalMs_;
+            int32_t waitMs = due ? 0 : intervalMs_ - elapsedMs;
+
+            if (delayedTrigger_ && !due)
+            {
+                int32_t delayMs = now.msecsTo(delayedTriggerTime_);
+                if (delayMs <= 0)
+                    due = true;
+                else if (delayMs < waitMs)
+                    waitMs = delayMs;
+            }
+
+            // a trigger that arrives during the execution will cause another execution
+            if (due)
+            {
+                triggered_ = false;
+                delayedTrigger_ = false;
+            }
+
+            mutex_.unlock();
+
+            if (due)
+            {
+                lastExecution = DateTime::now();
+                task_->execute();
+            }
+            else
+            {
+                // sleep until the task is due, or until it is triggered, changed or stopped
+                // (every post() of the semaphore just causes the state to be re-evaluated)
+                semaphore_.timedWait(waitMs);
+            }
+        }
+
+        logger_->debug("The thread of task '%s' has stopped", name_.c_str());
+    }
+
+
+    // Trigger the task
+    // =============================================================================================
+    void Scheduler::TaskThread::trigger()
+    {
+        mutex_.lock();
+        bool wakeUp = !triggered_;
+        triggered_ = true;
+        mutex_.unlock();
+
+        if (wakeUp)
+            semaphore_.post(1);
+    }
+
+
+    // Trigger the task after a delay
+    // =============================================================================================
+    void Scheduler::TaskThread::triggerIn(double delaySec)
+    {
+        DateTime time = DateTime::now();
+        time.addMilliSecs(toMs(delaySec));
+
+        mutex_.lock();
+        if (!delayedTrigger_ || time < delayedTriggerTime_)
+        {
+            delayedTrigger_ = true;
+            delayedTriggerTime_ = time;
+        }
+        mutex_.unlock();
+
+        semaphore_.post(1);
+    }
+
+
+    // Change the interval
+    // =============================================================================================
+    void Scheduler::TaskThread::setInterval(double intervalSec)
+    {
+        mutex_.lock();
+        intervalMs_ = toMs(intervalSec);
+        mutex_.unlock();
+
+        semaphore_.post(1);
+    }
+
+
+    // Stop the thread
+    // =============================================================================================
+    void Scheduler::TaskThread::stop()
+    {
+        mutex_.lock();
+        stopping_ = true;
+        mutex_.unlock();
+
+        semaphore_.post(1);
+    }
+
+}
@@ -0,0 +1,226 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_SCHEDULER_H_
+#define UAF_SCHEDULER_H_
+
+
+// STD
+#include <string>
+#include <vector>
+// SDK
+#include "uabase/uathread.h"
+#include "uabase/uamutex.h"
+#include "uabase/uasemaphore.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/logger.h"
+#include "uaf/util/datetime.h"
+#include "uaf/client/clientexport.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::ScheduledTask is a background duty of the client (e.g. discovery, or the
+    * reconstruction of monitored items) that is executed by a uaf::Scheduler.
+    *
+    * @ingroup Client
+    ***********************************************************************************************/
+    class UAF_EXPORT ScheduledTask
+    {
+    public:
+
+        /**
+         * Virtual destructor.
+         */
+        virtual ~ScheduledTask() {}
+
+        /**
+         * Execute the task (called by the thread of the task).
+         */
+        virtual void execute() = 0;
+    };
+
+
+
+    /*******************************************************************************************//**
+    * A uaf::ScheduledMemberTask executes a member function (without arguments) of an object.
+    *
+    * @tparam _Owner   The class of the object.
+    *
+    * @ingroup Client
+    ***********************************************************************************************/
+    template<typename _Owner>
+    class ScheduledMemberTask : public uaf::ScheduledTask
+    {
+    public:
+
+        /** The type of the member function. */
+        typedef void (_Owner::*Method)();
+
+        /**
+         * Construct the task.
+         *
+         * @param owner     The object (it must outlive the task).
+         * @param method    The member function to execute.
+         */
+        ScheduledMemberTask(_Owner* owner, Method method) : owner_(owner), method_(method) {}
+
+        /**
+         * Execute the member function.
+         */
+        virtual void execute() { (owner_->*method_)(); }
+
+    private:
+        _Owner* owner_;
+        Method  method_;
+    };
+
+
+
+    /*******************************************************************************************//**
+    * A uaf::Scheduler executes a number of tasks periodically, each task by its own thread.
+    *
+    * The threads don't poll: each thread sleeps until its task is due (i.e. until the interval
+    * of the task has expired since its previous execution), or until the task is triggered
+    * explicitly. A slow task therefore never delays the other tasks. Triggers that arrive while
+    * a task is being executed are coalesced into a single extra execution.
+    *
+    * @ingroup Client
+    ***********************************************************************************************/
+    class UAF_EXPORT Scheduler
+    {
+    public:
+
+
+        /**
+         * Construct a scheduler without tasks.
+         *
+         * @param loggerFactory Logger factory to log all messages to.
+         */
+        Scheduler(uaf::LoggerFactory* loggerFactory);
+
+
+        /**
+         * Destruct the scheduler (the threads are stopped, the tasks are deleted).
+         */
+        ~Scheduler();
+
+
+        /**
+         * Add a task, and start its thread.
+         *
+         * @param name          The name of the task (for the logging).
+         * @param task          The task. The scheduler takes ownership of it.
+         * @param intervalSec   The period of the task, in seconds (at least 0.1 seconds,
+         *                      shorter periods are raised to this minimum).
+         * @return              The id of the task, to be used by trigger() and setInterval().
+         */
+        uint32_t addTask(const std::string& name, uaf::ScheduledTask* task, double intervalSec);
+
+
+        /**
+         * Execute a task as soon as possible (without waiting for its interval to expire).
+         *
+         * This method never blocks, so it can be called from any callback of the SDK.
+         *
+         * @param taskId    The id of the task.
+         */
+        void trigger(uint32_t taskId);
+
+
+        /**
+         * Execute a task after the given delay, unless it is executed earlier anyway.
+         *
+         * If a delayed trigger is already pending, the earliest of both is kept.
+         *
+         * @param taskId    The id of the task.
+         * @param delaySec  The delay, in seconds.
+         */
+        void triggerIn(uint32_t taskId, double delaySec);
+
+
+        /**
+         * Change the interval of a task.
+         *
+         * @param taskId        The id of the task.
+         * @param intervalSec   The new period of the task, in seconds (at least 0.1 seconds).
+         */
+        void setInterval(uint32_t taskId, double intervalSec);
+
+
+        /**
+         * Stop all threads (the task that is being executed, if any, is finished first).
+         *
+         * After the scheduler was stopped, triggers are ignored.
+         */
+        void stop();
+
+
+    private:
+
+
+        DISALLOW_COPY_AND_ASSIGN(Scheduler);
+
+
+        // the state and the thread of a single task
+        class TaskThread : public UaThread
+        {
+        public:
+            TaskThread(
+                    uaf::Logger*        logger,
+                    const std::string&  name,
+                    uaf::ScheduledTask* task,
+                    double              intervalSec);
+            ~TaskThread();
+
+            void run();
+            void trigger();
+            void triggerIn(double delaySec);
+            void setInterval(double intervalSec);
+            void stop();
+
+        private:
+            uaf::Logger*        logger_;
+            std::string         name_;
+            uaf::ScheduledTask* task_;
+            int32_t             intervalMs_;
+            bool                triggered_;
+            bool                delayedTrigger_;
+            uaf::DateTime       delayedTriggerTime_;
+            bool                stopping_;
+            UaMutex             mutex_;
+            UaSemaphore         semaphore_;
+        };
+
+        typedef std::vector<TaskThread*> TaskThreads;
+
+        uaf::Logger*    logger_;
+        TaskThreads     taskThreads_;
+        UaMutex         mutex_;
+    };
+
+}
+
+
+#endif /* UAF_SCHEDULER_H_ */
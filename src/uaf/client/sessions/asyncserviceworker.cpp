@@ -0,0 +1,223 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/sessions/asyncserviceworker.h"
+
+namespace uaf
+{
+    using namespace uaf;
+
+
+    // Constructor
+    // =============================================================================================
+    AsyncServiceWorker::AsyncServiceWorker(uint32_t noOfThreads)
+    : noOfThreads_(noOfThreads > 0 ? noOfThreads : 1),
+      noOfLiveThreads_(0),
+      running_(0),
+      stopping_(false),
+      semaphore_(0, 0x7FFFFFFF),
+      idleWaiters_(0),
+      idleSemaphore_(0, 0x7FFFFFFF)
+    {}
+
+
+    // Destructor
+    // =============================================================================================
+    AsyncServiceWorker::~AsyncServiceWorker()
+    {
+        stop();
+    }
+
+
+    // Enqueue an invocation
+    // =============================================================================================
+    void AsyncServiceWorker::enqueue(DeferredInvocation* invocation)
+    {
+        mutex_.lock();
+
+        if (stopping_)
+        {
+            mutex_.unlock();
+            invocation->cancel();
+            delete invocation;
+            return;
+        }
+
+        queue_.push_back(invocation);
+
+        // start the threads lazily
+        startThreads();
+
+        mutex_.unlock();
+
+        semaphore_.post(1);
+    }
+
+
+    // Start the missing threads
+    // =============================================================================================
+    void AsyncServiceWorker::startThreads()
+    {
+        while (noOfLiveThreads_ < noOfThreads_)
+        {
+            threads_.push_back(new WorkerThread(this));
+            threads_.back()->start();
+            noOfLiveThreads_++;
+        }
+    }
+
+
+    // Change the number of threads
+    // =============================================================================================
+    void AsyncServiceWorker::setNoOfThreads(uint32_t noOfThreads)
+    {
+        UaMutexLocker locker(&mutex_);
+
+        noOfThreads_ = noOfThreads > 0 ? noOfThreads : 1;
+
+        if (stopping_ || noOfLiveThreads_ == 0)
+            return;
+
+        // wake up the superfluous threads so they can stop, or start the additional ones
+        if (noOfLiveThreads_ > noOfThreads_)
+            semaphore_.post(noOfLiveThreads_ - noOfThreads_);
+        else
+            startThreads();
+    }
+
+
+    // Cancel all queued invocations, and wait for the running ones
+    // =============================================================================================
+    void AsyncServiceWorker::clear()
+    {
+        Queue cancelled;
+
+        mutex_.lock();
+        cancelled.swap(queue_);
+        mutex_.unlock();
+
+        for (Queue::iterator it = cancelled.begin(); it != cancelled.end(); ++it)
+        {
+            (*it)->cancel();
+            delete *it;
+        }
+
+        // the semaphore may now be posted more often than there are queued invocations, which is
+        // harmless since the threads will simply find an empty queue
+        mutex_.lock();
+        while (running_ > 0)
+        {
+            // register as a waiter before unlocking, so that the wake-up can't be missed
+            idleWaiters_++;
+            mutex_.unlock();
+
+            idleSemaphore_.wait();
+
+            mutex_.lock();
+        }
+        mutex_.unlock();
+    }
+
+
+    // Get the number of pending invocations
+    // =============================================================================================
+    std::size_t AsyncServiceWorker::pending()
+    {
+        UaMutexLocker locker(&mutex_);
+        return queue_.size() + running_;
+    }
+
+
+    // Stop all threads
+    // =============================================================================================
+    void AsyncServiceWorker::stop()
+    {
+        mutex_.lock();
+        stopping_ = true;
+        uint32_t noOfThreads = noOfLiveThreads_;
+        Threads threads;
+        threads.swap(threads_);
+        mutex_.unlock();
+
+        // wake up all threads, so they can see the stopping_ flag
+        if (noOfThreads > 0)
+            semaphore_.post(noOfThreads);
+
+        // (the threads that stopped before because they were superfluous are joined as well)
+        for (Threads::iterator it = threads.begin(); it != threads.end(); ++it)
+        {
+            (*it)->wait();
+            delete *it;
+        }
+
+        // cancel the invocations that were never executed
+        clear();
+    }
+
+
+    // The loop of each thread
+    // =============================================================================================
+    void AsyncServiceWorker::work()
+    {
+        while (true)
+        {
+            semaphore_.wait();
+
+            mutex_.lock();
+            if (stopping_)
+            {
+                mutex_.unlock();
+                return;
+            }
+            if (noOfLiveThreads_ > noOfThreads_)
+            {
+                // this thread is superfluous, so stop it (and pass the wake-up on, in case it
+                // was meant for a queued invocation)
+                noOfLiveThreads_--;
+                mutex_.unlock();
+                semaphore_.post(1);
+                return;
+            }
+            if (queue_.empty())
+            {
+                mutex_.unlock();
+                continue;
+            }
+            DeferredInvocation* invocation = queue_.front();
+            queue_.pop_front();
+            running_++;
+            mutex_.unlock();
+
+            invocation->execute();
+            delete invocation;
+
+            mutex_.lock();
+            running_--;
+            // wake up the threads that are waiting in clear() (each of them is posted once)
+            if (running_ == 0 && idleWaiters_ > 0)
+            {
+                idleSemaphore_.post(idleWaiters_);
+                idleWaiters_ = 0;
+            }
+            mutex_.unlock();
+        }
+    }
+
+}
@@ -0,0 +1,179 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_ASYNCSERVICEWORKER_H_
+#define UAF_ASYNCSERVICEWORKER_H_
+
+
+// STD
+#include <deque>
+#include <vector>
+// SDK
+#include "uabase/uathread.h"
+#include "uabase/uamutex.h"
+#include "uabase/uasemaphore.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/client/clientexport.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::DeferredInvocation is an asynchronous service request that the SDK cannot invoke
+    * asynchronously by itself, and that will therefore be invoked synchronously by a
+    * uaf::AsyncServiceWorker thread instead.
+    *
+    * @ingroup ClientSessions
+    ***********************************************************************************************/
+    class UAF_EXPORT DeferredInvocation
+    {
+    public:
+
+        /**
+         * Virtual destructor.
+         */
+        virtual ~DeferredInvocation() {}
+
+        /**
+         * Invoke the service and deliver its result (called by a worker thread).
+         */
+        virtual void execute() = 0;
+
+        /**
+         * Clean up without invoking the service (called when the worker is stopped or cleared
+         * before the invocation could be executed).
+         */
+        virtual void cancel() = 0;
+    };
+
+
+
+    /*******************************************************************************************//**
+    * A uaf::AsyncServiceWorker executes uaf::DeferredInvocation instances by a small pool of
+    * threads.
+    *
+    * The threads are only started when the first invocation is enqueued.
+    *
+    * @ingroup ClientSessions
+    ***********************************************************************************************/
+    class UAF_EXPORT AsyncServiceWorker
+    {
+    public:
+
+
+        /**
+         * Construct a worker.
+         *
+         * @param noOfThreads   The maximum number of invocations that are executed in parallel.
+         */
+        AsyncServiceWorker(uint32_t noOfThreads);
+
+
+        /**
+         * Destruct the worker (the threads are stopped, queued invocations are cancelled).
+         */
+        ~AsyncServiceWorker();
+
+
+        /**
+         * Enqueue an invocation. The worker takes ownership of the invocation.
+         *
+         * @param invocation    The invocation to be executed (or cancelled) by the worker.
+         */
+        void enqueue(uaf::DeferredInvocation* invocation);
+
+
+        /**
+         * Cancel all queued invocations, and wait until the running ones are finished.
+         */
+        void clear();
+
+
+        /**
+         * Get the number of invocations that are queued or being executed.
+         *
+         * @return  The number of pending invocations.
+         */
+        std::size_t pending();
+
+
+        /**
+         * Change the maximum number of invocations that are executed in parallel. Additional
+         * threads are started when needed, superfluous threads stop when they are idle.
+         *
+         * @param noOfThreads   The new maximum number of threads.
+         */
+        void setNoOfThreads(uint32_t noOfThreads);
+
+
+        /**
+         * Stop all threads (after their running invocations are finished), and cancel the queued
+         * invocations. Invocations that are enqueued afterwards are cancelled immediately.
+         */
+        void stop();
+
+
+    private:
+
+
+        DISALLOW_COPY_AND_ASSIGN(AsyncServiceWorker);
+
+
+        // a thread of the worker
+        class WorkerThread : public UaThread
+        {
+        public:
+            WorkerThread(AsyncServiceWorker* worker) : worker_(worker) {}
+            void run() { worker_->work(); }
+        private:
+            AsyncServiceWorker* worker_;
+        };
+
+
+        // the loop of each thread
+        void work();
+
+        // start threads until there are noOfThreads_ running (not locked!)
+        void startThreads();
+
+
+        typedef std::deque<uaf::DeferredInvocation*> Queue;
+        typedef std::vector<WorkerThread*>           Threads;
+
+        uint32_t    noOfThreads_;
+        uint32_t    noOfLiveThreads_;
+        Threads     threads_;
+        Queue       queue_;
+        std::size_t running_;
+        bool        stopping_;
+        UaMutex     mutex_;
+        UaSemaphore semaphore_;
+        // the threads waiting in clear() until no invocations are running anymore
+        uint32_t    idleWaiters_;
+        UaSemaphore idleSemaphore_;
+    };
+
+}
+
+
+#endif /* UAF_ASYNCSERVICEWORKER_H_ */
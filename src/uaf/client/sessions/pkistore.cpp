@@ -0,0 +1,362 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/sessions/pkistore.h"
+
+// STD
+#include <sys/types.h>
+#include <sys/stat.h>
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::map;
+
+
+    // the minimum time between two checks of the modification times of the PKI files
+    static const int32_t CHECK_INTERVAL_MS = 1000;
+
+
+    // Compare the locations
+    // =============================================================================================
+    bool PkiStore::Locations::operator==(const Locations& other) const
+    {
+        return certificateRevocationListLocation == other.certificateRevocationListLocation
+            && certificateTrustListLocation == other.certificateTrustListLocation
+            && issuersRevocationListLocation == other.issuersRevocationListLocation
+            && issuersCertificatesLocation == other.issuersCertificatesLocation
+            && clientCertificate == other.clientCertificate
+            && clientPrivateKey == other.clientPrivateKey
+            && createSecurityLocationsIfNeeded == other.createSecurityLocationsIfNeeded;
+    }
+
+
+    // Constructor
+    // =============================================================================================
+    PkiStore::PkiStore(LoggerFactory* loggerFactory, Database* database)
+    : database_(database),
+      pkiLoaded_(false),
+      clientCertificateLoaded_(false)
+    {
+        logger_ = new Logger(loggerFactory, "PkiStore");
+        locations_.createSecurityLocationsIfNeeded = false;
+        logger_->debug("The PkiStore has been constructed");
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    PkiStore::~PkiStore()
+    {
+        logger_->debug("Destructing the PkiStore");
+        delete logger_;
+        logger_ = 0;
+    }
+
+
+    // Initialize the PKI provider of a session
+    // =============================================================================================
+    Status PkiStore::initializePkiProvider(UaClientSdk::SessionSecurityInfo& uaSecurity)
+    {
+        UaMutexLocker locker(&mutex_);
+
+        refreshIfNeeded();
+
+        if (!pkiLoaded_)
+        {
+            logger_->debug("Initializing the PKI store");
+
+            const Locations& loc = locations_;
+            bool checkOnly = !loc.createSecurityLocationsIfNeeded;
+
+            pkiSecurityInfo_ = UaClientSdk::SessionSecurityInfo();
+
+            pkiStatus_ = checkOrCreatePath(
+                    checkOnly,
+                    loc.certificateRevocationListLocation,
+                    "certificate revocation list location");
+
+            if (pkiStatus_.isGood())
+                pkiStatus_ = checkOrCreatePath(
+                        checkOnly,
+                        loc.certificateTrustListLocation,
+                        "certificate trust list location");
+
+            if (pkiStatus_.isGood())
+                pkiStatus_ = checkOrCreatePath(
+                        checkOnly,
+                        loc.issuersRevocationListLocation,
+                        "issuers revocation trust list location");
+
+            if (pkiStatus_.isGood())
+                pkiStatus_ = checkOrCreatePath(
+                        checkOnly,
+                        loc.issuersCertificatesLocation,
+                        "issuers certificates location");
+
+            if (pkiStatus_.isGood())
+            {
+                logger_->debug("Now initializing the OpenSSL PKI store via the SDK");
+                SdkStatus sdkStatus = pkiSecurityInfo_.initializePkiProviderOpenSSL(
+                        UaString(loc.certificateRevocationListLocation.c_str()),
+                        UaString(loc.certificateTrustListLocation.c_str()),
+                        UaString(loc.issuersRevocationListLocation.c_str()),
+                        UaString(loc.issuersCertificatesLocation.c_str()));
+
+                if (sdkStatus.isGood())
+                    logger_->debug("The OpenSSL PKI store was initialized successfully");
+                else
+                    pkiStatus_ = OpenSSLStoreInitializationError(sdkStatus);
+            }
+
+            if (pkiStatus_.isGood())
+                logger_->debug("The PKI store has been initialized");
+            else
+                logger_->error(pkiStatus_.toString());
+
+            // the paths may have been created just now
+            modificationTimes_ = modificationTimes(locations_);
+            pkiLoaded_ = true;
+        }
+
+        if (pkiStatus_.isGood())
+            uaSecurity = pkiSecurityInfo_;
+
+        return pkiStatus_;
+    }
+
+
+    // Load the client certificate of a session
+    // =============================================================================================
+    Status PkiStore::loadClientCertificate(UaClientSdk::SessionSecurityInfo& uaSecurity)
+    {
+        UaMutexLocker locker(&mutex_);
+
+        refreshIfNeeded();
+
+        if (!clientCertificateLoaded_)
+        {
+            logger_->debug("Loading the client certificate and private key");
+
+            const bool checkOnly = true;
+
+            // start from the PKI provider of the session
+            clientSecurityInfo_ = uaSecurity;
+
+            clientCertificateStatus_ = checkOrCreatePath(
+                    checkOnly, locations_.clientCertificate, "client certificate");
+
+            if (clientCertificateStatus_.isGood())
+                clientCertificateStatus_ = checkOrCreatePath(
+                        checkOnly, locations_.clientPrivateKey, "client private key");
+
+            if (clientCertificateStatus_.isGood())
+            {
+                logger_->debug("Now loading the client certificate via the SDK");
+                SdkStatus sdkStatus = clientSecurityInfo_.loadClientCertificateOpenSSL(
+                        UaString(locations_.clientCertificate.c_str()),
+                        UaString(locations_.clientPrivateKey.c_str()));
+
+                if (sdkStatus.isGood())
+                    logger_->debug("The client certificate was loaded successfully (%s)",
+                                   sdkStatus.toString().c_str());
+                else
+                    clientCertificateStatus_ = ClientCertificateLoadingError(sdkStatus);
+            }
+
+            if (clientCertificateStatus_.isGood())
+                logger_->debug("The client certificate and private key are loaded");
+            else
+                logger_->error(clientCertificateStatus_.toString());
+
+            clientCertificateLoaded_ = true;
+        }
+
+        if (clientCertificateStatus_.isGood())
+        {
+            // copy the loaded certificate and key, but keep the server certificate (and the way
+            // it must be verified) of the session
+            UaByteString serverCertificate = uaSecurity.serverCertificate;
+            bool doServerCertificateVerify = uaSecurity.doServerCertificateVerify ? true : false;
+
+            uaSecurity = clientSecurityInfo_;
+
+            uaSecurity.serverCertificate = serverCertificate;
+            uaSecurity.doServerCertificateVerify = doServerCertificateVerify;
+        }
+
+        return clientCertificateStatus_;
+    }
+
+
+    // Check if a server certificate was verified before
+    // =============================================================================================
+    bool PkiStore::isTrusted(const PkiCertificate& certificate)
+    {
+        UaMutexLocker locker(&mutex_);
+
+        refreshIfNeeded();
+
+        TrustedCertificates::iterator it = trustedCertificates_.find(certificate.thumbPrint());
+
+        if (it == trustedCertificates_.end())
+            return false;
+
+        // an expired certificate must be verified again (so that it gets rejected)
+        if (DateTime::now().msecsTo(it->second) <= 0)
+        {
+            trustedCertificates_.erase(it);
+            return false;
+        }
+
+        return true;
+    }
+
+
+    // Remember a verified server certificate
+    // =============================================================================================
+    void PkiStore::addTrusted(const PkiCertificate& certificate)
+    {
+        UaMutexLocker locker(&mutex_);
+        trustedCertificates_[certificate.thumbPrint()] = certificate.validTo();
+    }
+
+
+    // Forget the loaded material if needed
+    // =============================================================================================
+    void PkiStore::refreshIfNeeded()
+    {
+        const ClientSettings& settings = database_->clientSettings;
+
+        Locations locations;
+        locations.certificateRevocationListLocation = settings.certificateRevocationListLocation;
+        locations.certificateTrustListLocation      = settings.certificateTrustListLocation;
+        locations.issuersRevocationListLocation     = settings.issuersRevocationListLocation;
+        locations.issuersCertificatesLocation       = settings.issuersCertificatesLocation;
+        locations.clientCertificate                 = settings.clientCertificate;
+        locations.clientPrivateKey                  = settings.clientPrivateKey;
+        locations.createSecurityLocationsIfNeeded   = settings.createSecurityLocationsIfNeeded;
+
+        bool changed = false;
+
+        if (!(locations == locations_))
+        {
+            logger_->debug("The security locations of the ClientSettings have changed");
+            locations_ = locations;
+            changed = true;
+        }
+        else if (lastCheckTime_.isNull()
+                || lastCheckTime_.msecsTo(DateTime::now()) >= CHECK_INTERVAL_MS)
+        {
+            // a certificate may have been added to (or removed from) the trust lists,
+            // or the client certificate may have been renewed
+            if (modificationTimes(locations_) != modificationTimes_)
+            {
+                logger_->debug("The PKI files have been modified");
+                changed = true;
+            }
+        }
+        else
+        {
+            return;
+        }
+
+        lastCheckTime_ = DateTime::now();
+
+        if (changed)
+        {
+            logger_->debug("The PKI store and client certificate will be loaded again");
+            modificationTimes_ = modificationTimes(locations_);
+            pkiLoaded_ = false;
+            clientCertificateLoaded_ = false;
+            trustedCertificates_.clear();
+        }
+    }
+
+
+    // Get the modification times
+    // =============================================================================================
+    PkiStore::ModificationTimes PkiStore::modificationTimes(const Locations& locations) const
+    {
+        string paths[] = { locations.certificateRevocationListLocation,
+                           locations.certificateTrustListLocation,
+                           locations.issuersRevocationListLocation,
+                           locations.issuersCertificatesLocation,
+                           locations.clientCertificate,
+                           locations.clientPrivateKey };
+
+        ModificationTimes times;
+
+        for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++)
+        {
+            // a path that doesn't exist (yet) gets time 0
+            struct stat info;
+            if (stat(paths[i].c_str(), &info) == 0)
+                times[paths[i]] = info.st_mtime;
+            else
+                times[paths[i]] = 0;
+        }
+
+        return times;
+    }
+
+
+    // Check or create a path
+    // =============================================================================================
+    Status PkiStore::checkOrCreatePath(
+            bool checkOnly, const string& path, const string& description) const
+    {
+        Status ret;
+
+        logger_->debug("Checking %s: %s", description.c_str(), path.c_str());
+        UaDir helperDir(UaUniString(""));
+        if (helperDir.exists(UaUniString(path.c_str())))
+        {
+            ret = statuscodes::Good;
+            logger_->debug("OK, the %s exists", description.c_str());
+        }
+        else
+        {
+            if (checkOnly)
+            {
+                ret = PathNotExistsError(path, description);
+                logger_->error(ret.toString());
+            }
+            else
+            {
+                logger_->debug("The path does not exist so we try to create it");
+                if (helperDir.mkpath(UaUniString(path.c_str())))
+                {
+                    ret = statuscodes::Good;
+                    logger_->debug("The %s has been created", path.c_str());
+                }
+                else
+                {
+                    ret = PathCreationError(path, description);
+                    logger_->error(ret.toString());
+                }
+            }
+        }
+
+        return ret;
+    }
+}
@@ -0,0 +1,199 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_PKISTORE_H_
+#define UAF_PKISTORE_H_
+
+
+// STD
+#include <map>
+#include <string>
+#include <ctime>
+// SDK
+#include "uabase/uamutex.h"
+#include "uabase/uadir.h"
+#include "uaclient/uaclientsdk.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/logger.h"
+#include "uaf/util/status.h"
+#include "uaf/util/sdkstatus.h"
+#include "uaf/util/bytestring.h"
+#include "uaf/util/datetime.h"
+#include "uaf/util/pkicertificate.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/database/database.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::PkiStore holds the PKI material (the OpenSSL PKI provider configuration, and the client
+    * certificate and private key) that is shared by all sessions of a client.
+    *
+    * The material is loaded from disk only once, and it is loaded again only when the
+    * security locations of the ClientSettings are changed, or when the modification time of one
+    * of these locations (or of the client certificate or private key files) has changed.
+    *
+    * The server certificates that were verified successfully are remembered by their thumbprint
+    * (until they expire, or until the trust lists change), so that reconnecting sessions don't
+    * have to read the trust lists again.
+    *
+    * @ingroup ClientSessions
+    ***********************************************************************************************/
+    class UAF_EXPORT PkiStore
+    {
+    public:
+
+
+        /**
+         * Construct a PKI store.
+         *
+         * @param loggerFactory     Logger factory to log all messages to.
+         * @param database          Client database to use (for the ClientSettings).
+         */
+        PkiStore(uaf::LoggerFactory* loggerFactory, uaf::Database* database);
+
+
+        /**
+         * Destruct the PKI store.
+         */
+        virtual ~PkiStore();
+
+
+        /**
+         * Initialize the PKI provider of the given SDK security info.
+         *
+         * @param uaSecurity    The security info of a session.
+         * @return              Good if the PKI provider could be initialized.
+         */
+        uaf::Status initializePkiProvider(UaClientSdk::SessionSecurityInfo& uaSecurity);
+
+
+        /**
+         * Load the client certificate and private key into the given SDK security info (which
+         * must have been initialized by initializePkiProvider() before).
+         *
+         * The server certificate of the security info is left untouched.
+         *
+         * @param uaSecurity    The security info of a session.
+         * @return              Good if the client certificate and private key could be loaded.
+         */
+        uaf::Status loadClientCertificate(UaClientSdk::SessionSecurityInfo& uaSecurity);
+
+
+        /**
+         * Check if the given server certificate was verified successfully before.
+         *
+         * @param certificate   The server certificate.
+         * @return              True if the certificate is trusted (and not expired).
+         */
+        bool isTrusted(const uaf::PkiCertificate& certificate);
+
+
+        /**
+         * Remember that the given server certificate was verified successfully.
+         *
+         * @param certificate   The server certificate.
+         */
+        void addTrusted(const uaf::PkiCertificate& certificate);
+
+
+    private:
+        DISALLOW_COPY_AND_ASSIGN(PkiStore);
+
+
+        // the locations and files the PKI material is loaded from
+        struct Locations
+        {
+            std::string certificateRevocationListLocation;
+            std::string certificateTrustListLocation;
+            std::string issuersRevocationListLocation;
+            std::string issuersCertificatesLocation;
+            std::string clientCertificate;
+            std::string clientPrivateKey;
+            bool        createSecurityLocationsIfNeeded;
+
+            bool operator==(const Locations& other) const;
+        };
+
+        // the modification times of the locations and files, per path
+        typedef std::map<std::string, time_t> ModificationTimes;
+
+        // the expiry times of the trusted server certificates, per thumbprint
+        typedef std::map<uaf::ByteString, uaf::DateTime> TrustedCertificates;
+
+
+        /**
+         * Forget the loaded material if the ClientSettings or the files on disk have changed
+         * (the mutex must be locked).
+         */
+        void refreshIfNeeded();
+
+
+        /**
+         * Get the current modification times of the locations and files.
+         */
+        ModificationTimes modificationTimes(const Locations& locations) const;
+
+
+        /**
+         * Helper function to check if a path exists, or create the path if needed.
+         */
+        uaf::Status checkOrCreatePath(
+                bool checkOnly,
+                const std::string& path,
+                const std::string& description) const;
+
+
+        // the logger of the PKI store
+        uaf::Logger* logger_;
+        // the client database
+        uaf::Database* database_;
+
+        // the locations of the loaded material, and their modification times
+        Locations           locations_;
+        ModificationTimes   modificationTimes_;
+        // the time when the modification times were last checked
+        uaf::DateTime       lastCheckTime_;
+
+        // the security info with only the PKI provider initialized, and its status
+        UaClientSdk::SessionSecurityInfo    pkiSecurityInfo_;
+        bool                                pkiLoaded_;
+        uaf::Status                         pkiStatus_;
+
+        // the security info with also the client certificate loaded, and its status
+        UaClientSdk::SessionSecurityInfo    clientSecurityInfo_;
+        bool                                clientCertificateLoaded_;
+        uaf::Status                         clientCertificateStatus_;
+
+        // the server certificates that were verified successfully
+        TrustedCertificates trustedCertificates_;
+
+        // mutex to safely access the above state
+        UaMutex mutex_;
+    };
+
+}
+
+
+#endif /* UAF_PKISTORE_H_ */
@@ -30,6 +30,28 @@ namespace uaf
     using std::pair;
 
 
+    // Can a failed connection attempt be caused by outdated endpoint descriptions?
+    // =============================================================================================
+    static bool isEndpointMismatch(uint32_t statusCode)
+    {
+        switch (statusCode)
+        {
+            case OpcUa_BadSecurityChecksFailed:
+            case OpcUa_BadSecurityPolicyRejected:
+            case OpcUa_BadSecurityModeRejected:
+            case OpcUa_BadCertificateInvalid:
+            case OpcUa_BadCertificateUriInvalid:
+            case OpcUa_BadCertificateHostNameInvalid:
+            case OpcUa_BadCertificateTimeInvalid:
+            case OpcUa_BadTcpEndpointUrlInvalid:
+            case OpcUa_BadServerUriInvalid:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+
     // Constructor
     // =============================================================================================
     Session::Session(
@@ -40,16 +62,19 @@ namespace uaf
             UaClientSdk::UaSessionCallback* uaSessionCallback,
             ClientInterface*                clientInterface,
             Discoverer*                     discoverer,
+            PkiStore*                       pkiStore,
             Database*                       database)
     : uaSessionCallback_(uaSessionCallback),
       sessionState_(uaf::sessionstates::Disconnected),
       lastConnectionAttemptStep_(connectionsteps::NoAttemptYet),
+      failedConnectionAttempts_(0),
       clientConnectionId_(clientConnectionId),
       serverUri_(serverUri),
       sessionSettings_(sessionSettings),
       database_(database),
       clientInterface_(clientInterface),
-      discoverer_(discoverer)
+      discoverer_(discoverer),
+      pkiStore_(pkiStore)
     {
         // build the logger name:
         stringstream loggerName;
@@ -65,7 +90,8 @@ namespace uaf
                 clientConnectionId,
                 uaSession_,
                 clientInterface_,
-                database);
+                database,
+                sessionSettings_);
 
         updateConnectionInfo(uaSessionConnectInfo_, clientConnectionId, true);
         updateConnectionInfo(uaSessionConnectInfoNoInitialRetry_, clientConnectionId, false);
@@ -126,68 +152,26 @@ namespace uaf
     }
 
 
-    // Initialize the PKI store
+    // Update the publish request count of the connection info
     // =============================================================================================
-    Status Session::initializePkiStore(UaClientSdk::SessionSecurityInfo& uaSecurity)
+    void Session::updatePublishRequestCount(UaClientSdk::SessionConnectInfo& info)
     {
-        Status ret;
-        logger_->debug("Initializing the PKI store");
-
-        string certificateRevocationListLocation = \
-                database_->clientSettings.certificateRevocationListLocation;
-        string certificateTrustListLocation = \
-                database_->clientSettings.certificateTrustListLocation;
-        string issuersRevocationListLocation = \
-                database_->clientSettings.issuersRevocationListLocation;
-        string issuersCertificatesLocation = \
-                database_->clientSettings.issuersCertificatesLocation;
-
-        bool checkOnly = !(database_->clientSettings.createSecurityLocationsIfNeeded);
+        // 0 means that the SDK decides (based on the number of subscriptions)
+        uint32_t publishRequestCount = subscriptionFactory_->publishRequestCount();
+        if (publishRequestCount > 0)
+            info.nMaxPublishRequestCount = publishRequestCount;
 
-        ret = checkOrCreatePath(
-                checkOnly,
-                certificateRevocationListLocation,
-                "certificate revocation list location");
-
-        if (ret.isGood())
-            ret = checkOrCreatePath(
-                    checkOnly,
-                    certificateTrustListLocation,
-                    "certificate trust list location");
-
-        if (ret.isGood())
-            ret = checkOrCreatePath(
-                    checkOnly,
-                    issuersRevocationListLocation,
-                    "issuers revocation trust list location");
-
-        if (ret.isGood())
-            ret = checkOrCreatePath(
-                    checkOnly,
-                    issuersCertificatesLocation,
-                    "issuers certificates location");
-
-        if (ret.isGood())
-        {
-            logger_->debug("Now initializing the OpenSSL PKI store via the SDK");
-            SdkStatus sdkStatus = uaSecurity.initializePkiProviderOpenSSL(
-                    UaString(certificateRevocationListLocation.c_str()),
-                    UaString(certificateTrustListLocation.c_str()),
-                    UaString(issuersRevocationListLocation.c_str()),
-                    UaString(issuersCertificatesLocation.c_str()));
-
-            if (sdkStatus.isGood())
-                logger_->debug("The OpenSSL PKI store was initialized successfully");
-            else
-                ret = OpenSSLStoreInitializationError(sdkStatus);
-        }
+        // the subscriptions report the count that is actually in use
+        subscriptionFactory_->setEffectivePublishRequestCount(publishRequestCount);
+    }
 
-        if (ret.isGood())
-            logger_->debug("The PKI store has been initialized");
-        else
-            logger_->error(ret.toString());
 
-        return ret;
+    // Initialize the PKI store
+    // =============================================================================================
+    Status Session::initializePkiStore(UaClientSdk::SessionSecurityInfo& uaSecurity)
+    {
+        logger_->debug("Initializing the PKI store");
+        return pkiStore_->initializePkiProvider(uaSecurity);
     }
 
 
@@ -196,37 +180,7 @@ namespace uaf
     Status Session::loadClientCertificate(UaClientSdk::SessionSecurityInfo& uaSecurity)
     {
         logger_->debug("Loading the client certificate and private key");
-
-        string clientCertificate = database_->clientSettings.clientCertificate;
-        string clientPrivateKey = database_->clientSettings.clientPrivateKey;
-
-        const bool checkOnly = true;
-
-        Status ret = checkOrCreatePath(checkOnly, clientCertificate, "client certificate");
-
-        if (ret.isGood())
-            ret = checkOrCreatePath(checkOnly, clientPrivateKey, "client private key");
-
-        if (ret.isGood())
-        {
-            logger_->debug("Now loading the client certificate via the SDK");
-            SdkStatus sdkStatus = uaSecurity.loadClientCertificateOpenSSL(
-                    UaString(clientCertificate.c_str()),
-                    UaString(clientPrivateKey.c_str()));
-
-            if (sdkStatus.isGood())
-                logger_->debug("The client certificate was loaded successfully (%s)",
-                               sdkStatus.toString().c_str());
-            else
-                ret = ClientCertificateLoadingError(sdkStatus);
-        }
-
-        if (ret.isGood())
-            logger_->debug("The client certificate and private key are loaded");
-        else
-            logger_->error(ret.toString());
-
-        return ret;
+        return pkiStore_->loadClientCertificate(uaSecurity);
     }
 
 
@@ -356,57 +310,68 @@ namespace uaf
 
         logger_->debug("Now verifying the server certificate");
 
-        SdkStatus trustStatus(uaSecurity.verifyServerCertificate());
+        ByteString bs;
+        bs.fromSdk(uaSecurity.serverCertificate);
+        PkiCertificate cert = PkiCertificate::fromDER(bs);
 
-        if (trustStatus.isGood())
+        // a certificate that was verified before doesn't need the trust lists to be read again
+        if (pkiStore_->isTrusted(cert))
         {
-            logger_->debug("The server certificate is trusted");
+            logger_->debug("The server certificate was verified before, so it is trusted");
+            uaSecurity.doServerCertificateVerify = false;
             ret = statuscodes::Good;
         }
         else
         {
-            logger_->debug("The server certificate is NOT trusted");
-            logger_->debug("Therefore we call the untrustedServerCertificateReceived(...) callback:");
-
-            ByteString bs;
-            bs.fromSdk(uaSecurity.serverCertificate);
-            PkiCertificate cert = PkiCertificate::fromDER(bs);
+            SdkStatus trustStatus(uaSecurity.verifyServerCertificate());
 
-            PkiCertificate::Action action;
-            action = clientInterface_->untrustedServerCertificateReceived(cert, trustStatus);
-
-            if (action == PkiCertificate::Action_Reject)
-            {
-                logger_->debug("The server certificate was rejected by the user");
-                ret = ServerCertificateRejectedByUserError();
-            }
-            else if (action == PkiCertificate::Action_AcceptTemporarily)
+            if (trustStatus.isGood())
             {
-                logger_->debug("The server certificate was accepted temporarily by the user");
-                uaSecurity.doServerCertificateVerify = false;
+                logger_->debug("The server certificate is trusted");
+                pkiStore_->addTrusted(cert);
                 ret = statuscodes::Good;
             }
-            else if (action == PkiCertificate::Action_AcceptPermanently)
+            else
             {
-                logger_->debug("The server certificate was accepted permanently by the user");
-                logger_->debug("We therefore try to store the certificate first");
-                UaPkiCertificate uaCert = UaPkiCertificate::fromDER(uaSecurity.serverCertificate);
-                UaString uaThumbprint = uaCert.thumbPrint().toHex();
-
-                logger_->debug("Name of the certificate (thumbprint): %s", uaThumbprint.toUtf8());
+                logger_->debug("The server certificate is NOT trusted");
+                logger_->debug("Therefore we call the untrustedServerCertificateReceived(...) callback:");
 
-                SdkStatus savingStatus = uaSecurity.saveServerCertificate(uaThumbprint);
+                PkiCertificate::Action action;
+                action = clientInterface_->untrustedServerCertificateReceived(cert, trustStatus);
 
-                if (savingStatus.isGood())
+                if (action == PkiCertificate::Action_Reject)
                 {
-                    logger_->debug("Certificate %s was stored", uaThumbprint.toUtf8());
+                    logger_->debug("The server certificate was rejected by the user");
+                    ret = ServerCertificateRejectedByUserError();
+                }
+                else if (action == PkiCertificate::Action_AcceptTemporarily)
+                {
+                    logger_->debug("The server certificate was accepted temporarily by the user");
+                    uaSecurity.doServerCertificateVerify = false;
                     ret = statuscodes::Good;
                 }
-                else
+                else if (action == PkiCertificate::Action_AcceptPermanently)
                 {
-                    ret = ServerCertificateSavingError(savingStatus);
+                    logger_->debug("The server certificate was accepted permanently by the user");
+                    logger_->debug("We therefore try to store the certificate first");
+                    UaPkiCertificate uaCert = UaPkiCertificate::fromDER(uaSecurity.serverCertificate);
+                    UaString uaThumbprint = uaCert.thumbPrint().toHex();
+
+                    logger_->debug("Name of the certificate (thumbprint): %s", uaThumbprint.toUtf8());
+
+                    SdkStatus savingStatus = uaSecurity.saveServerCertificate(uaThumbprint);
+
+                    if (savingStatus.isGood())
+                    {
+                        logger_->debug("Certificate %s was stored", uaThumbprint.toUtf8());
+                        ret = statuscodes::Good;
+                    }
+                    else
+                    {
+                        ret = ServerCertificateSavingError(savingStatus);
+                    }
+                    uaSecurity.doServerCertificateVerify = true;
                 }
-                uaSecurity.doServerCertificateVerify = true;
             }
         }
 
@@ -417,10 +382,34 @@ namespace uaf
     // Connect the session
     // =============================================================================================
     Status Session::connect()
+    {
+        bool endpointMismatch;
+        Status ret = connect(true, endpointMismatch);
+
+        // the cached endpoints may be outdated (e.g. the server certificate may have been renewed),
+        // so refresh them and try once more
+        if (ret.isNotGood() && endpointMismatch)
+        {
+            logger_->debug("The cached endpoints may be outdated, so we refresh them and retry");
+            ret = connect(false, endpointMismatch);
+        }
+
+        return ret;
+    }
+
+
+    // Connect the session, using the cached endpoints or not
+    // =============================================================================================
+    Status Session::connect(bool useCachedEndpoints, bool& endpointMismatch)
     {
         Status ret;
         logger_->debug("Connecting the session");
 
+        endpointMismatch = false;
+
+        // true if at least one of the endpoint descriptions was taken from the cache
+        bool endpointsFromCache = false;
+
         // reset the last connection attempt step and status
         lastConnectionAttemptStep_ = connectionsteps::NoAttemptYet;
         lastConnectionAttemptStatus_ = statuscodes::Uncertain;
@@ -441,7 +430,14 @@ namespace uaf
              ++it)
         {
             vector<EndpointDescription> tmp;
-            ret = discoverer_->getEndpoints(*it, tmp);
+            bool fromCache = false;
+
+            if (useCachedEndpoints)
+                ret = discoverer_->getCachedEndpoints(*it, tmp, fromCache);
+            else
+                ret = discoverer_->getEndpoints(*it, tmp);
+
+            endpointsFromCache = endpointsFromCache || fromCache;
 
             if (ret.isGood())
                 discoveredEndpoints.insert(discoveredEndpoints.end(), tmp.begin(), tmp.end());
@@ -481,6 +477,10 @@ namespace uaf
         if (ret.isGood())
             ret = verifyServerCertificate(uaSecurity);
 
+        // if the cached endpoints could not be used, they may be outdated
+        if (ret.isNotGood() && endpointsFromCache && discoveredEndpoints.size() > 0)
+            endpointMismatch = true;
+
         // only load the client certificate if we need to sign or encrypt the data!
         if (ret.isGood())
         {
@@ -505,6 +505,9 @@ namespace uaf
         {
             logger_->debug("Now connecting the session at the SDK level");
 
+            // the subscriptions report the publish request count given to the SDK
+            updatePublishRequestCount(uaSessionConnectInfo_);
+
             SdkStatus sdkStatus = uaSession_->connect(
                     suitableEndpoint.endpointUrl.c_str(),
                     uaSessionConnectInfo_,//uaSessionConnectInfo_, uaSessionConnectInfoNoInitialRetry_
@@ -520,6 +523,7 @@ namespace uaf
             else
             {
                 ret = ConnectionFailedError(suitableEndpoint.endpointUrl, sdkStatus);
+                endpointMismatch = endpointsFromCache && isEndpointMismatch(sdkStatus.statusCode);
             }
         }
 
@@ -601,6 +605,9 @@ namespace uaf
         {
             logger_->debug("Now connecting the session at the SDK level");
 
+            // the subscriptions report the publish request count given to the SDK
+            updatePublishRequestCount(uaSessionConnectInfoNoInitialRetry_);
+
             SdkStatus sdkStatus = uaSession_->connect(
                     endpointUrl.c_str(),
                     uaSessionConnectInfoNoInitialRetry_,
@@ -636,6 +643,30 @@ namespace uaf
     }
 
 
+    // Start the first connection attempt
+    // =============================================================================================
+    void Session::startFirstConnectionAttempt()
+    {
+        firstConnectionAttemptMutex_.lock();
+    }
+
+
+    // Finish the first connection attempt
+    // =============================================================================================
+    void Session::finishFirstConnectionAttempt()
+    {
+        firstConnectionAttemptMutex_.unlock();
+    }
+
+
+    // Wait for the first connection attempt
+    // =============================================================================================
+    void Session::waitForFirstConnectionAttempt()
+    {
+        UaMutexLocker locker(&firstConnectionAttemptMutex_);
+    }
+
+
     // Disconnect the session
     // =============================================================================================
     Status Session::disconnect()
@@ -687,12 +718,25 @@ namespace uaf
                 sessionSettings_,
                 lastConnectionAttemptStep_,
                 lastConnectionAttemptStatus_);
+        info.nextConnectionAttemptTime = nextConnectionAttemptTime_;
+        info.failedConnectionAttempts  = failedConnectionAttempts_;
         logger_->debug("Fetching session information:");
         logger_->debug(info.toString());
         return info;
     }
 
 
+    // Set the reconnection backoff
+    // =============================================================================================
+    void Session::setConnectionBackoff(
+            const DateTime& nextConnectionAttemptTime,
+            uint32_t        failedConnectionAttempts)
+    {
+        nextConnectionAttemptTime_ = nextConnectionAttemptTime;
+        failedConnectionAttempts_  = failedConnectionAttempts;
+    }
+
+
     // Check if the session is established
     // =============================================================================================
     bool Session::isConnected() const
@@ -812,6 +856,13 @@ namespace uaf
                     logger_->debug(namespaceArray_.toString());
                 }
 
+                // the cached structure definitions of this server are only valid as long as
+                // the namespace indexes didn't change
+                if (namespaceArrayStatus.isGood())
+                    database_->structureDefinitionCache.updateNamespaceArray(
+                            serverUri_,
+                            namespaceArray_.toString());
+
                 // update the return status
                 if (serverArrayStatus.isBad())
                     ret = serverArrayStatus;
@@ -854,6 +905,22 @@ namespace uaf
     }
 
 
+    // Check if there are subscriptions to transfer
+    // =============================================================================================
+    bool Session::hasSubscriptionsToTransfer()
+    {
+        return subscriptionFactory_->hasSubscriptionsToTransfer();
+    }
+
+
+    // Transfer the subscriptions to the new session
+    // =============================================================================================
+    bool Session::transferSubscriptions()
+    {
+        return subscriptionFactory_->transferSubscriptions();
+    }
+
+
     // Get information about all subscriptions
     // =============================================================================================
     vector<SubscriptionInformation> Session::allSubscriptionInformations()
@@ -971,6 +1038,22 @@ namespace uaf
     }
 
 
+    // Modify the monitored items
+    // =============================================================================================
+    Status Session::modifyMonitoredItemsIfNeeded(
+            const vector<ClientHandle>&             clientHandles,
+            const vector<MonitoredItemSettings>&    settings,
+            const ServiceSettings*                  serviceSettings,
+            vector<Status>&                         results)
+    {
+        return subscriptionFactory_->modifyMonitoredItemsIfNeeded(clientHandles,
+                                                                  settings,
+                                                                  serviceSettings,
+                                                                  namespaceArray_,
+                                                                  results);
+    }
+
+
     // Get a structure definition
     // =============================================================================================
     Status Session::structureDefinition(
@@ -979,59 +1062,190 @@ namespace uaf
     {
         Status ret;
 
-        UaNodeId uaNodeId;
-        UaStructureDefinition uaDef;
+        NodeId key;
+
+        if (!structureDefinitionKey(dataTypeId, key))
+        {
+            // the namespace of the DataType is not known by this server
+            ret = DefinitionNotFoundError();
+        }
+        else if (database_->structureDefinitionCache.find(serverUri_, key, definition))
+        {
+            logger_->debug("The definition of %s was found in the cache",
+                           dataTypeId.toString().c_str());
+            ret = uaf::statuscodes::Good;
+        }
+        else
+        {
+            UaNodeId uaNodeId;
+            UaStructureDefinition uaDef;
 
-        dataTypeId.toSdk(uaNodeId);
+            key.toSdk(uaNodeId);
 
-        uaDef = uaSession_->structureDefinition(uaNodeId);
+            uaDef = uaSession_->structureDefinition(uaNodeId);
 
-        definition.fromSdk(uaDef);
+            definition.fromSdk(uaDef);
 
-        if (definition.isNull())
-        	ret = DefinitionNotFoundError();
-        else
-        	ret = uaf::statuscodes::Good;
+            if (definition.isNull())
+            {
+                ret = DefinitionNotFoundError();
+            }
+            else
+            {
+                database_->structureDefinitionCache.add(serverUri_, key, definition);
+                ret = uaf::statuscodes::Good;
+            }
+        }
 
         return ret;
     }
 
 
-    // Set the publishing mode.
+    // Get the key of a structure definition in the cache
     // =============================================================================================
-    Status Session::checkOrCreatePath(
-            bool checkOnly, const string& path, const string& description) const
+    bool Session::structureDefinitionKey(const NodeId& dataTypeId, NodeId& key) const
     {
+        bool found = true;
+        NameSpaceIndex nameSpaceIndex = dataTypeId.nameSpaceIndex();
+
+        // the cache only knows the namespace indexes of this server
+        if (dataTypeId.hasNameSpaceUri())
+            found = namespaceArray_.findNamespaceIndex(dataTypeId.nameSpaceUri(), nameSpaceIndex);
+
+        if (found)
+            key = NodeId(dataTypeId.identifier(), nameSpaceIndex);
+
+        return found;
+    }
+
+
+    // Fetch the definitions of all structured DataTypes of the server
+    // =============================================================================================
+    Status Session::prefetchStructureDefinitions()
+    {
+        logger_->debug("Prefetching the structure definitions");
+
         Status ret;
 
-        logger_->debug("Checking %s: %s", description.c_str(), path.c_str());
-        UaDir helperDir(UaUniString(""));
-        if (helperDir.exists(UaUniString(path.c_str())))
+        if (!isConnected())
         {
-            ret = statuscodes::Good;
-            logger_->debug("OK, the %s exists", description.c_str());
+            ret = SessionNotConnectedError();
         }
         else
         {
-            if (checkOnly)
-            {
-                ret = PathNotExistsError(path, description);
-                logger_->error(ret.toString());
-            }
-            else
+            ret = statuscodes::Good;
+
+            UaClientSdk::ServiceSettings uaServiceSettings;
+            sessionSettings_.readServerInfoSettings.toSdk(uaServiceSettings);
+
+            OpcUa_ViewDescription uaViewDescription;
+            OpcUa_ViewDescription_Initialize(&uaViewDescription);
+
+            // browse the subtypes of Structure, level by level
+            vector<UaNodeId> level(1, UaNodeId(OpcUaId_Structure));
+            vector<UaNodeId> dataTypeIds;
+
+            while (!level.empty() && ret.isGood())
             {
-                logger_->debug("The path does not exist so we try to create it");
-                if (helperDir.mkpath(UaUniString(path.c_str())))
+                UaBrowseDescriptions uaBrowseDescriptions;
+                UaBrowseResults      uaBrowseResults;
+                UaDiagnosticInfos    uaDiagnosticInfos;
+
+                uaBrowseDescriptions.create(level.size());
+                for (size_t i = 0; i < level.size(); i++)
                 {
-                    ret = statuscodes::Good;
-                    logger_->debug("The %s has been created", path.c_str());
+                    level[i].copyTo(&uaBrowseDescriptions[i].NodeId);
+                    UaNodeId(OpcUaId_HasSubtype).copyTo(&uaBrowseDescriptions[i].ReferenceTypeId);
+                    uaBrowseDescriptions[i].BrowseDirection = OpcUa_BrowseDirection_Forward;
+                    uaBrowseDescriptions[i].IncludeSubtypes = OpcUa_False;
+                    uaBrowseDescriptions[i].NodeClassMask   = OpcUa_NodeClass_DataType;
+                    uaBrowseDescriptions[i].ResultMask      = OpcUa_BrowseResultMask_None;
                 }
-                else
+
+                SdkStatus sdkStatus = uaSession_->browseList(
+                        uaServiceSettings,
+                        uaViewDescription,
+                        0, // no maximum number of references per node
+                        uaBrowseDescriptions,
+                        uaBrowseResults,
+                        uaDiagnosticInfos);
+
+                level.clear();
+
+                // collect the subtypes, and follow the continuation points if needed
+                while (sdkStatus.isGood() && uaBrowseResults.length() > 0)
+                {
+                    UaByteStringArray uaContinuationPoints;
+
+                    for (OpcUa_UInt32 i = 0; i < uaBrowseResults.length(); i++)
+                    {
+                        for (OpcUa_Int32 j = 0; j < uaBrowseResults[i].NoOfReferences; j++)
+                        {
+                            const OpcUa_ExpandedNodeId& uaId =
+                                    uaBrowseResults[i].References[j].NodeId;
+
+                            // only the DataTypes of this server are of interest
+                            if (uaId.ServerIndex == 0)
+                            {
+                                level.push_back(UaNodeId(uaId.NodeId));
+                                dataTypeIds.push_back(UaNodeId(uaId.NodeId));
+                            }
+                        }
+
+                        if (   uaBrowseResults[i].ContinuationPoint.Length > 0
+                            && OpcUa_IsGood(uaBrowseResults[i].StatusCode))
+                        {
+                            OpcUa_UInt32 current = uaContinuationPoints.length();
+                            uaContinuationPoints.resize(current + 1);
+                            UaByteString(uaBrowseResults[i].ContinuationPoint).copyTo(
+                                    &uaContinuationPoints[current]);
+                        }
+                    }
+
+                    uaBrowseResults.clear();
+
+                    if (uaContinuationPoints.length() > 0)
+                        sdkStatus = uaSession_->browseListNext(
+                                uaServiceSettings,
+                                OpcUa_False,
+                                uaContinuationPoints,
+                                uaBrowseResults,
+                                uaDiagnosticInfos);
+                }
+
+                if (sdkStatus.isBad())
+                {
+                    ret = BrowseInvocationError(sdkStatus);
+                    logger_->error(ret);
+                }
+            }
+
+            OpcUa_ViewDescription_Clear(&uaViewDescription);
+
+            // now fetch the definitions that are not cached yet
+            for (size_t i = 0; i < dataTypeIds.size() && ret.isGood(); i++)
+            {
+                NodeId dataTypeId;
+                NodeId key;
+                StructureDefinition definition;
+
+                dataTypeId.fromSdk(dataTypeIds[i]);
+
+                if (   structureDefinitionKey(dataTypeId, key)
+                    && !database_->structureDefinitionCache.find(serverUri_, key, definition))
                 {
-                    ret = PathCreationError(path, description);
-                    logger_->error(ret.toString());
+                    definition.fromSdk(uaSession_->structureDefinition(dataTypeIds[i]));
+
+                    if (!definition.isNull())
+                        database_->structureDefinitionCache.add(serverUri_, key, definition);
                 }
             }
+
+            if (ret.isGood())
+            {
+                logger_->debug("%d structured DataTypes have been prefetched", dataTypeIds.size());
+                database_->structureDefinitionCache.setPrefetched(serverUri_);
+            }
         }
 
         return ret;
@@ -47,6 +47,7 @@
 #include "uaf/client/settings/sessionsettings.h"
 #include "uaf/client/subscriptions/subscriptionfactory.h"
 #include "uaf/client/discovery/discoverer.h"
+#include "uaf/client/sessions/pkistore.h"
 #include "uaf/client/clientservices.h"
 
 
@@ -78,6 +79,7 @@ namespace uaf
          * @param clientInterface    Client interface to call when asynchronous
          *                           communication is received.
          * @param discoverer         The discoverer of the client.
+         * @param pkiStore           The PKI store shared by all sessions of the client.
          * @param database           Pointer to the client database.
          */
         Session(
@@ -88,6 +90,7 @@ namespace uaf
                 UaClientSdk::UaSessionCallback* uaSessionCallback,
                 uaf::ClientInterface*          clientInterface,
                 uaf::Discoverer*               discoverer,
+                uaf::PkiStore*                 pkiStore,
                 uaf::Database*                 database);
 
 
@@ -127,6 +130,29 @@ namespace uaf
         uaf::Status disconnect();
 
 
+        /**
+         * Make the threads that call waitForFirstConnectionAttempt() block, until the calling
+         * thread has called finishFirstConnectionAttempt().
+         *
+         * This is called by the session factory before the new session becomes visible to other
+         * threads, so that the session can be connected without locking all other sessions.
+         */
+        void startFirstConnectionAttempt();
+
+
+        /**
+         * Unblock the threads that are waiting for the first connection attempt.
+         */
+        void finishFirstConnectionAttempt();
+
+
+        /**
+         * Wait until the first connection attempt of the session has finished (whether it
+         * succeeded or not).
+         */
+        void waitForFirstConnectionAttempt();
+
+
         ///@} //////////////////////////////////////////////////////////////////////////////////////
         /**
          *  @name SessionInfo
@@ -171,6 +197,18 @@ namespace uaf
          */
         uaf::sessionstates::SessionState sessionState()    const { return sessionState_; };
 
+        /**
+         * Set the reconnection backoff of the session (as decided by the session factory), so it
+         * can be reported by sessionInformation().
+         *
+         * @param nextConnectionAttemptTime The earliest time of the next reconnection attempt
+         *                                  (null if it isn't delayed).
+         * @param failedConnectionAttempts  The number of consecutive failed connection attempts.
+         */
+        void setConnectionBackoff(
+                const uaf::DateTime&    nextConnectionAttemptTime,
+                uint32_t                failedConnectionAttempts);
+
 
         ///@} //////////////////////////////////////////////////////////////////////////////////////
         /**
@@ -206,6 +244,25 @@ namespace uaf
         uaf::Status manuallyUnsubscribe(uaf::ClientSubscriptionHandle clientSubscriptionHandle);
 
 
+        /**
+         * Check if some subscriptions were lost together with the session, and are waiting to be
+         * transferred once the session is reconnected.
+         *
+         * @return True if some subscriptions should be transferred.
+         */
+        bool hasSubscriptionsToTransfer();
+
+
+        /**
+         * Transfer the subscriptions that were lost together with the session, to the new
+         * session (i.e. after the session has been reconnected), and abandon the ones that have
+         * waited too long.
+         *
+         * @return True if some subscriptions were deleted, and must be created again.
+         */
+        bool transferSubscriptions();
+
+
         /**
          * Get information about a particular subscription.
          *
@@ -270,6 +327,22 @@ namespace uaf
                const uaf::ServiceSettings*            serviceSettings,
                std::vector<uaf::Status>&               results);
 
+
+        /**
+        * Modify the specified monitored items.
+        *
+        * @param clientHandles     The ClientHandles of the monitored items to be affected.
+        * @param settings          The new settings (one for each ClientHandle).
+        * @param serviceSettings   The service settings to be used.
+        * @param results           A vector of statuses (one result for each ClientHandle).
+        * @return                  The immediate result of the service call.
+        */
+        uaf::Status modifyMonitoredItemsIfNeeded(
+               const std::vector<uaf::ClientHandle>&           clientHandles,
+               const std::vector<uaf::MonitoredItemSettings>&  settings,
+               const uaf::ServiceSettings*                     serviceSettings,
+               std::vector<uaf::Status>&                       results);
+
         /**
          * Get the definition of a structured datatype.
          *
@@ -283,6 +356,15 @@ namespace uaf
 				 uaf::StructureDefinition& 	definition);
 
 
+        /**
+         * Browse the subtypes of Structure, and fetch the definitions of all structured DataTypes
+         * of the server that are not cached yet.
+         *
+         * @return  Good if the DataTypes could be browsed, bad if not.
+         */
+        uaf::Status prefetchStructureDefinitions();
+
+
 
         ///@} //////////////////////////////////////////////////////////////////////////////////////
         /**
@@ -373,6 +455,17 @@ namespace uaf
         DISALLOW_COPY_AND_ASSIGN(Session);
 
 
+        /**
+         * Connect the session.
+         *
+         * @param useCachedEndpoints    True to use the endpoint descriptions that were cached by
+         *                              the discoverer, false to get them from the server.
+         * @param endpointMismatch      Output parameter: true if the connection failed in a way
+         *                              that may be caused by outdated cached endpoints.
+         */
+        uaf::Status connect(bool useCachedEndpoints, bool& endpointMismatch);
+
+
         /**
          * Update the ServerArray and NamespaceArray (not locked!).
          *
@@ -391,13 +484,20 @@ namespace uaf
 
 
         /**
-         * Initialize the PKI store
+         * Update the publish request count of the connection info (from the subscription factory).
+         */
+        void updatePublishRequestCount(UaClientSdk::SessionConnectInfo& info);
+
+
+        /**
+         * Initialize the PKI store (from the shared PKI store of the client).
          */
         uaf::Status initializePkiStore(UaClientSdk::SessionSecurityInfo& uaSecurity);
 
 
         /**
-         * Load the client certificate from the file specified in the ClientSettings.
+         * Load the client certificate from the file specified in the ClientSettings (via the
+         * shared PKI store of the client).
          */
         uaf::Status loadClientCertificate(UaClientSdk::SessionSecurityInfo& uaSecurity);
 
@@ -408,6 +508,15 @@ namespace uaf
         uaf::Status verifyServerCertificate(UaClientSdk::SessionSecurityInfo& uaSecurity);
 
 
+        /**
+         * Get the key of a DataType in the structure definition cache (i.e. the NodeId with the
+         * namespace index of this server).
+         *
+         * @return  False if the namespace URI of the DataType is not known by this server.
+         */
+        bool structureDefinitionKey(const uaf::NodeId& dataTypeId, uaf::NodeId& key) const;
+
+
         /**
          * Load the server certificate from an endpoint description (which was fetched by the
          * discovery process).
@@ -424,14 +533,6 @@ namespace uaf
                 UaClientSdk::SessionSecurityInfo& uaSecurity,
                 const uaf::SessionSecuritySettings& securitySettings);
 
-        /**
-         * Helper function to check if a path exists, or create the path if needed.
-         */
-        uaf::Status checkOrCreatePath(
-                bool checkOnly,
-                const std::string& path,
-                const std::string& description) const;
-
 
         // Wrapped SDK session instance and callback instance
         UaClientSdk::UaSession*             uaSession_;
@@ -447,6 +548,8 @@ namespace uaf
         // the last connection attempt information:
         uaf::connectionsteps::ConnectionStep lastConnectionAttemptStep_;
         uaf::Status                          lastConnectionAttemptStatus_;
+        uaf::DateTime                        nextConnectionAttemptTime_;
+        uint32_t                             failedConnectionAttempts_;
 
         // fixed session properties:
         uaf::ClientConnectionId             clientConnectionId_;
@@ -464,10 +567,14 @@ namespace uaf
         UaClientSdk::SessionConnectInfo     uaSessionConnectInfoNoInitialRetry_;
         // mutex for critical sections
         UaMutex                             sessionMutex_;
+        // mutex that is locked during the first connection attempt
+        UaMutex                             firstConnectionAttemptMutex_;
         // the RequesterInterface to call when asynchronous messages are received
         uaf::ClientInterface*              clientInterface_;
         // the Discoverer to use
         uaf::Discoverer*                   discoverer_;
+        // the PKI store to use
+        uaf::PkiStore*                     pkiStore_;
 
 
     };
@@ -28,6 +28,49 @@ namespace uaf
     using std::map;
 
 
+    // A deferred invocation of an asynchronous request
+    // =============================================================================================
+    template<typename _Service>
+    class DeferredServiceInvocation : public DeferredInvocation
+    {
+    public:
+
+        typedef typename _Service::Invocation::SessionResultType SyncResult;
+        typedef void (ClientInterface::*Callback)(const SyncResult&);
+
+        DeferredServiceInvocation(
+                SessionFactory*                     factory,
+                const typename _Service::Request&   request,
+                Session*                            session,
+                typename _Service::Invocation*      invocation,
+                Callback                            callback)
+        : factory_(factory),
+          request_(request),
+          session_(session),
+          invocation_(invocation),
+          callback_(callback)
+        {}
+
+        void execute()
+        {
+            factory_->executeDeferredInvocation<_Service>(request_, session_, invocation_, callback_);
+        }
+
+        void cancel()
+        {
+            factory_->cancelDeferredInvocation(session_, invocation_->transactionId());
+            delete invocation_;
+        }
+
+    private:
+        SessionFactory*                 factory_;
+        typename _Service::Request      request_;
+        Session*                        session_;
+        typename _Service::Invocation*  invocation_;
+        Callback                        callback_;
+    };
+
+
     // Constructor
     // =============================================================================================
     SessionFactory::SessionFactory(
@@ -36,11 +79,21 @@ namespace uaf
             Discoverer* discoverer,
             Database* database)
     : clientInterface_(clientInterface),
+      sessionStateListener_(NULL),
       discoverer_(discoverer),
-      database_(database)
+      database_(database),
+      pkiStore_(loggerFactory, database),
+      preConnectionsRequested_(0),
+      preConnectionsDone_(0),
+      readinessWaiters_(0),
+      readinessSemaphore_(0, 0x7FFFFFFF),
+      asyncServiceWorker_(database->clientSettings.asyncServiceMaxThreads)
     {
         logger_ = new Logger(loggerFactory, "SessionFactory");
 
+        jitterSeed_ = uint32_t(DateTime::now().msec()) + 1;
+        reconnectionPass_ = 0;
+
         transactionId_ = 0;
 
         logger_->debug("The SessionFactory has been constructed");
@@ -53,6 +106,9 @@ namespace uaf
     {
         logger_->debug("Destructing the SessionFactory");
 
+        // stop the worker threads now, since they use the sessions and the logger
+        asyncServiceWorker_.stop();
+
         deleteAllSessions();
 
         delete logger_;
@@ -61,12 +117,31 @@ namespace uaf
     }
 
 
+    // Update the number of threads of the asyncServiceWorker_
+    // =============================================================================================
+    void SessionFactory::updateAsyncServiceThreads()
+    {
+        asyncServiceWorker_.setNoOfThreads(database_->clientSettings.asyncServiceMaxThreads);
+    }
+
+
+    // Set the session state listener
+    // =============================================================================================
+    void SessionFactory::setSessionStateListener(SessionStateListener* listener)
+    {
+        sessionStateListener_ = listener;
+    }
+
+
     // Delete all sessions on the client side
     // =============================================================================================
     void SessionFactory::deleteAllSessions()
     {
         logger_->debug("Deleting all sessions and their subscriptions and monitored items");
 
+        // make sure that no worker thread is still using a session
+        asyncServiceWorker_.clear();
+
         // lock the mutex to make sure the sessionMap is not being manipulated
         UaMutexLocker sessionMapLocker(&sessionMapMutex_);
 
@@ -189,6 +264,7 @@ namespace uaf
                 this,
                 clientInterface_,
                 discoverer_,
+                &pkiStore_,
                 database_);
 
         // store the new session instance in the sessionMap
@@ -255,38 +331,468 @@ namespace uaf
 
 
 
+    // Transfer the subscriptions of the reconnected sessions
+    // =============================================================================================
+    bool SessionFactory::transferSubscriptions()
+    {
+        bool mustRecreate = false;
+
+        // don't keep the sessionMap_ locked while the sessions may go to the network
+        vector<SessionInformation> infos = allSessionInformations();
+
+        for (vector<SessionInformation>::const_iterator it = infos.begin();
+                it != infos.end();
+                ++it)
+        {
+            Session* session = 0;
+            if (acquireExistingSession(it->clientConnectionId, session).isGood())
+            {
+                // (also the disconnected sessions, since their transfers may have expired)
+                if (session->transferSubscriptions())
+                    mustRecreate = true;
+
+                // a disconnected session without transfers left may be garbage collected now
+                releaseSession(session);
+            }
+        }
+
+        return mustRecreate;
+    }
+
+
     // Manually disconnect a session
     // =============================================================================================
     void SessionFactory::doHouseKeeping()
     {
         vector<SessionInformation> infos = allSessionInformations();
 
-        Session* session = 0;
-        Status acquisitionStatus;
-        bool tryToReconnect;
+        // collect the disconnected sessions (reconnect() checks the backoff of their servers)
+        reconnectionMutex_.lock();
+
+        reconnectionJobs_.clear();
+        reconnectionPass_++;
+
         for (vector<SessionInformation>::const_iterator it = infos.begin();
                 it != infos.end();
                 ++it)
         {
-            acquisitionStatus = acquireExistingSession(it->clientConnectionId, session);
+            if (it->sessionState == uaf::sessionstates::Disconnected)
+                reconnectionJobs_.push_back(it->clientConnectionId);
+        }
+
+        // the current thread reconnects sessions too, so only start the remaining threads
+        uint32_t noOfJobs = uint32_t(reconnectionJobs_.size());
+        uint32_t maxThreads = database_->clientSettings.reconnectMaxParallelConnects;
+        uint32_t noOfThreads = noOfJobs;
+        if (maxThreads > 0 && noOfThreads > maxThreads)
+            noOfThreads = maxThreads;
+
+        reconnectionMutex_.unlock();
 
-            if (acquisitionStatus.isGood())
+        if (noOfJobs == 0)
+            return;
+
+        logger_->debug("Checking %d disconnected session(s) by %d thread(s)",
+                       noOfJobs, noOfThreads);
+
+        vector<ReconnectionWorker*> workers;
+        for (uint32_t i = 1; i < noOfThreads; i++)
+        {
+            ReconnectionWorker* worker = new ReconnectionWorker(this);
+            workers.push_back(worker);
+            worker->start();
+        }
+
+        processReconnectionJobs();
+
+        for (vector<ReconnectionWorker*>::iterator it = workers.begin(); it != workers.end(); ++it)
+        {
+            (*it)->wait();
+            delete *it;
+        }
+    }
+
+
+    // Reconnect sessions until there are none left
+    // =============================================================================================
+    void SessionFactory::processReconnectionJobs()
+    {
+        while (true)
+        {
+            reconnectionMutex_.lock();
+
+            if (reconnectionJobs_.empty())
             {
-                if (session->sessionState() == uaf::sessionstates::Disconnected)
-                {
-                    // if other activities are going on besides the house keeping,
-                    // then try to reconnect the session
-                    activityMapMutex_.lock();
-                    tryToReconnect = (activityMap_[it->clientConnectionId] > 1);
-                    activityMapMutex_.unlock();
+                reconnectionMutex_.unlock();
+                break;
+            }
+
+            ClientConnectionId clientConnectionId = reconnectionJobs_.front();
+            reconnectionJobs_.pop_front();
+
+            reconnectionMutex_.unlock();
+
+            reconnect(clientConnectionId);
+        }
+    }
+
 
-                    if (tryToReconnect)
-                        session->connect();
+    // Reconnect a single session
+    // =============================================================================================
+    void SessionFactory::reconnect(ClientConnectionId clientConnectionId)
+    {
+        Session* session = 0;
+        Status acquisitionStatus = acquireExistingSession(clientConnectionId, session);
+
+        if (acquisitionStatus.isNotGood())
+            return;
+
+        if (session->sessionState() == uaf::sessionstates::Disconnected)
+        {
+            // if other activities are going on besides the house keeping,
+            // then try to reconnect the session
+            activityMapMutex_.lock();
+            bool tryToReconnect = (activityMap_[clientConnectionId] > 1);
+            activityMapMutex_.unlock();
+
+            // the subscriptions that are waiting to be transferred need the session as well
+            if (!tryToReconnect)
+                tryToReconnect = session->hasSubscriptionsToTransfer();
+
+            // another session to the same server may have failed in the meantime
+            if (tryToReconnect)
+            {
+                UaMutexLocker locker(&reconnectionMutex_);
+
+                ServerBackoffMap::const_iterator backoff =
+                        serverBackoffMap_.find(session->serverUri());
+
+                if (backoff != serverBackoffMap_.end()
+                        && DateTime::now().msecsTo(backoff->second.nextConnectionAttemptTime) > 0)
+                {
+                    logger_->debug("Session %d will not be reconnected before %s",
+                                   clientConnectionId,
+                                   backoff->second.nextConnectionAttemptTime.toString().c_str());
+                    session->setConnectionBackoff(backoff->second.nextConnectionAttemptTime,
+                                                  backoff->second.failedConnectionAttempts);
+                    tryToReconnect = false;
                 }
-                releaseSession(session);
             }
+
+            if (tryToReconnect)
+            {
+                waitForConnectRateLimit();
+
+                Status connectionStatus = session->connect();
+
+                updateServerBackoff(session->serverUri(), connectionStatus.isGood(), session);
+            }
+        }
+
+        releaseSession(session);
+    }
+
+
+    // Wait for the connect-rate limit
+    // =============================================================================================
+    void SessionFactory::waitForConnectRateLimit()
+    {
+        float maxConnectsPerSec = database_->clientSettings.reconnectMaxConnectsPerSec;
+
+        if (maxConnectsPerSec <= 0.0)
+            return;
+
+        // reserve the next free slot
+        reconnectionMutex_.lock();
+
+        DateTime now = DateTime::now();
+        if (nextConnectTime_.isNull() || now.msecsTo(nextConnectTime_) < 0)
+            nextConnectTime_ = now;
+
+        int32_t waitMs = now.msecsTo(nextConnectTime_);
+        nextConnectTime_.addMilliSecs(int(1000.0 / maxConnectsPerSec));
+
+        reconnectionMutex_.unlock();
+
+        if (waitMs > 0)
+        {
+            logger_->debug("Waiting %dms before connecting (rate limit)", waitMs);
+            DateTime::msleep(waitMs);
+        }
+    }
+
+
+    // Update the backoff of a server
+    // =============================================================================================
+    void SessionFactory::updateServerBackoff(
+            const string&   serverUri,
+            bool            connected,
+            Session*        session)
+    {
+        UaMutexLocker locker(&reconnectionMutex_);
+
+        if (connected)
+        {
+            serverBackoffMap_.erase(serverUri);
+            session->setConnectionBackoff(DateTime(), 0);
+            return;
+        }
+
+        ServerBackoff& backoff = serverBackoffMap_[serverUri];
+
+        // the sessions to the same server that are reconnected in parallel during the same pass
+        // don't increase the backoff again, they just get the backoff of the first failure
+        if (backoff.failedConnectionAttempts > 0 && backoff.lastFailedPass == reconnectionPass_)
+        {
+            session->setConnectionBackoff(backoff.nextConnectionAttemptTime,
+                                          backoff.failedConnectionAttempts);
+            return;
+        }
+
+        backoff.failedConnectionAttempts++;
+        backoff.lastFailedPass = reconnectionPass_;
+
+        // exponential backoff: initial * 2^(failures-1), limited to the maximum
+        double backoffSec = database_->clientSettings.reconnectInitialBackoffSec;
+        double maxBackoffSec = database_->clientSettings.reconnectMaxBackoffSec;
+        for (uint32_t i = 1; i < backoff.failedConnectionAttempts && backoffSec < maxBackoffSec; i++)
+            backoffSec *= 2.0;
+        if (backoffSec > maxBackoffSec)
+            backoffSec = maxBackoffSec;
+
+        // jitter: a random factor between (1 - jitter) and (1 + jitter)
+        jitterSeed_ = jitterSeed_ * 1103515245u + 12345u;
+        double random = double((jitterSeed_ >> 16) & 0x7FFF) / 32767.0;
+        backoffSec *= 1.0 + database_->clientSettings.reconnectBackoffJitter * (2.0 * random - 1.0);
+        if (backoffSec < 0.0)
+            backoffSec = 0.0;
+
+        backoff.nextConnectionAttemptTime = DateTime::now();
+        backoff.nextConnectionAttemptTime.addMilliSecs(int(backoffSec * 1000.0));
+
+        logger_->debug("Connecting to %s failed %d time(s), the next attempt is delayed by %.3fs",
+                       serverUri.c_str(), backoff.failedConnectionAttempts, backoffSec);
+
+        session->setConnectionBackoff(backoff.nextConnectionAttemptTime,
+                                      backoff.failedConnectionAttempts);
+    }
+
+
+    // Get the earliest time of the delayed reconnection attempts
+    // =============================================================================================
+    bool SessionFactory::nextConnectionAttemptTime(DateTime& time)
+    {
+        UaMutexLocker locker(&reconnectionMutex_);
+
+        bool found = false;
+        DateTime now = DateTime::now();
+
+        for (ServerBackoffMap::const_iterator it = serverBackoffMap_.begin();
+                it != serverBackoffMap_.end();
+                ++it)
+        {
+            // the attempts that are due already, have been handled by the house keeping
+            if (now.msecsTo(it->second.nextConnectionAttemptTime) <= 0)
+                continue;
+
+            if (!found || it->second.nextConnectionAttemptTime < time)
+            {
+                time = it->second.nextConnectionAttemptTime;
+                found = true;
+            }
+        }
+
+        return found;
+    }
+
+
+    // Request a new pre-connection
+    // =============================================================================================
+    void SessionFactory::requestPreConnection()
+    {
+        UaMutexLocker locker(&preConnectionMutex_);
+        preConnectionsRequested_++;
+    }
+
+
+    // Connect the sessions of the given servers
+    // =============================================================================================
+    void SessionFactory::preConnect(const vector<string>& serverUris)
+    {
+        preConnectionMutex_.lock();
+
+        uint32_t request = preConnectionsRequested_;
+
+        // forget the pre-connected sessions that were deleted in the meantime
+        // (e.g. by manuallyDisconnect), so that they are created again, and the ones of the
+        // servers that should no longer be pre-connected, so that isReady() doesn't wait for them
+        // (their sessions remain, like manually connected sessions)
+        sessionMapMutex_.lock();
+        PreConnectionMap::iterator it = preConnectionMap_.begin();
+        while (it != preConnectionMap_.end())
+        {
+            if (sessionMap_.find(it->second) == sessionMap_.end()
+                    || std::find(serverUris.begin(), serverUris.end(), it->first)
+                            == serverUris.end())
+                preConnectionMap_.erase(it++);
+            else
+                ++it;
+        }
+        sessionMapMutex_.unlock();
+
+        preConnectionJobs_.clear();
+
+        for (vector<string>::const_iterator uri = serverUris.begin();
+                uri != serverUris.end();
+                ++uri)
+        {
+            if (preConnectionMap_.find(*uri) == preConnectionMap_.end()
+                    && std::find(preConnectionJobs_.begin(), preConnectionJobs_.end(), *uri)
+                            == preConnectionJobs_.end())
+                preConnectionJobs_.push_back(*uri);
+        }
+
+        // the current thread connects sessions too, so only start the remaining threads
+        uint32_t noOfJobs = uint32_t(preConnectionJobs_.size());
+        uint32_t maxThreads = database_->clientSettings.reconnectMaxParallelConnects;
+        uint32_t noOfThreads = noOfJobs;
+        if (maxThreads > 0 && noOfThreads > maxThreads)
+            noOfThreads = maxThreads;
+
+        preConnectionMutex_.unlock();
+
+        if (noOfJobs > 0)
+        {
+            logger_->debug("Pre-connecting %d server(s) by %d thread(s)", noOfJobs, noOfThreads);
+
+            vector<PreConnectionWorker*> workers;
+            for (uint32_t i = 1; i < noOfThreads; i++)
+            {
+                PreConnectionWorker* worker = new PreConnectionWorker(this);
+                workers.push_back(worker);
+                worker->start();
+            }
+
+            processPreConnectionJobs();
+
+            for (vector<PreConnectionWorker*>::iterator worker = workers.begin();
+                    worker != workers.end();
+                    ++worker)
+            {
+                (*worker)->wait();
+                delete *worker;
+            }
+        }
+
+        preConnectionMutex_.lock();
+        preConnectionsDone_ = request;
+        preConnectionMutex_.unlock();
+
+        notifyReadinessWaiters();
+    }
+
+
+    // Connect the sessions of the pre-connected servers until there are none left
+    // =============================================================================================
+    void SessionFactory::processPreConnectionJobs()
+    {
+        while (true)
+        {
+            preConnectionMutex_.lock();
+
+            if (preConnectionJobs_.empty())
+            {
+                preConnectionMutex_.unlock();
+                break;
+            }
+
+            string serverUri = preConnectionJobs_.front();
+            preConnectionJobs_.pop_front();
+
+            preConnectionMutex_.unlock();
+
+            waitForConnectRateLimit();
+
+            // the session is kept open like a manually connected session (also if the
+            // connection failed, so that the house keeping will reconnect it)
+            ClientConnectionId clientConnectionId;
+            Status status = manuallyConnect(serverUri, NULL, clientConnectionId);
+
+            if (status.isGood())
+            {
+                logger_->debug("Session %d was pre-connected to %s",
+                               clientConnectionId, serverUri.c_str());
+
+                UaMutexLocker locker(&preConnectionMutex_);
+                preConnectionMap_[serverUri] = clientConnectionId;
+            }
+        }
+    }
+
+
+    // Check if the pre-connected sessions are ready
+    // =============================================================================================
+    bool SessionFactory::isReady()
+    {
+        preConnectionMutex_.lock();
+        bool ready = (preConnectionsDone_ == preConnectionsRequested_);
+        PreConnectionMap preConnectionMap = preConnectionMap_;
+        preConnectionMutex_.unlock();
+
+        UaMutexLocker locker(&sessionMapMutex_);
+
+        for (PreConnectionMap::const_iterator it = preConnectionMap.begin();
+                ready && it != preConnectionMap.end();
+                ++it)
+        {
+            SessionMap::const_iterator session = sessionMap_.find(it->second);
+            ready = (session != sessionMap_.end() && session->second->isConnected());
         }
 
+        return ready;
+    }
+
+
+    // Wait until the pre-connected sessions are ready
+    // =============================================================================================
+    Status SessionFactory::waitUntilReady(double timeoutSec)
+    {
+        DateTime deadline = DateTime::now();
+        deadline.addMilliSecs(int(timeoutSec * 1000.0));
+
+        while (true)
+        {
+            // register as a waiter before checking, so that no notification can be missed
+            preConnectionMutex_.lock();
+            readinessWaiters_++;
+            preConnectionMutex_.unlock();
+
+            bool ready = isReady();
+            int32_t remainingMs = DateTime::now().msecsTo(deadline);
+
+            if (!ready && remainingMs > 0)
+                readinessSemaphore_.timedWait(uint32_t(remainingMs));
+
+            preConnectionMutex_.lock();
+            readinessWaiters_--;
+            preConnectionMutex_.unlock();
+
+            if (ready)
+                return statuscodes::Good;
+            else if (remainingMs <= 0)
+                return ClientNotReadyError();
+        }
+    }
+
+
+    // Wake up the threads that are waiting until the client is ready
+    // =============================================================================================
+    void SessionFactory::notifyReadinessWaiters()
+    {
+        UaMutexLocker locker(&preConnectionMutex_);
+
+        if (readinessWaiters_ > 0)
+            readinessSemaphore_.post(readinessWaiters_);
     }
 
 
@@ -521,29 +1027,120 @@ namespace uaf
     }
 
 
+    // Modify the monitored items with the given ClientHandles.
+    // =============================================================================================
+    Status SessionFactory::modifyMonitoredItems(
+            const vector<ClientHandle>&             clientHandles,
+            const vector<MonitoredItemSettings>&    settings,
+            const ServiceSettings*                  serviceSettings,
+            vector<Status>&                         results)
+    {
+        Status ret;
+
+        if (settings.size() != clientHandles.size())
+            return InvalidRequestError(uaf::format(
+                    "The number of settings (%d) does not match the number of client handles (%d)",
+                    settings.size(), clientHandles.size()));
+
+        // set the correct size for the results output parameter
+        results.resize(clientHandles.size());
+
+        // fill all statuses with an "UnknownClientHandleError" status.
+        // The statuses for which a handle will be found, will be updated further on.
+        for (std::size_t i = 0; i < clientHandles.size(); i++)
+            results[i] = UnknownClientHandleError(clientHandles[i]);
+
+        // don't keep the sessionMap_ locked while the sessions may go to the network
+        vector<SessionInformation> infos = allSessionInformations();
+
+        // loop trough the sessions and let ModifyMonitoredItems be called (if needed!) on each
+        for (vector<SessionInformation>::const_iterator it = infos.begin();
+                it != infos.end() && ret.isNotBad();
+                ++it)
+        {
+            Session* session = 0;
+            if (acquireExistingSession(it->clientConnectionId, session).isGood())
+            {
+                ret = session->modifyMonitoredItemsIfNeeded(clientHandles,
+                                                            settings,
+                                                            serviceSettings,
+                                                            results);
+                releaseSession(session);
+            }
+        }
+
+        return ret;
+    }
+
+
     // Get a structure definition
     // =============================================================================================
     Status SessionFactory::structureDefinition(
     		const NodeId& 			dataTypeId,
 			StructureDefinition& 	definition)
     {
-        Status ret;
+        return structureDefinition(string(), dataTypeId, definition);
+    }
 
-        // lock the mutex to make sure the sessionMap_ is not being manipulated
-        UaMutexLocker locker(&sessionMapMutex_);
 
-        // loop trough the sessions and let structureDefinition be called (if needed!) on each of them
-        for (SessionMap::const_iterator it = sessionMap_.begin();
-                it != sessionMap_.end() && ret.isNotGood();
+    // Get a structure definition of a particular server
+    // =============================================================================================
+    Status SessionFactory::structureDefinition(
+            const string&           serverUri,
+            const NodeId&           dataTypeId,
+            StructureDefinition&    definition)
+    {
+        Status ret = DefinitionNotFoundError();
+
+        // don't keep the sessionMap_ locked while the sessions may go to the network
+        vector<SessionInformation> infos = allSessionInformations();
+
+        // ask the connected sessions (of the given server, if any) until one of them knows it
+        for (vector<SessionInformation>::const_iterator it = infos.begin();
+                it != infos.end() && ret.isNotGood();
                 ++it)
         {
-            ret = it->second->structureDefinition(dataTypeId, definition);
+            if (   it->sessionState == uaf::sessionstates::Connected
+                && (serverUri.empty() || it->serverUri == serverUri))
+            {
+                Session* session = 0;
+                if (acquireExistingSession(it->clientConnectionId, session).isGood())
+                {
+                    ret = session->structureDefinition(dataTypeId, definition);
+                    releaseSession(session);
+                }
+            }
         }
 
         return ret;
     }
 
 
+    // Prefetch the structure definitions of the connected servers
+    // =============================================================================================
+    void SessionFactory::prefetchStructureDefinitions()
+    {
+        vector<SessionInformation> infos = allSessionInformations();
+
+        for (vector<SessionInformation>::const_iterator it = infos.begin();
+                it != infos.end();
+                ++it)
+        {
+            // a single session per server is enough, since the cache is shared
+            if (   it->sessionState == uaf::sessionstates::Connected
+                && !database_->structureDefinitionCache.isPrefetched(it->serverUri))
+            {
+                Session* session = 0;
+                if (acquireExistingSession(it->clientConnectionId, session).isGood())
+                {
+                    session->prefetchStructureDefinitions();
+                    releaseSession(session);
+                }
+            }
+        }
+    }
+
+
 
     // Construct a session if needed, without connecting
     // =============================================================================================
@@ -559,8 +1156,13 @@ namespace uaf
 
         session = 0;
 
+        // true if a new session was created (which must still be connected)
+        bool created = false;
+
         // lock the mutex to make sure the sessionMap_ is not being manipulated
-        UaMutexLocker locker(&sessionMapMutex_);
+        // (but don't keep it locked while connecting, since other sessions may be acquired and
+        // connected concurrently)
+        sessionMapMutex_.lock();
 
         // first check if we need to create a new session in any case:
         if (sessionSettings.unique)
@@ -614,6 +1216,7 @@ namespace uaf
                     this,
                     clientInterface_,
                     discoverer_,
+                    &pkiStore_,
                     database_);
 
             // store the new session instance in the sessionMap
@@ -624,14 +1227,28 @@ namespace uaf
             activityMap_[clientConnectionId] = 1;
             activityMapMutex_.unlock();
 
-            // connect to the session
-            session->connect();
+            // other threads that acquire the session must wait until it has been connected
+            session->startFirstConnectionAttempt();
+            created = true;
 
-            // regardless of whether the connection succeeded or failed, set the return status
+            // regardless of whether the connection will succeed or fail, set the return status
             // to 'good'
             ret = statuscodes::Good;
         }
 
+        sessionMapMutex_.unlock();
+
+        if (created)
+        {
+            // connect to the session
+            session->connect();
+            session->finishFirstConnectionAttempt();
+        }
+        else if (ret.isGood())
+        {
+            session->waitForFirstConnectionAttempt();
+        }
+
         // add some diagnostics
         if (ret.isGood())
         {
@@ -663,7 +1280,7 @@ namespace uaf
         session = 0;
 
         // lock the mutex to make sure the sessionMap is not being manipulated
-        UaMutexLocker locker(&sessionMapMutex_);
+        sessionMapMutex_.lock();
 
         SessionMap::iterator iter = sessionMap_.find(clientConnectionId);
 
@@ -691,6 +1308,12 @@ namespace uaf
                            clientConnectionId, newActivityCount);
         }
 
+        sessionMapMutex_.unlock();
+
+        // the session may still be connecting for the first time (by another thread)
+        if (ret.isGood())
+            session->waitForFirstConnectionAttempt();
+
         return ret;
     }
 
@@ -732,7 +1355,10 @@ namespace uaf
             {
                 // if there is no ongoing activity of the session (in other words: if there is no
                 // pointer to this session being used), we may delete it!
-                if (activityMap_[id] == 0 && allowGarbageCollection)
+                // (unless it still has subscriptions that should be transferred to a new session)
+                if (   activityMap_[id] == 0
+                    && allowGarbageCollection
+                    && !session->hasSubscriptionsToTransfer())
                 {
                     logger_->debug("There's no ongoing activity of this disconnected session, so "
                                    "we may delete it");
@@ -777,6 +1403,140 @@ namespace uaf
         return 0;
     }
 
+
+    // Find a transaction and remove it from the transaction map
+    // =============================================================================================
+    bool SessionFactory::takeTransaction(TransactionId transactionId, Transaction& transaction)
+    {
+        UaMutexLocker locker(&transactionMapMutex_);
+
+        TransactionMap::iterator iter = transactionMap_.find(transactionId);
+        if (iter == transactionMap_.end())
+            return false;
+
+        transaction = iter->second;
+        transactionMap_.erase(iter);
+        return true;
+    }
+
+    // Execute a deferred invocation
+    // =============================================================================================
+    template<typename _Service>
+    void SessionFactory::executeDeferredInvocation(
+            const typename _Service::Request&   request,
+            Session*                            session,
+            typename _Service::Invocation*      invocation,
+            void (ClientInterface::*callback)(
+                    const typename _Service::Invocation::SessionResultType&))
+    {
+        TransactionId transactionId = invocation->transactionId();
+
+        logger_->debug("Executing the deferred %sRequest %d (transaction %d)",
+                       _Service::name().c_str(), request.requestHandle(), transactionId);
+
+        // create a synchronous result to fill it
+        typename _Service::Invocation::SessionResultType result;
+        result.requestHandle = request.requestHandle();
+        result.targets.resize(request.targets.size());
+
+        // invoke the service synchronously, on the session that is still acquired for us
+        Status ret;
+        invocation->setAsynchronous(false);
+        if (session->isConnected())
+            ret = session->invokeService<_Service>(request, *invocation);
+        else
+            ret = session->sessionInformation().lastConnectionAttemptStatus;
+
+        if (ret.isGood())
+            ret = invocation->copyToResult(result);
+
+        // if something went wrong, the invoked targets get the error status
+        if (ret.isNotGood())
+        {
+            vector<size_t> ranks = invocation->ranks();
+            for (size_t i = 0; i < ranks.size(); i++)
+            {
+                if (ranks[i] < result.targets.size())
+                    result.targets[ranks[i]].status = ret;
+            }
+        }
+
+        result.updateOverallStatus();
+
+        releaseSession(session);
+        delete invocation;
+
+        logger_->debug("%sResult for request %d (transaction %d):",
+                       _Service::name().c_str(), result.requestHandle, transactionId);
+        logger_->debug(result.toString());
+
+        // call the completion handler of the request (if any)
+        Transaction transaction;
+        if (takeTransaction(transactionId, transaction))
+            completeTransaction(transaction, result);
+        else
+            logger_->error("Unknown transaction id %d", transactionId);
+
+        // call the callback interface
+        (clientInterface_->*callback)(result);
+    }
+
+
+    // Cancel a deferred invocation
+    // =============================================================================================
+    void SessionFactory::cancelDeferredInvocation(Session* session, TransactionId transactionId)
+    {
+        logger_->debug("Cancelling the deferred invocation of transaction %d", transactionId);
+
+        releaseSession(session);
+
+        Transaction transaction;
+        if (takeTransaction(transactionId, transaction) && transaction.completionHandler != NULL)
+            transaction.completionHandler->release();
+    }
+
+
+    // Defer an AsyncBrowseRequest
+    // =============================================================================================
+    Status SessionFactory::deferInvocation(
+            const AsyncBrowseRequest&   request,
+            Session*                    session,
+            BrowseInvocation*           invocation)
+    {
+        asyncServiceWorker_.enqueue(new DeferredServiceInvocation<AsyncBrowseService>(
+                this, request, session, invocation, &ClientInterface::browseComplete));
+        return statuscodes::Good;
+    }
+
+
+    // Defer an AsyncBrowseNextRequest
+    // =============================================================================================
+    Status SessionFactory::deferInvocation(
+            const AsyncBrowseNextRequest&   request,
+            Session*                        session,
+            BrowseNextInvocation*           invocation)
+    {
+        asyncServiceWorker_.enqueue(new DeferredServiceInvocation<AsyncBrowseNextService>(
+                this, request, session, invocation, &ClientInterface::browseNextComplete));
+        return statuscodes::Good;
+    }
+
+
+    // Defer an AsyncTranslateBrowsePathsToNodeIdsRequest
+    // =============================================================================================
+    Status SessionFactory::deferInvocation(
+            const AsyncTranslateBrowsePathsToNodeIdsRequest&    request,
+            Session*                                            session,
+            TranslateBrowsePathsToNodeIdsInvocation*            invocation)
+    {
+        asyncServiceWorker_.enqueue(
+                new DeferredServiceInvocation<AsyncTranslateBrowsePathsToNodeIdsService>(
+                        this, request, session, invocation,
+                        &ClientInterface::translateBrowsePathsToNodeIdsComplete));
+        return statuscodes::Good;
+    }
+
+
     // implemented from the callback interface
     // =============================================================================================
     bool SessionFactory::connectError(
@@ -838,11 +1598,24 @@ namespace uaf
 
         if (acquireStatus.isGood())
         {
+            // a connected session resets the backoff of its server
+            if (state == sessionstates::Connected)
+                updateServerBackoff(session->serverUri(), true, session);
+
             // update the session state
+            // (the lost subscriptions are transferred by the house keeping, which is triggered by
+            //  the listener, so that this SDK callback isn't blocked by the service calls)
             session->setSessionState(state);
 
             // release the acquired session
             releaseSession(session, false);
+
+            // the pre-connected sessions may be ready now
+            notifyReadinessWaiters();
+
+            // notify the listener
+            if (sessionStateListener_ != NULL)
+                sessionStateListener_->sessionStateChanged(clientConnectionId, state);
         }
     }
 
@@ -856,15 +1629,10 @@ namespace uaf
     {
         logger_->debug("Call complete: transactionId %d", transactionId);
 
-        // find the request handle for the given transaction id
-        RequestHandle handle = 0;
-        bool transactionIdFound;
-        transactionMapMutex_.lock();
-        TransactionMap::iterator iter = transactionMap_.find(transactionId);
-        transactionIdFound = (iter != transactionMap_.end());
-        if (transactionIdFound)
-            handle = iter->second;
-        transactionMapMutex_.unlock();
+        // find (and remove) the transaction for the given transaction id
+        Transaction transaction;
+        bool transactionIdFound = takeTransaction(transactionId, transaction);
+        RequestHandle handle = transaction.requestHandle;
 
         // create a result to fill it
         MethodCallResult result;
@@ -907,21 +1675,17 @@ namespace uaf
             result.targets[0].inputArgumentOpcUaStatusCodes.push_back(callResponse.inputArgumentResults[i]);
         }
 
-        // if the transaction id was found, put the result in the correct cache
+        // if the transaction id was found, call the completion handler of the request (if any)
         if (transactionIdFound)
         {
             logger_->debug("Transaction id %d corresponds to the asynchronous handle %d",
                            transactionId, handle);
 
-            // remove the transaction id : request handle pair
-            transactionMapMutex_.lock();      // lock the map
-            transactionMap_.erase(transactionId);         // erase the key
-            transactionMapMutex_.unlock();    // unlock the map
+            completeTransaction(transaction, result);
         }
-        // if the transaction id was not found, we cannot store the result in the cache
         else
         {
-            logger_->error("Unknown transaction id received, so we cannot cache the result");
+            logger_->error("Unknown transaction id %d received", transactionId);
         }
 
         // call the callback interface
@@ -941,15 +1705,10 @@ namespace uaf
         logger_->debug("Read complete: transactionId %d", transactionId);
 
 
-        // find the request handle for the given transaction id
-        RequestHandle handle = 0;
-        bool transactionIdFound;
-        transactionMapMutex_.lock();
-        TransactionMap::iterator iter = transactionMap_.find(transactionId);
-        transactionIdFound = (iter != transactionMap_.end());
-        if (transactionIdFound)
-            handle = iter->second;
-        transactionMapMutex_.unlock();
+        // find (and remove) the transaction for the given transaction id
+        Transaction transaction;
+        bool transactionIdFound = takeTransaction(transactionId, transaction);
+        RequestHandle handle = transaction.requestHandle;
 
         // create a result to fill it
         ReadResult result;
@@ -985,25 +1744,11 @@ namespace uaf
         logger_->debug("ReadResult for request %d (transaction %d):", handle, transactionId);
         logger_->debug(result.toString());
 
-//        // if the transaction id was found, put the result in the correct cache
-//        if (transactionIdFound)
-//        {
-//            logger_->debug("Transaction id %d corresponds to the asynchronous handle %d",
-//                           transactionId, handle);
-//
-//            // add the result to the database
-//            database_->asyncMethodCallResultCache.set(handle, result);
-//
-//            // remove the transaction id : request handle pair
-//            transactionMapMutex_.lock();      // lock the map
-//            transactionMap_.erase(transactionId);         // erase the key
-//            transactionMapMutex_.unlock();    // unlock the map
-//        }
-//        // if the transaction id was not found, we cannot store the result in the cache
-//        else
-//        {
-//            logger_->error("Unknown transaction id received, so we cannot cache the result");
-//        }
+        // if the transaction id was found, call the completion handler of the request (if any)
+        if (transactionIdFound)
+            completeTransaction(transaction, result);
+        else
+            logger_->error("Unknown transaction id %d received", transactionId);
 
         // call the callback interface
         clientInterface_->readComplete(result);
@@ -1022,15 +1767,10 @@ namespace uaf
         logger_->debug("Write complete: transactionId %d", transactionId);
 
 
-        // find the request handle for the given transaction id
-        RequestHandle handle = 0;
-        bool transactionIdFound;
-        transactionMapMutex_.lock();
-        TransactionMap::iterator iter = transactionMap_.find(transactionId);
-        transactionIdFound = (iter != transactionMap_.end());
-        if (transactionIdFound)
-            handle = iter->second;
-        transactionMapMutex_.unlock();
+        // find (and remove) the transaction for the given transaction id
+        Transaction transaction;
+        bool transactionIdFound = takeTransaction(transactionId, transaction);
+        RequestHandle handle = transaction.requestHandle;
 
         // create a result to fill it
         WriteResult result;
@@ -1061,28 +1801,88 @@ namespace uaf
         logger_->debug("WriteResult for request %d (transaction %d):", handle, transactionId);
         logger_->debug(result.toString());
 
-//        // if the transaction id was found, put the result in the correct cache
-//        if (transactionIdFound)
-//        {
-//            logger_->debug("Transaction id %d corresponds to the asynchronous handle %d",
-//                           transactionId, handle);
-//
-//            // add the result to the database
-//            database_->asyncMethodCallResultCache.set(handle, result);
-//
-//            // remove the transaction id : request handle pair
-//            transactionMapMutex_.lock();      // lock the map
-//            transactionMap_.erase(transactionId);         // erase the key
-//            transactionMapMutex_.unlock();    // unlock the map
-//        }
-//        // if the transaction id was not found, we cannot store the result in the cache
-//        else
-//        {
-//            logger_->error("Unknown transaction id received, so we cannot cache the result");
-//        }
+        // if the transaction id was found, call the completion handler of the request (if any)
+        if (transactionIdFound)
+            completeTransaction(transaction, result);
+        else
+            logger_->error("Unknown transaction id %d received", transactionId);
 
         // call the callback interface
         clientInterface_->writeComplete(result);
     }
 
+
+    // implemented from the callback interface
+    // =============================================================================================
+    void SessionFactory::historyReadRawModifiedComplete(
+        OpcUa_UInt32                                transactionId,
+        const UaStatus&                             uaStatus,
+        const UaClientSdk::HistoryReadDataResults&  results,
+        const UaDiagnosticInfos&                    diagnosticInfos)
+    {
+        logger_->debug("HistoryReadRawModified complete: transactionId %d", transactionId);
+
+        // find (and remove) the transaction for the given transaction id
+        Transaction transaction;
+        bool transactionIdFound = takeTransaction(transactionId, transaction);
+        RequestHandle handle = transaction.requestHandle;
+
+        // create a result to fill it
+        HistoryReadRawModifiedResult result;
+
+        // fill the status and requestHandle
+        result.requestHandle = handle;
+
+        // fill the status
+        if (uaStatus.isGood())
+            result.overallStatus = statuscodes::Good;
+        else
+            result.overallStatus = HistoryReadRawModifiedCompleteError(SdkStatus(uaStatus));
+
+        // create the targets
+        result.targets.resize(results.length());
+
+        // walk through the received results
+        for (uint32_t i = 0; i < results.length(); i++)
+        {
+            // set the status of the target
+            if (OpcUa_IsGood(results[i].m_status.statusCode()))
+                result.targets[i].status = statuscodes::Good;
+            else
+                result.targets[i].status = ServerCouldNotHistoryReadError(
+                        SdkStatus(results[i].m_status.statusCode()));
+
+            result.targets[i].opcUaStatusCode = results[i].m_status.statusCode();
+
+            // update the continuation point
+            // (asynchronous history reads never automatically read more data)
+            result.targets[i].continuationPoint.fromSdk(results[i].m_continuationPoint);
+
+            // update the data values
+            uint32_t noOfDataValues = results[i].m_dataValues.length();
+            result.targets[i].dataValues.resize(noOfDataValues);
+            for (uint32_t j = 0; j < noOfDataValues; j++)
+                result.targets[i].dataValues[j].fromSdk(UaDataValue(results[i].m_dataValues[j]));
+
+            // update the modification information
+            uint32_t noOfModificationInfos = results[i].m_modificationInformation.length();
+            result.targets[i].modificationInfos.resize(noOfModificationInfos);
+            for (uint32_t j = 0; j < noOfModificationInfos; j++)
+                result.targets[i].modificationInfos[j].fromSdk(
+                        results[i].m_modificationInformation[j]);
+        }
+        logger_->debug("HistoryReadRawModifiedResult for request %d (transaction %d):",
+                       handle, transactionId);
+        logger_->debug(result.toString());
+
+        // if the transaction id was found, call the completion handler of the request (if any)
+        if (transactionIdFound)
+            completeTransaction(transaction, result);
+        else
+            logger_->error("Unknown transaction id %d received", transactionId);
+
+        // call the callback interface
+        clientInterface_->historyReadRawModifiedComplete(result);
+    }
+
 }
@@ -23,20 +23,27 @@
 
 // STD
 #include <vector>
+#include <algorithm>
+#include <deque>
 #include <string>
 #include <sstream>
 // SDK
 #include "uabase/uasemaphore.h"
+#include "uabase/uathread.h"
 #include "uaclient/uaclientsdk.h"
 // UAF
 #include "uaf/util/logger.h"
 #include "uaf/client/clientexport.h"
 #include "uaf/client/database/database.h"
 #include "uaf/client/sessions/session.h"
+#include "uaf/client/sessions/pkistore.h"
+#include "uaf/client/sessions/asyncserviceworker.h"
 #include "uaf/client/discovery/discoverer.h"
 #include "uaf/client/clientinterface.h"
+#include "uaf/client/completionhandler.h"
 #include "uaf/client/requests/requests.h"
 #include "uaf/client/results/results.h"
+#include "uaf/client/invocations/invocations.h"
 #include "uaf/client/settings/allsettings.h"
 
 
@@ -44,6 +51,34 @@ namespace uaf
 {
 
 
+    /*******************************************************************************************//**
+    * A uaf::SessionStateListener is notified by the uaf::SessionFactory whenever the SDK reports
+    * a new state of a session (so the client can react immediately, e.g. by reconnecting).
+    *
+    * @ingroup ClientSessions
+    ***********************************************************************************************/
+    class UAF_EXPORT SessionStateListener
+    {
+    public:
+
+        /**
+         * Virtual destructor.
+         */
+        virtual ~SessionStateListener() {}
+
+        /**
+         * Called by the thread of the SDK that reported the new state, so it must return quickly.
+         *
+         * @param clientConnectionId    The id of the session.
+         * @param state                 The new state of the session.
+         */
+        virtual void sessionStateChanged(
+                uaf::ClientConnectionId             clientConnectionId,
+                uaf::sessionstates::SessionState    state) = 0;
+    };
+
+
+
     /*******************************************************************************************//**
     * An uaf::SessionFactory creates and owns uaf::Session instances.
     *
@@ -84,6 +119,21 @@ namespace uaf
         void deleteAllSessions();
 
 
+        /**
+         * Apply uaf::ClientSettings::asyncServiceMaxThreads (after the client settings were
+         * changed).
+         */
+        void updateAsyncServiceThreads();
+
+
+        /**
+         * Set the listener to notify of session state changes.
+         *
+         * @param listener  The listener (or NULL), which must outlive the session factory.
+         */
+        void setSessionStateListener(uaf::SessionStateListener* listener);
+
+
         /**
          * Manually connect to a specific server.
          *
@@ -139,10 +189,80 @@ namespace uaf
         /**
          * Do some housekeeping, such as reconnecting sessions that were disconnected, but that
          * had activities going on.
+         *
+         * The sessions are reconnected concurrently (by at most
+         * ClientSettings::reconnectMaxParallelConnects threads, and at most
+         * ClientSettings::reconnectMaxConnectsPerSec times per second). After a failed attempt,
+         * the sessions to the same server are not reconnected until an exponential backoff time
+         * has expired.
          */
         void doHouseKeeping();
 
 
+        /**
+         * Transfer the subscriptions that were lost together with their session, to the
+         * reconnected session (see uaf::ClientSettings::reconnectTransferSubscriptions).
+         *
+         * This is done by the house keeping, not by the SDK callbacks, since it invokes a
+         * TransferSubscriptions service per subscription. Subscriptions that wait for a transfer
+         * for longer than their lifetime (lifeTimeCount publishing intervals) are abandoned, so
+         * that their session is no longer kept alive (or reconnected) for them.
+         *
+         * @return True if some subscriptions were deleted, and must be created again.
+         */
+        bool transferSubscriptions();
+
+
+        /**
+         * Get the earliest time (in the future) at which a delayed reconnection attempt is due.
+         *
+         * @param time  Output parameter: the earliest time of the next reconnection attempt.
+         * @return      True if a reconnection attempt is delayed, false if not.
+         */
+        bool nextConnectionAttemptTime(uaf::DateTime& time);
+
+
+        /**
+         * Announce that the pre-connected servers may have changed (e.g. because the ClientSettings
+         * were changed), so that the client is not ready until preConnect() has been called
+         * again.
+         */
+        void requestPreConnection();
+
+
+        /**
+         * Connect sessions to the given servers (if they were not pre-connected already).
+         *
+         * The sessions are connected concurrently (by at most
+         * ClientSettings::reconnectMaxParallelConnects threads, and at most
+         * ClientSettings::reconnectMaxConnectsPerSec times per second). They remain open like
+         * manually connected sessions, so the ones that could not be connected are reconnected
+         * by the house keeping.
+         *
+         * @param serverUris    The server URIs of the servers to connect to.
+         */
+        void preConnect(const std::vector<std::string>& serverUris);
+
+
+        /**
+         * Check if all requested pre-connections have been made, and if all pre-connected
+         * sessions are connected.
+         *
+         * @return  True if the pre-connected sessions are ready to be used.
+         */
+        bool isReady();
+
+
+        /**
+         * Wait until the pre-connected sessions are ready to be used (see isReady()).
+         *
+         * @param timeoutSec    The maximum time to wait, in seconds.
+         * @return              Good if the sessions are ready, ClientNotReadyError if the
+         *                      timeout expired.
+         */
+        uaf::Status waitUntilReady(double timeoutSec);
+
+
         /**
          * Get some information about a particular session.
          *
@@ -262,6 +382,22 @@ namespace uaf
                std::vector<uaf::Status>&               results);
 
 
+        /**
+        * Modify the specified monitored items.
+        *
+        * @param clientHandles     The ClientHandles of the monitored items to be affected.
+        * @param settings          The new settings (one for each ClientHandle).
+        * @param serviceSettings   The service settings to be used.
+        * @param results           A vector of statuses (one result for each ClientHandle).
+        * @return                  The immediate result of the service call.
+        */
+        uaf::Status modifyMonitoredItems(
+               const std::vector<uaf::ClientHandle>&           clientHandles,
+               const std::vector<uaf::MonitoredItemSettings>&  settings,
+               const uaf::ServiceSettings*                     serviceSettings,
+               std::vector<uaf::Status>&                       results);
+
+
         /**
          * Get the definition of a structured datatype.
          *
@@ -275,6 +411,32 @@ namespace uaf
 				 uaf::StructureDefinition& 	definition);
 
 
+        /**
+         * Get the definition of a structured datatype of a particular server.
+         *
+         * The definitions are cached per server, and the sessions are asked for a definition
+         * without keeping the sessions locked (so other threads can still acquire sessions).
+         *
+         * @param serverUri     The URI of the server that owns the datatype (or an empty string
+         *                      to ask all connected servers).
+         * @param dataTypeId    The NodeId of the structured datatype.
+         * @param definition    Output parameter, the definition (if found).
+         * @return              DefinitionNotFoundError if no definition was found,
+         *                      Good otherwise.
+         */
+        uaf::Status structureDefinition(
+                const std::string&          serverUri,
+                const uaf::NodeId&          dataTypeId,
+                uaf::StructureDefinition&   definition);
+
+
+        /**
+         * Fetch the definitions of all structured datatypes of the connected servers that have
+         * not been prefetched yet.
+         */
+        void prefetchStructureDefinitions();
+
+
         template<typename _Service>
         typename _Service::Settings getServiceSettings(const typename _Service::Request&  request)
         {
@@ -323,13 +485,17 @@ namespace uaf
          * @param mask      The mask identifying the targets of the request that need to be included
          *                  in the invocation.
          * @param result    Output parameter: the result of the invocation.
+         * @param completionHandler  Optional handler to call when the result of an asynchronous
+         *                  request arrives. It is stored next to the transaction id, and it
+         *                  will be released (without being called) if the invocation fails.
          * @return          Good if the invocation went fine, bad if not.
          */
         template<typename _Service>
         uaf::Status invokeRequest(
                 const typename _Service::Request&  request,
                 const uaf::Mask&                   mask,
-                typename _Service::Result&         result)
+                typename _Service::Result&         result,
+                uaf::BaseCompletionHandler*        completionHandler = NULL)
         {
             logger_->debug("Invoking %sRequest %d", _Service::name().c_str(), request.requestHandle());
             logger_->debug("Mask is %s", mask.toString().c_str());
@@ -348,6 +514,8 @@ namespace uaf
             else
             {
                 ret = uaf::UnexpectedError("The mask does not match the number of targets");
+                if (completionHandler != NULL)
+                    completionHandler->release();
                 return ret;
             }
 
@@ -356,7 +524,8 @@ namespace uaf
 
             // store the UAF handle and map it to a transaction id, if request is asynchronous
             uaf::TransactionId transactionId;
-            bool handleStored = storeRequestHandleIfNeeded<_Service>(request, transactionId);
+            bool handleStored = storeRequestHandleIfNeeded<_Service>(
+                    request, completionHandler, transactionId);
 
             // create a map to store the invocations that we'll create
             typedef std::map<uaf::Session*, Invocation*> InvocationMap;
@@ -495,27 +664,45 @@ namespace uaf
                 invocation->setSessionInformation(session->sessionInformation());
 
                 // if the session is connected, invoke the service
-                if (session->isConnected())
+                bool deferred = false;
+                if (session->isConnected() && async && isDeferredRequest(request))
+                {
+                    // the SDK cannot invoke this service asynchronously, so a worker thread will
+                    // invoke it synchronously instead (and release the session afterwards)
+                    logger_->debug("Deferring the invocation for session %d to a worker thread",
+                                   session->clientConnectionId());
+                    ret = invocation->copyToResult(result);
+
+                    if (ret.isGood())
+                    {
+                        ret = deferInvocation(request, session, invocation);
+                        deferred = ret.isGood();
+                    }
+                }
+                else if (session->isConnected())
                 {
                     logger_->debug("Forwarding the invocation to session %d",
                                    session->clientConnectionId());
                     ret = session->invokeService<_Service>(request, *invocation);
+
+                    // copy all data to the result
+                    if (ret.isGood())
+                    {
+                        logger_->debug("Copying the invocation data to the result");
+                        ret = invocation->copyToResult(result);
+                    }
                 }
                 else
                     ret = session->sessionInformation().lastConnectionAttemptStatus;
 
-                // copy all data to the result
-                if (ret.isGood())
+                if (!deferred)
                 {
-                    logger_->debug("Copying the invocation data to the result");
-                    ret = invocation->copyToResult(result);
-                }
-
-                releaseSession(session);
+                    releaseSession(session);
 
-                // don't forget to delete the invocation!!!
-                // (see bugfix https://github.com/uaf/uaf/issues/86)
-                delete invocation;
+                    // don't forget to delete the invocation!!!
+                    // (see bugfix https://github.com/uaf/uaf/issues/86)
+                    delete invocation;
+                }
 
                 invocationIndex++;
             }
@@ -524,13 +711,15 @@ namespace uaf
             invocations.clear();
 
             // remove the handle if one was stored, and if there was an unexpected error
-            if (ret.isNotGood() && handleStored)
+            // (or if nothing was invoked, in which case no result will ever arrive)
+            if (handleStored && (ret.isNotGood() || invocationIndex == 0))
             {
                 logger_->debug("Removing the transaction id");
-                // remove the transaction id : request handle pair
-                transactionMapMutex_.lock();            // lock the map
-                transactionMap_.erase(transactionId);   // erase the key
-                transactionMapMutex_.unlock();          // unlock the map
+                // remove the transaction, and release its completion handler (if any)
+                Transaction transaction;
+                if (takeTransaction(transactionId, transaction)
+                        && transaction.completionHandler != NULL)
+                    transaction.completionHandler->release();
             }
 
             return ret;
@@ -543,6 +732,10 @@ namespace uaf
         DISALLOW_COPY_AND_ASSIGN(SessionFactory);
 
 
+        // the deferred invocations need to release their session and transaction when done
+        template<typename _Service> friend class DeferredServiceInvocation;
+
+
         // define a dataype for the number of activities associated with a specific session
         typedef uint32_t Activity;
 
@@ -550,8 +743,52 @@ namespace uaf
         typedef std::map<uaf::ClientConnectionId, uaf::Session*>   SessionMap;
         typedef std::map<uaf::ClientConnectionId, Activity>         ActivityMap;
 
-        // define a map to relate transaction ids with request handles
-        typedef std::map<uaf::TransactionId, uaf::RequestHandle>  TransactionMap;
+        // define the reconnection backoff of a server
+        struct ServerBackoff
+        {
+            ServerBackoff() : failedConnectionAttempts(0), lastFailedPass(0) {}
+            uint32_t        failedConnectionAttempts;
+            uaf::DateTime   nextConnectionAttemptTime;
+            // the reconnection pass in which the last failure was counted
+            uint32_t        lastFailedPass;
+        };
+        typedef std::map<std::string, ServerBackoff> ServerBackoffMap;
+
+        // a thread that helps to reconnect the sessions during the house keeping
+        class ReconnectionWorker : public UaThread
+        {
+        public:
+            ReconnectionWorker(uaf::SessionFactory* factory) : factory_(factory) {}
+            void run() { factory_->processReconnectionJobs(); }
+        private:
+            uaf::SessionFactory* factory_;
+        };
+        friend class ReconnectionWorker;
+
+        // a thread that helps to connect the sessions of the pre-connected servers
+        class PreConnectionWorker : public UaThread
+        {
+        public:
+            PreConnectionWorker(uaf::SessionFactory* factory) : factory_(factory) {}
+            void run() { factory_->processPreConnectionJobs(); }
+        private:
+            uaf::SessionFactory* factory_;
+        };
+        friend class PreConnectionWorker;
+
+        // define a map to relate the pre-connected server URIs with their sessions
+        typedef std::map<std::string, uaf::ClientConnectionId> PreConnectionMap;
+
+        // define the information that is stored for each asynchronous request in flight
+        struct Transaction
+        {
+            Transaction() : requestHandle(0), completionHandler(NULL) {}
+            uaf::RequestHandle          requestHandle;
+            uaf::BaseCompletionHandler* completionHandler;
+        };
+
+        // define a map to relate transaction ids with the request handles and completion handlers
+        typedef std::map<uaf::TransactionId, Transaction>  TransactionMap;
 
 
         /**
@@ -605,6 +842,56 @@ namespace uaf
         uaf::Status releaseSession(uaf::Session*& session, bool allowGarbageCollection=true);
 
 
+        /**
+         * Reconnect sessions until there are none left to reconnect (called by all threads of
+         * the house keeping).
+         */
+        void processReconnectionJobs();
+
+
+        /**
+         * Reconnect a single session, if it is still disconnected and if its server is not
+         * being backed off.
+         */
+        void reconnect(uaf::ClientConnectionId clientConnectionId);
+
+
+        /**
+         * Wait until the next connection attempt is allowed by the connect-rate limit.
+         */
+        void waitForConnectRateLimit();
+
+
+        /**
+         * Connect the sessions of the pre-connected servers until there are none left to
+         * connect (called by all threads of the pre-connection).
+         */
+        void processPreConnectionJobs();
+
+
+        /**
+         * Wake up the threads that are waiting until the client is ready, so that they check
+         * the readiness again.
+         */
+        void notifyReadinessWaiters();
+
+
+        /**
+         * Update the backoff of a server after a connection attempt.
+         *
+         * A server counts at most one failure per reconnection pass, no matter how many of its
+         * sessions failed to connect during that pass.
+         *
+         * @param serverUri     The URI of the server.
+         * @param connected     True if the connection attempt succeeded.
+         * @param session       The session that was (re)connected (its backoff will be updated).
+         */
+        void updateServerBackoff(
+                const std::string&  serverUri,
+                bool                connected,
+                uaf::Session*       session);
+
+
         /**
          * Get a new transaction id
          *
@@ -613,6 +900,42 @@ namespace uaf
         uaf::TransactionId getNewTransactionId();
 
 
+        /**
+         * Find a transaction and remove it from the transaction map.
+         *
+         * @param transactionId The transaction id of the asynchronous request.
+         * @param transaction   Output parameter: the removed transaction, if it was found.
+         * @return              True if the transaction was found.
+         */
+        bool takeTransaction(uaf::TransactionId transactionId, Transaction& transaction);
+
+
+        /**
+         * Call and release the completion handler of a transaction, if it has one.
+         *
+         * @tparam _Result      The type of the result.
+         * @param transaction   The transaction (as removed by takeTransaction()).
+         * @param result        The result to pass to the handler.
+         */
+        template<typename _Result>
+        void completeTransaction(const Transaction& transaction, const _Result& result)
+        {
+            if (transaction.completionHandler != NULL)
+            {
+                uaf::CompletionHandler<_Result>* handler =
+                        dynamic_cast<uaf::CompletionHandler<_Result>*>(transaction.completionHandler);
+
+                if (handler != NULL)
+                    handler->complete(result);
+                else
+                    logger_->error("The completion handler of request %d has the wrong type",
+                                   transaction.requestHandle);
+
+                transaction.completionHandler->release();
+            }
+        }
+
+
         /**
          * Receive connection errors caused by automatic retries
          *
@@ -672,6 +995,85 @@ namespace uaf
             const UaDiagnosticInfos& diagnosticInfos    //!< [in] List of diagnostic information
             );
 
+        /**
+         * Send history read results.
+         */
+        virtual void historyReadRawModifiedComplete(
+            OpcUa_UInt32                              transactionId,  //!< [in] Client defined transction id for the history read
+            const UaStatus&                           uaStatus,       //!< [in] Overall history read result
+            const UaClientSdk::HistoryReadDataResults& results,       //!< [in] List of history read results
+            const UaDiagnosticInfos&                  diagnosticInfos //!< [in] List of diagnostic information
+            );
+
+
+        /**
+         * Check if an asynchronous request must be deferred to the asyncServiceWorker_, because
+         * the SDK cannot invoke the corresponding service asynchronously.
+         *
+         * This default version returns false, the overloads for the deferred requests return true.
+         */
+        template<typename _Request>
+        static bool isDeferredRequest(const _Request& request) { return false; }
+        static bool isDeferredRequest(const uaf::AsyncBrowseRequest& request) { return true; }
+        static bool isDeferredRequest(const uaf::AsyncBrowseNextRequest& request) { return true; }
+        static bool isDeferredRequest(const uaf::AsyncTranslateBrowsePathsToNodeIdsRequest& request)
+        { return true; }
+
+
+        /**
+         * Hand over an invocation to the asyncServiceWorker_, which will invoke it synchronously,
+         * release the session, delete the invocation, and deliver the result to the client
+         * interface.
+         *
+         * This default version is never called (see isDeferredRequest()).
+         */
+        template<typename _Request, typename _Invocation>
+        uaf::Status deferInvocation(
+                const _Request&     request,
+                uaf::Session*       session,
+                _Invocation*        invocation)
+        { return uaf::UnexpectedError("This request cannot be deferred"); }
+        uaf::Status deferInvocation(
+                const uaf::AsyncBrowseRequest&      request,
+                uaf::Session*                       session,
+                uaf::BrowseInvocation*              invocation);
+        uaf::Status deferInvocation(
+                const uaf::AsyncBrowseNextRequest&  request,
+                uaf::Session*                       session,
+                uaf::BrowseNextInvocation*          invocation);
+        uaf::Status deferInvocation(
+                const uaf::AsyncTranslateBrowsePathsToNodeIdsRequest&  request,
+                uaf::Session*                                           session,
+                uaf::TranslateBrowsePathsToNodeIdsInvocation*           invocation);
+
+
+        /**
+         * Invoke a deferred invocation synchronously (called by a thread of the
+         * asyncServiceWorker_), and deliver its result.
+         *
+         * @param request       The asynchronous request.
+         * @param session       The session, which was acquired by invokeRequest() and which will
+         *                      be released by this method.
+         * @param invocation    The invocation, which will be deleted by this method.
+         * @param callback      The client interface method to call with the result.
+         */
+        template<typename _Service>
+        void executeDeferredInvocation(
+                const typename _Service::Request&   request,
+                uaf::Session*                       session,
+                typename _Service::Invocation*      invocation,
+                void (uaf::ClientInterface::*callback)(
+                        const typename _Service::Invocation::SessionResultType&));
+
+
+        /**
+         * Release the session and the transaction of a deferred invocation that was cancelled.
+         *
+         * @param session       The session to release.
+         * @param transactionId The transaction id of the deferred invocation.
+         */
+        void cancelDeferredInvocation(uaf::Session* session, uaf::TransactionId transactionId);
+
 
         /**
          * Generate a new transaction ID and store the request id of the associated request, if
@@ -684,6 +1086,7 @@ namespace uaf
          * subscription requests.
          *
          * @param request       The request for which we will store the request handle, if needed.
+         * @param completionHandler The handler to store next to the request handle (may be NULL).
          * @param transactionId Output parameter: the newly generated transaction id, if the return
          *                      value is true.
          * @return              True if a request handle was stored, false if not.
@@ -693,6 +1096,7 @@ namespace uaf
                 const uaf::BaseSessionRequest<typename _Service::Settings,
                                                typename _Service::RequestTarget,
                                                _Service::asynchronous>& request,
+                uaf::BaseCompletionHandler* completionHandler,
                 uaf::TransactionId& transactionId)
         {
             bool stored;
@@ -701,7 +1105,8 @@ namespace uaf
             {
                 transactionMapMutex_.lock();
                 transactionId = getNewTransactionId();
-                transactionMap_[transactionId] = request.requestHandle();
+                transactionMap_[transactionId].requestHandle     = request.requestHandle();
+                transactionMap_[transactionId].completionHandler = completionHandler;
                 transactionMapMutex_.unlock();
                 stored = true;
                 logger_->debug("A new transaction id %d was stored for request %d",
@@ -726,6 +1131,7 @@ namespace uaf
                 const uaf::BaseSubscriptionRequest<typename _Service::Settings,
                                                     typename _Service::RequestTarget,
                                                     _Service::asynchronous>& request,
+                uaf::BaseCompletionHandler* completionHandler,
                 uaf::TransactionId& transactionId)
         {
             // nothing to do
@@ -740,10 +1146,14 @@ namespace uaf
         uaf::Logger* logger_;
         // the client interface to call whenever an asynchronous message is received
         uaf::ClientInterface* clientInterface_;
+        // the listener to notify of session state changes (may be NULL)
+        uaf::SessionStateListener* sessionStateListener_;
         // the discoverer of the servers in the system
         uaf::Discoverer* discoverer_;
         // pointer to the client database
         uaf::Database* database_;
+        // the PKI material shared by all sessions
+        uaf::PkiStore pkiStore_;
 
         // the current transaction id, and a mutex to safely increment it
         uaf::TransactionId  transactionId_;
@@ -763,6 +1173,38 @@ namespace uaf
         // mutex to safely manipulate the activity map
         UaMutex activityMapMutex_;
 
+        // the reconnection backoffs per server URI
+        ServerBackoffMap serverBackoffMap_;
+        // the sessions that still need to be reconnected during the current house keeping
+        std::deque<uaf::ClientConnectionId> reconnectionJobs_;
+        // the number of the current reconnection pass (increased by every house keeping)
+        uint32_t reconnectionPass_;
+        // the earliest time at which the next connection attempt is allowed by the rate limit
+        uaf::DateTime nextConnectTime_;
+        // the state of the random generator for the backoff jitter
+        uint32_t jitterSeed_;
+        // mutex to safely manipulate the above reconnection state
+        UaMutex reconnectionMutex_;
+
+        // the sessions that were created by the pre-connection, per server URI
+        PreConnectionMap preConnectionMap_;
+        // the server URIs that still need to be pre-connected during the current pre-connection
+        std::deque<std::string> preConnectionJobs_;
+        // the number of times a pre-connection was requested, and the number of the request that
+        // was last handled by preConnect()
+        uint32_t preConnectionsRequested_;
+        uint32_t preConnectionsDone_;
+        // the number of threads that are waiting until the client is ready, and the semaphore
+        // that wakes them up
+        uint32_t readinessWaiters_;
+        UaSemaphore readinessSemaphore_;
+        // mutex to safely manipulate the above pre-connection state
+        UaMutex preConnectionMutex_;
+
+        // the threads that invoke the asynchronous requests that the SDK can only invoke
+        // synchronously (i.e. Browse, BrowseNext and TranslateBrowsePathsToNodeIds)
+        uaf::AsyncServiceWorker asyncServiceWorker_;
+
 
 
     };
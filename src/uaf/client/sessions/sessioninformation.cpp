@@ -34,7 +34,8 @@ namespace uaf
     : sessionState(uaf::sessionstates::Disconnected),
       serverState(uaf::serverstates::Unknown),
       clientConnectionId(0),
-      lastConnectionAttemptStep(uaf::connectionsteps::ActivateSession)
+      lastConnectionAttemptStep(uaf::connectionsteps::ActivateSession),
+      failedConnectionAttempts(0)
     {}
 
 
@@ -54,7 +55,8 @@ namespace uaf
         serverUri(serverUri),
         sessionSettings(sessionSettings),
         lastConnectionAttemptStatus(lastConnectionAttemptStatus),
-        lastConnectionAttemptStep(lastConnectionAttemptStep)
+        lastConnectionAttemptStep(lastConnectionAttemptStep),
+        failedConnectionAttempts(0)
     {}
 
 
@@ -89,7 +91,18 @@ namespace uaf
 
         ss << indent << " - lastConnectionAttemptStatus";
         ss << fillToPos(ss, colon);
-        ss << ": " << lastConnectionAttemptStatus.toString();
+        ss << ": " << lastConnectionAttemptStatus.toString() << "\n";
+
+        ss << indent << " - nextConnectionAttemptTime";
+        ss << fillToPos(ss, colon);
+        if (nextConnectionAttemptTime.isNull())
+            ss << ": NULL\n";
+        else
+            ss << ": " << nextConnectionAttemptTime.toString() << "\n";
+
+        ss << indent << " - failedConnectionAttempts";
+        ss << fillToPos(ss, colon);
+        ss << ": " << failedConnectionAttempts;
 
         return ss.str();
     }
@@ -104,7 +117,9 @@ namespace uaf
                && object1.sessionState == object2.sessionState
                && object1.serverState == object2.serverState
                && object1.lastConnectionAttemptStep == object2.lastConnectionAttemptStep
-               && object1.lastConnectionAttemptStatus == object2.lastConnectionAttemptStatus;
+               && object1.lastConnectionAttemptStatus == object2.lastConnectionAttemptStatus
+               && object1.nextConnectionAttemptTime == object2.nextConnectionAttemptTime
+               && object1.failedConnectionAttempts == object2.failedConnectionAttempts;
     }
 
 
@@ -128,6 +143,10 @@ namespace uaf
             return object1.lastConnectionAttemptStep < object2.lastConnectionAttemptStep;
         else if (object1.lastConnectionAttemptStatus != object2.lastConnectionAttemptStatus)
             return object1.lastConnectionAttemptStatus < object2.lastConnectionAttemptStatus;
+        else if (object1.nextConnectionAttemptTime != object2.nextConnectionAttemptTime)
+            return object1.nextConnectionAttemptTime < object2.nextConnectionAttemptTime;
+        else if (object1.failedConnectionAttempts != object2.failedConnectionAttempts)
+            return object1.failedConnectionAttempts < object2.failedConnectionAttempts;
         else if (object1.sessionState != object2.sessionState)
             return object1.sessionState < object2.sessionState;
         else
@@ -98,6 +98,12 @@ namespace uaf
         /** The step of the last connection attempt. */
         uaf::connectionsteps::ConnectionStep lastConnectionAttemptStep;
 
+        /** The earliest time of the next reconnection attempt (null if it isn't delayed). */
+        uaf::DateTime                       nextConnectionAttemptTime;
+
+        /** The number of consecutive failed attempts to connect to the server of the session. */
+        uint32_t                            failedConnectionAttempts;
+
         /**
          * Get a string representation of the information.
          */
@@ -49,11 +49,23 @@ namespace uaf
       discoveryFindServersTimeoutSec(2.0),
       discoveryGetEndpointsTimeoutSec(1.0),
       discoveryIntervalSec(30.0),
+      discoveryMaxParallelRequests(10),
+      discoveryServerTimeToLiveSec(0.0),
+      discoveryEndpointsTimeToLiveSec(60.0),
       discoveryOnNetworkEnable(false),
       discoveryOnNetworkTimeoutSec(30.0),
       discoveryOnNetworkDiscoveryServer("opc.tcp://localhost"),
       discoveryOnNetworkStartingRecordId(0),
       discoveryOnNetworkMaxRecordsToReturn(0),
+      reconnectMaxParallelConnects(10),
+      reconnectMaxConnectsPerSec(20.0),
+      reconnectInitialBackoffSec(1.0),
+      reconnectMaxBackoffSec(60.0),
+      reconnectBackoffJitter(0.2),
+      reconnectTransferSubscriptions(true),
+      asyncServiceMaxThreads(4),
+      preConnectAllDiscoveredServers(false),
+      prefetchStructureDefinitions(false),
       certificateTrustListLocation("PKI/trusted/certs/"),
       certificateRevocationListLocation("PKI/trusted/crl/"),
       issuersCertificatesLocation("PKI/issuers/certs/"),
@@ -72,11 +84,23 @@ namespace uaf
       discoveryFindServersTimeoutSec(2.0),
       discoveryGetEndpointsTimeoutSec(1.0),
       discoveryIntervalSec(30.0),
+      discoveryMaxParallelRequests(10),
+      discoveryServerTimeToLiveSec(0.0),
+      discoveryEndpointsTimeToLiveSec(60.0),
       discoveryOnNetworkEnable(false),
       discoveryOnNetworkTimeoutSec(30.0),
       discoveryOnNetworkDiscoveryServer("opc.tcp://localhost"),
       discoveryOnNetworkStartingRecordId(0),
       discoveryOnNetworkMaxRecordsToReturn(0),
+      reconnectMaxParallelConnects(10),
+      reconnectMaxConnectsPerSec(20.0),
+      reconnectInitialBackoffSec(1.0),
+      reconnectMaxBackoffSec(60.0),
+      reconnectBackoffJitter(0.2),
+      reconnectTransferSubscriptions(true),
+      asyncServiceMaxThreads(4),
+      preConnectAllDiscoveredServers(false),
+      prefetchStructureDefinitions(false),
       certificateTrustListLocation("PKI/trusted/certs/"),
       certificateRevocationListLocation("PKI/trusted/crl/"),
       issuersCertificatesLocation("PKI/issuers/certs/"),
@@ -98,11 +122,23 @@ namespace uaf
       discoveryFindServersTimeoutSec(2.0),
       discoveryGetEndpointsTimeoutSec(1.0),
       discoveryIntervalSec(30.0),
+      discoveryMaxParallelRequests(10),
+      discoveryServerTimeToLiveSec(0.0),
+      discoveryEndpointsTimeToLiveSec(60.0),
       discoveryOnNetworkEnable(false),
       discoveryOnNetworkTimeoutSec(30.0),
       discoveryOnNetworkDiscoveryServer("opc.tcp://localhost"),
       discoveryOnNetworkStartingRecordId(0),
       discoveryOnNetworkMaxRecordsToReturn(0),
+      reconnectMaxParallelConnects(10),
+      reconnectMaxConnectsPerSec(20.0),
+      reconnectInitialBackoffSec(1.0),
+      reconnectMaxBackoffSec(60.0),
+      reconnectBackoffJitter(0.2),
+      reconnectTransferSubscriptions(true),
+      asyncServiceMaxThreads(4),
+      preConnectAllDiscoveredServers(false),
+      prefetchStructureDefinitions(false),
       certificateTrustListLocation("PKI/trusted/certs/"),
       certificateRevocationListLocation("PKI/trusted/crl/"),
       issuersCertificatesLocation("PKI/issuers/certs/"),
@@ -257,6 +293,18 @@ namespace uaf
         ss << fillToPos(ss, colon);
         ss << ": " << discoveryIntervalSec << "\n";
 
+        ss << indent << " - discoveryMaxParallelRequests";
+        ss << fillToPos(ss, colon);
+        ss << ": " << discoveryMaxParallelRequests << "\n";
+
+        ss << indent << " - discoveryServerTimeToLiveSec";
+        ss << fillToPos(ss, colon);
+        ss << ": " << discoveryServerTimeToLiveSec << "\n";
+
+        ss << indent << " - discoveryEndpointsTimeToLiveSec";
+        ss << fillToPos(ss, colon);
+        ss << ": " << discoveryEndpointsTimeToLiveSec << "\n";
+
         ss << indent << " - discoveryFindServersTimeoutSec";
         ss << fillToPos(ss, colon);
         ss << ": " << discoveryFindServersTimeoutSec << "\n";
@@ -304,6 +352,61 @@ namespace uaf
         ss << fillToPos(ss, colon);
         ss << ": " << discoveryOnNetworkMaxRecordsToReturn << "\n";
 
+        ss << indent << " - reconnectMaxParallelConnects";
+        ss << fillToPos(ss, colon);
+        ss << ": " << reconnectMaxParallelConnects << "\n";
+
+        ss << indent << " - reconnectMaxConnectsPerSec";
+        ss << fillToPos(ss, colon);
+        ss << ": " << reconnectMaxConnectsPerSec << "\n";
+
+        ss << indent << " - reconnectInitialBackoffSec";
+        ss << fillToPos(ss, colon);
+        ss << ": " << reconnectInitialBackoffSec << "\n";
+
+        ss << indent << " - reconnectMaxBackoffSec";
+        ss << fillToPos(ss, colon);
+        ss << ": " << reconnectMaxBackoffSec << "\n";
+
+        ss << indent << " - reconnectBackoffJitter";
+        ss << fillToPos(ss, colon);
+        ss << ": " << reconnectBackoffJitter << "\n";
+
+        ss << indent << " - reconnectTransferSubscriptions";
+        ss << fillToPos(ss, colon);
+        ss << ": " << (reconnectTransferSubscriptions ? "true" : "false") << "\n";
+
+        ss << indent << " - asyncServiceMaxThreads";
+        ss << fillToPos(ss, colon);
+        ss << ": " << asyncServiceMaxThreads << "\n";
+
+        ss << indent << " - preConnectServerUris[]";
+
+        if (preConnectServerUris.size() == 0)
+        {
+            ss << fillToPos(ss, colon);
+            ss << ": []\n";
+        }
+        else
+        {
+            ss << "\n";
+
+            for (size_t i = 0; i<preConnectServerUris.size(); i++)
+            {
+                ss << indent << "    - " << "preConnectServerUris[" << i << "]";
+                fillToPos(ss, colon);
+                ss << ": " << preConnectServerUris[i] << "\n";
+            }
+        }
+
+        ss << indent << " - preConnectAllDiscoveredServers";
+        ss << fillToPos(ss, colon);
+        ss << ": " << (preConnectAllDiscoveredServers ? "true" : "false") << "\n";
+
+        ss << indent << " - prefetchStructureDefinitions";
+        ss << fillToPos(ss, colon);
+        ss << ": " << (prefetchStructureDefinitions ? "true" : "false") << "\n";
+
         ss << indent << " - certificateTrustListLocation";
         ss << fillToPos(ss, colon);
         ss << ": " << certificateTrustListLocation << "\n";
@@ -383,6 +486,9 @@ namespace uaf
         ss << indent << " - defaultSetMonitoringModeSettings\n";
         ss << defaultSetMonitoringModeSettings.toString(indent + "   ", colon) << "\n";
 
+        ss << indent << " - defaultModifyMonitoredItemsSettings\n";
+        ss << defaultModifyMonitoredItemsSettings.toString(indent + "   ", colon) << "\n";
+
 
 
 
@@ -404,12 +510,25 @@ namespace uaf
                && object1.logToCallbackLevel == object2.logToCallbackLevel
                && object1.discoveryFindServersTimeoutSec == object2.discoveryFindServersTimeoutSec
                && object1.discoveryGetEndpointsTimeoutSec == object2.discoveryGetEndpointsTimeoutSec
+               && object1.discoveryMaxParallelRequests == object2.discoveryMaxParallelRequests
+               && object1.discoveryServerTimeToLiveSec == object2.discoveryServerTimeToLiveSec
+               && object1.discoveryEndpointsTimeToLiveSec == object2.discoveryEndpointsTimeToLiveSec
                && object1.discoveryOnNetworkEnable == object2.discoveryOnNetworkEnable
                && object1.discoveryOnNetworkTimeoutSec == object2.discoveryOnNetworkTimeoutSec
                && object1.discoveryOnNetworkDiscoveryServer == object2.discoveryOnNetworkDiscoveryServer
                && object1.discoveryOnNetworkStartingRecordId == object2.discoveryOnNetworkStartingRecordId
                && object1.discoveryOnNetworkServerCapabilities == object2.discoveryOnNetworkServerCapabilities
                && object1.discoveryOnNetworkMaxRecordsToReturn == object2.discoveryOnNetworkMaxRecordsToReturn
+               && object1.reconnectMaxParallelConnects == object2.reconnectMaxParallelConnects
+               && object1.reconnectMaxConnectsPerSec == object2.reconnectMaxConnectsPerSec
+               && object1.reconnectInitialBackoffSec == object2.reconnectInitialBackoffSec
+               && object1.reconnectMaxBackoffSec == object2.reconnectMaxBackoffSec
+               && object1.reconnectBackoffJitter == object2.reconnectBackoffJitter
+               && object1.reconnectTransferSubscriptions == object2.reconnectTransferSubscriptions
+               && object1.asyncServiceMaxThreads == object2.asyncServiceMaxThreads
+               && object1.preConnectServerUris == object2.preConnectServerUris
+               && object1.preConnectAllDiscoveredServers == object2.preConnectAllDiscoveredServers
+               && object1.prefetchStructureDefinitions == object2.prefetchStructureDefinitions
                && object1.certificateTrustListLocation == object2.certificateTrustListLocation
                && object1.certificateRevocationListLocation == object2.certificateRevocationListLocation
                && object1.issuersCertificatesLocation == object2.issuersCertificatesLocation
@@ -450,6 +569,12 @@ namespace uaf
             return object1.discoveryFindServersTimeoutSec < object2.discoveryFindServersTimeoutSec;
         else if (object1.discoveryGetEndpointsTimeoutSec != object2.discoveryGetEndpointsTimeoutSec)
             return object1.discoveryGetEndpointsTimeoutSec < object2.discoveryGetEndpointsTimeoutSec;
+        else if (object1.discoveryMaxParallelRequests != object2.discoveryMaxParallelRequests)
+            return object1.discoveryMaxParallelRequests < object2.discoveryMaxParallelRequests;
+        else if (object1.discoveryServerTimeToLiveSec != object2.discoveryServerTimeToLiveSec)
+            return object1.discoveryServerTimeToLiveSec < object2.discoveryServerTimeToLiveSec;
+        else if (object1.discoveryEndpointsTimeToLiveSec != object2.discoveryEndpointsTimeToLiveSec)
+            return object1.discoveryEndpointsTimeToLiveSec < object2.discoveryEndpointsTimeToLiveSec;
         else if (object1.discoveryOnNetworkEnable != object2.discoveryOnNetworkEnable)
             return object1.discoveryOnNetworkEnable < object2.discoveryOnNetworkEnable;
         else if (object1.discoveryOnNetworkTimeoutSec != object2.discoveryOnNetworkTimeoutSec)
@@ -460,6 +585,26 @@ namespace uaf
             return object1.discoveryOnNetworkStartingRecordId < object2.discoveryOnNetworkStartingRecordId;
         else if (object1.discoveryOnNetworkMaxRecordsToReturn != object2.discoveryOnNetworkMaxRecordsToReturn)
             return object1.discoveryOnNetworkMaxRecordsToReturn < object2.discoveryOnNetworkMaxRecordsToReturn;
+        else if (object1.reconnectMaxParallelConnects != object2.reconnectMaxParallelConnects)
+            return object1.reconnectMaxParallelConnects < object2.reconnectMaxParallelConnects;
+        else if (object1.reconnectMaxConnectsPerSec != object2.reconnectMaxConnectsPerSec)
+            return object1.reconnectMaxConnectsPerSec < object2.reconnectMaxConnectsPerSec;
+        else if (object1.reconnectInitialBackoffSec != object2.reconnectInitialBackoffSec)
+            return object1.reconnectInitialBackoffSec < object2.reconnectInitialBackoffSec;
+        else if (object1.reconnectMaxBackoffSec != object2.reconnectMaxBackoffSec)
+            return object1.reconnectMaxBackoffSec < object2.reconnectMaxBackoffSec;
+        else if (object1.reconnectBackoffJitter != object2.reconnectBackoffJitter)
+            return object1.reconnectBackoffJitter < object2.reconnectBackoffJitter;
+        else if (object1.reconnectTransferSubscriptions != object2.reconnectTransferSubscriptions)
+            return object1.reconnectTransferSubscriptions < object2.reconnectTransferSubscriptions;
+        else if (object1.asyncServiceMaxThreads != object2.asyncServiceMaxThreads)
+            return object1.asyncServiceMaxThreads < object2.asyncServiceMaxThreads;
+        else if (object1.preConnectServerUris != object2.preConnectServerUris)
+            return object1.preConnectServerUris < object2.preConnectServerUris;
+        else if (object1.preConnectAllDiscoveredServers != object2.preConnectAllDiscoveredServers)
+            return object1.preConnectAllDiscoveredServers < object2.preConnectAllDiscoveredServers;
+        else if (object1.prefetchStructureDefinitions != object2.prefetchStructureDefinitions)
+            return object1.prefetchStructureDefinitions < object2.prefetchStructureDefinitions;
         else if (object1.certificateTrustListLocation != object2.certificateTrustListLocation)
             return object1.certificateTrustListLocation < object2.certificateTrustListLocation;
         else if (object1.certificateRevocationListLocation != object2.certificateRevocationListLocation)
@@ -70,6 +70,9 @@ namespace uaf
          *  - discoveryFindServersTimeoutSec : 2.0
          *  - discoveryGetEndpointsTimeoutSec : 1.0
          *  - discoveryIntervalSec : 30.0
+         *  - discoveryMaxParallelRequests : 10
+         *  - discoveryServerTimeToLiveSec : 0.0
+         *  - discoveryEndpointsTimeToLiveSec : 60.0
          *  - discoveryOnNetworkEnable: false,
          *  - discoveryOnNetworkTimeoutSec: 30.0
          *  - discoveryOnNetworkDiscoveryServer: "opc.tcp://localhost"
@@ -78,6 +81,16 @@ namespace uaf
          *  - discoveryOnNetworkMaxRecordsToReturn: 0
          *  - logToStdOutLevel : uaf::loglevels::Disabled
          *  - logToCallbackLevel : uaf::loglevels::Disabled
+         *  - reconnectMaxParallelConnects : 10
+         *  - reconnectMaxConnectsPerSec : 20.0
+         *  - reconnectInitialBackoffSec : 1.0
+         *  - reconnectMaxBackoffSec : 60.0
+         *  - reconnectBackoffJitter : 0.2
+         *  - reconnectTransferSubscriptions : true
+         *  - asyncServiceMaxThreads : 4
+         *  - preConnectServerUris : []
+         *  - preConnectAllDiscoveredServers : false
+         *  - prefetchStructureDefinitions : false
          *  - certificateTrustListLocation : "PKI/trusted/certs/"
          *  - certificateRevocationListLocation : "PKI/trusted/crl/"
          *  - issuersCertificatesLocation : "PKI/issuers/certs/"
@@ -144,6 +157,22 @@ namespace uaf
          *  background, in seconds. */
         float discoveryIntervalSec;
 
+        /** The maximum number of discovery servers that are invoked concurrently during a
+         *  discovery cycle. Default: 10. 0 = no limit. */
+        uint32_t discoveryMaxParallelRequests;
+
+        /** The time a discovered server is remembered after its discovery server was last able
+         *  to report it, in seconds. This avoids that the servers of a temporarily unavailable
+         *  discovery server disappear immediately. Default: 0.0 = forget them immediately. */
+        float discoveryServerTimeToLiveSec;
+
+        /** The time the endpoint descriptions of a discovery URL are cached, in seconds. While
+         *  they are cached, sessions connect without invoking the GetEndpoints service first.
+         *  The cache is refreshed when a connection fails in a way that may be caused by outdated
+         *  endpoint descriptions (a certificate or security mismatch).
+         *  Default: 60.0. 0.0 = no caching. */
+        float discoveryEndpointsTimeToLiveSec;
+
         /** If true, the FindServersOnNetwork service will be called automatically, on every
          * discovery cycle. Default: false. */
         bool discoveryOnNetworkEnable;
@@ -168,6 +197,71 @@ namespace uaf
         uint32_t discoveryOnNetworkMaxRecordsToReturn;
 
 
+        /////// Reconnection ///////
+
+        /** The maximum number of disconnected sessions that are reconnected concurrently.
+         *  Default: 10. 0 = no limit. */
+        uint32_t reconnectMaxParallelConnects;
+
+        /** The maximum number of reconnection attempts per second (for all servers together),
+         *  to avoid that all servers are flooded after a network outage.
+         *  Default: 20.0. 0.0 = no limit. */
+        float reconnectMaxConnectsPerSec;
+
+        /** The time to wait before reconnecting to a server after the first failed attempt,
+         *  in seconds. The time is doubled after every subsequent failure. Default: 1.0. */
+        float reconnectInitialBackoffSec;
+
+        /** The maximum time to wait before reconnecting to a server, in seconds. Default: 60.0. */
+        float reconnectMaxBackoffSec;
+
+        /** The relative random variation of the backoff times (e.g. 0.2 means +/- 20%), so that
+         *  the sessions of different servers don't retry in lock step. Default: 0.2. */
+        float reconnectBackoffJitter;
+
+        /** Set this flag to true to transfer the subscriptions of a lost session to the new
+         *  session (via the TransferSubscriptions service), so that their monitored items don't
+         *  have to be created again. Only the subscriptions that the server no longer has are
+         *  created again (together with their monitored items). A subscription waits for its
+         *  transfer at most lifeTimeCount publishing intervals (after which the server has
+         *  deleted it anyway), so a session is not kept alive forever for it. Default: true. */
+        bool reconnectTransferSubscriptions;
+
+
+        /////// Asynchronous services ///////
+
+        /** The maximum number of threads that invoke the asynchronous Browse, BrowseNext and
+         *  TranslateBrowsePathsToNodeIds requests (which the SDK can only invoke synchronously).
+         *  Each request occupies a thread until its server has responded, so raise this number if
+         *  some servers respond slowly. Default: 4. */
+        uint32_t asyncServiceMaxThreads;
+
+
+        /////// Pre-connection ///////
+
+        /** The server URIs of the servers to connect to in the background as soon as possible
+         *  (i.e. right after the ClientSettings are set and the servers are discovered), instead
+         *  of when the first request is processed. The sessions are created with the
+         *  specificSessionSettings of the server (or the defaultSessionSettings), and they remain
+         *  connected like manually connected sessions. Use uaf::Client::waitUntilReady to wait
+         *  for them. Default: [] */
+        std::vector<std::string> preConnectServerUris;
+
+        /** If true, a session is created in the background to every server that is discovered
+         *  (in addition to the preConnectServerUris). Default: false. */
+        bool preConnectAllDiscoveredServers;
+
+
+        /////// Structure definitions ///////
+
+        /** If true, the definitions of all structured DataTypes of a server are fetched in the
+         *  background as soon as a session to the server is connected (and again when its
+         *  NamespaceArray has changed), so that decoding a structure doesn't have to wait for
+         *  the server. If false, the definitions are fetched (and cached) one by one, when they
+         *  are needed. Default: false. */
+        bool prefetchStructureDefinitions;
+
+
         /////// Security ///////
 
         /** The trust list location.
@@ -248,6 +342,7 @@ namespace uaf
         uaf::WriteSettings                          defaultWriteSettings;
         uaf::ServiceSettings                        defaultSetPublishingModeSettings;
         uaf::ServiceSettings                        defaultSetMonitoringModeSettings;
+        uaf::ServiceSettings                        defaultModifyMonitoredItemsSettings;
 
         /**
          * The default session settings.
@@ -38,6 +38,7 @@ namespace uaf
         watchdogTimeoutSec         = 2.0;
         watchdogTimeSec            = 5.0;
         unique                     = false;
+        publishRequestCount        = 0;
 
     }
 
@@ -62,6 +63,9 @@ namespace uaf
         ss << indent << " - unique";
         ss << fillToPos(ss, colon);
         ss << ": " << (unique ? "true" : "false") << "\n";
+        ss << indent << " - publishRequestCount";
+        ss << fillToPos(ss, colon);
+        ss << ": " << publishRequestCount << "\n";
         ss << indent << " - readServerInfoSettings\n";
         ss << readServerInfoSettings.toString(indent + "   ", colon).c_str() << '\n';
         ss << indent << " - securitySettings\n";
@@ -87,6 +91,8 @@ namespace uaf
             return int(object1.watchdogTimeSec*1000) < int(object2.watchdogTimeSec*1000);
         else if (object1.unique != object2.unique)
             return object1.unique < object2.unique;
+        else if (object1.publishRequestCount != object2.publishRequestCount)
+            return object1.publishRequestCount < object2.publishRequestCount;
         else if (object1.readServerInfoSettings != object2.readServerInfoSettings)
             return object1.readServerInfoSettings < object2.readServerInfoSettings;
         else if (object1.securitySettings != object2.securitySettings)
@@ -107,6 +113,7 @@ namespace uaf
            &&    (int(object1.watchdogTimeoutSec*1000) == int(object2.watchdogTimeoutSec*1000))
            &&    (int(object1.watchdogTimeSec*1000)    == int(object2.watchdogTimeSec*1000)))
            &&    object1.unique == object2.unique
+           &&    object1.publishRequestCount == object2.publishRequestCount
            &&    object1.readServerInfoSettings == object2.readServerInfoSettings
            &&    object1.securitySettings == object2.securitySettings;
     }
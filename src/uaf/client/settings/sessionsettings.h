@@ -52,11 +52,12 @@ namespace uaf
          * Construct default settings.
          *
          * The following default values are given:
-         *   - sessionTimeoutSec  = 1200.0
-         *   - connectTimeoutSec  = 2.0
-         *   - watchdogTimeoutSec = 2.0
-         *   - watchdogTimeSec    = 5.0
-         *   - unique             = false
+         *   - sessionTimeoutSec   = 1200.0
+         *   - connectTimeoutSec   = 2.0
+         *   - watchdogTimeoutSec  = 2.0
+         *   - watchdogTimeSec     = 5.0
+         *   - unique              = false
+         *   - publishRequestCount = 0
          */
         SessionSettings();
 
@@ -75,6 +76,13 @@ namespace uaf
         /** Should this session that uses these settings be unique, or not? **/
         bool        unique;
 
+        /** The number of publish requests that the session keeps outstanding on the server, or 0
+         *  to leave it to the SDK. At high notification rates, more outstanding publish requests
+         *  allow the server to send the next notification message without waiting for the client.
+         *  The count is given to the SDK when the UAF connects the session, so it is not changed
+         *  while the session stays connected (or is reconnected automatically by the SDK). **/
+        uint32_t    publishRequestCount;
+
         /** The settings to be used to read the namespace array and server array, when the session
          *  is first connected (UAF clients will do this automatically in the background). */
         uaf::ReadSettings readServerInfoSettings;
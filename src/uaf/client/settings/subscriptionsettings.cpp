@@ -39,6 +39,12 @@ namespace uaf
         maxKeepAliveCount          = 5;
         maxNotificationsPerPublish = 0;
         priority                   = 0;
+        keepAliveClientHandles     = true;
+        batchDataChanges           = false;
+        batchEvents                = false;
+        republishMissingNotifications = false;
+        maxRepublishCount          = 100;
+        maxMonitoredItemsPerSubscription = 0;
 
     }
 
@@ -72,7 +78,31 @@ namespace uaf
 
         ss << indent << " - priority";
         ss << fillToPos(ss, colon);
-        ss << ": " << int(priority);
+        ss << ": " << int(priority) << "\n";
+
+        ss << indent << " - keepAliveClientHandles";
+        ss << fillToPos(ss, colon);
+        ss << ": " << (keepAliveClientHandles ? string("true") : string("false")) << "\n";
+
+        ss << indent << " - batchDataChanges";
+        ss << fillToPos(ss, colon);
+        ss << ": " << (batchDataChanges ? string("true") : string("false")) << "\n";
+
+        ss << indent << " - batchEvents";
+        ss << fillToPos(ss, colon);
+        ss << ": " << (batchEvents ? string("true") : string("false")) << "\n";
+
+        ss << indent << " - republishMissingNotifications";
+        ss << fillToPos(ss, colon);
+        ss << ": " << (republishMissingNotifications ? string("true") : string("false")) << "\n";
+
+        ss << indent << " - maxRepublishCount";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxRepublishCount << "\n";
+
+        ss << indent << " - maxMonitoredItemsPerSubscription";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxMonitoredItemsPerSubscription;
 
         return ss.str();
     }
@@ -107,7 +137,14 @@ namespace uaf
               && (object1.lifeTimeCount == object2.lifeTimeCount)
               && (object1.maxKeepAliveCount == object2.maxKeepAliveCount)
               && (object1.maxNotificationsPerPublish == object2.maxNotificationsPerPublish)
-              && (object1.priority == object2.priority));
+              && (object1.priority == object2.priority)
+              && (object1.keepAliveClientHandles == object2.keepAliveClientHandles)
+              && (object1.batchDataChanges == object2.batchDataChanges)
+              && (object1.batchEvents == object2.batchEvents)
+              && (object1.republishMissingNotifications == object2.republishMissingNotifications)
+              && (object1.maxRepublishCount == object2.maxRepublishCount)
+              && (object1.maxMonitoredItemsPerSubscription
+                      == object2.maxMonitoredItemsPerSubscription));
     }
 
 
@@ -139,6 +176,20 @@ namespace uaf
             return object1.maxKeepAliveCount < object2.maxKeepAliveCount;
         else if (object1.priority != object2.priority)
             return object1.priority < object2.priority;
+        else if (object1.keepAliveClientHandles != object2.keepAliveClientHandles)
+            return object1.keepAliveClientHandles < object2.keepAliveClientHandles;
+        else if (object1.batchDataChanges != object2.batchDataChanges)
+            return object1.batchDataChanges < object2.batchDataChanges;
+        else if (object1.batchEvents != object2.batchEvents)
+            return object1.batchEvents < object2.batchEvents;
+        else if (object1.republishMissingNotifications != object2.republishMissingNotifications)
+            return object1.republishMissingNotifications < object2.republishMissingNotifications;
+        else if (object1.maxRepublishCount != object2.maxRepublishCount)
+            return object1.maxRepublishCount < object2.maxRepublishCount;
+        else if (object1.maxMonitoredItemsPerSubscription
+                     != object2.maxMonitoredItemsPerSubscription)
+            return object1.maxMonitoredItemsPerSubscription
+                       < object2.maxMonitoredItemsPerSubscription;
         else
             return false;
     }
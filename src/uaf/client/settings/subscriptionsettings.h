@@ -57,6 +57,12 @@ namespace uaf
          *   - maxKeepAliveCount          = 5
          *   - maxNotificationsPerPublish = 0
          *   - priority                   = 0
+         *   - keepAliveClientHandles     = true
+         *   - batchDataChanges           = false
+         *   - batchEvents                = false
+         *   - republishMissingNotifications = false
+         *   - maxRepublishCount          = 100
+         *   - maxMonitoredItemsPerSubscription = 0
          */
         SubscriptionSettings();
 
@@ -80,6 +86,50 @@ namespace uaf
         /** The priority of the subscription. */
         uint8_t priority;
 
+        /** Set this flag to false to leave uaf::KeepAliveNotification::clientHandles empty.
+            Copying the ClientHandles of all monitored items on every keep alive message
+            becomes expensive for subscriptions with many monitored items, so if you don't
+            need them, you can avoid this cost by disabling them. */
+        bool keepAliveClientHandles;
+
+        /** Set this flag to true to receive the data changes of the subscription as a
+            uaf::DataChangeNotificationBatch (via uaf::ClientInterface::dataChangeBatchReceived)
+            instead of as a vector of uaf::DataChangeNotification instances (via
+            uaf::ClientInterface::dataChangesReceived). */
+        bool batchDataChanges;
+
+        /** Set this flag to true in order to receive the events of the subscription as one
+            uaf::EventNotificationBatch per monitored item per publish response (via
+            uaf::ClientInterface::eventBatchReceived) instead of as a vector of
+            uaf::EventNotification instances (via uaf::ClientInterface::eventsReceived). */
+        bool batchEvents;
+
+        /** Set this flag to true to recover missing notifications (i.e. gaps in the sequence
+            numbers of the notification messages, e.g. due to transient network congestion) by
+            requesting them again from the server via the Republish service. The Republish
+            service is invoked by a background thread of the session, while the notifications
+            that are received in the meantime are held back, so all notifications are still
+            delivered in their original order. A server restart (i.e. a reset of the sequence
+            numbers) is not considered to be a gap. The notifications that cannot be recovered
+            are still reported via uaf::ClientInterface::notificationsMissing. */
+        bool republishMissingNotifications;
+
+        /** The maximum number of notification messages to republish for a single gap. Larger gaps
+            are not recovered but only reported, because re-reading the monitored items is
+            probably cheaper then. */
+        uint32_t maxRepublishCount;
+
+        /** The maximum number of monitored items per subscription, or 0 for no maximum.
+            If a maximum is given, the monitored items created with these settings are spread
+            over as many subscriptions (with these same settings) as needed. New items are placed
+            in the subscriptions with the fewest monitored items first. Since the monitored items
+            are always identified by their ClientHandle, this is invisible to the other services.
+            Asynchronous requests are not spread, so they are placed as a whole in the least
+            loaded subscription that has room for them. An asynchronous request with more
+            monitored items than the maximum gets a new subscription of its own, which exceeds
+            the maximum (a warning is logged). */
+        uint32_t maxMonitoredItemsPerSubscription;
+
         /**
          * Get a string representation of the settings.
          *
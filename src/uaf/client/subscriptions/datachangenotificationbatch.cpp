@@ -0,0 +1,145 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/subscriptions/datachangenotificationbatch.h"
+
+// STD
+#include <limits>
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+    using std::vector;
+    using std::size_t;
+
+
+    // Convert a scalar numeric OPC UA variant to a double (or NaN if it's not numeric)
+    // =============================================================================================
+    static double toNumericValue(const OpcUa_Variant& variant)
+    {
+        if (variant.ArrayType == OpcUa_VariantArrayType_Scalar)
+        {
+            switch (variant.Datatype)
+            {
+                case OpcUaType_Boolean: return variant.Value.Boolean ? 1.0 : 0.0;
+                case OpcUaType_SByte:   return double(variant.Value.SByte);
+                case OpcUaType_Byte:    return double(variant.Value.Byte);
+                case OpcUaType_Int16:   return double(variant.Value.Int16);
+                case OpcUaType_UInt16:  return double(variant.Value.UInt16);
+                case OpcUaType_Int32:   return double(variant.Value.Int32);
+                case OpcUaType_UInt32:  return double(variant.Value.UInt32);
+                case OpcUaType_Int64:   return double(variant.Value.Int64);
+                case OpcUaType_UInt64:  return double(variant.Value.UInt64);
+                case OpcUaType_Float:   return double(variant.Value.Float);
+                case OpcUaType_Double:  return variant.Value.Double;
+                default:                break;
+            }
+        }
+
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+
+    // Convert an OPC UA timestamp to seconds since the epoch (or 0.0 if it's null)
+    // =============================================================================================
+    static double toCtime(const OpcUa_DateTime& uaDateTime)
+    {
+        DateTime dateTime;
+        dateTime.fromSdk(UaDateTime(uaDateTime));
+        return dateTime.isNull() ? 0.0 : dateTime.ctime();
+    }
+
+
+    // Constructor
+    // =============================================================================================
+    DataChangeNotificationBatch::DataChangeNotificationBatch()
+    : clientConnectionId(0),
+      clientSubscriptionHandle(0)
+    {}
+
+
+    // Reserve memory
+    // =============================================================================================
+    void DataChangeNotificationBatch::reserve(size_t noOfNotifications)
+    {
+        clientHandles.reserve(noOfNotifications);
+        statusCodes.reserve(noOfNotifications);
+        sourceTimestamps.reserve(noOfNotifications);
+        serverTimestamps.reserve(noOfNotifications);
+        numericValues.reserve(noOfNotifications);
+        values.reserve(noOfNotifications);
+    }
+
+
+    // Add a notification
+    // =============================================================================================
+    void DataChangeNotificationBatch::append(
+            ClientHandle            clientHandle,
+            const OpcUa_DataValue&  dataValue)
+    {
+        clientHandles.push_back(clientHandle);
+        statusCodes.push_back(dataValue.StatusCode);
+        sourceTimestamps.push_back(toCtime(dataValue.SourceTimestamp));
+        serverTimestamps.push_back(toCtime(dataValue.ServerTimestamp));
+        numericValues.push_back(toNumericValue(dataValue.Value));
+        values.push_back(Variant(dataValue.Value));
+    }
+
+
+    // Get a string representation
+    // =============================================================================================
+    string DataChangeNotificationBatch::toString(const string& indent, size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - clientConnectionId";
+        ss << fillToPos(ss, colon);
+        ss << ": " << clientConnectionId << "\n";
+
+        ss << indent << " - clientSubscriptionHandle";
+        ss << fillToPos(ss, colon);
+        ss << ": " << clientSubscriptionHandle << "\n";
+
+        ss << indent << " - notifications[]";
+
+        if (clientHandles.size() == 0)
+        {
+            ss << fillToPos(ss, colon);
+            ss << ": []";
+        }
+
+        for (size_t i = 0; i < clientHandles.size(); i++)
+        {
+            ss << "\n";
+            ss << indent << "    - notifications[" << i << "]";
+            ss << fillToPos(ss, colon);
+            ss << ": clientHandle=" << clientHandles[i]
+               << ", statusCode=0x" << std::hex << statusCodes[i] << std::dec
+               << ", data=" << values[i].toString();
+        }
+
+        return ss.str();
+    }
+
+}
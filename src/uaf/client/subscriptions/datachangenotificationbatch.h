@@ -0,0 +1,134 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_DATACHANGENOTIFICATIONBATCH_H_
+#define UAF_DATACHANGENOTIFICATIONBATCH_H_
+
+
+// STD
+#include <vector>
+#include <string>
+#include <sstream>
+// SDK
+#include "uabase/uadatetime.h"
+// UAF
+#include "uaf/util/variant.h"
+#include "uaf/util/datetime.h"
+#include "uaf/util/stringifiable.h"
+#include "uaf/util/handles.h"
+#include "uaf/client/clientexport.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::DataChangeNotificationBatch holds all data change notifications of a single publish
+    * response in a "columnar" way.
+    *
+    * Instead of one uaf::DataChangeNotification per monitored item, the batch holds one vector per
+    * field (the ClientHandles, the status codes, the timestamps, ...), so that all notifications
+    * can be handled at once. The i-th element of each vector belongs to the i-th notification.
+    *
+    * Batches are only produced for subscriptions of which the
+    * uaf::SubscriptionSettings::batchDataChanges flag is true, and they are delivered by
+    * uaf::ClientInterface::dataChangeBatchReceived.
+    *
+    * @ingroup ClientSubscriptions
+    ***********************************************************************************************/
+    class UAF_EXPORT DataChangeNotificationBatch
+    {
+    public:
+
+        /**
+         * Construct an empty batch.
+         */
+        DataChangeNotificationBatch();
+
+
+        /** The id of the session that hosts the subscription. */
+        uaf::ClientConnectionId clientConnectionId;
+
+        /** The handle of the subscription that received the notifications. */
+        uaf::ClientSubscriptionHandle clientSubscriptionHandle;
+
+        /** The ClientHandles of the monitored items. */
+        std::vector<uaf::ClientHandle> clientHandles;
+
+        /** The OPC UA status codes of the data values. */
+        std::vector<uint32_t> statusCodes;
+
+        /** The source timestamps of the data values, in seconds since the epoch
+            (like uaf::DateTime::ctime), or 0.0 if the server didn't provide one. */
+        std::vector<double> sourceTimestamps;
+
+        /** The server timestamps of the data values, in seconds since the epoch
+            (like uaf::DateTime::ctime), or 0.0 if the server didn't provide one. */
+        std::vector<double> serverTimestamps;
+
+        /** The data values converted to a double, if they are numeric scalars (Boolean, integer
+            or floating point types). Values of any other type are represented by NaN. */
+        std::vector<double> numericValues;
+
+        /** The data values, as they were received. */
+        std::vector<uaf::Variant> values;
+
+
+        /**
+         * Get the number of notifications in the batch.
+         *
+         * @return  The number of notifications.
+         */
+        std::size_t size() const { return clientHandles.size(); }
+
+
+        /**
+         * Reserve memory for the given number of notifications.
+         *
+         * @param noOfNotifications     The expected number of notifications.
+         */
+        void reserve(std::size_t noOfNotifications);
+
+
+#ifndef SWIG
+        /**
+         * Add a notification to the batch.
+         *
+         * @param clientHandle  The ClientHandle of the monitored item.
+         * @param dataValue     The data value as received by the SDK.
+         */
+        void append(uaf::ClientHandle clientHandle, const OpcUa_DataValue& dataValue);
+#endif
+
+
+        /**
+         * Get a string representation of the batch.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=28) const;
+    };
+
+
+}
+
+
+
+
+#endif /* UAF_DATACHANGENOTIFICATIONBATCH_H_ */
@@ -0,0 +1,248 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/subscriptions/eventnotificationbatch.h"
+
+// STD
+#include <limits>
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+    using std::vector;
+    using std::size_t;
+
+
+    // Convert a scalar OPC UA variant of a numeric column to a double (or NaN)
+    // =============================================================================================
+    static double toNumericValue(const OpcUa_Variant& variant)
+    {
+        if (variant.ArrayType == OpcUa_VariantArrayType_Scalar)
+        {
+            switch (variant.Datatype)
+            {
+                case OpcUaType_Boolean:     return variant.Value.Boolean ? 1.0 : 0.0;
+                case OpcUaType_SByte:       return double(variant.Value.SByte);
+                case OpcUaType_Byte:        return double(variant.Value.Byte);
+                case OpcUaType_Int16:       return double(variant.Value.Int16);
+                case OpcUaType_UInt16:      return double(variant.Value.UInt16);
+                case OpcUaType_Int32:       return double(variant.Value.Int32);
+                case OpcUaType_UInt32:      return double(variant.Value.UInt32);
+                case OpcUaType_Int64:       return double(variant.Value.Int64);
+                case OpcUaType_UInt64:      return double(variant.Value.UInt64);
+                case OpcUaType_Float:       return double(variant.Value.Float);
+                case OpcUaType_Double:      return variant.Value.Double;
+                case OpcUaType_StatusCode:  return double(variant.Value.StatusCode);
+                case OpcUaType_DateTime:
+                {
+                    DateTime dateTime;
+                    dateTime.fromSdk(UaDateTime(variant.Value.DateTime));
+                    return dateTime.ctime();
+                }
+                default:                    break;
+            }
+        }
+
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+
+    // Convert a scalar OPC UA variant of a string column to a string (or an empty string)
+    // =============================================================================================
+    static string toStringValue(const OpcUa_Variant& variant)
+    {
+        if (variant.ArrayType == OpcUa_VariantArrayType_Scalar)
+        {
+            switch (variant.Datatype)
+            {
+                case OpcUaType_String:
+                    return string(UaString(&variant.Value.String).toUtf8());
+                case OpcUaType_LocalizedText:
+                    if (variant.Value.LocalizedText != OpcUa_Null)
+                        return string(UaString(&variant.Value.LocalizedText->Text).toUtf8());
+                    break;
+                case OpcUaType_QualifiedName:
+                    if (variant.Value.QualifiedName != OpcUa_Null)
+                        return string(UaString(&variant.Value.QualifiedName->Name).toUtf8());
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        return string();
+    }
+
+
+    // Constructor
+    // =============================================================================================
+    EventNotificationBatch::EventNotificationBatch()
+    : clientConnectionId(0),
+      clientSubscriptionHandle(0),
+      clientHandle(0),
+      noOfEvents_(0)
+    {}
+
+
+    // Allocate the columns
+    // =============================================================================================
+    void EventNotificationBatch::resize(size_t noOfEvents)
+    {
+        noOfEvents_ = noOfEvents;
+        numericValues.assign(schema.columnCount(EventSchema::ColumnType_Numeric) * noOfEvents,
+                             std::numeric_limits<double>::quiet_NaN());
+        stringValues.assign(schema.columnCount(EventSchema::ColumnType_String) * noOfEvents,
+                            string());
+        values.assign(schema.columnCount(EventSchema::ColumnType_Variant) * noOfEvents,
+                      Variant());
+    }
+
+
+    // Get a numeric value
+    // =============================================================================================
+    double EventNotificationBatch::numericValue(size_t eventIndex, size_t fieldIndex) const
+    {
+        if (   eventIndex < noOfEvents_
+            && fieldIndex < schema.fieldCount()
+            && schema.columnType(fieldIndex) == EventSchema::ColumnType_Numeric
+            && valueIndex(eventIndex, fieldIndex) < numericValues.size())
+            return numericValues[valueIndex(eventIndex, fieldIndex)];
+        else
+            return std::numeric_limits<double>::quiet_NaN();
+    }
+
+
+    // Get a string value
+    // =============================================================================================
+    string EventNotificationBatch::stringValue(size_t eventIndex, size_t fieldIndex) const
+    {
+        if (   eventIndex < noOfEvents_
+            && fieldIndex < schema.fieldCount()
+            && schema.columnType(fieldIndex) == EventSchema::ColumnType_String
+            && valueIndex(eventIndex, fieldIndex) < stringValues.size())
+            return stringValues[valueIndex(eventIndex, fieldIndex)];
+        else
+            return string();
+    }
+
+
+    // Get a variant value
+    // =============================================================================================
+    Variant EventNotificationBatch::value(size_t eventIndex, size_t fieldIndex) const
+    {
+        if (   eventIndex < noOfEvents_
+            && fieldIndex < schema.fieldCount()
+            && schema.columnType(fieldIndex) == EventSchema::ColumnType_Variant
+            && valueIndex(eventIndex, fieldIndex) < values.size())
+            return values[valueIndex(eventIndex, fieldIndex)];
+        else
+            return Variant();
+    }
+
+
+    // Store the fields of an event
+    // =============================================================================================
+    void EventNotificationBatch::set(size_t eventIndex, const OpcUa_EventFieldList& eventFieldList)
+    {
+        if (eventIndex >= noOfEvents_)
+            return;
+
+        size_t noOfFields = size_t(eventFieldList.NoOfEventFields);
+        if (noOfFields > schema.fieldCount())
+            noOfFields = schema.fieldCount();
+
+        for (size_t fieldIndex = 0; fieldIndex < noOfFields; fieldIndex++)
+        {
+            const OpcUa_Variant& field = eventFieldList.EventFields[fieldIndex];
+            size_t i = valueIndex(eventIndex, fieldIndex);
+
+            switch (schema.columnType(fieldIndex))
+            {
+                case EventSchema::ColumnType_Numeric:
+                    numericValues[i] = toNumericValue(field);
+                    break;
+                case EventSchema::ColumnType_String:
+                    stringValues[i] = toStringValue(field);
+                    break;
+                default:
+                    values[i] = Variant(field);
+                    break;
+            }
+        }
+    }
+
+
+    // Get a string representation
+    // =============================================================================================
+    string EventNotificationBatch::toString(const string& indent, size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - clientConnectionId";
+        ss << fillToPos(ss, colon);
+        ss << ": " << clientConnectionId << "\n";
+
+        ss << indent << " - clientSubscriptionHandle";
+        ss << fillToPos(ss, colon);
+        ss << ": " << clientSubscriptionHandle << "\n";
+
+        ss << indent << " - clientHandle";
+        ss << fillToPos(ss, colon);
+        ss << ": " << clientHandle << "\n";
+
+        ss << indent << " - schema\n";
+        ss << schema.toString(indent + "   ", colon) << "\n";
+
+        ss << indent << " - events[]";
+
+        if (noOfEvents_ == 0)
+        {
+            ss << fillToPos(ss, colon);
+            ss << ": []";
+        }
+
+        for (size_t i = 0; i < noOfEvents_; i++)
+        {
+            ss << "\n";
+            ss << indent << "    - events[" << i << "]";
+            ss << fillToPos(ss, colon);
+            ss << ":";
+
+            for (size_t j = 0; j < schema.fieldCount(); j++)
+            {
+                ss << (j == 0 ? " " : ", ") << schema.fieldName(j) << "=";
+
+                if (schema.columnType(j) == EventSchema::ColumnType_Numeric)
+                    ss << numericValue(i, j);
+                else if (schema.columnType(j) == EventSchema::ColumnType_String)
+                    ss << stringValue(i, j);
+                else
+                    ss << value(i, j).toString();
+            }
+        }
+
+        return ss.str();
+    }
+
+}
@@ -0,0 +1,178 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_EVENTNOTIFICATIONBATCH_H_
+#define UAF_EVENTNOTIFICATIONBATCH_H_
+
+
+// STD
+#include <vector>
+#include <string>
+#include <sstream>
+// SDK
+#include "uabase/uaplatformlayer.h"
+#include "uabase/uastring.h"
+#include "uabase/uadatetime.h"
+// UAF
+#include "uaf/util/variant.h"
+#include "uaf/util/datetime.h"
+#include "uaf/util/stringifiable.h"
+#include "uaf/util/handles.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/subscriptions/eventschema.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::EventNotificationBatch holds the events of a single monitored item that were received
+    * in a single publish response, in a "columnar" way.
+    *
+    * Each field of the events (i.e. each select clause of the event filter) is stored in a column
+    * of the type that is described by the uaf::EventSchema of the monitored item: numeric fields
+    * are stored as doubles, string fields as strings, and all other fields as variants.
+    * The columns of the same type are stored one after the other in a single vector, so the
+    * value of event e of field f is stored at index
+    * <tt>schema.columnIndex(f) * size() + e</tt> of the vector that corresponds to
+    * <tt>schema.columnType(f)</tt>. The numericValue(), stringValue() and value() methods do this
+    * calculation for you.
+    *
+    * Batches are only produced for subscriptions of which the
+    * uaf::SubscriptionSettings::batchEvents flag is true, and they are delivered by
+    * uaf::ClientInterface::eventBatchReceived.
+    *
+    * @ingroup ClientSubscriptions
+    ***********************************************************************************************/
+    class UAF_EXPORT EventNotificationBatch
+    {
+    public:
+
+        /**
+         * Construct an empty batch.
+         */
+        EventNotificationBatch();
+
+
+        /** The id of the session that hosts the subscription. */
+        uaf::ClientConnectionId clientConnectionId;
+
+        /** The handle of the subscription that received the events. */
+        uaf::ClientSubscriptionHandle clientSubscriptionHandle;
+
+        /** The ClientHandle of the monitored item that received the events. */
+        uaf::ClientHandle clientHandle;
+
+        /** The schema of the events (compiled from the event filter of the monitored item). */
+        uaf::EventSchema schema;
+
+        /** The numeric columns: numeric, Boolean and StatusCode fields as they are, and DateTime
+            fields in seconds since the epoch (like uaf::DateTime::ctime). Values of another type
+            than expected are represented by NaN. */
+        std::vector<double> numericValues;
+
+        /** The string columns: the String fields, the text of the LocalizedText fields and the
+            name of the QualifiedName fields. Values of another type than expected are
+            represented by an empty string. */
+        std::vector<std::string> stringValues;
+
+        /** The variant columns: all other fields, as they were received. */
+        std::vector<uaf::Variant> values;
+
+
+        /**
+         * Get the number of events in the batch.
+         *
+         * @return  The number of events.
+         */
+        std::size_t size() const { return noOfEvents_; }
+
+
+        /**
+         * Allocate the columns for the given number of events (at once).
+         *
+         * @param noOfEvents    The number of events.
+         */
+        void resize(std::size_t noOfEvents);
+
+
+        /**
+         * Get the value of a numeric field (or NaN if the field is not numeric).
+         *
+         * @param eventIndex    The index of the event.
+         * @param fieldIndex    The index of the field (see uaf::EventSchema::fieldIndex).
+         */
+        double numericValue(std::size_t eventIndex, std::size_t fieldIndex) const;
+
+
+        /**
+         * Get the value of a string field (or an empty string if the field is not a string).
+         *
+         * @param eventIndex    The index of the event.
+         * @param fieldIndex    The index of the field (see uaf::EventSchema::fieldIndex).
+         */
+        std::string stringValue(std::size_t eventIndex, std::size_t fieldIndex) const;
+
+
+        /**
+         * Get the value of a variant field (or a null variant if the field is numeric or a
+         * string).
+         *
+         * @param eventIndex    The index of the event.
+         * @param fieldIndex    The index of the field (see uaf::EventSchema::fieldIndex).
+         */
+        uaf::Variant value(std::size_t eventIndex, std::size_t fieldIndex) const;
+
+
+#ifndef SWIG
+        /**
+         * Store the fields of an event in the columns.
+         *
+         * @param eventIndex        The index of the event (must be smaller than size()).
+         * @param eventFieldList    The fields of the event, as received by the SDK.
+         */
+        void set(std::size_t eventIndex, const OpcUa_EventFieldList& eventFieldList);
+#endif
+
+
+        /**
+         * Get a string representation of the batch.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=28) const;
+
+
+    private:
+
+        // the number of events
+        std::size_t noOfEvents_;
+
+        // the index of a value within the vector of its column type
+        std::size_t valueIndex(std::size_t eventIndex, std::size_t fieldIndex) const
+        { return schema.columnIndex(fieldIndex) * noOfEvents_ + eventIndex; }
+    };
+
+
+}
+
+
+
+
+#endif /* UAF_EVENTNOTIFICATIONBATCH_H_ */
@@ -0,0 +1,235 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/subscriptions/eventschema.h"
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+    using std::vector;
+    using std::size_t;
+
+
+    // Get the expected type of a standard event field (or Null if the field is not known)
+    // =============================================================================================
+    static opcuatypes::OpcUaType knownFieldType(const string& fieldName)
+    {
+        // BaseEventType
+        if      (fieldName == "EventId")                return opcuatypes::ByteString;
+        else if (fieldName == "EventType")              return opcuatypes::NodeId;
+        else if (fieldName == "SourceNode")             return opcuatypes::NodeId;
+        else if (fieldName == "SourceName")             return opcuatypes::String;
+        else if (fieldName == "Time")                   return opcuatypes::DateTime;
+        else if (fieldName == "ReceiveTime")            return opcuatypes::DateTime;
+        else if (fieldName == "Message")                return opcuatypes::LocalizedText;
+        else if (fieldName == "Severity")               return opcuatypes::UInt16;
+        // ConditionType
+        else if (fieldName == "ConditionName")          return opcuatypes::String;
+        else if (fieldName == "BranchId")               return opcuatypes::NodeId;
+        else if (fieldName == "Retain")                 return opcuatypes::Boolean;
+        else if (fieldName == "EnabledState")           return opcuatypes::LocalizedText;
+        else if (fieldName == "EnabledState/Id")        return opcuatypes::Boolean;
+        else if (fieldName == "Quality")                return opcuatypes::StatusCode;
+        else if (fieldName == "LastSeverity")           return opcuatypes::UInt16;
+        else if (fieldName == "Comment")                return opcuatypes::LocalizedText;
+        else if (fieldName == "ClientUserId")           return opcuatypes::String;
+        // AcknowledgeableConditionType and AlarmConditionType
+        else if (fieldName == "AckedState")             return opcuatypes::LocalizedText;
+        else if (fieldName == "AckedState/Id")          return opcuatypes::Boolean;
+        else if (fieldName == "ConfirmedState")         return opcuatypes::LocalizedText;
+        else if (fieldName == "ConfirmedState/Id")      return opcuatypes::Boolean;
+        else if (fieldName == "ActiveState")            return opcuatypes::LocalizedText;
+        else if (fieldName == "ActiveState/Id")         return opcuatypes::Boolean;
+        else if (fieldName == "SuppressedOrShelved")    return opcuatypes::Boolean;
+        else                                            return opcuatypes::Null;
+    }
+
+
+    // Get the column type of an OPC UA type
+    // =============================================================================================
+    static EventSchema::ColumnType toColumnType(opcuatypes::OpcUaType type)
+    {
+        switch (type)
+        {
+            case opcuatypes::Boolean:
+            case opcuatypes::SByte:
+            case opcuatypes::Byte:
+            case opcuatypes::Int16:
+            case opcuatypes::UInt16:
+            case opcuatypes::Int32:
+            case opcuatypes::UInt32:
+            case opcuatypes::Int64:
+            case opcuatypes::UInt64:
+            case opcuatypes::Float:
+            case opcuatypes::Double:
+            case opcuatypes::DateTime:
+            case opcuatypes::StatusCode:    return EventSchema::ColumnType_Numeric;
+            case opcuatypes::String:
+            case opcuatypes::LocalizedText:
+            case opcuatypes::QualifiedName: return EventSchema::ColumnType_String;
+            default:                        return EventSchema::ColumnType_Variant;
+        }
+    }
+
+
+    // Constructor
+    // =============================================================================================
+    EventSchema::EventSchema()
+    {
+        columnCounts_[ColumnType_Numeric] = 0;
+        columnCounts_[ColumnType_String]  = 0;
+        columnCounts_[ColumnType_Variant] = 0;
+    }
+
+
+    // Constructor
+    // =============================================================================================
+    EventSchema::EventSchema(const EventFilter& eventFilter)
+    {
+        columnCounts_[ColumnType_Numeric] = 0;
+        columnCounts_[ColumnType_String]  = 0;
+        columnCounts_[ColumnType_Variant] = 0;
+
+        for (size_t i = 0; i < eventFilter.selectClauses.size(); i++)
+        {
+            const SimpleAttributeOperand& selectClause = eventFilter.selectClauses[i];
+
+            // the name is the browse path, or the attribute if there is no browse path
+            string name;
+            if (selectClause.browsePath.empty())
+            {
+                name = attributeids::toString(selectClause.attributeId);
+            }
+            else
+            {
+                for (size_t j = 0; j < selectClause.browsePath.size(); j++)
+                {
+                    if (j > 0)
+                        name += "/";
+                    name += selectClause.browsePath[j].name();
+                }
+            }
+
+            opcuatypes::OpcUaType type = opcuatypes::Null;
+            if (selectClause.attributeId == attributeids::Value)
+                type = knownFieldType(name);
+
+            ColumnType columnType = toColumnType(type);
+
+            fieldNames_.push_back(name);
+            fieldTypes_.push_back(type);
+            columnTypes_.push_back(columnType);
+            columnIndexes_.push_back(columnCounts_[columnType]++);
+
+            // if several fields have the same name, the first one can be found by name
+            if (fieldIndexes_.find(name) == fieldIndexes_.end())
+                fieldIndexes_[name] = int(i);
+        }
+    }
+
+
+    // Get the index of a field
+    // =============================================================================================
+    int EventSchema::fieldIndex(const string& fieldName) const
+    {
+        std::map<string, int>::const_iterator it = fieldIndexes_.find(fieldName);
+        return it == fieldIndexes_.end() ? -1 : it->second;
+    }
+
+
+    // Get the name of a field
+    // =============================================================================================
+    string EventSchema::fieldName(size_t fieldIndex) const
+    {
+        return fieldIndex < fieldNames_.size() ? fieldNames_[fieldIndex] : string();
+    }
+
+
+    // Get the expected type of a field
+    // =============================================================================================
+    opcuatypes::OpcUaType EventSchema::fieldType(size_t fieldIndex) const
+    {
+        return fieldIndex < fieldTypes_.size() ? fieldTypes_[fieldIndex] : opcuatypes::Null;
+    }
+
+
+    // Get the column type of a field
+    // =============================================================================================
+    EventSchema::ColumnType EventSchema::columnType(size_t fieldIndex) const
+    {
+        return fieldIndex < columnTypes_.size() ? columnTypes_[fieldIndex] : ColumnType_Variant;
+    }
+
+
+    // Get the column index of a field
+    // =============================================================================================
+    size_t EventSchema::columnIndex(size_t fieldIndex) const
+    {
+        return fieldIndex < columnIndexes_.size() ? columnIndexes_[fieldIndex] : 0;
+    }
+
+
+    // Get the number of columns of a kind
+    // =============================================================================================
+    size_t EventSchema::columnCount(ColumnType columnType) const
+    {
+        return columnCounts_[columnType];
+    }
+
+
+    // Get a string representation
+    // =============================================================================================
+    string EventSchema::toString(const string& indent, size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - fields[]";
+
+        if (fieldNames_.empty())
+        {
+            ss << fillToPos(ss, colon);
+            ss << ": []";
+        }
+
+        for (size_t i = 0; i < fieldNames_.size(); i++)
+        {
+            ss << "\n";
+            ss << indent << "    - fields[" << i << "]";
+            ss << fillToPos(ss, colon);
+            ss << ": " << fieldNames_[i]
+               << " (" << opcuatypes::toString(fieldTypes_[i]) << ", ";
+
+            if (columnTypes_[i] == ColumnType_Numeric)
+                ss << "numeric";
+            else if (columnTypes_[i] == ColumnType_String)
+                ss << "string";
+            else
+                ss << "variant";
+
+            ss << " column " << columnIndexes_[i] << ")";
+        }
+
+        return ss.str();
+    }
+
+}
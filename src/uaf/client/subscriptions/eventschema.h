@@ -0,0 +1,164 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_EVENTSCHEMA_H_
+#define UAF_EVENTSCHEMA_H_
+
+
+// STD
+#include <vector>
+#include <string>
+#include <sstream>
+#include <map>
+// SDK
+// UAF
+#include "uaf/util/stringifiable.h"
+#include "uaf/util/opcuatypes.h"
+#include "uaf/util/eventfilter.h"
+#include "uaf/client/clientexport.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::EventSchema describes the columns of a uaf::EventNotificationBatch.
+    *
+    * The schema is compiled once per monitored item, from the select clauses of its event filter.
+    * Each field (i.e. each select clause) gets a name, an expected type and a column:
+    *  - the name is the browse path of the select clause, joined by '/' (e.g. "Severity" or
+    *    "ActiveState/Id"), or the name of the attribute if the browse path is empty (e.g.
+    *    "NodeId" for the ConditionId);
+    *  - the expected type is known for the standard fields of the BaseEventType and of the
+    *    ConditionType and AlarmConditionType (e.g. UInt16 for "Severity"), and Null for any other
+    *    field;
+    *  - the column is a numeric column (numeric, Boolean, DateTime and StatusCode fields),
+    *    a string column (String, LocalizedText and QualifiedName fields) or a variant column
+    *    (any other field, including the fields of unknown type).
+    *
+    * @ingroup ClientSubscriptions
+    ***********************************************************************************************/
+    class UAF_EXPORT EventSchema
+    {
+    public:
+
+
+        /**
+         * The kind of column that holds the values of a field.
+         */
+        enum ColumnType
+        {
+            ColumnType_Numeric  = 0, //!< The values are stored as doubles.
+            ColumnType_String   = 1, //!< The values are stored as strings.
+            ColumnType_Variant  = 2  //!< The values are stored as variants.
+        };
+
+
+        /**
+         * Construct an empty schema.
+         */
+        EventSchema();
+
+
+        /**
+         * Compile the schema of the given event filter.
+         *
+         * @param eventFilter   The event filter of the monitored item.
+         */
+        EventSchema(const uaf::EventFilter& eventFilter);
+
+
+        /**
+         * Get the number of fields.
+         */
+        std::size_t fieldCount() const { return fieldNames_.size(); }
+
+
+        /**
+         * Get the index of a field.
+         *
+         * @param fieldName The name of the field (e.g. "Severity").
+         * @return          The index of the field, or -1 if there is no such field.
+         */
+        int fieldIndex(const std::string& fieldName) const;
+
+
+        /**
+         * Get the name of a field (or an empty string if the index is out of bounds).
+         */
+        std::string fieldName(std::size_t fieldIndex) const;
+
+
+        /**
+         * Get the expected type of a field (or Null if the type is unknown, or the index is out
+         * of bounds).
+         */
+        uaf::opcuatypes::OpcUaType fieldType(std::size_t fieldIndex) const;
+
+
+        /**
+         * Get the kind of column that holds the values of a field.
+         */
+        uaf::EventSchema::ColumnType columnType(std::size_t fieldIndex) const;
+
+
+        /**
+         * Get the index of the column that holds the values of a field, among the columns of the
+         * same kind (e.g. the 2nd numeric column has index 1).
+         */
+        std::size_t columnIndex(std::size_t fieldIndex) const;
+
+
+        /**
+         * Get the number of columns of the given kind.
+         */
+        std::size_t columnCount(uaf::EventSchema::ColumnType columnType) const;
+
+
+        /**
+         * Get a string representation.
+         *
+         * @return  A string representation.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=20) const;
+
+
+    private:
+
+        // the names, expected types, column types and column indexes of the fields
+        std::vector<std::string>                fieldNames_;
+        std::vector<uaf::opcuatypes::OpcUaType> fieldTypes_;
+        std::vector<ColumnType>                 columnTypes_;
+        std::vector<std::size_t>                columnIndexes_;
+
+        // the number of columns per column type
+        std::size_t columnCounts_[3];
+
+        // the index of each field, per name
+        std::map<std::string, int> fieldIndexes_;
+    };
+
+
+}
+
+
+
+#endif /* UAF_EVENTSCHEMA_H_ */
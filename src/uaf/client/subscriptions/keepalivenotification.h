@@ -60,7 +60,8 @@ namespace uaf
 
 
         /** The clientMonitoredItem handles of the monitored items that are owned by the
-         * subscription that got a keep alive message. */
+         * subscription that got a keep alive message. Empty if the
+         * uaf::SubscriptionSettings::keepAliveClientHandles flag of the subscription was false. */
         ClientHandles clientHandles;
 
 
@@ -36,6 +36,7 @@
 #include "uaf/util/handles.h"
 #include "uaf/client/clientexport.h"
 #include "uaf/client/settings/monitoreditemsettings.h"
+#include "uaf/client/subscriptions/eventschema.h"
 #include "uaf/client/database/database.h"
 
 namespace uaf
@@ -72,6 +73,10 @@ namespace uaf
 
         /** The revised queue size on the server side. */
         uint32_t revisedQueueSize;
+
+        /** The schema of the events (for monitored events only), compiled once from the event
+         * filter when the monitored item is created. */
+        uaf::EventSchema eventSchema;
     };
 }
 
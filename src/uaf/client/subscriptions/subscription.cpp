@@ -48,7 +48,13 @@ namespace uaf
       clientConnectionId_(clientConnectionId),
       database_(database),
       clientInterface_(clientInterface),
-      clientHandle_(0)
+      clientHandle_(0),
+      noOfNotificationGaps_(0),
+      noOfMissingNotifications_(0),
+      noOfRecoveredNotifications_(0),
+      recovering_(false),
+      transferPending_(false),
+      publishRequestCount_(0)
     {
         // build the logger name:
         stringstream loggerName;
@@ -95,6 +101,7 @@ namespace uaf
         UaClientSdk::SubscriptionSettings subscriptionSettings;
         subscriptionSettings = toSdk(subscriptionSettings_);
 
+        uaSubscriptionMutex_.lock();
         SdkStatus sdkStatus = uaSession_->createSubscription(
                 serviceSettings,
                 uaSubscriptionCallback_,
@@ -102,6 +109,7 @@ namespace uaf
                 subscriptionSettings,
                 OpcUa_True,
                 &uaSubscription_);
+        uaSubscriptionMutex_.unlock();
 
 
         if (sdkStatus.isGood())
@@ -136,7 +144,9 @@ namespace uaf
                 logger_->debug("Now deleting subscription %d and thereby deleting all monitored items",
                                clientSubscriptionHandle_);
                 UaClientSdk::ServiceSettings serviceSettings;
+                uaSubscriptionMutex_.lock();
                 SdkStatus sdkStatus = uaSession_->deleteSubscription(serviceSettings, &uaSubscription_);
+                uaSubscriptionMutex_.unlock();
 
                 if (sdkStatus.isGood())
                     ret = statuscodes::Good;
@@ -207,6 +217,121 @@ namespace uaf
     }
 
 
+    // Remember that the subscription must be transferred
+    // =============================================================================================
+    void Subscription::setTransferPending()
+    {
+        // the server deletes the subscription when it hasn't received any publish requests for
+        // lifeTimeCount publishing intervals
+        transferDeadline_ = DateTime::now();
+        transferDeadline_.addMilliSecs(int(subscriptionSettings_.lifeTimeCount
+                                           * subscriptionSettings_.publishingIntervalSec * 1000));
+        transferPending_ = true;
+    }
+
+
+    // Check if the subscription must be transferred
+    // =============================================================================================
+    bool Subscription::isTransferPending() const
+    {
+        return transferPending_ && DateTime::now().msecsTo(transferDeadline_) > 0;
+    }
+
+
+    // Check if the transfer should be abandoned
+    // =============================================================================================
+    bool Subscription::hasTransferExpired() const
+    {
+        return transferPending_ && DateTime::now().msecsTo(transferDeadline_) <= 0;
+    }
+
+
+    // Transfer the subscription to the new session
+    // =============================================================================================
+    Status Subscription::transferSubscription()
+    {
+        Status ret;
+
+        transferPending_ = false;
+
+        // the SDK subscription instance is replaced while nobody else (e.g. the republish
+        // worker) is using it
+        uaSubscriptionMutex_.lock();
+
+        if (uaSubscription_ == 0)
+        {
+            ret = TransferSubscriptionError();
+        }
+        else
+        {
+            OpcUa_UInt32 subscriptionId = uaSubscription_->subscriptionId();
+
+            logger_->debug("Transferring subscription %d (SubscriptionId %d) to the new session",
+                           clientSubscriptionHandle_, subscriptionId);
+
+            UaClientSdk::ServiceSettings serviceSettings;
+
+            UaClientSdk::SubscriptionSettings subscriptionSettings;
+            subscriptionSettings = toSdk(subscriptionSettings_);
+
+            // the server still has the monitored items of the subscription, but the values may
+            // have changed in the meantime, so let the server send the current values again
+            UaClientSdk::UaSubscription* uaSubscription = 0;
+            UaUInt32Array availableSequenceNumbers;
+
+            SdkStatus sdkStatus = uaSession_->transferSubscription(
+                    serviceSettings,
+                    uaSubscriptionCallback_,
+                    clientSubscriptionHandle_,
+                    subscriptionId,
+                    subscriptionSettings,
+                    OpcUa_True,
+                    &uaSubscription,
+                    availableSequenceNumbers);
+
+            if (sdkStatus.isGood() && uaSubscription != 0)
+            {
+                // the old SDK subscription instance is owned by the uaSession_, so it's left to
+                // the uaSession_ (deleting it would delete the transferred subscription on the
+                // server)
+                uaSubscription_ = uaSubscription;
+                ret = statuscodes::Good;
+            }
+            else
+            {
+                // the subscription will be created again, so the SDK subscription instances are
+                // deleted the usual way (which also makes sure that the server doesn't keep it)
+                if (uaSubscription != 0 && uaSubscription != uaSubscription_)
+                    uaSession_->deleteSubscription(serviceSettings, &uaSubscription);
+                uaSession_->deleteSubscription(serviceSettings, &uaSubscription_);
+
+                uaSubscription_ = 0;
+                ret = TransferSubscriptionError(sdkStatus);
+            }
+        }
+
+        uaSubscriptionMutex_.unlock();
+
+        if (ret.isGood())
+        {
+            logger_->debug("The subscription has been transferred, so its monitored items "
+                           "don't need to be created again");
+            setSubscriptionState(uaf::subscriptionstates::Created);
+        }
+        else
+        {
+            logger_->warning(ret.toString());
+            logger_->warning("The subscription could not be transferred, so it will be created "
+                             "again");
+
+            // mark the persistent requests as 'Bad', so that they will be processed again
+            deleteSubscription(false);
+        }
+
+        return ret;
+    }
+
+
     // Set the monitoring mode
     // =============================================================================================
     Status Subscription::setPublishingMode(
@@ -321,6 +446,215 @@ namespace uaf
     }
 
 
+    // Modify the monitored items with the given client handles.
+    // =============================================================================================
+    Status Subscription::modifyMonitoredItemsIfNeeded(
+            const vector<ClientHandle>&             clientHandles,
+            const vector<MonitoredItemSettings>&    settings,
+            const ServiceSettings&                  serviceSettings,
+            const NamespaceArray&                   nameSpaceArray,
+            vector<Status>&                         results)
+    {
+        logger_->debug("Modifying the monitored items");
+
+        Status ret;
+
+        UaMutexLocker locker(&monitoredItemsMapMutex_); // unlocks when locker goes out of scope
+
+        // Create an array of modify requests, and their rank number.
+        // Like for setMonitoringModeIfNeeded, we first make these arrays the same size as the
+        // ClientHandles, then fill the arrays from the front towards the end, and finally we
+        // resize them again to the correct size.
+        uint32_t maxSize = clientHandles.size();
+        uint32_t realSize = 0; // to be updated
+        UaUInt32Array ranks;
+        UaMonitoredItemModifyRequests uaModifyRequests;
+        ranks.resize(maxSize);
+        uaModifyRequests.create(maxSize);
+        MonitoredItemsMap::const_iterator it;
+        vector<ClientHandle> handlesToChange;
+        for (uint32_t i = 0; i < maxSize; i++)
+        {
+            it = monitoredItemsMap_.find(clientHandles[i]);
+
+            if (it == monitoredItemsMap_.end())
+                continue;
+
+            if (it->second.settings.kind() != settings[i].kind())
+            {
+                results[i] = InvalidRequestError(uaf::format(
+                        "The kind (data or event) of the settings for clientHandle %d does not " \
+                        "match the kind of the monitored item", clientHandles[i]));
+                continue;
+            }
+
+            OpcUa_MonitoredItemModifyRequest& uaRequest = uaModifyRequests[realSize];
+            uaRequest.MonitoredItemId = it->second.monitoredItemId;
+            uaRequest.RequestedParameters.ClientHandle = clientHandles[i];
+            uaRequest.RequestedParameters.SamplingInterval = settings[i].samplingIntervalSec * 1000;
+            uaRequest.RequestedParameters.QueueSize = settings[i].queueSize;
+            uaRequest.RequestedParameters.DiscardOldest = settings[i].discardOldest;
+
+            if (settings[i].kind() == MonitoredItemSettings::Data)
+            {
+                OpcUa_DataChangeFilter* pDataChangeFilter = (OpcUa_DataChangeFilter*)OpcUa_Null;
+
+                OpcUa_EncodeableObject_CreateExtension(
+                        &OpcUa_DataChangeFilter_EncodeableType,
+                        &uaRequest.RequestedParameters.Filter,
+                        (OpcUa_Void**)&pDataChangeFilter);
+
+                OpcUa_DataChangeFilter_Initialize(pDataChangeFilter);
+
+                settings[i].dataChangeFilter->toSdk(pDataChangeFilter);
+            }
+            else
+            {
+                Status filterStatus = CreateMonitoredEventsInvocation::fillSdkEventFilter(
+                        *settings[i].eventFilter,
+                        nameSpaceArray,
+                        uaRequest.RequestedParameters.Filter);
+
+                if (filterStatus.isNotGood())
+                {
+                    // clear the partially filled request so that the slot can be reused
+                    OpcUa_MonitoredItemModifyRequest_Clear(&uaRequest);
+                    OpcUa_MonitoredItemModifyRequest_Initialize(&uaRequest);
+                    results[i] = filterStatus;
+                    continue;
+                }
+            }
+
+            ranks[realSize] = i;
+            realSize++;
+
+            handlesToChange.push_back(clientHandles[i]);
+        }
+
+        if (realSize > 0)
+        {
+            logger_->debug("The following client handles were found: [%s]",
+                           uaf::uint32ArrayToString(handlesToChange).c_str());
+
+            // don't forget to resize the ranks and requests now to their real size:
+            ranks.resize(realSize);
+            uaModifyRequests.resize(realSize);
+
+            // now invoke the service
+            UaClientSdk::ServiceSettings uaServiceSettings;
+            serviceSettings.toSdk(uaServiceSettings);
+            UaMonitoredItemModifyResults uaModifyResults;
+
+            SdkStatus sdkStatus = uaSubscription_->modifyMonitoredItems(
+                    uaServiceSettings,
+                    OpcUa_TimestampsToReturn_Both,
+                    uaModifyRequests,
+                    uaModifyResults);
+
+            if (sdkStatus.isGood())
+                ret = statuscodes::Good;
+            else
+                ret = ModifyMonitoredItemsInvocationError(sdkStatus);
+
+            logger_->debug("Result of OPC UA service call: %s", ret.toString().c_str());
+
+            if (ret.isGood())
+            {
+                for (uint32_t i = 0; i < realSize; i++)
+                {
+                    ClientHandle clientHandle = clientHandles[ranks[i]];
+
+                    if (OpcUa_IsGood(uaModifyResults[i].StatusCode))
+                    {
+                        MonitoredItem& monitoredItem = monitoredItemsMap_[clientHandle];
+                        monitoredItem.settings = settings[ranks[i]];
+                        monitoredItem.revisedSamplingIntervalSec
+                            = uaModifyResults[i].RevisedSamplingInterval / 1000.0;
+                        monitoredItem.revisedQueueSize = uaModifyResults[i].RevisedQueueSize;
+
+                        if (monitoredItem.settings.kind() == MonitoredItemSettings::Event)
+                            monitoredItem.eventSchema = EventSchema(
+                                    *monitoredItem.settings.eventFilter);
+
+                        updatePersistentRequest(monitoredItem);
+
+                        results[ranks[i]] = statuscodes::Good;
+                    }
+                    else
+                    {
+                        results[ranks[i]] = ServerCouldNotModifyMonitoredItemError(
+                                clientHandle,
+                                SdkStatus(uaModifyResults[i].StatusCode));
+                    }
+                }
+            }
+        }
+        else
+        {
+            logger_->debug("No (valid) client handles belong to this subscription, skipping");
+            // ret remains Uncertain
+        }
+
+        return ret;
+    }
+
+
+    // Update the persistent request that created the given monitored item
+    // =============================================================================================
+    void Subscription::updatePersistentRequest(const MonitoredItem& monitoredItem)
+    {
+        Status ret;
+
+        if (monitoredItem.settings.kind() == MonitoredItemSettings::Data)
+        {
+            CreateMonitoredDataRequestTarget target;
+            ret = database_->createMonitoredDataRequestStore.getRequestTarget(
+                    monitoredItem.requestHandle,
+                    monitoredItem.targetRank,
+                    target);
+
+            if (ret.isGood())
+            {
+                target.samplingIntervalSec = monitoredItem.settings.samplingIntervalSec;
+                target.queueSize           = monitoredItem.settings.queueSize;
+                target.discardOldest       = monitoredItem.settings.discardOldest;
+                target.dataChangeFilter    = *monitoredItem.settings.dataChangeFilter;
+
+                database_->createMonitoredDataRequestStore.updateRequestTarget(
+                        monitoredItem.requestHandle,
+                        monitoredItem.targetRank,
+                        target);
+            }
+        }
+        else
+        {
+            CreateMonitoredEventsRequestTarget target;
+            ret = database_->createMonitoredEventsRequestStore.getRequestTarget(
+                    monitoredItem.requestHandle,
+                    monitoredItem.targetRank,
+                    target);
+
+            if (ret.isGood())
+            {
+                target.samplingIntervalSec = monitoredItem.settings.samplingIntervalSec;
+                target.queueSize           = monitoredItem.settings.queueSize;
+                target.discardOldest       = monitoredItem.settings.discardOldest;
+                target.eventFilter         = *monitoredItem.settings.eventFilter;
+
+                database_->createMonitoredEventsRequestStore.updateRequestTarget(
+                        monitoredItem.requestHandle,
+                        monitoredItem.targetRank,
+                        target);
+            }
+        }
+
+        // a non-persistent request is not stored, so there's nothing to update in that case
+        if (ret.isNotGood())
+            logger_->debug("No persistent request %d to update",
+                           monitoredItem.requestHandle);
+    }
+
+
 
     // Change the subscription status
     // =============================================================================================
@@ -345,10 +679,25 @@ namespace uaf
         info.clientSubscriptionHandle = clientSubscriptionHandle_;
         info.subscriptionState = subscriptionState_;
         info.subscriptionSettings = subscriptionSettings_;
+        statisticsMutex_.lock();
+        info.noOfNotificationGaps = noOfNotificationGaps_;
+        info.noOfMissingNotifications = noOfMissingNotifications_;
+        info.noOfRecoveredNotifications = noOfRecoveredNotifications_;
+        statisticsMutex_.unlock();
+        info.publishRequestCount = publishRequestCount_;
         return info;
     }
 
 
+    // Get the number of monitored items
+    // =============================================================================================
+    size_t Subscription::noOfMonitoredItems()
+    {
+        UaMutexLocker locker(&monitoredItemsMapMutex_); // unlocks when locker goes out of scope
+        return monitoredItemsMap_.size();
+    }
+
+
     // Get information about the monitored item
     // =============================================================================================
     bool Subscription::monitoredItemInformation(
@@ -387,13 +736,18 @@ namespace uaf
         notification.clientSubscriptionHandle   = clientSubscriptionHandle_;
         notification.subscriptionState          = subscriptionState_;
 
-        UaMutexLocker locker(&monitoredItemsMapMutex_); // unlocks when locker goes out of scope
+        // now add the monitored item handles, unless the user doesn't want them (in which case
+        // we don't need to lock the monitored items at all)
+        if (subscriptionSettings_.keepAliveClientHandles)
+        {
+            UaMutexLocker locker(&monitoredItemsMapMutex_); // unlocks when locker goes out of scope
 
-        // now add the monitored item handles
+            notification.clientHandles.reserve(monitoredItemsMap_.size());
 
-        for (MonitoredItemsMap::iterator it = monitoredItemsMap_.begin();
-                it != monitoredItemsMap_.end(); ++it)
-            notification.clientHandles.push_back(it->first);
+            for (MonitoredItemsMap::iterator it = monitoredItemsMap_.begin();
+                    it != monitoredItemsMap_.end(); ++it)
+                notification.clientHandles.push_back(it->first);
+        }
 
         // call the callback interface
         clientInterface_->keepAliveReceived(notification);
@@ -409,11 +763,32 @@ namespace uaf
         // get the number of notifications
         uint32_t noOfNotifications = dataNotifications.length();
 
+        logger_->debug("A total of %d data notifications were received", noOfNotifications);
+
+        // deliver them as a single batch, if the user wants so
+        if (subscriptionSettings_.batchDataChanges)
+        {
+            DataChangeNotificationBatch batch;
+            batch.clientConnectionId       = clientConnectionId_;
+            batch.clientSubscriptionHandle = clientSubscriptionHandle_;
+            batch.reserve(noOfNotifications);
+
+            for (uint32_t i=0; i < noOfNotifications; i++)
+            {
+                ClientHandle clientHandle = dataNotifications[i].ClientHandle;
+
+                if (monitoredItemsMap_.find(clientHandle) != monitoredItemsMap_.end())
+                    batch.append(clientHandle, dataNotifications[i].Value);
+            }
+
+            // call the callback interface
+            clientInterface_->dataChangeBatchReceived(batch);
+            return;
+        }
+
         // create the notifications
         vector<DataChangeNotification> notifications;
 
-        logger_->debug("A total of %d data notifications were received", noOfNotifications);
-
         // fill the notifications
         for (uint32_t i=0; i < noOfNotifications; i++)
         {
@@ -457,6 +832,13 @@ namespace uaf
 
         logger_->debug("A total of %d notifications were received", noOfNotifications);
 
+        // deliver them as one batch per monitored item, if the user wants so
+        if (subscriptionSettings_.batchEvents)
+        {
+            deliverEventBatches(uaEventFieldList);
+            return;
+        }
+
         // create the notifications
         vector<EventNotification> notifications;
 
@@ -491,5 +873,323 @@ namespace uaf
         clientInterface_->eventsReceived(notifications);
     }
 
+
+    // Count the missing notification messages between two sequence numbers
+    // =============================================================================================
+    static uint32_t noOfMissingSequenceNumbers(
+            uint32_t previousSequenceNumber,
+            uint32_t newSequenceNumber)
+    {
+        // the sequence numbers wrap around (modulo 2^32), so the distance is computed modulo
+        // 2^32 as well: a "distance" of more than 2^31 is in fact a jump backwards, which
+        // means that the server has reset the sequence numbers (e.g. after a restart), in
+        // which case nothing can be republished
+        uint32_t distance = newSequenceNumber - previousSequenceNumber;
+        if (distance == 0 || distance > 0x80000000u)
+            return 0;
+
+        uint32_t noOfMissing = distance - 1;
+
+        // 0 is never used as a sequence number, so it's skipped when the range wraps around
+        if (newSequenceNumber < previousSequenceNumber && noOfMissing > 0)
+            noOfMissing--;
+
+        return noOfMissing;
+    }
+
+
+    // A data change message was received
+    // =============================================================================================
+    void Subscription::receivedDataChange(
+            const UaDataNotifications&  dataNotifications,
+            const UaDiagnosticInfos&    diagnosticInfos)
+    {
+        recoveryMutex_.lock();
+        bool holdBack = recovering_;
+        if (holdBack)
+        {
+            heldBackMessages_.push_back(HeldBackMessage());
+            HeldBackMessage& message = heldBackMessages_.back();
+            message.type              = HeldBackMessage::DataChange;
+            message.dataNotifications = dataNotifications;
+            message.diagnosticInfos   = diagnosticInfos;
+        }
+        recoveryMutex_.unlock();
+
+        if (holdBack)
+            logger_->debug("Holding back a data change message until the recovery is done");
+        else
+            dataChange(dataNotifications, diagnosticInfos);
+    }
+
+
+    // An event message was received
+    // =============================================================================================
+    void Subscription::receivedEvents(UaEventFieldLists& eventFieldList)
+    {
+        recoveryMutex_.lock();
+        bool holdBack = recovering_;
+        if (holdBack)
+        {
+            heldBackMessages_.push_back(HeldBackMessage());
+            HeldBackMessage& message = heldBackMessages_.back();
+            message.type           = HeldBackMessage::Events;
+            message.eventFieldList = eventFieldList;
+        }
+        recoveryMutex_.unlock();
+
+        if (holdBack)
+            logger_->debug("Holding back an event message until the recovery is done");
+        else
+            newEvents(eventFieldList);
+    }
+
+
+    // Handle missing notification messages
+    // =============================================================================================
+    bool Subscription::notificationsMissing(
+            uint32_t previousSequenceNumber,
+            uint32_t newSequenceNumber)
+    {
+        uint32_t noOfMissing = noOfMissingSequenceNumbers(previousSequenceNumber,
+                                                          newSequenceNumber);
+
+        statisticsMutex_.lock();
+        noOfNotificationGaps_++;
+        noOfMissingNotifications_ += noOfMissing;
+        statisticsMutex_.unlock();
+
+        bool mustRepublish = subscriptionSettings_.republishMissingNotifications
+                             && noOfMissing > 0;
+
+        if (mustRepublish && noOfMissing > subscriptionSettings_.maxRepublishCount)
+        {
+            logger_->warning("%d notification messages are missing, which is more than the "
+                             "maxRepublishCount (%d), so they will not be republished",
+                             noOfMissing, subscriptionSettings_.maxRepublishCount);
+            mustRepublish = false;
+        }
+
+        // if a recovery is still busy, this gap is handled after the messages before it
+        recoveryMutex_.lock();
+        bool holdBack = recovering_;
+        if (holdBack)
+        {
+            heldBackMessages_.push_back(HeldBackMessage());
+            HeldBackMessage& message = heldBackMessages_.back();
+            message.type                   = HeldBackMessage::Gap;
+            message.previousSequenceNumber = previousSequenceNumber;
+            message.newSequenceNumber      = newSequenceNumber;
+            message.mustRepublish          = mustRepublish;
+        }
+        else if (mustRepublish)
+        {
+            // hold back the next messages until the missing ones are recovered
+            recovering_ = true;
+        }
+        recoveryMutex_.unlock();
+
+        if (holdBack)
+            return false;
+
+        if (!mustRepublish)
+            clientInterface_->notificationsMissing(subscriptionInformation(),
+                                                   previousSequenceNumber,
+                                                   newSequenceNumber);
+
+        return mustRepublish;
+    }
+
+
+    // Recover the missing notification messages
+    // =============================================================================================
+    void Subscription::recoverMissingNotifications(
+            uint32_t previousSequenceNumber,
+            uint32_t newSequenceNumber)
+    {
+        handleMissingNotifications(previousSequenceNumber, newSequenceNumber, true);
+
+        // deliver the messages that were held back in the meantime, until there are none left
+        while (true)
+        {
+            recoveryMutex_.lock();
+            if (heldBackMessages_.empty())
+            {
+                recovering_ = false;
+                recoveryMutex_.unlock();
+                break;
+            }
+            HeldBackMessage message = heldBackMessages_.front();
+            heldBackMessages_.pop_front();
+            recoveryMutex_.unlock();
+
+            if (message.type == HeldBackMessage::DataChange)
+                dataChange(message.dataNotifications, message.diagnosticInfos);
+            else if (message.type == HeldBackMessage::Events)
+                newEvents(message.eventFieldList);
+            else
+                handleMissingNotifications(message.previousSequenceNumber,
+                                           message.newSequenceNumber,
+                                           message.mustRepublish);
+        }
+    }
+
+
+    // Republish the missing notification messages (if needed), and report the lost ones
+    // =============================================================================================
+    void Subscription::handleMissingNotifications(
+            uint32_t    previousSequenceNumber,
+            uint32_t    newSequenceNumber,
+            bool        mustRepublish)
+    {
+        if (mustRepublish && republish(previousSequenceNumber, newSequenceNumber))
+            logger_->debug("All missing notifications were recovered");
+        else
+            clientInterface_->notificationsMissing(subscriptionInformation(),
+                                                   previousSequenceNumber,
+                                                   newSequenceNumber);
+    }
+
+
+    // Republish missing notification messages
+    // =============================================================================================
+    bool Subscription::republish(
+            uint32_t previousSequenceNumber,
+            uint32_t newSequenceNumber)
+    {
+        uint32_t noOfMissing = noOfMissingSequenceNumbers(previousSequenceNumber,
+                                                          newSequenceNumber);
+
+        logger_->debug("Republishing %d missing notification messages", noOfMissing);
+
+        UaClientSdk::ServiceSettings uaServiceSettings;
+        ServiceSettings().toSdk(uaServiceSettings);
+
+        // republish the messages in the order of their sequence numbers, and deliver their
+        // notifications immediately (the later messages are held back in the meantime)
+        uint32_t noOfRecovered = 0;
+        uint32_t sequenceNumber = previousSequenceNumber;
+        for (uint32_t i = 0; i < noOfMissing; i++)
+        {
+            // skip 0, which is never used as a sequence number
+            sequenceNumber++;
+            if (sequenceNumber == 0)
+                sequenceNumber++;
+
+            UaDataNotifications dataNotifications;
+            UaDiagnosticInfos   diagnosticInfos;
+            UaEventFieldLists   eventFieldList;
+            UaDateTime          publishTime;
+
+            // don't let the SDK subscription instance be replaced during the service call
+            uaSubscriptionMutex_.lock();
+
+            // the SDK subscription may be gone (e.g. after a failed transfer)
+            if (uaSubscription_ == 0)
+            {
+                uaSubscriptionMutex_.unlock();
+                logger_->warning("The subscription has no SDK subscription (anymore), so the "
+                                 "missing notification messages cannot be republished");
+                break;
+            }
+
+            SdkStatus sdkStatus = uaSubscription_->republish(
+                    uaServiceSettings,
+                    sequenceNumber,
+                    dataNotifications,
+                    diagnosticInfos,
+                    eventFieldList,
+                    publishTime);
+
+            uaSubscriptionMutex_.unlock();
+
+            // deliver the notifications without holding the lock
+            if (sdkStatus.isGood())
+            {
+                noOfRecovered++;
+
+                if (dataNotifications.length() > 0)
+                    dataChange(dataNotifications, diagnosticInfos);
+
+                if (eventFieldList.length() > 0)
+                    newEvents(eventFieldList);
+            }
+            else
+            {
+                // e.g. BadMessageNotAvailable if the server no longer has the message
+                logger_->warning("Notification message %d could not be republished: %s",
+                                 sequenceNumber, sdkStatus.toString().c_str());
+            }
+        }
+
+        statisticsMutex_.lock();
+        noOfRecoveredNotifications_ += noOfRecovered;
+        statisticsMutex_.unlock();
+
+        logger_->debug("%d of the %d missing notification messages were recovered",
+                       noOfRecovered, noOfMissing);
+
+        return noOfRecovered == noOfMissing;
+    }
+
+
+    // Deliver the events as one batch per monitored item
+    // =============================================================================================
+    void Subscription::deliverEventBatches(const UaEventFieldLists& uaEventFieldList)
+    {
+        uint32_t noOfNotifications = uaEventFieldList.length();
+
+        // count the events per monitored item, so that each batch is allocated only once
+        std::map<ClientHandle, size_t> noOfEvents;
+        for (uint32_t i=0; i < noOfNotifications; i++)
+            noOfEvents[uaEventFieldList[i].ClientHandle]++;
+
+        // create the batches (for the known monitored items only)
+        std::map<ClientHandle, EventNotificationBatch> batches;
+        {
+            UaMutexLocker locker(&monitoredItemsMapMutex_); // unlocks when locker goes out of scope
+
+            for (std::map<ClientHandle, size_t>::const_iterator it = noOfEvents.begin();
+                 it != noOfEvents.end();
+                 ++it)
+            {
+                MonitoredItemsMap::const_iterator item = monitoredItemsMap_.find(it->first);
+
+                if (item != monitoredItemsMap_.end())
+                {
+                    EventNotificationBatch& batch   = batches[it->first];
+                    batch.clientConnectionId        = clientConnectionId_;
+                    batch.clientSubscriptionHandle  = clientSubscriptionHandle_;
+                    batch.clientHandle              = it->first;
+                    batch.schema                    = item->second.eventSchema;
+                    batch.resize(it->second);
+                }
+            }
+        }
+
+        // fill the columns, keeping the order in which the events were received
+        std::map<ClientHandle, size_t> eventIndexes;
+        for (uint32_t i=0; i < noOfNotifications; i++)
+        {
+            ClientHandle clientHandle = uaEventFieldList[i].ClientHandle;
+
+            std::map<ClientHandle, EventNotificationBatch>::iterator it;
+            it = batches.find(clientHandle);
+
+            if (it != batches.end())
+                it->second.set(eventIndexes[clientHandle]++, uaEventFieldList[i]);
+        }
+
+        // call the callback interface
+        for (std::map<ClientHandle, EventNotificationBatch>::const_iterator it = batches.begin();
+             it != batches.end();
+             ++it)
+        {
+            logger_->debug("Delivering a batch of %d events for ClientHandle %d",
+                           int(it->second.size()), it->first);
+            clientInterface_->eventBatchReceived(it->second);
+        }
+    }
+
 }
 
@@ -25,6 +25,8 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include <map>
+#include <deque>
 // SDK
 #include "uaclient/uaclientsdk.h"
 #include "uaclient/uasession.h"
@@ -35,6 +37,7 @@
 #include "uaf/util/logger.h"
 #include "uaf/util/handles.h"
 #include "uaf/util/constants.h"
+#include "uaf/util/datetime.h"
 #include "uaf/client/clientexport.h"
 #include "uaf/client/clientinterface.h"
 #include "uaf/client/settings/subscriptionsettings.h"
@@ -119,6 +122,63 @@ namespace uaf
         bool isCreated() const;
 
 
+        /**
+         * Remember that the subscription was lost together with its session, so that it can be
+         * transferred to the new session later on (instead of being garbage collected).
+         *
+         * The transfer is only pending as long as the server may still have the subscription,
+         * i.e. during lifeTimeCount publishing intervals.
+         */
+        void setTransferPending();
+
+
+        /**
+         * Check if the subscription is waiting to be transferred to a new session.
+         *
+         * @return  True if the subscription should be transferred.
+         */
+        bool isTransferPending() const;
+
+
+        /**
+         * Check if the subscription was waiting to be transferred for so long, that the server
+         * has surely deleted it in the meantime.
+         *
+         * @return  True if the transfer should be abandoned (see cancelTransfer()).
+         */
+        bool hasTransferExpired() const;
+
+
+        /**
+         * Abandon the transfer, so that the subscription is garbage collected and its monitored
+         * items are created again from the persistent requests.
+         */
+        void cancelTransfer() { transferPending_ = false; }
+
+
+        /**
+         * Set the number of publish requests that the session keeps outstanding, so that it can
+         * be reported by subscriptionInformation().
+         *
+         * @param publishRequestCount  The publish request count of the session.
+         */
+        void setPublishRequestCount(uint32_t publishRequestCount)
+        { publishRequestCount_ = publishRequestCount; }
+
+
+        /**
+         * Transfer the subscription (including its monitored items) to the new session, after
+         * the original session was lost.
+         *
+         * If the transfer fails (e.g. because the server no longer has the subscription), the
+         * subscription is deleted, so that its monitored items will be created again from the
+         * persistent requests.
+         *
+         * @return  Good if the subscription was transferred.
+         */
+        uaf::Status transferSubscription();
+
+
 
         /**
          * Tell the subscription that it's still alive.
@@ -134,6 +194,14 @@ namespace uaf
         uaf::SubscriptionInformation subscriptionInformation() const;
 
 
+        /**
+         * Get the number of monitored items owned by the subscription.
+         *
+         * @return  The number of monitored items.
+         */
+        std::size_t noOfMonitoredItems();
+
+
         /**
          * Get some information about the specified monitored item.
          *
@@ -161,6 +229,54 @@ namespace uaf
         virtual void newEvents(UaEventFieldLists &eventFieldList);
 
 
+        /**
+         * Called by the SDK callback thread for every received data change message: the
+         * notifications are delivered via dataChange(), unless missing notification messages
+         * are being recovered, in which case they are held back until the recovery is done.
+         */
+        void receivedDataChange(
+                const UaDataNotifications&  dataNotifications,
+                const UaDiagnosticInfos&    diagnosticInfos);
+
+
+        /**
+         * Called by the SDK callback thread for every received event message: the events
+         * are delivered via newEvents(), or held back just like receivedDataChange().
+         */
+        void receivedEvents(UaEventFieldLists& eventFieldList);
+
+
+        /**
+         * Called every time notification messages are missing: update the statistics and
+         * check if the missing messages should be recovered via recoverMissingNotifications().
+         *
+         * This method is called by the SDK callback thread, so it doesn't invoke any service.
+         * If the missing messages are not recovered, they are reported to the client interface
+         * (right away, or after the recovery that is still busy).
+         *
+         * @param previousSequenceNumber    The sequence number of the last received message.
+         * @param newSequenceNumber         The sequence number of the new message.
+         * @return                          True if recoverMissingNotifications() must be called
+         *                                  (by a worker thread).
+         */
+        bool notificationsMissing(
+                uint32_t previousSequenceNumber,
+                uint32_t newSequenceNumber);
+
+
+        /**
+         * Recover the missing notification messages via the Republish service, report the
+         * ones that could not be recovered, and then deliver the messages that were held back
+         * in the meantime. This way all notifications are delivered in their original order.
+         *
+         * @param previousSequenceNumber    The sequence number of the last received message.
+         * @param newSequenceNumber         The sequence number of the new message.
+         */
+        void recoverMissingNotifications(
+                uint32_t previousSequenceNumber,
+                uint32_t newSequenceNumber);
+
+
         /**
          * Set the publishing mode of the subscription.
          *
@@ -190,6 +306,29 @@ namespace uaf
                std::vector<uaf::Status>&               results);
 
 
+       /**
+        * Modify the monitored items with the given ClientHandles, if they are owned by the
+        * subscription.
+        *
+        * All affected monitored items of this subscription are modified by a single
+        * ModifyMonitoredItems service call. The persistent requests that created the monitored
+        * items are updated too, so that the new settings survive a reconnection.
+        *
+        * @param clientHandles     The ClientHandles of the monitored items to be affected.
+        * @param settings          The new settings (one for each ClientHandle).
+        * @param serviceSettings   The service settings to be used.
+        * @param nameSpaceArray    The namespace array, to convert the event filters.
+        * @param results           A vector of statuses (one result for each ClientHandle).
+        * @return                  The immediate result of the service call.
+        */
+        uaf::Status modifyMonitoredItemsIfNeeded(
+               const std::vector<uaf::ClientHandle>&           clientHandles,
+               const std::vector<uaf::MonitoredItemSettings>&  settings,
+               const uaf::ServiceSettings&                     serviceSettings,
+               const uaf::NamespaceArray&                      nameSpaceArray,
+               std::vector<uaf::Status>&                       results);
+
+
         /**
          * Execute a CreateMonitoredData service invocation.
          *
@@ -285,6 +424,8 @@ namespace uaf
                         invocation.requestTargets()[i].queueSize,
                         invocation.requestTargets()[i].discardOldest,
                         invocation.requestTargets()[i].eventFilter);
+                monitoredItemsMap_[clientHandle].eventSchema = uaf::EventSchema(
+                        invocation.requestTargets()[i].eventFilter);
                 monitoredItemsMap_[clientHandle].requestHandle = invocation.requestHandle();
                 monitoredItemsMap_[clientHandle].targetRank    = invocation.ranks()[i];
 
@@ -361,12 +502,52 @@ namespace uaf
         typedef std::map<uaf::ClientHandle, uaf::MonitoredItem> MonitoredItemsMap;
 
 
+        // deliver the events as one uaf::EventNotificationBatch per monitored item
+        void deliverEventBatches(const UaEventFieldLists& uaEventFieldList);
+
+
+        // a received message, or a gap between the received messages, that is held back while
+        // missing notification messages are being recovered
+        struct HeldBackMessage
+        {
+            enum Type { DataChange, Events, Gap };
+
+            Type                type;
+            UaDataNotifications dataNotifications;
+            UaDiagnosticInfos   diagnosticInfos;
+            UaEventFieldLists   eventFieldList;
+            uint32_t            previousSequenceNumber;
+            uint32_t            newSequenceNumber;
+            bool                mustRepublish;
+        };
+
+
+        // republish the missing notification messages and deliver their notifications,
+        // and return true if all of them were recovered
+        bool republish(uint32_t previousSequenceNumber, uint32_t newSequenceNumber);
+
+
+        // republish (if needed) the missing notification messages, and report the ones that
+        // could not be recovered to the client interface
+        void handleMissingNotifications(
+                uint32_t    previousSequenceNumber,
+                uint32_t    newSequenceNumber,
+                bool        mustRepublish);
+
+
+        // update the persistent request that created the given monitored item, so that it will
+        // be re-processed with the new settings
+        void updatePersistentRequest(const uaf::MonitoredItem& monitoredItem);
+
+
         // logger of the subscription
         uaf::Logger*                                logger_;
         // SDK session instance
         UaClientSdk::UaSession*                     uaSession_;
-        // SDK subscription instance
+        // SDK subscription instance, and the mutex that guards its creation, deletion and
+        // transfer (and the republishing, which runs in a worker thread)
         UaClientSdk::UaSubscription*                uaSubscription_;
+        UaMutex                                     uaSubscriptionMutex_;
         // SDK subscription callback
         UaClientSdk::UaSubscriptionCallback*        uaSubscriptionCallback_;
         // the settings of the subscription
@@ -391,6 +572,24 @@ namespace uaf
         MonitoredItemsMap                           monitoredItemsMap_;
         UaMutex                                     monitoredItemsMapMutex_;
 
+        // statistics about the missing (and recovered) notification messages, and their mutex
+        uint32_t                                    noOfNotificationGaps_;
+        uint32_t                                    noOfMissingNotifications_;
+        uint32_t                                    noOfRecoveredNotifications_;
+        mutable UaMutex                             statisticsMutex_;
+
+        // true while missing notification messages are being recovered, the messages that are
+        // held back in the meantime, and their mutex
+        bool                                        recovering_;
+        std::deque<HeldBackMessage>                 heldBackMessages_;
+        UaMutex                                     recoveryMutex_;
+
+        // true if the subscription must be transferred to a new session, and until when
+        bool                                        transferPending_;
+        uaf::DateTime                               transferDeadline_;
+        // the publish request count of the session, as reported by subscriptionInformation()
+        uint32_t                                    publishRequestCount_;
+
 
 
     };
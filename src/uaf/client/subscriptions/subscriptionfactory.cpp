@@ -26,6 +26,41 @@ namespace uaf
     using std::string;
     using std::stringstream;
     using std::vector;
+    using std::size_t;
+
+
+    // A job for the republishWorker_ to recover missing notification messages
+    // =============================================================================================
+    class RepublishInvocation : public DeferredInvocation
+    {
+    public:
+
+        RepublishInvocation(
+                SubscriptionFactory*        factory,
+                ClientSubscriptionHandle    clientSubscriptionHandle,
+                uint32_t                    previousSequenceNumber,
+                uint32_t                    newSequenceNumber)
+        : factory_(factory),
+          clientSubscriptionHandle_(clientSubscriptionHandle),
+          previousSequenceNumber_(previousSequenceNumber),
+          newSequenceNumber_(newSequenceNumber)
+        {}
+
+        void execute()
+        {
+            factory_->republish(clientSubscriptionHandle_,
+                                previousSequenceNumber_,
+                                newSequenceNumber_);
+        }
+
+        void cancel() {}
+
+    private:
+        SubscriptionFactory*        factory_;
+        ClientSubscriptionHandle    clientSubscriptionHandle_;
+        uint32_t                    previousSequenceNumber_;
+        uint32_t                    newSequenceNumber_;
+    };
 
 
     // Constructor
@@ -35,12 +70,16 @@ namespace uaf
             uaf::ClientConnectionId    clientConnectionId,
             UaClientSdk::UaSession*     uaSession,
             ClientInterface*            clientInterface,
-            Database*                   database)
+            Database*                   database,
+            const SessionSettings&      sessionSettings)
     : uaSession_(uaSession),
       clientConnectionId_(clientConnectionId),
       database_(database),
       clientInterface_(clientInterface),
-      transactionId_(0)
+      transactionId_(0),
+      publishRequestCount_(sessionSettings.publishRequestCount),
+      effectivePublishRequestCount_(0),
+      republishWorker_(1)
     {
         // build the logger name:
         stringstream loggerName;
@@ -58,6 +97,9 @@ namespace uaf
     {
         logger_->debug("Destructing the subscription factory");
 
+        // make sure that the worker thread doesn't use the subscriptions anymore
+        republishWorker_.clear();
+
         // delete the logger
         delete logger_;
         logger_ = 0;
@@ -195,6 +237,42 @@ namespace uaf
     }
 
 
+    // Get the publish request count
+    // =============================================================================================
+    uint32_t SubscriptionFactory::publishRequestCount()
+    {
+        return publishRequestCount_;
+    }
+
+
+    // Get the publish request count in use
+    // =============================================================================================
+    uint32_t SubscriptionFactory::effectivePublishRequestCount()
+    {
+        UaMutexLocker locker(&publishRequestCountMutex_);
+        return effectivePublishRequestCount_;
+    }
+
+
+    // Provide the publish request count in use to all subscriptions
+    // =============================================================================================
+    void SubscriptionFactory::setEffectivePublishRequestCount(uint32_t publishRequestCount)
+    {
+        publishRequestCountMutex_.lock();
+        effectivePublishRequestCount_ = publishRequestCount;
+        publishRequestCountMutex_.unlock();
+
+        UaMutexLocker locker(&subscriptionMapMutex_);
+
+        for (SubscriptionMap::const_iterator it = subscriptionMap_.begin();
+                it != subscriptionMap_.end();
+                ++it)
+        {
+            it->second->setPublishRequestCount(publishRequestCount);
+        }
+    }
+
+
     // Get information about the monitored item
     // =============================================================================================
     bool SubscriptionFactory::monitoredItemInformation(
@@ -289,6 +367,208 @@ namespace uaf
     }
 
 
+    // Modify the monitored items with the given client handles.
+    // =============================================================================================
+    Status SubscriptionFactory::modifyMonitoredItemsIfNeeded(
+            const vector<ClientHandle>&             clientHandles,
+            const vector<MonitoredItemSettings>&    settings,
+            const ServiceSettings*                  serviceSettingsPtr,
+            const NamespaceArray&                   nameSpaceArray,
+            vector<Status>&                         results)
+    {
+        Status ret;
+
+        ServiceSettings serviceSettings;
+        if (serviceSettingsPtr == NULL)
+            serviceSettings = database_->clientSettings.defaultModifyMonitoredItemsSettings;
+        else
+            serviceSettings = *serviceSettingsPtr;
+
+        // lock the mutex to make sure the subscriptionMap_ is not being manipulated
+        UaMutexLocker locker(&subscriptionMapMutex_);
+
+        // loop trough the subscriptions, each one modifies its own items in a single service call
+        for (SubscriptionMap::iterator it = subscriptionMap_.begin();
+                it != subscriptionMap_.end() && ret.isNotBad();
+                ++it)
+        {
+            ret = it->second->modifyMonitoredItemsIfNeeded(
+                    clientHandles,
+                    settings,
+                    serviceSettings,
+                    nameSpaceArray,
+                    results);
+        }
+
+        return ret;
+    }
+
+
+    // Create a new subscription
+    // =============================================================================================
+    Status SubscriptionFactory::createNewSubscription(
+            const SubscriptionSettings& subscriptionSettings,
+            Subscription*&              subscription)
+    {
+        ClientSubscriptionHandle clientSubscriptionHandle;
+        clientSubscriptionHandle = database_->createUniqueClientSubscriptionHandle();
+
+        logger_->debug("We create a new subscription with clientSubscriptionHandle %d",
+                       clientSubscriptionHandle);
+
+        // create a new subscription instance
+        subscription = new Subscription(
+                logger_->loggerFactory(),
+                subscriptionSettings,
+                clientSubscriptionHandle,
+                clientConnectionId_,
+                uaSession_,
+                this,
+                clientInterface_,
+                database_);
+        subscription->setPublishRequestCount(effectivePublishRequestCount());
+
+        // store the new subscription instance in the subscriptionMap
+        subscriptionMap_[clientSubscriptionHandle] = subscription;
+
+        logger_->debug("The new subscription has been created");
+
+        // create an activity count for the subscription
+        activityMapMutex_.lock();
+        activityMap_[clientSubscriptionHandle] = 1;
+        activityMapMutex_.unlock();
+
+        // create the subscription on the server
+        return subscription->createSubscription();
+    }
+
+
+    // Acquire the subscriptions to spread the monitored items over
+    // =============================================================================================
+    Status SubscriptionFactory::acquireSubscriptionShards(
+            const SubscriptionSettings& subscriptionSettings,
+            size_t                      noOfItems,
+            bool                        splitAllowed,
+            vector<Subscription*>&      shards,
+            vector<size_t>&             shardSizes)
+    {
+        size_t maxItems = subscriptionSettings.maxMonitoredItemsPerSubscription;
+
+        logger_->debug("Acquiring subscriptions for %d monitored items (max %d per subscription)",
+                       noOfItems, maxItems);
+
+        shards.clear();
+        shardSizes.clear();
+
+        if (noOfItems == 0)
+            return UnexpectedError("No monitored items to spread over the subscriptions");
+
+        // lock the mutex to make sure the subscriptionMap_ is not being manipulated
+        UaMutexLocker locker(&subscriptionMapMutex_);
+
+        // find the existing subscriptions with the same settings, and their load
+        // (i.e. their monitored items plus the ones that are about to be created)
+        vector< std::pair<size_t, Subscription*> > candidates;
+
+        if (!subscriptionSettings.unique)
+        {
+            for (SubscriptionMap::const_iterator it = subscriptionMap_.begin();
+                 it != subscriptionMap_.end();
+                 ++it)
+            {
+                if (it->second->isCreated()
+                        && it->second->subscriptionSettings() == subscriptionSettings)
+                {
+                    size_t load = it->second->noOfMonitoredItems();
+
+                    ReservationMap::const_iterator reservation = reservationMap_.find(it->first);
+                    if (reservation != reservationMap_.end())
+                        load += reservation->second;
+
+                    candidates.push_back(std::make_pair(load, it->second));
+                }
+            }
+        }
+
+        // fill the least loaded subscriptions first
+        std::sort(candidates.begin(), candidates.end());
+
+        size_t remaining = noOfItems;
+
+        for (size_t i = 0; i < candidates.size() && remaining > 0; i++)
+        {
+            size_t load = candidates[i].first;
+            size_t room = load < maxItems ? maxItems - load : 0;
+
+            // if we can't split, the subscription must have room for all items
+            if (room == 0 || (!splitAllowed && room < remaining))
+                continue;
+
+            Subscription* subscription = candidates[i].second;
+            ClientSubscriptionHandle handle = subscription->clientSubscriptionHandle();
+            size_t noOfItemsForShard = std::min(room, remaining);
+
+            activityMapMutex_.lock();
+            activityMap_[handle] = activityMap_[handle] + 1;
+            activityMapMutex_.unlock();
+
+            reservationMap_[handle] += noOfItemsForShard;
+            shards.push_back(subscription);
+            shardSizes.push_back(noOfItemsForShard);
+            remaining -= noOfItemsForShard;
+        }
+
+        // an asynchronous request can't be split, so it may not fit in any subscription
+        if (!splitAllowed && remaining > maxItems)
+            logger_->warning("An asynchronous request with %d monitored items can't be spread, so "
+                             "its subscription will exceed the maximum of %d monitored items",
+                             remaining, maxItems);
+
+        // create new subscriptions for the items that didn't fit
+        while (remaining > 0)
+        {
+            Subscription* subscription = 0;
+            Status creationStatus = createNewSubscription(subscriptionSettings, subscription);
+
+            // if the creation failed, the invocation will fail with SubscriptionNotCreatedError
+            if (creationStatus.isNotGood())
+                logger_->error(creationStatus);
+
+            size_t noOfItemsForShard = splitAllowed ? std::min(maxItems, remaining) : remaining;
+
+            reservationMap_[subscription->clientSubscriptionHandle()] += noOfItemsForShard;
+            shards.push_back(subscription);
+            shardSizes.push_back(noOfItemsForShard);
+            remaining -= noOfItemsForShard;
+        }
+
+        logger_->debug("The monitored items will be spread over %d subscriptions", shards.size());
+
+        return statuscodes::Good;
+    }
+
+
+    // Release a subscription that was acquired by acquireSubscriptionShards
+    // =============================================================================================
+    void SubscriptionFactory::releaseSubscriptionShard(
+            Subscription*&  subscription,
+            size_t          noOfItems)
+    {
+        subscriptionMapMutex_.lock();
+        ClientSubscriptionHandle handle = subscription->clientSubscriptionHandle();
+        ReservationMap::iterator it = reservationMap_.find(handle);
+        if (it != reservationMap_.end())
+        {
+            it->second = it->second > noOfItems ? it->second - noOfItems : 0;
+            if (it->second == 0)
+                reservationMap_.erase(it);
+        }
+        subscriptionMapMutex_.unlock();
+
+        releaseSubscription(subscription);
+    }
+
+
     // Construct a subscription if needed
     // =============================================================================================
     Status SubscriptionFactory::acquireSubscription(
@@ -343,37 +623,7 @@ namespace uaf
 
         // if no subscription exists yet, we create one
         if (subscription == 0)
-        {
-            ClientSubscriptionHandle clientSubscriptionHandle;
-            clientSubscriptionHandle = database_->createUniqueClientSubscriptionHandle();
-
-            logger_->debug("We create a new subscription with clientSubscriptionHandle %d",
-                           clientSubscriptionHandle);
-
-            // create a new subscription instance
-            subscription = new Subscription(
-                    logger_->loggerFactory(),
-                    subscriptionSettings,
-                    clientSubscriptionHandle,
-                    clientConnectionId_,
-                    uaSession_,
-                    this,
-                    clientInterface_,
-                    database_);
-
-            // store the new subscription instance in the subscriptionMap
-            subscriptionMap_[clientSubscriptionHandle] = subscription;
-
-            logger_->debug("The new subscription has been created");
-
-            // create an activity count for the subscription
-            activityMapMutex_.lock();
-            activityMap_[clientSubscriptionHandle] = 1;
-            activityMapMutex_.unlock();
-
-            // create the subscription on the server
-            ret = subscription->createSubscription();
-        }
+            ret = createNewSubscription(subscriptionSettings, subscription);
 
         // 'subscription' now points to an existing Subscription instance
         // (i.e. a valid memory location)
@@ -478,7 +728,9 @@ namespace uaf
                            handle, activityMap_[handle]);
 
             // check if the subscription is closed
-            if (!subscription->isCreated() && allowGarbageCollection)
+            if (   !subscription->isCreated()
+                && !subscription->isTransferPending()
+                && allowGarbageCollection)
             {
                 // if there is no ongoing activity of the session (in other words: if there is no
                 // pointer to this session being used), we may delete it!
@@ -500,6 +752,91 @@ namespace uaf
     }
 
 
+    // Check if there are subscriptions to transfer
+    // =============================================================================================
+    bool SubscriptionFactory::hasSubscriptionsToTransfer()
+    {
+        // lock the mutex to make sure the subscriptionMap_ is not being manipulated
+        UaMutexLocker locker(&subscriptionMapMutex_);
+
+        for (SubscriptionMap::const_iterator it = subscriptionMap_.begin();
+             it != subscriptionMap_.end();
+             ++it)
+        {
+            if (it->second->isTransferPending())
+                return true;
+        }
+
+        return false;
+    }
+
+
+    // Transfer the subscriptions of the lost session
+    // =============================================================================================
+    bool SubscriptionFactory::transferSubscriptions()
+    {
+        // collect the handles of the subscriptions to transfer (or to abandon)
+        vector<ClientSubscriptionHandle> handles;
+        {
+            UaMutexLocker locker(&subscriptionMapMutex_);
+
+            for (SubscriptionMap::const_iterator it = subscriptionMap_.begin();
+                 it != subscriptionMap_.end();
+                 ++it)
+            {
+                if (it->second->isTransferPending() || it->second->hasTransferExpired())
+                    handles.push_back(it->first);
+            }
+        }
+
+        if (handles.empty())
+            return false;
+
+        bool isConnected = uaSession_->isConnected();
+
+        logger_->debug("Checking %d subscription(s) to transfer", int(handles.size()));
+
+        int noOfTransferred = 0;
+        bool mustRecreate = false;
+
+        for (vector<ClientSubscriptionHandle>::const_iterator it = handles.begin();
+             it != handles.end();
+             ++it)
+        {
+            Subscription* subscription = 0;
+            Status acquireStatus = acquireExistingSubscription(*it, subscription);
+
+            if (acquireStatus.isGood())
+            {
+                if (subscription->hasTransferExpired())
+                {
+                    // the server has deleted the subscription by now, so don't keep the session
+                    // alive (or reconnect it) for this subscription any longer
+                    logger_->warning("Subscription %d was not transferred in time, so it will be "
+                                     "created again", *it);
+                    subscription->cancelTransfer();
+                    mustRecreate = true;
+                }
+                else if (isConnected && subscription->isTransferPending())
+                {
+                    if (subscription->transferSubscription().isGood())
+                        noOfTransferred++;
+                    else
+                        mustRecreate = true;
+                }
+
+                // the subscriptions that could not be transferred are garbage collected now
+                releaseSubscription(subscription);
+            }
+        }
+
+        logger_->debug("%d of the %d subscription(s) were transferred",
+                       noOfTransferred, int(handles.size()));
+
+        return mustRecreate;
+    }
+
+
     // implemented from callback interface
     // =============================================================================================
     void SubscriptionFactory::subscriptionStatusChanged(
@@ -515,8 +852,22 @@ namespace uaf
 
         if (acquireStatus.isGood())
         {
+            subscriptionstates::SubscriptionState state = uaf::subscriptionstates::toUaf(uaStatus);
+
+            // a subscription that is lost together with its session may still exist on the
+            // server, so keep it (instead of garbage collecting it) to transfer it later on
+            if (   state == uaf::subscriptionstates::Deleted
+                && subscription->isCreated()
+                && !uaSession_->isConnected()
+                && database_->clientSettings.reconnectTransferSubscriptions)
+            {
+                logger_->debug("Subscription %d will be transferred when the session is "
+                               "reconnected", clientSubscriptionHandle);
+                subscription->setTransferPending();
+            }
+
             // update the session state
-            subscription->setSubscriptionState(uaf::subscriptionstates::toUaf(uaStatus));
+            subscription->setSubscriptionState(state);
 
             // release the acquired session
             releaseSubscription(subscription);
@@ -564,23 +915,59 @@ namespace uaf
         // acquire the subscription:
         Subscription* subscription = 0;
         Status acquireStatus = acquireExistingSubscription(clientSubscriptionHandle, subscription);
-        SubscriptionInformation info;
 
         if (acquireStatus.isGood())
         {
-            // get the updated subscription info
-            info = subscription->subscriptionInformation();
+            // update the statistics, and either report the missing notifications or start
+            // recovering them (in which case the next messages are held back)
+            bool mustRecover = subscription->notificationsMissing(previousSequenceNumber,
+                                                                  newSequenceNumber);
 
             // release the acquired session
             releaseSubscription(subscription);
+
+            // the Republish service calls are made by the worker thread, so that the SDK
+            // callback thread is not blocked by them
+            if (mustRecover)
+                republishWorker_.enqueue(new RepublishInvocation(this,
+                                                                 clientSubscriptionHandle,
+                                                                 previousSequenceNumber,
+                                                                 newSequenceNumber));
         }
         else
         {
             logger_->warning("Unknown ClientSubscriptionHandle, discarding notification!");
+            clientInterface_->notificationsMissing(SubscriptionInformation(),
+                                                   previousSequenceNumber,
+                                                   newSequenceNumber);
         }
+    }
+
 
-        // call the callback interface
-        clientInterface_->notificationsMissing(info, previousSequenceNumber, newSequenceNumber);
+    // Republish the missing notifications (called by the republishWorker_)
+    // =============================================================================================
+    void SubscriptionFactory::republish(
+            ClientSubscriptionHandle    clientSubscriptionHandle,
+            uint32_t                    previousSequenceNumber,
+            uint32_t                    newSequenceNumber)
+    {
+        // acquire the subscription (it may have been deleted in the meantime)
+        Subscription* subscription = 0;
+        Status acquireStatus = acquireExistingSubscription(clientSubscriptionHandle, subscription);
+
+        if (acquireStatus.isGood())
+        {
+            // recover the missing notifications, and deliver the held back ones after them
+            subscription->recoverMissingNotifications(previousSequenceNumber, newSequenceNumber);
+
+            // release the acquired session
+            releaseSubscription(subscription);
+        }
+        else
+        {
+            logger_->debug("Subscription %d no longer exists, so nothing is republished",
+                           clientSubscriptionHandle);
+        }
     }
 
 
@@ -601,7 +988,7 @@ namespace uaf
         if (acquireStatus.isGood())
         {
             // update the session state
-            subscription->dataChange(dataNotifications, diagnosticInfos);
+            subscription->receivedDataChange(dataNotifications, diagnosticInfos);
 
             // release the acquired session
             releaseSubscription(subscription);
@@ -630,7 +1017,7 @@ namespace uaf
         if (acquireStatus.isGood())
         {
             // update the session state
-            subscription->newEvents(uaEventFieldList);
+            subscription->receivedEvents(uaEventFieldList);
 
             // release the acquired session
             releaseSubscription(subscription);
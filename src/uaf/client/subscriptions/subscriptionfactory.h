@@ -26,6 +26,9 @@
 #include <string>
 #include <sstream>
 #include <map>
+#include <vector>
+#include <utility>
+#include <algorithm>
 // SDK
 #include "uaclient/uaclientsdk.h"
 #include "uaclient/uasession.h"
@@ -34,7 +37,10 @@
 #include "uaf/util/status.h"
 #include "uaf/util/logger.h"
 #include "uaf/util/handles.h"
+#include "uaf/util/datetime.h"
 #include "uaf/client/clientexport.h"
+#include "uaf/client/settings/sessionsettings.h"
+#include "uaf/client/sessions/asyncserviceworker.h"
 #include "uaf/client/subscriptions/subscription.h"
 #include "uaf/client/clientinterface.h"
 
@@ -67,13 +73,15 @@ namespace uaf
          * @param clientInterface    Client interface to call when asynchronous
          *                           communication is received.
          * @param database           Pointer to the client database.
+         * @param sessionSettings    The settings of the session (for the publish request count).
          */
         SubscriptionFactory(
                 uaf::LoggerFactory*             loggerFactory,
                 uaf::ClientConnectionId         clientConnectionId,
                 UaClientSdk::UaSession*         uaSession,
                 uaf::ClientInterface*          clientInterface,
-                uaf::Database*                 database);
+                uaf::Database*                 database,
+                const uaf::SessionSettings&     sessionSettings);
 
 
         /**
@@ -129,6 +137,48 @@ namespace uaf
         std::vector<uaf::SubscriptionInformation> allSubscriptionInformations();
 
 
+        /**
+         * Get the number of publish requests that the session should keep outstanding (as
+         * configured by the session settings). This count is given to the SDK when the session
+         * is connected.
+         *
+         * @return  The publish request count, or 0 to leave it to the SDK.
+         */
+        uint32_t publishRequestCount();
+
+
+        /**
+         * Remember the publish request count that was given to the SDK when the session was
+         * connected, so that the subscriptions can report it.
+         *
+         * @param publishRequestCount   The publish request count in use, or 0 if the SDK decides.
+         */
+        void setEffectivePublishRequestCount(uint32_t publishRequestCount);
+
+
+        /**
+         * Check if some subscriptions were lost together with the session, and are waiting to be
+         * transferred to the new session.
+         *
+         * @return True if some subscriptions should be transferred.
+         */
+        bool hasSubscriptionsToTransfer();
+
+
+        /**
+         * Transfer the subscriptions that were lost together with the session to the new session
+         * (if uaf::ClientSettings::reconnectTransferSubscriptions is true, and if the session is
+         * connected again).
+         *
+         * The subscriptions that can't be transferred, or that have waited too long to be
+         * transferred, are deleted, so that their monitored items will be created again from the
+         * persistent requests.
+         *
+         * @return True if some subscriptions were deleted, and must be created again.
+         */
+        bool transferSubscriptions();
+
+
         /**
          * Get some information about the specified monitored item.
          *
@@ -175,6 +225,25 @@ namespace uaf
                std::vector<uaf::Status>&               results);
 
 
+       /**
+        * Modify the monitored items with the given ClientHandles, if they are owned by one of the
+        * subscriptions.
+        *
+        * @param clientHandles     The ClientHandles of the monitored items to be affected.
+        * @param settings          The new settings (one for each ClientHandle).
+        * @param serviceSettings   The service settings to be used.
+        * @param nameSpaceArray    The namespace array, to convert the event filters.
+        * @param results           A vector of statuses (one result for each ClientHandle).
+        * @return                  The immediate result of the service call.
+        */
+        uaf::Status modifyMonitoredItemsIfNeeded(
+               const std::vector<uaf::ClientHandle>&           clientHandles,
+               const std::vector<uaf::MonitoredItemSettings>&  settings,
+               const uaf::ServiceSettings*                     serviceSettings,
+               const uaf::NamespaceArray&                      nameSpaceArray,
+               std::vector<uaf::Status>&                       results);
+
+
         /**
          * Execute a service invocation in a generic way.
          *
@@ -206,19 +275,26 @@ namespace uaf
             // try to acquire a subscription for the given subscription settings
             uaf::Subscription* subscription = 0;
 
+            const uaf::SubscriptionSettings& subscriptionSettings
+                = request.subscriptionSettingsGiven
+                    ? request.subscriptionSettings
+                    : database_->clientSettings.defaultSubscriptionSettings;
+
             if (request.clientSubscriptionHandleGiven)
             {
                 ret = acquireExistingSubscription(request.clientSubscriptionHandle, subscription);
             }
-            else if (request.subscriptionSettingsGiven)
+            else if (subscriptionSettings.maxMonitoredItemsPerSubscription > 0)
             {
-                ret = acquireSubscription(request.subscriptionSettings, subscription);
+                // the monitored items may be spread over several subscriptions
+                return invokeShardedService<_Service>(invocation,
+                                                      subscriptionSettings,
+                                                      nameSpaceArray,
+                                                      serverArray);
             }
             else
             {
-                ret = acquireSubscription(
-                        database_->clientSettings.defaultSubscriptionSettings,
-                        subscription);
+                ret = acquireSubscription(subscriptionSettings, subscription);
             }
 
              // check if the subscription was acquired
@@ -252,6 +328,150 @@ namespace uaf
         DISALLOW_COPY_AND_ASSIGN(SubscriptionFactory);
 
 
+        // the republish invocations need to call republish()
+        friend class RepublishInvocation;
+
+
+        /**
+         * Recover the missing notification messages of a subscription (called by the
+         * republishWorker_), report the ones that could not be recovered, and deliver the
+         * messages that were held back during the recovery.
+         *
+         * @param clientSubscriptionHandle  The handle of the subscription.
+         * @param previousSequenceNumber    The sequence number of the last received message.
+         * @param newSequenceNumber         The sequence number of the message after the gap.
+         */
+        void republish(
+                uaf::ClientSubscriptionHandle   clientSubscriptionHandle,
+                uint32_t                        previousSequenceNumber,
+                uint32_t                        newSequenceNumber);
+
+
+        /**
+         * Execute a service invocation of which the monitored items must be spread over several
+         * subscriptions, because SubscriptionSettings::maxMonitoredItemsPerSubscription is given.
+         *
+         * A synchronous invocation is split into one invocation per subscription, and the results
+         * of these invocations are copied back to the original invocation. An asynchronous
+         * invocation is forwarded as a whole to the least loaded subscription.
+         *
+         * @param invocation            The invocation to execute.
+         * @param subscriptionSettings  The settings of the subscriptions.
+         * @param nameSpaceArray        The namespace array.
+         * @param serverArray           The server array.
+         * @return                      Good if the monitored items of at least one of the
+         *                              subscriptions could be created.
+         */
+        template<typename _Service>
+        uaf::Status invokeShardedService(
+                typename _Service::Invocation&      invocation,
+                const uaf::SubscriptionSettings&    subscriptionSettings,
+                const uaf::NamespaceArray&          nameSpaceArray,
+                const uaf::ServerArray&             serverArray)
+        {
+            typedef typename _Service::Invocation Invocation;
+
+            uaf::Status ret;
+
+            std::size_t noOfTargets = invocation.requestTargets().size();
+            std::vector<uaf::Subscription*> shards;
+            std::vector<std::size_t> shardSizes;
+
+            ret = acquireSubscriptionShards(subscriptionSettings,
+                                            noOfTargets,
+                                            !invocation.asynchronous(),
+                                            shards,
+                                            shardSizes);
+
+            if (ret.isNotGood())
+                return ret;
+
+            // the subscription information of the invocation is the one of the first shard,
+            // the individual targets get the handle of their own shard
+            invocation.setSubscriptionInformation(shards[0]->subscriptionInformation());
+
+            if (shards.size() == 1)
+            {
+                if (shards[0]->isCreated())
+                    ret = shards[0]->invokeService(invocation, nameSpaceArray, serverArray);
+                else
+                    ret = uaf::SubscriptionNotCreatedError();
+
+                releaseSubscriptionShard(shards[0], shardSizes[0]);
+
+                return ret;
+            }
+
+            logger_->debug("Spreading %d monitored items over %d subscriptions",
+                           noOfTargets, shards.size());
+
+            uaf::Status firstError;
+            std::size_t noOfFailedShards = 0;
+            std::size_t first = 0;
+
+            for (std::size_t k = 0; k < shards.size(); k++)
+            {
+                Invocation shardInvocation;
+                shardInvocation.setAsynchronous(false);
+                shardInvocation.setRequestHandle(invocation.requestHandle());
+                shardInvocation.setServiceSettings(invocation.serviceSettings());
+                shardInvocation.setSubscriptionInformation(shards[k]->subscriptionInformation());
+
+                for (std::size_t j = first; j < first + shardSizes[k]; j++)
+                    shardInvocation.addTarget(invocation.ranks()[j],
+                                              invocation.requestTargets()[j],
+                                              invocation.resultTargets()[j]);
+
+                uaf::Status shardStatus;
+
+                if (shards[k]->isCreated())
+                {
+                    logger_->debug("Forwarding %d monitored items to subscription %d",
+                                   shardSizes[k], shards[k]->clientSubscriptionHandle());
+                    shardStatus = shards[k]->invokeService(shardInvocation,
+                                                           nameSpaceArray,
+                                                           serverArray);
+                }
+                else
+                {
+                    shardStatus = uaf::SubscriptionNotCreatedError();
+                }
+
+                // copy the results back to the original invocation
+                for (std::size_t j = first; j < first + shardSizes[k]; j++)
+                {
+                    invocation.resultTargets()[j] = shardInvocation.resultTargets()[j - first];
+                    invocation.setClientSubscriptionHandle(j,
+                                                           shards[k]->clientSubscriptionHandle());
+
+                    if (shardStatus.isNotGood())
+                        invocation.resultTargets()[j].status = shardStatus;
+                }
+
+                if (shardStatus.isNotGood())
+                {
+                    logger_->error(shardStatus);
+                    if (noOfFailedShards == 0)
+                        firstError = shardStatus;
+                    noOfFailedShards++;
+                }
+
+                first += shardSizes[k];
+
+                releaseSubscriptionShard(shards[k], shardSizes[k]);
+            }
+
+            // only fail the whole invocation if none of the shards succeeded, otherwise the
+            // failed targets are reported by their own status
+            if (noOfFailedShards == shards.size())
+                ret = firstError;
+            else
+                ret = uaf::statuscodes::Good;
+
+            return ret;
+        }
+
+
         /** private typedef: the number of activities (i.e. active service invocations). */
         typedef uint32_t Activity;
 
@@ -264,6 +484,18 @@ namespace uaf
         // private typedef: a map to relate transaction ids with request handles
         typedef std::map<uaf::TransactionId, uaf::RequestHandle> TransactionMap;
 
+        // private typedef: a map to store the number of monitored items that are about to be
+        // created in each subscription
+        typedef std::map<uaf::ClientSubscriptionHandle, std::size_t> ReservationMap;
+
+
+        /**
+         * Get the publish request count that was given to the SDK at the last connect.
+         *
+         * @return  The publish request count in use, or 0 if the SDK decides.
+         */
+        uint32_t effectivePublishRequestCount();
+
 
         /**
          * Acquire a subscription with the given properties (by getting an existing one, or creating
@@ -282,6 +514,56 @@ namespace uaf
                 uaf::Subscription*&                 subscription);
 
 
+        /**
+         * Acquire the subscriptions ("shards") over which the given number of monitored items
+         * can be spread, without exceeding SubscriptionSettings::maxMonitoredItemsPerSubscription.
+         *
+         * The existing subscriptions with the fewest monitored items are filled first, and new
+         * subscriptions are created if needed. The monitored items are reserved in the
+         * subscriptions until releaseSubscriptionShard() is called, so that concurrent requests
+         * take them into account.
+         *
+         * @param subscriptionSettings  Settings of the subscriptions to be acquired.
+         * @param noOfItems             The number of monitored items to be placed.
+         * @param splitAllowed          False if all items must be placed in a single subscription.
+         * @param shards                Output parameter: the acquired subscriptions.
+         * @param shardSizes            Output parameter: the number of items for each shard.
+         * @return                      Good if the shards could be acquired.
+         */
+        uaf::Status acquireSubscriptionShards(
+                const uaf::SubscriptionSettings&    subscriptionSettings,
+                std::size_t                         noOfItems,
+                bool                                splitAllowed,
+                std::vector<uaf::Subscription*>&    shards,
+                std::vector<std::size_t>&           shardSizes);
+
+
+        /**
+         * Release a subscription that was acquired by acquireSubscriptionShards().
+         *
+         * @param subscription  Pointer to the subscription which we like to release.
+         * @param noOfItems     The number of monitored items that were reserved for it.
+         */
+        void releaseSubscriptionShard(
+                uaf::Subscription*&    subscription,
+                std::size_t            noOfItems);
+
+
+        /**
+         * Create a new subscription and store it (with an activity count of 1).
+         *
+         * The subscriptionMapMutex_ must be locked by the caller.
+         *
+         * @param subscriptionSettings  Settings of the subscription to be created.
+         * @param subscription          Output parameter: the new subscription.
+         * @return                      The result of the creation of the subscription on the
+         *                              server.
+         */
+        uaf::Status createNewSubscription(
+                const uaf::SubscriptionSettings&    subscriptionSettings,
+                uaf::Subscription*&                 subscription);
+
+
         /**
          * Acquire an existing subscription with the given client connection ID.
          *
@@ -333,6 +615,17 @@ namespace uaf
         // map storing all activity counts, and its mutex
         ActivityMap activityMap_;
         UaMutex     activityMapMutex_;
+        // map storing the reserved monitored items per subscription (guarded by the
+        // subscriptionMapMutex_)
+        ReservationMap reservationMap_;
+        // the configured publish request count of the session, the one in use, and the mutex
+        // of the latter
+        const uint32_t      publishRequestCount_;
+        uint32_t            effectivePublishRequestCount_;
+        UaMutex             publishRequestCountMutex_;
+        // a single thread that republishes missing notification messages (in order), so that
+        // the SDK callback thread is never blocked by the Republish service calls
+        uaf::AsyncServiceWorker republishWorker_;
         // the mutex to safeguard the critical sections
         UaMutex subscriptionMutex_;
         // the RequesterInterface to call when asynchronous messages are received
@@ -33,7 +33,11 @@ namespace uaf
     SubscriptionInformation::SubscriptionInformation()
     : clientConnectionId(0),
       clientSubscriptionHandle(0),
-      subscriptionState(uaf::subscriptionstates::Deleted)
+      subscriptionState(uaf::subscriptionstates::Deleted),
+      noOfNotificationGaps(0),
+      noOfMissingNotifications(0),
+      noOfRecoveredNotifications(0),
+      publishRequestCount(0)
     {}
 
 
@@ -45,7 +49,11 @@ namespace uaf
             uaf::subscriptionstates::SubscriptionState subscriptionState)
     : clientConnectionId(clientConnectionId),
       clientSubscriptionHandle(clientSubscriptionHandle),
-      subscriptionState(subscriptionState)
+      subscriptionState(subscriptionState),
+      noOfNotificationGaps(0),
+      noOfMissingNotifications(0),
+      noOfRecoveredNotifications(0),
+      publishRequestCount(0)
     {}
 
     // Get a new client connection id
@@ -68,7 +76,23 @@ namespace uaf
                 << " (" << uaf::subscriptionstates::toString(subscriptionState) << ")\n";
 
         ss << indent << " - subscriptionSettings\n";
-        ss << subscriptionSettings.toString(indent + "   ", colon);
+        ss << subscriptionSettings.toString(indent + "   ", colon) << "\n";
+
+        ss << indent << " - noOfNotificationGaps";
+        ss << fillToPos(ss, colon);
+        ss << ": " << noOfNotificationGaps << "\n";
+
+        ss << indent << " - noOfMissingNotifications";
+        ss << fillToPos(ss, colon);
+        ss << ": " << noOfMissingNotifications << "\n";
+
+        ss << indent << " - noOfRecoveredNotifications";
+        ss << fillToPos(ss, colon);
+        ss << ": " << noOfRecoveredNotifications << "\n";
+
+        ss << indent << " - publishRequestCount";
+        ss << fillToPos(ss, colon);
+        ss << ": " << publishRequestCount;
 
 
         return ss.str();
@@ -82,7 +106,11 @@ namespace uaf
         return    object1.clientConnectionId == object2.clientConnectionId
                && object1.clientSubscriptionHandle == object2.clientSubscriptionHandle
                && object1.subscriptionState == object2.subscriptionState
-               && object1.subscriptionSettings == object2.subscriptionSettings;
+               && object1.subscriptionSettings == object2.subscriptionSettings
+               && object1.noOfNotificationGaps == object2.noOfNotificationGaps
+               && object1.noOfMissingNotifications == object2.noOfMissingNotifications
+               && object1.noOfRecoveredNotifications == object2.noOfRecoveredNotifications
+               && object1.publishRequestCount == object2.publishRequestCount;
     }
 
 
@@ -104,7 +132,15 @@ namespace uaf
             return object1.clientSubscriptionHandle < object2.clientSubscriptionHandle;
         else if (object1.subscriptionState != object2.subscriptionState)
             return object1.subscriptionState < object2.subscriptionState;
-        else
+        else if (object1.subscriptionSettings != object2.subscriptionSettings)
             return object1.subscriptionSettings < object2.subscriptionSettings;
+        else if (object1.noOfNotificationGaps != object2.noOfNotificationGaps)
+            return object1.noOfNotificationGaps < object2.noOfNotificationGaps;
+        else if (object1.noOfMissingNotifications != object2.noOfMissingNotifications)
+            return object1.noOfMissingNotifications < object2.noOfMissingNotifications;
+        else if (object1.noOfRecoveredNotifications != object2.noOfRecoveredNotifications)
+            return object1.noOfRecoveredNotifications < object2.noOfRecoveredNotifications;
+        else
+            return object1.publishRequestCount < object2.publishRequestCount;
     }
 }
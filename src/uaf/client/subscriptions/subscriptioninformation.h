@@ -78,6 +78,22 @@ namespace uaf
         /** The SubscriptonSettings of the subscription. */
         uaf::SubscriptionSettings                   subscriptionSettings;
 
+        /** The number of gaps that were detected in the sequence numbers of the notification
+            messages of the subscription. */
+        uint32_t                                    noOfNotificationGaps;
+
+        /** The total number of notification messages that were missing. */
+        uint32_t                                    noOfMissingNotifications;
+
+        /** The number of missing notification messages that could be recovered by the Republish
+            service (see uaf::SubscriptionSettings::republishMissingNotifications). */
+        uint32_t                                    noOfRecoveredNotifications;
+
+        /** The number of publish requests that the session of the subscription keeps outstanding,
+            i.e. the count that was given to the SDK when the session was last connected by the
+            UAF (see uaf::SessionSettings::publishRequestCount), or 0 if the SDK decides. */
+        uint32_t                                    publishRequestCount;
+
         /**
          * Get a string representation of the information.
          */
@@ -0,0 +1,343 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_BINARYCODEC_H_
+#define UAF_BINARYCODEC_H_
+
+
+// STD
+#include <string>
+#include <vector>
+#include <cstring>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/datetime.h"
+#include "uaf/util/bytestring.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+     * A BinaryEncoder appends values to a buffer, encoded according to the OPC UA Binary
+     * encoding (little endian, strings and arrays prefixed by their Int32 length).
+     *
+     * It is used by the structs that are generated by pyuaf.util.structgen: a structure value
+     * is encoded by calling write() for each field, so no intermediate generic value is needed.
+     * The buffer is only appended to, so it can be reused (after clear()) to avoid allocations.
+     *
+     * @ingroup Util
+     **********************************************************************************************/
+    class UAF_EXPORT BinaryEncoder
+    {
+    public:
+
+        /**
+         * Create an encoder that appends to the given buffer.
+         *
+         * @param buffer    The buffer to append to.
+         */
+        BinaryEncoder(std::vector<uint8_t>& buffer) : buffer_(buffer) {}
+
+        /** Encode a built-in value. */
+        void write(bool value)      { buffer_.push_back(value ? 1 : 0); }
+        void write(int8_t value)    { writeBits(uint8_t(value), 1); }
+        void write(uint8_t value)   { writeBits(value, 1); }
+        void write(int16_t value)   { writeBits(uint16_t(value), 2); }
+        void write(uint16_t value)  { writeBits(value, 2); }
+        void write(int32_t value)   { writeBits(uint32_t(value), 4); }
+        void write(uint32_t value)  { writeBits(value, 4); }
+        void write(int64_t value)   { writeBits(uint64_t(value), 8); }
+        void write(uint64_t value)  { writeBits(value, 8); }
+
+        void write(float value)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, 4);
+            writeBits(bits, 4);
+        }
+
+        void write(double value)
+        {
+            uint64_t bits;
+            std::memcpy(&bits, &value, 8);
+            writeBits(bits, 8);
+        }
+
+        void write(const std::string& value)
+        {
+            write(int32_t(value.size()));
+            buffer_.insert(buffer_.end(), value.begin(), value.end());
+        }
+
+        void write(const uaf::DateTime& value)
+        {
+            write(int64_t(value.toFileTime()));
+        }
+
+        void write(const uaf::ByteString& value)
+        {
+            // uaf::ByteString can't tell a null from an empty ByteString, so both are encoded
+            // with length 0 (which is what read() would give back for either of them)
+            write(int32_t(value.length()));
+            if (value.length() > 0)
+                buffer_.insert(buffer_.end(), value.data(), value.data() + value.length());
+        }
+
+        /** Encode an array of values. */
+        template<typename _T>
+        void write(const std::vector<_T>& array)
+        {
+            write(int32_t(array.size()));
+            for (typename std::vector<_T>::size_type i = 0; i < array.size(); i++)
+                write(array[i]);
+        }
+
+        /** Encode a (generated) structure, by letting it encode its fields. */
+        template<typename _T>
+        void write(const _T& structure)
+        {
+            structure.encode(*this);
+        }
+
+    private:
+
+        // the buffer to append to
+        std::vector<uint8_t>& buffer_;
+
+        // append the given number of bytes of an integer, least significant byte first
+        void writeBits(uint64_t bits, int noOfBytes)
+        {
+            for (int i = 0; i < noOfBytes; i++)
+                buffer_.push_back(uint8_t(bits >> (8 * i)));
+        }
+    };
+
+
+
+    /*******************************************************************************************//**
+     * A BinaryDecoder reads values from a buffer that is encoded according to the OPC UA Binary
+     * encoding (see uaf::BinaryEncoder).
+     *
+     * The decoder doesn't copy the buffer. Every read() returns false (and leaves the value
+     * untouched) when the buffer doesn't contain enough bytes.
+     *
+     * @ingroup Util
+     **********************************************************************************************/
+    class UAF_EXPORT BinaryDecoder
+    {
+    public:
+
+        /**
+         * Create a decoder that reads from the given bytes.
+         *
+         * @param data      The encoded bytes.
+         * @param length    The number of encoded bytes.
+         */
+        BinaryDecoder(const uint8_t* data, int32_t length)
+        : data_(data),
+          remaining_(length > 0 ? uint32_t(length) : 0)
+        {}
+
+        /** Get the number of bytes that were not read yet. */
+        uint32_t remaining() const { return remaining_; }
+
+        /** Decode a built-in value. */
+        bool read(bool& value)
+        {
+            uint64_t bits;
+            bool ret = readBits(bits, 1);
+            if (ret)
+                value = (bits != 0);
+            return ret;
+        }
+
+        bool read(int8_t& value)    { return readInteger(value, 1); }
+        bool read(uint8_t& value)   { return readInteger(value, 1); }
+        bool read(int16_t& value)   { return readInteger(value, 2); }
+        bool read(uint16_t& value)  { return readInteger(value, 2); }
+        bool read(int32_t& value)   { return readInteger(value, 4); }
+        bool read(uint32_t& value)  { return readInteger(value, 4); }
+        bool read(int64_t& value)   { return readInteger(value, 8); }
+        bool read(uint64_t& value)  { return readInteger(value, 8); }
+
+        bool read(float& value)
+        {
+            uint32_t bits;
+            bool ret = readInteger(bits, 4);
+            if (ret)
+                std::memcpy(&value, &bits, 4);
+            return ret;
+        }
+
+        bool read(double& value)
+        {
+            uint64_t bits;
+            bool ret = readBits(bits, 8);
+            if (ret)
+                std::memcpy(&value, &bits, 8);
+            return ret;
+        }
+
+        bool read(std::string& value)
+        {
+            const uint8_t* bytes;
+            int32_t length;
+            bool ret = readBytes(bytes, length);
+            if (ret)
+            {
+                if (length > 0)
+                    value.assign(reinterpret_cast<const char*>(bytes), length);
+                else
+                    value.clear();
+            }
+            return ret;
+        }
+
+        bool read(uaf::DateTime& value)
+        {
+            int64_t fileTime;
+            bool ret = read(fileTime);
+            if (ret)
+                value = uaf::DateTime::fromFileTime(fileTime);
+            return ret;
+        }
+
+        bool read(uaf::ByteString& value)
+        {
+            const uint8_t* bytes;
+            int32_t length;
+            bool ret = readBytes(bytes, length);
+            if (ret)
+                value = uaf::ByteString(length, const_cast<uint8_t*>(bytes));
+            return ret;
+        }
+
+        /** Decode an array of values. */
+        template<typename _T>
+        bool read(std::vector<_T>& array)
+        {
+            int32_t length;
+            bool ret = readArrayLength(length);
+            if (ret)
+            {
+                array.resize(length);
+                for (int32_t i = 0; i < length && ret; i++)
+                    ret = read(array[i]);
+            }
+            return ret;
+        }
+
+        /** Decode an array of booleans (which has no references to its elements). */
+        bool read(std::vector<bool>& array)
+        {
+            int32_t length;
+            bool ret = readArrayLength(length);
+            if (ret)
+            {
+                array.resize(length);
+                for (int32_t i = 0; i < length && ret; i++)
+                {
+                    bool element = false;
+                    ret = read(element);
+                    array[i] = element;
+                }
+            }
+            return ret;
+        }
+
+        /** Decode a (generated) structure, by letting it decode its fields. */
+        template<typename _T>
+        bool read(_T& structure)
+        {
+            return structure.decode(*this);
+        }
+
+    private:
+
+        // the bytes that were not read yet
+        const uint8_t*  data_;
+        uint32_t        remaining_;
+
+        // read the given number of bytes of an integer, least significant byte first
+        bool readBits(uint64_t& bits, uint32_t noOfBytes)
+        {
+            bool ret = (remaining_ >= noOfBytes);
+            if (ret)
+            {
+                bits = 0;
+                for (uint32_t i = 0; i < noOfBytes; i++)
+                    bits |= uint64_t(data_[i]) << (8 * i);
+                data_      += noOfBytes;
+                remaining_ -= noOfBytes;
+            }
+            return ret;
+        }
+
+        template<typename _T>
+        bool readInteger(_T& value, uint32_t noOfBytes)
+        {
+            uint64_t bits;
+            bool ret = readBits(bits, noOfBytes);
+            if (ret)
+                value = _T(bits);
+            return ret;
+        }
+
+        // read a length-prefixed sequence of bytes (a length of -1 means NULL)
+        bool readBytes(const uint8_t*& bytes, int32_t& length)
+        {
+            bytes = 0;
+            bool ret = read(length);
+            if (ret && length > 0)
+            {
+                ret = (uint32_t(length) <= remaining_);
+                if (ret)
+                {
+                    bytes       = data_;
+                    data_      += length;
+                    remaining_ -= length;
+                }
+            }
+            return ret;
+        }
+
+        // read the length of an array, and check that the buffer can hold that many elements
+        bool readArrayLength(int32_t& length)
+        {
+            bool ret = read(length);
+            if (ret)
+            {
+                if (length < 0)
+                    length = 0; // a NULL array is decoded as an empty array
+                else
+                    ret = (uint32_t(length) <= remaining_); // each element has at least 1 byte
+            }
+            return ret;
+        }
+    };
+
+}
+
+
+#endif /* UAF_BINARYCODEC_H_ */
@@ -0,0 +1,195 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/util/contentfilter.h"
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using namespace uaf::filteroperators;
+    using std::string;
+    using std::size_t;
+    using std::stringstream;
+    using std::vector;
+
+
+    // Constructor
+    // =============================================================================================
+    ContentFilter::ContentFilter()
+    {}
+
+
+    // Add an element
+    // =============================================================================================
+    uint32_t ContentFilter::addElement(
+            FilterOperator                  filterOperator,
+            const vector<FilterOperand>&    filterOperands)
+    {
+        elements.push_back(ContentFilterElement(filterOperator, filterOperands));
+        return uint32_t(elements.size() - 1);
+    }
+
+
+    // Add an element with two operands
+    // =============================================================================================
+    uint32_t ContentFilter::addBinaryElement(
+            FilterOperator          filterOperator,
+            const FilterOperand&    operand1,
+            const FilterOperand&    operand2)
+    {
+        vector<FilterOperand> operands;
+        operands.push_back(operand1);
+        operands.push_back(operand2);
+        return addElement(filterOperator, operands);
+    }
+
+
+    // Add an OfType element
+    // =============================================================================================
+    uint32_t ContentFilter::ofType(const NodeId& typeId)
+    {
+        Variant value;
+        value.setNodeId(typeId);
+        return addElement(OfType, vector<FilterOperand>(1, FilterOperand::literal(value)));
+    }
+
+
+    // Add a comparison element
+    // =============================================================================================
+    uint32_t ContentFilter::equals(const FilterOperand& operand1, const FilterOperand& operand2)
+    {
+        return addBinaryElement(Equals, operand1, operand2);
+    }
+
+    uint32_t ContentFilter::greaterThan(
+            const FilterOperand& operand1,
+            const FilterOperand& operand2)
+    {
+        return addBinaryElement(GreaterThan, operand1, operand2);
+    }
+
+    uint32_t ContentFilter::greaterThanOrEqual(
+            const FilterOperand& operand1,
+            const FilterOperand& operand2)
+    {
+        return addBinaryElement(GreaterThanOrEqual, operand1, operand2);
+    }
+
+    uint32_t ContentFilter::lessThan(const FilterOperand& operand1, const FilterOperand& operand2)
+    {
+        return addBinaryElement(LessThan, operand1, operand2);
+    }
+
+    uint32_t ContentFilter::lessThanOrEqual(
+            const FilterOperand& operand1,
+            const FilterOperand& operand2)
+    {
+        return addBinaryElement(LessThanOrEqual, operand1, operand2);
+    }
+
+
+    // Add an InList element
+    // =============================================================================================
+    uint32_t ContentFilter::inList(const FilterOperand& operand, const vector<FilterOperand>& list)
+    {
+        vector<FilterOperand> operands;
+        operands.push_back(operand);
+        operands.insert(operands.end(), list.begin(), list.end());
+        return addElement(InList, operands);
+    }
+
+
+    // Add a logical element
+    // =============================================================================================
+    uint32_t ContentFilter::andElements(uint32_t elementIndex1, uint32_t elementIndex2)
+    {
+        return addBinaryElement(And,
+                                FilterOperand::element(elementIndex1),
+                                FilterOperand::element(elementIndex2));
+    }
+
+    uint32_t ContentFilter::orElements(uint32_t elementIndex1, uint32_t elementIndex2)
+    {
+        return addBinaryElement(Or,
+                                FilterOperand::element(elementIndex1),
+                                FilterOperand::element(elementIndex2));
+    }
+
+    uint32_t ContentFilter::notElement(uint32_t elementIndex)
+    {
+        return addElement(Not, vector<FilterOperand>(1, FilterOperand::element(elementIndex)));
+    }
+
+
+    // Get a string representation
+    // =============================================================================================
+    string ContentFilter::toString(const string& indent, size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - elements[]";
+
+        if (elements.size() == 0)
+        {
+            ss << fillToPos(ss, colon);
+            ss << ": []";
+        }
+        else
+        {
+            for (size_t i = 0; i < elements.size(); i++)
+            {
+                ss << "\n";
+                ss << indent << "    - " << "elements[" << i << "]";
+                if (i == elements.size() - 1)
+                    ss << " (root)";
+                ss << "\n";
+                ss << elements[i].toString(indent + "      ", colon);
+            }
+        }
+
+        return ss.str();
+    }
+
+
+    // operator<
+    // =============================================================================================
+    bool operator<(const ContentFilter& object1, const ContentFilter& object2)
+    {
+        return object1.elements < object2.elements;
+    }
+
+
+    // operator==
+    // =============================================================================================
+    bool operator==(const ContentFilter& object1, const ContentFilter& object2)
+    {
+        return object1.elements == object2.elements;
+    }
+
+
+    // operator!=
+    // =============================================================================================
+    bool operator!=(const ContentFilter& object1, const ContentFilter& object2)
+    {
+        return !(object1 == object2);
+    }
+
+}
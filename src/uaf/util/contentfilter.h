@@ -0,0 +1,235 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_CONTENTFILTER_H_
+#define UAF_CONTENTFILTER_H_
+
+
+// STD
+#include <vector>
+#include <string>
+#include <sstream>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/stringifiable.h"
+#include "uaf/util/nodeid.h"
+#include "uaf/util/filteroperators.h"
+#include "uaf/util/filteroperand.h"
+#include "uaf/util/contentfilterelement.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::ContentFilter is a tree of filter elements, such as the where clause of a
+    * uaf::EventFilter.
+    *
+    * The filter is built bottom-up: each method that adds an element returns the index of the new
+    * element, which can then be used as an operand of the next element (e.g. by andElements()).
+    * The element that was added last is the root of the filter, i.e. its result decides whether
+    * an event passes or not. An empty content filter lets all events pass.
+    *
+    * For instance, to receive only the events of type ns=2;i=1234 with a Severity of at least
+    * 500:
+    * @code
+    * uaf::ContentFilter filter;
+    * uint32_t ofType  = filter.ofType(uaf::NodeId(1234, 2));
+    * uint32_t severe  = filter.greaterThanOrEqual(
+    *                       uaf::FilterOperand::simpleAttribute(severityOperand),
+    *                       uaf::FilterOperand::literal(severity));
+    * filter.andElements(ofType, severe);
+    * @endcode
+    *
+    * Literal NodeIds may be specified by namespace URI: they are resolved by the UAF before the
+    * filter is sent to the server.
+    *
+    * @ingroup Util
+    ***********************************************************************************************/
+    class UAF_EXPORT ContentFilter
+    {
+    public:
+
+
+        /**
+         * Construct an empty content filter.
+         */
+        ContentFilter();
+
+
+        /**
+         * The elements of the filter (the last one is the root).
+         */
+        std::vector<uaf::ContentFilterElement> elements;
+
+
+        /**
+         * Check if the filter has no elements.
+         *
+         * @return  True if the filter is empty (and therefore lets all events pass).
+         */
+        bool isEmpty() const { return elements.empty(); }
+
+
+        /**
+         * Add an element to the filter.
+         *
+         * @param filterOperator    The operator of the element.
+         * @param filterOperands    The operands of the element.
+         * @return                  The index of the new element.
+         */
+        uint32_t addElement(
+                uaf::filteroperators::FilterOperator    filterOperator,
+                const std::vector<uaf::FilterOperand>&  filterOperands);
+
+
+        /**
+         * Add an OfType element: true if the event is of (a subtype of) the given type.
+         *
+         * @param typeId    The NodeId of the event type.
+         * @return          The index of the new element.
+         */
+        uint32_t ofType(const uaf::NodeId& typeId);
+
+
+        /**
+         * Add an Equals element.
+         *
+         * @return  The index of the new element.
+         */
+        uint32_t equals(const uaf::FilterOperand& operand1, const uaf::FilterOperand& operand2);
+
+
+        /**
+         * Add a GreaterThan element: true if operand1 > operand2.
+         *
+         * @return  The index of the new element.
+         */
+        uint32_t greaterThan(
+                const uaf::FilterOperand& operand1,
+                const uaf::FilterOperand& operand2);
+
+
+        /**
+         * Add a GreaterThanOrEqual element: true if operand1 >= operand2.
+         *
+         * @return  The index of the new element.
+         */
+        uint32_t greaterThanOrEqual(
+                const uaf::FilterOperand& operand1,
+                const uaf::FilterOperand& operand2);
+
+
+        /**
+         * Add a LessThan element: true if operand1 < operand2.
+         *
+         * @return  The index of the new element.
+         */
+        uint32_t lessThan(const uaf::FilterOperand& operand1, const uaf::FilterOperand& operand2);
+
+
+        /**
+         * Add a LessThanOrEqual element: true if operand1 <= operand2.
+         *
+         * @return  The index of the new element.
+         */
+        uint32_t lessThanOrEqual(
+                const uaf::FilterOperand& operand1,
+                const uaf::FilterOperand& operand2);
+
+
+        /**
+         * Add an InList element: true if the operand equals one of the operands of the list.
+         *
+         * @param operand   The operand to check.
+         * @param list      The operands to compare with.
+         * @return          The index of the new element.
+         */
+        uint32_t inList(
+                const uaf::FilterOperand&               operand,
+                const std::vector<uaf::FilterOperand>&  list);
+
+
+        /**
+         * Add an And element: true if both elements are true.
+         *
+         * @param elementIndex1 The index of the first element.
+         * @param elementIndex2 The index of the second element.
+         * @return              The index of the new element.
+         */
+        uint32_t andElements(uint32_t elementIndex1, uint32_t elementIndex2);
+
+
+        /**
+         * Add an Or element: true if at least one of the elements is true.
+         *
+         * @param elementIndex1 The index of the first element.
+         * @param elementIndex2 The index of the second element.
+         * @return              The index of the new element.
+         */
+        uint32_t orElements(uint32_t elementIndex1, uint32_t elementIndex2);
+
+
+        /**
+         * Add a Not element: true if the element is false.
+         *
+         * @param elementIndex  The index of the element.
+         * @return              The index of the new element.
+         */
+        uint32_t notElement(uint32_t elementIndex);
+
+
+        /**
+         * Get a string representation.
+         *
+         * @return  A string representation.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=24) const;
+
+
+        // comparison operators
+        friend bool UAF_EXPORT operator<(
+                const ContentFilter& object1,
+                const ContentFilter& object2);
+        friend bool UAF_EXPORT operator==(
+                const ContentFilter& object1,
+                const ContentFilter& object2);
+        friend bool UAF_EXPORT operator!=(
+                const ContentFilter& object1,
+                const ContentFilter& object2);
+
+
+    private:
+
+        // add an element with two operands
+        uint32_t addBinaryElement(
+                uaf::filteroperators::FilterOperator    filterOperator,
+                const uaf::FilterOperand&               operand1,
+                const uaf::FilterOperand&               operand2);
+
+    };
+
+}
+
+
+#endif /* UAF_CONTENTFILTER_H_ */
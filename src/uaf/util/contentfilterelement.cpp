@@ -0,0 +1,111 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/util/contentfilterelement.h"
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::size_t;
+    using std::stringstream;
+    using std::vector;
+
+
+    // Constructor
+    // =============================================================================================
+    ContentFilterElement::ContentFilterElement()
+    : filterOperator(filteroperators::Equals)
+    {}
+
+
+    // Constructor
+    // =============================================================================================
+    ContentFilterElement::ContentFilterElement(
+            filteroperators::FilterOperator filterOperator,
+            const vector<FilterOperand>&    filterOperands)
+    : filterOperator(filterOperator),
+      filterOperands(filterOperands)
+    {}
+
+
+    // Get a string representation
+    // =============================================================================================
+    string ContentFilterElement::toString(const string& indent, size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - filterOperator";
+        ss << fillToPos(ss, colon);
+        ss << ": " << int(filterOperator)
+           << " (" << filteroperators::toString(filterOperator) << ")\n";
+
+        ss << indent << " - filterOperands[]";
+
+        if (filterOperands.size() == 0)
+        {
+            ss << fillToPos(ss, colon);
+            ss << ": []";
+        }
+        else
+        {
+            for (size_t i = 0; i < filterOperands.size(); i++)
+            {
+                ss << "\n";
+                ss << indent << "    - " << "filterOperands[" << i << "]\n";
+                ss << filterOperands[i].toString(indent + "      ", colon);
+            }
+        }
+
+        return ss.str();
+    }
+
+
+    // operator<
+    // =============================================================================================
+    bool operator<(const ContentFilterElement& object1, const ContentFilterElement& object2)
+    {
+        if ( object1.filterOperator != object2.filterOperator )
+            return object1.filterOperator < object2.filterOperator;
+        else if ( object1.filterOperands != object2.filterOperands )
+            return object1.filterOperands < object2.filterOperands;
+        else
+            return false;
+    }
+
+
+    // operator==
+    // =============================================================================================
+    bool operator==(const ContentFilterElement& object1, const ContentFilterElement& object2)
+    {
+        return    ( object1.filterOperator == object2.filterOperator )
+               && ( object1.filterOperands == object2.filterOperands );
+    }
+
+
+    // operator!=
+    // =============================================================================================
+    bool operator!=(const ContentFilterElement& object1, const ContentFilterElement& object2)
+    {
+        return !(object1 == object2);
+    }
+
+}
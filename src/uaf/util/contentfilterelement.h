@@ -0,0 +1,105 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_CONTENTFILTERELEMENT_H_
+#define UAF_CONTENTFILTERELEMENT_H_
+
+
+// STD
+#include <vector>
+#include <string>
+#include <sstream>
+// SDK
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/stringifiable.h"
+#include "uaf/util/filteroperators.h"
+#include "uaf/util/filteroperand.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::ContentFilterElement is an element of a uaf::ContentFilter: a filter operator applied
+    * to a number of operands.
+    *
+    * @ingroup Util
+    ***********************************************************************************************/
+    class UAF_EXPORT ContentFilterElement
+    {
+    public:
+
+
+        /**
+         * Construct a default ContentFilterElement (an Equals operator without operands).
+         */
+        ContentFilterElement();
+
+
+        /**
+         * Construct a ContentFilterElement.
+         *
+         * @param filterOperator    The operator.
+         * @param filterOperands    The operands.
+         */
+        ContentFilterElement(
+                uaf::filteroperators::FilterOperator    filterOperator,
+                const std::vector<uaf::FilterOperand>&  filterOperands);
+
+
+        /**
+         * The filter operator.
+         */
+        uaf::filteroperators::FilterOperator filterOperator;
+
+
+        /**
+         * The operands (their number depends on the operator).
+         */
+        std::vector<uaf::FilterOperand> filterOperands;
+
+
+        /**
+         * Get a string representation.
+         *
+         * @return  A string representation.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=24) const;
+
+
+        // comparison operators
+        friend bool UAF_EXPORT operator<(
+                const ContentFilterElement& object1,
+                const ContentFilterElement& object2);
+        friend bool UAF_EXPORT operator==(
+                const ContentFilterElement& object1,
+                const ContentFilterElement& object2);
+        friend bool UAF_EXPORT operator!=(
+                const ContentFilterElement& object1,
+                const ContentFilterElement& object2);
+
+    };
+
+}
+
+
+#endif /* UAF_CONTENTFILTERELEMENT_H_ */
@@ -122,6 +122,15 @@ namespace uaf
     };
 
 
+    class UAF_EXPORT ClientNotReadyError : public uaf::ConnectionError
+    {
+    public:
+        ClientNotReadyError()
+        : uaf::ConnectionError("The pre-connected sessions of the client are not connected")
+        {}
+    };
+
+
 
 
 
@@ -233,6 +233,19 @@ namespace uaf
         : uaf::InvalidRequestError("No valid definition was found")
         {}
     };
+
+
+    class UAF_EXPORT InvalidContentFilterError : public uaf::InvalidRequestError
+    {
+    public:
+        InvalidContentFilterError()
+        : uaf::InvalidRequestError("Invalid content filter")
+        {}
+
+        InvalidContentFilterError(const std::string& reason)
+        : uaf::InvalidRequestError(uaf::format("Invalid content filter (%s)", reason.c_str()))
+        {}
+    };
 }
 
 
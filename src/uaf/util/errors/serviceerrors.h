@@ -317,6 +317,22 @@ namespace uaf
         uaf::SdkStatus sdkStatus;
     };
 
+    class UAF_EXPORT BeginHistoryReadRawModifiedInvocationError : public uaf::ServiceError
+    {
+    public:
+        BeginHistoryReadRawModifiedInvocationError()
+        : uaf::ServiceError("Could not invoke the async HistoryReadRawModified service")
+        {}
+
+        BeginHistoryReadRawModifiedInvocationError(const uaf::SdkStatus& sdkStatus)
+        : uaf::ServiceError(uaf::format("Could not invoke the async HistoryReadRawModified service: %s",
+                            sdkStatus.toString().c_str())),
+          sdkStatus(sdkStatus)
+        {}
+
+        uaf::SdkStatus sdkStatus;
+    };
+
 
     class UAF_EXPORT ServerCouldNotHistoryReadError : public uaf::ServiceError
     {
@@ -499,6 +515,31 @@ namespace uaf
         uaf::SdkStatus sdkStatus;
     };
 
+    class UAF_EXPORT HistoryReadRawModifiedCompleteError : public uaf::ServiceError
+    {
+    public:
+        HistoryReadRawModifiedCompleteError()
+        : uaf::ServiceError("The async history read was completed with error")
+        {}
+
+        HistoryReadRawModifiedCompleteError(const uaf::SdkStatus& sdkStatus)
+        : uaf::ServiceError(uaf::format("The async history read was completed with error: %s",
+                            sdkStatus.toString().c_str())),
+          sdkStatus(sdkStatus)
+        {}
+
+        uaf::SdkStatus sdkStatus;
+    };
+
+
+    class UAF_EXPORT AsyncResultNotAvailableError : public uaf::ServiceError
+    {
+    public:
+        AsyncResultNotAvailableError()
+        : uaf::ServiceError("The result of the asynchronous request is not available")
+        {}
+    };
+
 
     class UAF_EXPORT SetPublishingModeInvocationError : public uaf::ServiceError
     {
@@ -554,6 +595,44 @@ namespace uaf
         uaf::SdkStatus sdkStatus;
     };
 
+    class UAF_EXPORT ModifyMonitoredItemsInvocationError : public uaf::ServiceError
+    {
+    public:
+        ModifyMonitoredItemsInvocationError()
+        : uaf::ServiceError("Could not invoke the ModifyMonitoredItems service")
+        {}
+
+        ModifyMonitoredItemsInvocationError(const uaf::SdkStatus& sdkStatus)
+        : uaf::ServiceError(uaf::format("Could not invoke the ModifyMonitoredItems service: %s",
+                            sdkStatus.toString().c_str())),
+          sdkStatus(sdkStatus)
+        {}
+
+        uaf::SdkStatus sdkStatus;
+    };
+
+    class UAF_EXPORT ServerCouldNotModifyMonitoredItemError : public uaf::ServiceError
+    {
+    public:
+        ServerCouldNotModifyMonitoredItemError()
+        : uaf::ServiceError("The server could not modify the monitored item successfully"),
+          clientHandle(uaf::constants::CLIENTHANDLE_NOT_ASSIGNED)
+        {}
+
+        ServerCouldNotModifyMonitoredItemError(uaf::ClientHandle clientHandle,
+                                               uaf::SdkStatus sdkStatus)
+        : uaf::ServiceError(uaf::format("The server could not modify the monitored item " \
+                                        "successfully for clientHandle %d: %s",
+                                        clientHandle,
+                                        sdkStatus.toString().c_str())),
+          clientHandle(clientHandle),
+          sdkStatus(sdkStatus)
+        {}
+
+        uaf::ClientHandle clientHandle;
+        uaf::SdkStatus sdkStatus;
+    };
+
 
     class UAF_EXPORT BadDataReceivedError : public uaf::ServiceError
     {
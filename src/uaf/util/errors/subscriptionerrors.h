@@ -121,6 +121,23 @@ namespace uaf
     };
 
 
+    class UAF_EXPORT TransferSubscriptionError : public uaf::SubscriptionError
+    {
+    public:
+        TransferSubscriptionError()
+        : uaf::SubscriptionError("Could not transfer the subscription")
+        {}
+
+        TransferSubscriptionError(const uaf::SdkStatus& sdkStatus)
+        : uaf::SubscriptionError(uaf::format("Could not transfer the subscription: %s",
+                                             sdkStatus.toString().c_str())),
+          sdkStatus(sdkStatus)
+        {}
+
+        uaf::SdkStatus sdkStatus;
+    };
+
+
 }
 
 #endif /* UAF_SUBSCRIPTIONERRORS_H_ */
@@ -56,8 +56,12 @@ namespace uaf
                 ss << indent << "    - " << "selectClauses[" << i << "]\n";
                 ss << selectClauses[i].toString(indent + "      ", colon);
             }
+            ss << "\n";
         }
 
+        ss << indent << " - whereClause\n";
+        ss << whereClause.toString(indent + "   ", colon);
+
         return ss.str();
     }
 
@@ -66,7 +70,12 @@ namespace uaf
     // =============================================================================================
     bool operator<(const EventFilter& object1, const EventFilter& object2)
     {
-        return object1.selectClauses < object2.selectClauses;
+        if ( object1.selectClauses != object2.selectClauses )
+            return object1.selectClauses < object2.selectClauses;
+        else if ( object1.whereClause != object2.whereClause )
+            return object1.whereClause < object2.whereClause;
+        else
+            return false;
     }
 
 
@@ -74,7 +83,8 @@ namespace uaf
     // =============================================================================================
     bool operator==(const EventFilter& object1, const EventFilter& object2)
     {
-        return (object1.selectClauses == object2.selectClauses);
+        return    ( object1.selectClauses == object2.selectClauses )
+               && ( object1.whereClause == object2.whereClause );
     }
 
 
@@ -32,6 +32,7 @@
 #include "uaf/util/util.h"
 #include "uaf/util/stringifiable.h"
 #include "uaf/util/simpleattributeoperand.h"
+#include "uaf/util/contentfilter.h"
 
 
 namespace uaf
@@ -52,9 +53,17 @@ namespace uaf
          */
         EventFilter();
 
+        /**
+         * The event fields to be reported by the notifications.
+         */
         std::vector<uaf::SimpleAttributeOperand> selectClauses;
 
-        //uaf::WhereClause whereClause;
+
+        /**
+         * The condition that an event must fulfill to be reported (evaluated by the server).
+         * By default, the where clause is empty, so all events are reported.
+         */
+        uaf::ContentFilter whereClause;
 
 
         /**
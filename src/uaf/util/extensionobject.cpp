@@ -72,6 +72,55 @@ namespace uaf
 
 
 
+    // Get the binary encoded body
+    // =============================================================================================
+    bool ExtensionObject::binaryBody(const uint8_t*& data, int32_t& length) const
+    {
+        const OpcUa_ExtensionObject* opcUaExtensionObject = uaExtensionObject_;
+
+        bool ret = (   opcUaExtensionObject != OpcUa_Null
+                    && opcUaExtensionObject->Encoding == OpcUa_ExtensionObjectEncoding_Binary);
+
+        if (ret)
+        {
+            data   = opcUaExtensionObject->Body.Binary.Data;
+            length = opcUaExtensionObject->Body.Binary.Length > 0 ?
+                     opcUaExtensionObject->Body.Binary.Length : 0;
+        }
+
+        return ret;
+    }
+
+
+    // Set the binary encoded body
+    // =============================================================================================
+    void ExtensionObject::setBinaryBody(
+            const NodeId&   encodingTypeId,
+            const uint8_t*  data,
+            int32_t         length)
+    {
+        OpcUa_ExtensionObject opcUaExtensionObject;
+        OpcUa_ExtensionObject_Initialize(&opcUaExtensionObject);
+
+        opcUaExtensionObject.Encoding = OpcUa_ExtensionObjectEncoding_Binary;
+        encodingTypeId.toSdk(&opcUaExtensionObject.TypeId.NodeId);
+
+        if (length > 0)
+        {
+            opcUaExtensionObject.Body.Binary.Data   = (OpcUa_Byte*)OpcUa_Alloc(length);
+            opcUaExtensionObject.Body.Binary.Length = length;
+            OpcUa_MemCpy(opcUaExtensionObject.Body.Binary.Data, length, (OpcUa_Void*)data, length);
+            opcUaExtensionObject.BodySize = length;
+        }
+
+        // the SDK object takes over the body, so it doesn't need to be copied again
+        uaExtensionObject_.attach(&opcUaExtensionObject);
+
+        this->encodingTypeId = encodingTypeId;
+        dataTypeId.fromSdk(uaExtensionObject_.dataTypeId());
+    }
+
+
     // Fill the ExtensionObject from an SDK object
     // =============================================================================================
     void ExtensionObject::fromSdk(const UaExtensionObject& uaExtensionObject)
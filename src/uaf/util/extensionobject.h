@@ -25,6 +25,7 @@
 // STD
 #include <string>
 #include <sstream>
+#include <stdint.h>
 // SDK
 #include "uabase/uaextensionobject.h"
 // UAF
@@ -73,6 +74,28 @@ namespace uaf
 //        uaf::NodeId dataTypeId() const;
 
         
+        /**
+         * Get the body of a binary encoded extension object, without copying it.
+         *
+         * @param data      Output parameter: pointer to the encoded bytes (only valid as long as
+         *                  this extension object is not changed or destructed).
+         * @param length    Output parameter: the number of encoded bytes.
+         * @return          True if the extension object is binary encoded, false if not.
+         */
+        bool binaryBody(const uint8_t*& data, int32_t& length) const;
+
+
+        /**
+         * Set the body of the extension object to the given binary encoded bytes.
+         *
+         * @param encodingTypeId    The NodeId of the DataTypeEncoding node of the server (with
+         *                          the namespace index of the server).
+         * @param data              Pointer to the encoded bytes.
+         * @param length            The number of encoded bytes.
+         */
+        void setBinaryBody(const uaf::NodeId& encodingTypeId, const uint8_t* data, int32_t length);
+
+
         /** Fill the extension object from an SDK object. */
         void fromSdk(const UaExtensionObject& uaExtensionObject);
 
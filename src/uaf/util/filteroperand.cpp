@@ -0,0 +1,142 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/util/filteroperand.h"
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::size_t;
+    using std::stringstream;
+
+
+    // Constructor
+    // =============================================================================================
+    FilterOperand::FilterOperand()
+    : operandType(OperandType_Literal),
+      elementIndex(0)
+    {}
+
+
+    // Create a literal operand
+    // =============================================================================================
+    FilterOperand FilterOperand::literal(const Variant& value)
+    {
+        FilterOperand ret;
+        ret.operandType = OperandType_Literal;
+        ret.value = value;
+        return ret;
+    }
+
+
+    // Create an element operand
+    // =============================================================================================
+    FilterOperand FilterOperand::element(uint32_t index)
+    {
+        FilterOperand ret;
+        ret.operandType = OperandType_Element;
+        ret.elementIndex = index;
+        return ret;
+    }
+
+
+    // Create a simple attribute operand
+    // =============================================================================================
+    FilterOperand FilterOperand::simpleAttribute(const SimpleAttributeOperand& operand)
+    {
+        FilterOperand ret;
+        ret.operandType = OperandType_SimpleAttribute;
+        ret.simpleAttributeOperand = operand;
+        return ret;
+    }
+
+
+    // Get a string representation
+    // =============================================================================================
+    string FilterOperand::toString(const string& indent, size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - operandType";
+        ss << fillToPos(ss, colon);
+
+        if (operandType == OperandType_Literal)
+        {
+            ss << ": " << int(operandType) << " (Literal)\n";
+            ss << indent << " - value";
+            ss << fillToPos(ss, colon);
+            ss << ": " << value.toString();
+        }
+        else if (operandType == OperandType_Element)
+        {
+            ss << ": " << int(operandType) << " (Element)\n";
+            ss << indent << " - elementIndex";
+            ss << fillToPos(ss, colon);
+            ss << ": " << elementIndex;
+        }
+        else
+        {
+            ss << ": " << int(operandType) << " (SimpleAttribute)\n";
+            ss << indent << " - simpleAttributeOperand\n";
+            ss << simpleAttributeOperand.toString(indent + "   ", colon);
+        }
+
+        return ss.str();
+    }
+
+
+    // operator<
+    // =============================================================================================
+    bool operator<(const FilterOperand& object1, const FilterOperand& object2)
+    {
+        if ( object1.operandType != object2.operandType )
+            return object1.operandType < object2.operandType;
+        else if ( object1.value != object2.value )
+            return object1.value < object2.value;
+        else if ( object1.elementIndex != object2.elementIndex )
+            return object1.elementIndex < object2.elementIndex;
+        else if ( object1.simpleAttributeOperand != object2.simpleAttributeOperand )
+            return object1.simpleAttributeOperand < object2.simpleAttributeOperand;
+        else
+            return false;
+    }
+
+
+    // operator==
+    // =============================================================================================
+    bool operator==(const FilterOperand& object1, const FilterOperand& object2)
+    {
+        return    ( object1.operandType == object2.operandType )
+               && ( object1.value == object2.value )
+               && ( object1.elementIndex == object2.elementIndex )
+               && ( object1.simpleAttributeOperand == object2.simpleAttributeOperand );
+    }
+
+
+    // operator!=
+    // =============================================================================================
+    bool operator!=(const FilterOperand& object1, const FilterOperand& object2)
+    {
+        return !(object1 == object2);
+    }
+
+}
@@ -0,0 +1,147 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_FILTEROPERAND_H_
+#define UAF_FILTEROPERAND_H_
+
+
+// STD
+#include <string>
+#include <sstream>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/stringifiable.h"
+#include "uaf/util/variant.h"
+#include "uaf/util/simpleattributeoperand.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::FilterOperand is an operand of a uaf::ContentFilterElement.
+    *
+    * Depending on its type, it's either a literal value, a reference to another element of the
+    * same content filter, or a uaf::SimpleAttributeOperand (i.e. a field of the event).
+    *
+    * @ingroup Util
+    ***********************************************************************************************/
+    class UAF_EXPORT FilterOperand
+    {
+    public:
+
+
+        /**
+         * The type of the operand.
+         */
+        enum OperandType
+        {
+            OperandType_Literal         = 0, //!< The operand is the literal value.
+            OperandType_Element         = 1, //!< The operand is the result of another element.
+            OperandType_SimpleAttribute = 2  //!< The operand is an attribute (e.g. an event field).
+        };
+
+
+        /**
+         * Construct a default FilterOperand (a literal operand with a null value).
+         */
+        FilterOperand();
+
+
+        /**
+         * Create a literal operand.
+         *
+         * @param value     The literal value.
+         * @return          The operand.
+         */
+        static uaf::FilterOperand literal(const uaf::Variant& value);
+
+
+        /**
+         * Create an operand that refers to another element of the same content filter.
+         *
+         * @param index     The index of the element (as returned by the methods of
+         *                  uaf::ContentFilter).
+         * @return          The operand.
+         */
+        static uaf::FilterOperand element(uint32_t index);
+
+
+        /**
+         * Create an operand that refers to an attribute (e.g. an event field).
+         *
+         * @param operand   The attribute.
+         * @return          The operand.
+         */
+        static uaf::FilterOperand simpleAttribute(const uaf::SimpleAttributeOperand& operand);
+
+
+        /**
+         * The type of the operand.
+         */
+        OperandType operandType;
+
+
+        /**
+         * The value of a literal operand (OperandType_Literal only).
+         */
+        uaf::Variant value;
+
+
+        /**
+         * The index of the referred element (OperandType_Element only).
+         */
+        uint32_t elementIndex;
+
+
+        /**
+         * The attribute (OperandType_SimpleAttribute only).
+         */
+        uaf::SimpleAttributeOperand simpleAttributeOperand;
+
+
+        /**
+         * Get a string representation.
+         *
+         * @return  A string representation.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=24) const;
+
+
+        // comparison operators
+        friend bool UAF_EXPORT operator<(
+                const FilterOperand& object1,
+                const FilterOperand& object2);
+        friend bool UAF_EXPORT operator==(
+                const FilterOperand& object1,
+                const FilterOperand& object2);
+        friend bool UAF_EXPORT operator!=(
+                const FilterOperand& object1,
+                const FilterOperand& object2);
+
+    };
+
+}
+
+
+#endif /* UAF_FILTEROPERAND_H_ */
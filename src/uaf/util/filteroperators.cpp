@@ -0,0 +1,89 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/util/filteroperators.h"
+
+namespace uaf
+{
+    using namespace uaf;
+
+    namespace filteroperators
+    {
+
+        // Get a string representation
+        // =========================================================================================
+        std::string toString(filteroperators::FilterOperator filterOperator)
+        {
+            switch (filterOperator)
+            {
+                case filteroperators::Equals:               return "Equals";
+                case filteroperators::IsNull:               return "IsNull";
+                case filteroperators::GreaterThan:          return "GreaterThan";
+                case filteroperators::LessThan:             return "LessThan";
+                case filteroperators::GreaterThanOrEqual:   return "GreaterThanOrEqual";
+                case filteroperators::LessThanOrEqual:      return "LessThanOrEqual";
+                case filteroperators::Like:                 return "Like";
+                case filteroperators::Not:                  return "Not";
+                case filteroperators::Between:              return "Between";
+                case filteroperators::InList:               return "InList";
+                case filteroperators::And:                  return "And";
+                case filteroperators::Or:                   return "Or";
+                case filteroperators::Cast:                 return "Cast";
+                case filteroperators::InView:               return "InView";
+                case filteroperators::OfType:               return "OfType";
+                case filteroperators::RelatedTo:            return "RelatedTo";
+                case filteroperators::BitwiseAnd:           return "BitwiseAnd";
+                case filteroperators::BitwiseOr:            return "BitwiseOr";
+                default:                                    return "UNKNOWN";
+            }
+        }
+
+
+        // UAF to SDK operator
+        // =========================================================================================
+        OpcUa_FilterOperator fromUafToSdk(filteroperators::FilterOperator filterOperator)
+        {
+            switch (filterOperator)
+            {
+                case filteroperators::Equals:               return OpcUa_FilterOperator_Equals;
+                case filteroperators::IsNull:               return OpcUa_FilterOperator_IsNull;
+                case filteroperators::GreaterThan:          return OpcUa_FilterOperator_GreaterThan;
+                case filteroperators::LessThan:             return OpcUa_FilterOperator_LessThan;
+                case filteroperators::GreaterThanOrEqual:
+                    return OpcUa_FilterOperator_GreaterThanOrEqual;
+                case filteroperators::LessThanOrEqual:
+                    return OpcUa_FilterOperator_LessThanOrEqual;
+                case filteroperators::Like:                 return OpcUa_FilterOperator_Like;
+                case filteroperators::Not:                  return OpcUa_FilterOperator_Not;
+                case filteroperators::Between:              return OpcUa_FilterOperator_Between;
+                case filteroperators::InList:               return OpcUa_FilterOperator_InList;
+                case filteroperators::And:                  return OpcUa_FilterOperator_And;
+                case filteroperators::Or:                   return OpcUa_FilterOperator_Or;
+                case filteroperators::Cast:                 return OpcUa_FilterOperator_Cast;
+                case filteroperators::InView:               return OpcUa_FilterOperator_InView;
+                case filteroperators::OfType:               return OpcUa_FilterOperator_OfType;
+                case filteroperators::RelatedTo:            return OpcUa_FilterOperator_RelatedTo;
+                case filteroperators::BitwiseAnd:           return OpcUa_FilterOperator_BitwiseAnd;
+                case filteroperators::BitwiseOr:            return OpcUa_FilterOperator_BitwiseOr;
+                default:                                    return OpcUa_FilterOperator_Equals;
+            }
+        }
+    }
+}
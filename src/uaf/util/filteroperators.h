@@ -0,0 +1,89 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_FILTEROPERATORS_H_
+#define UAF_FILTEROPERATORS_H_
+
+// STD
+#include <string>
+// SDK
+#include "uabase/uaplatformlayer.h"
+// UAF
+#include "uaf/util/util.h"
+
+namespace uaf
+{
+
+    namespace filteroperators
+    {
+
+        /**
+         * The operator of a content filter element (e.g. of the where clause of an event filter).
+         *
+         * @ingroup Util
+         */
+        enum FilterOperator
+        {
+            Equals              = 0,    /**< Operand[0] is equal to operand[1]. */
+            IsNull              = 1,    /**< Operand[0] is null. */
+            GreaterThan         = 2,    /**< Operand[0] is greater than operand[1]. */
+            LessThan            = 3,    /**< Operand[0] is less than operand[1]. */
+            GreaterThanOrEqual  = 4,    /**< Operand[0] is greater than or equal to operand[1]. */
+            LessThanOrEqual     = 5,    /**< Operand[0] is less than or equal to operand[1]. */
+            Like                = 6,    /**< Operand[0] matches the pattern of operand[1]. */
+            Not                 = 7,    /**< Operand[0] is false. */
+            Between             = 8,    /**< Operand[0] lies between operand[1] and operand[2]. */
+            InList              = 9,    /**< Operand[0] is equal to one of the other operands. */
+            And                 = 10,   /**< Operand[0] and operand[1] are true. */
+            Or                  = 11,   /**< Operand[0] or operand[1] is true. */
+            Cast                = 12,   /**< Operand[0] converted to the type of operand[1]. */
+            InView              = 13,   /**< The target node is in the view of operand[0]. */
+            OfType              = 14,   /**< The event is of (a subtype of) type operand[0]. */
+            RelatedTo           = 15,   /**< The target node is related to other nodes. */
+            BitwiseAnd          = 16,   /**< Bitwise AND of operand[0] and operand[1]. */
+            BitwiseOr           = 17    /**< Bitwise OR of operand[0] and operand[1]. */
+        };
+
+
+
+        /**
+         * Get a string representation of the filter operator.
+         *
+         * @param filterOperator    The filter operator (as an enum).
+         * @return                  The corresponding name of the filter operator.
+         *
+         * @ingroup Util
+         */
+        std::string UAF_EXPORT toString(uaf::filteroperators::FilterOperator filterOperator);
+
+
+        /**
+         * Convert the UAF instance to a SDK/Stack instance.
+         *
+         * @ingroup Util
+         */
+        OpcUa_FilterOperator UAF_EXPORT fromUafToSdk(FilterOperator filterOperator);
+
+
+    }
+}
+
+
+#endif /* UAF_FILTEROPERATORS_H_ */
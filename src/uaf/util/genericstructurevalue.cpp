@@ -143,12 +143,15 @@ namespace uaf
 			const std::vector<uaf::GenericStructureValue>& array)
 	{
 		UaString uaFieldName(fieldName.c_str());
-		int index;
-		bool found;
-		for(index=0; index<uaGenericStructureValue_.definition().childrenCount() && !found; index++)
+		UaStructureDefinition uaDef = uaGenericStructureValue_.definition();
+		int index = 0;
+		bool found = false;
+		while (index < uaDef.childrenCount() && !found)
 		{
-			if (uaGenericStructureValue_.definition().child(index).name() == uaFieldName)
+			if (uaDef.child(index).name() == uaFieldName)
 				found = true;
+			else
+				index++;
 		}
 
 		if (found)
@@ -46,6 +46,7 @@ namespace uaf
 
     // forward declarations
     class UAF_EXPORT GenericUnionValue;
+    class UAF_EXPORT StructureLayout;
 
 
     /*******************************************************************************************//**
@@ -215,6 +216,9 @@ namespace uaf
         // the wrapped SDK variable
         UaGenericStructureValue uaGenericStructureValue_;
 
+        // a StructureLayout accesses the wrapped SDK variable directly (to avoid copies)
+        friend class StructureLayout;
+
     };
 
 }
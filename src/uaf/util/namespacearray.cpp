@@ -355,6 +355,50 @@ namespace uaf
     }
 
 
+    // Fill out the namespace index of the encodingTypeId of an ExtensionObject
+    // =============================================================================================
+    Status NamespaceArray::fillEncodingTypeId(ExtensionObject& extensionObject) const
+    {
+        Status ret;
+
+        NodeId          encodingTypeId(extensionObject.encodingTypeId);
+        NameSpaceIndex  nameSpaceIndex;
+        const uint8_t*  data;
+        int32_t         length;
+
+        if (!encodingTypeId.hasNameSpaceUri())
+        {
+            // nothing to resolve, the namespace index (if any) is used as it is
+            ret = statuscodes::Good;
+        }
+        else if (!findNamespaceIndex(encodingTypeId.nameSpaceUri(), nameSpaceIndex))
+        {
+            ret = UnknownNamespaceUriError(
+                    encodingTypeId.nameSpaceUri(),
+                    nameSpaceMap_,
+                    toString(nameSpaceMap_));
+        }
+        else if (encodingTypeId.hasNameSpaceIndex()
+                 && encodingTypeId.nameSpaceIndex() == nameSpaceIndex)
+        {
+            ret = statuscodes::Good;
+        }
+        else
+        {
+            // the SDK object holds the encodingTypeId with its namespace index, so the body must
+            // be set again (setBinaryBody copies the data before the old body is released)
+            encodingTypeId.setNameSpaceIndex(nameSpaceIndex);
+
+            if (extensionObject.binaryBody(data, length))
+                extensionObject.setBinaryBody(encodingTypeId, data, length);
+
+            ret = statuscodes::Good;
+        }
+
+        return ret;
+    }
+
+
     // Fill out a NodeId
     // =============================================================================================
     Status NamespaceArray::fillNodeId(const OpcUa_NodeId& opcUaNodeId, NodeId& nodeId) const
@@ -518,7 +562,34 @@ namespace uaf
         }
         else if (variant.type() == uaf::opcuatypes::ExtensionObject)
         {
-            FILL_OPCUA_VARIANT_NSURI(ExtensionObject)
+            // ExtensionObjects that were created by the client may only have the namespace URI
+            // of their encoding, so the namespace index must be filled out first
+            ret = statuscodes::Good;
+
+            if (variant.isArray())
+            {
+                vector<ExtensionObject> vec;
+                variant.toExtensionObjectArray(vec);
+
+                for (std::size_t i = 0; i < vec.size() && ret.isGood(); i++)
+                    ret = fillEncodingTypeId(vec[i]);
+
+                if (ret.isGood()) variant.setExtensionObjectArray(vec);
+            }
+            else
+            {
+                ExtensionObject value;
+                variant.toExtensionObject(value);
+
+                ret = fillEncodingTypeId(value);
+
+                if (ret.isGood()) variant.setExtensionObject(value);
+            }
+
+            if (ret.isGood())
+            {
+                FILL_OPCUA_VARIANT_NSURI(ExtensionObject)
+            }
         }
         else
         {
@@ -180,6 +180,17 @@ namespace uaf
                 OpcUa_RelativePathElement&      opcUaElement) const;
 
 
+        /**
+         * Fill the namespace index of the encodingTypeId of an ExtensionObject (which may only
+         * have a namespace URI, e.g. if the ExtensionObject was created by a generated struct).
+         *
+         * @param extensionObject   The uaf::ExtensionObject to be updated.
+         * @return                  Good if the encodingTypeId has no namespace URI, or if the
+         *                          namespace index of the URI could be found.
+         */
+        uaf::Status fillEncodingTypeId(uaf::ExtensionObject& extensionObject) const;
+
+
         /**
          * Fill a NodeId from an OpcUa_NodeId (which includes filling out the namespace URI).
          *
@@ -230,9 +230,13 @@ namespace uaf
         UAF_STATUS_COPY_ERROR(CouldNotManuallyUnsubscribeError)
         UAF_STATUS_COPY_ERROR(CouldNotManuallySubscribeError)
         UAF_STATUS_COPY_ERROR(SessionNotConnectedError)
+        UAF_STATUS_COPY_ERROR(ClientNotReadyError)
         UAF_STATUS_COPY_ERROR(ServerCouldNotSetMonitoringModeError)
+        UAF_STATUS_COPY_ERROR(ModifyMonitoredItemsInvocationError)
+        UAF_STATUS_COPY_ERROR(ServerCouldNotModifyMonitoredItemError)
         UAF_STATUS_COPY_ERROR(CreateSubscriptionError)
         UAF_STATUS_COPY_ERROR(DeleteSubscriptionError)
+        UAF_STATUS_COPY_ERROR(TransferSubscriptionError)
         UAF_STATUS_COPY_ERROR(SubscriptionHasBeenDeletedError)
         UAF_STATUS_COPY_ERROR(SetMonitoringModeInvocationError)
         UAF_STATUS_COPY_ERROR(NoDiscoveryUrlsExposedByServerError)
@@ -258,6 +262,7 @@ namespace uaf
         UAF_STATUS_COPY_ERROR(ServerCouldNotTranslateBrowsePathsToNodeIdsError)
         UAF_STATUS_COPY_ERROR(HistoryReadInvocationError)
         UAF_STATUS_COPY_ERROR(HistoryReadRawModifiedInvocationError)
+        UAF_STATUS_COPY_ERROR(BeginHistoryReadRawModifiedInvocationError)
         UAF_STATUS_COPY_ERROR(ServerCouldNotHistoryReadError)
         UAF_STATUS_COPY_ERROR(MethodCallInvocationError)
         UAF_STATUS_COPY_ERROR(AsyncMethodCallInvocationError)
@@ -271,10 +276,13 @@ namespace uaf
         UAF_STATUS_COPY_ERROR(InputArgumentError)
         UAF_STATUS_COPY_ERROR(ReadCompleteError)
         UAF_STATUS_COPY_ERROR(WriteCompleteError)
+        UAF_STATUS_COPY_ERROR(HistoryReadRawModifiedCompleteError)
+        UAF_STATUS_COPY_ERROR(AsyncResultNotAvailableError)
         UAF_STATUS_COPY_ERROR(EmptyUserCertificateError)
         UAF_STATUS_COPY_ERROR(InvalidPrivateKeyError)
         UAF_STATUS_COPY_ERROR(SetPublishingModeInvocationError)
         UAF_STATUS_COPY_ERROR(DefinitionNotFoundError)
+        UAF_STATUS_COPY_ERROR(InvalidContentFilterError)
 
         // configuration errors
         UAF_STATUS_COPY_ERROR(ConfigurationError)
@@ -351,9 +359,13 @@ namespace uaf
         UAF_STATUS_TOSTRING_ELSE_IF(CouldNotManuallyUnsubscribeError)
         UAF_STATUS_TOSTRING_ELSE_IF(CouldNotManuallySubscribeError)
         UAF_STATUS_TOSTRING_ELSE_IF(SessionNotConnectedError)
+        UAF_STATUS_TOSTRING_ELSE_IF(ClientNotReadyError)
         UAF_STATUS_TOSTRING_ELSE_IF(ServerCouldNotSetMonitoringModeError)
+        UAF_STATUS_TOSTRING_ELSE_IF(ModifyMonitoredItemsInvocationError)
+        UAF_STATUS_TOSTRING_ELSE_IF(ServerCouldNotModifyMonitoredItemError)
         UAF_STATUS_TOSTRING_ELSE_IF(CreateSubscriptionError)
         UAF_STATUS_TOSTRING_ELSE_IF(DeleteSubscriptionError)
+        UAF_STATUS_TOSTRING_ELSE_IF(TransferSubscriptionError)
         UAF_STATUS_TOSTRING_ELSE_IF(SubscriptionHasBeenDeletedError)
         UAF_STATUS_TOSTRING_ELSE_IF(SetMonitoringModeInvocationError)
         UAF_STATUS_TOSTRING_ELSE_IF(NoDiscoveryUrlsExposedByServerError)
@@ -380,6 +392,7 @@ namespace uaf
         UAF_STATUS_TOSTRING_ELSE_IF(ServerCouldNotTranslateBrowsePathsToNodeIdsError)
         UAF_STATUS_TOSTRING_ELSE_IF(HistoryReadInvocationError)
         UAF_STATUS_TOSTRING_ELSE_IF(HistoryReadRawModifiedInvocationError)
+        UAF_STATUS_TOSTRING_ELSE_IF(BeginHistoryReadRawModifiedInvocationError)
         UAF_STATUS_TOSTRING_ELSE_IF(ServerCouldNotHistoryReadError)
         UAF_STATUS_TOSTRING_ELSE_IF(MethodCallInvocationError)
         UAF_STATUS_TOSTRING_ELSE_IF(AsyncMethodCallInvocationError)
@@ -393,10 +406,13 @@ namespace uaf
         UAF_STATUS_TOSTRING_ELSE_IF(InputArgumentError)
         UAF_STATUS_TOSTRING_ELSE_IF(ReadCompleteError)
         UAF_STATUS_TOSTRING_ELSE_IF(WriteCompleteError)
+        UAF_STATUS_TOSTRING_ELSE_IF(HistoryReadRawModifiedCompleteError)
+        UAF_STATUS_TOSTRING_ELSE_IF(AsyncResultNotAvailableError)
         UAF_STATUS_TOSTRING_ELSE_IF(EmptyUserCertificateError)
         UAF_STATUS_TOSTRING_ELSE_IF(InvalidPrivateKeyError)
         UAF_STATUS_TOSTRING_ELSE_IF(SetPublishingModeInvocationError)
         UAF_STATUS_TOSTRING_ELSE_IF(DefinitionNotFoundError)
+        UAF_STATUS_TOSTRING_ELSE_IF(InvalidContentFilterError)
 
         // configuration errors
         UAF_STATUS_TOSTRING_ELSE_IF(ConfigurationError)
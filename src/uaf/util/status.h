@@ -143,6 +143,7 @@ namespace uaf
         UAF_STATUS_CONSTRUCTOR(CouldNotManuallyUnsubscribeError)
         UAF_STATUS_CONSTRUCTOR(CouldNotManuallySubscribeError)
         UAF_STATUS_CONSTRUCTOR(SessionNotConnectedError)
+        UAF_STATUS_CONSTRUCTOR(ClientNotReadyError)
         UAF_STATUS_CONSTRUCTOR(SubscriptionHasBeenDeletedError)
         UAF_STATUS_CONSTRUCTOR(NoDiscoveryUrlsExposedByServerError)
         UAF_STATUS_CONSTRUCTOR(GetEndpointsError)
@@ -166,6 +167,7 @@ namespace uaf
         UAF_STATUS_CONSTRUCTOR(ServerCouldNotTranslateBrowsePathsToNodeIdsError)
         UAF_STATUS_CONSTRUCTOR(HistoryReadInvocationError)
         UAF_STATUS_CONSTRUCTOR(HistoryReadRawModifiedInvocationError)
+        UAF_STATUS_CONSTRUCTOR(BeginHistoryReadRawModifiedInvocationError)
         UAF_STATUS_CONSTRUCTOR(ServerCouldNotHistoryReadError)
         UAF_STATUS_CONSTRUCTOR(MethodCallInvocationError)
         UAF_STATUS_CONSTRUCTOR(AsyncMethodCallInvocationError)
@@ -179,12 +181,18 @@ namespace uaf
         UAF_STATUS_CONSTRUCTOR(InputArgumentError)
         UAF_STATUS_CONSTRUCTOR(ReadCompleteError)
         UAF_STATUS_CONSTRUCTOR(WriteCompleteError)
+        UAF_STATUS_CONSTRUCTOR(HistoryReadRawModifiedCompleteError)
+        UAF_STATUS_CONSTRUCTOR(AsyncResultNotAvailableError)
         UAF_STATUS_CONSTRUCTOR(SetPublishingModeInvocationError)
         UAF_STATUS_CONSTRUCTOR(ServerCouldNotSetMonitoringModeError)
+        UAF_STATUS_CONSTRUCTOR(ModifyMonitoredItemsInvocationError)
+        UAF_STATUS_CONSTRUCTOR(ServerCouldNotModifyMonitoredItemError)
         UAF_STATUS_CONSTRUCTOR(CreateSubscriptionError)
         UAF_STATUS_CONSTRUCTOR(DeleteSubscriptionError)
+        UAF_STATUS_CONSTRUCTOR(TransferSubscriptionError)
         UAF_STATUS_CONSTRUCTOR(SetMonitoringModeInvocationError)
         UAF_STATUS_CONSTRUCTOR(DefinitionNotFoundError)
+        UAF_STATUS_CONSTRUCTOR(InvalidContentFilterError)
 
         // configuration errors
         UAF_STATUS_CONSTRUCTOR(ConfigurationError)
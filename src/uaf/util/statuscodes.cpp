@@ -100,6 +100,7 @@ namespace uaf
                 UAF_STATUSCODES_TOSTRING(CouldNotManuallyUnsubscribeError)
                 UAF_STATUSCODES_TOSTRING(CouldNotManuallySubscribeError)
                 UAF_STATUSCODES_TOSTRING(SessionNotConnectedError)
+                UAF_STATUSCODES_TOSTRING(ClientNotReadyError)
                 UAF_STATUSCODES_TOSTRING(SubscriptionHasBeenDeletedError)
                 UAF_STATUSCODES_TOSTRING(NoDiscoveryUrlsExposedByServerError)
                 UAF_STATUSCODES_TOSTRING(GetEndpointsError)
@@ -122,6 +123,7 @@ namespace uaf
                 UAF_STATUSCODES_TOSTRING(ServerCouldNotTranslateBrowsePathsToNodeIdsError)
                 UAF_STATUSCODES_TOSTRING(HistoryReadInvocationError)
                 UAF_STATUSCODES_TOSTRING(HistoryReadRawModifiedInvocationError)
+                UAF_STATUSCODES_TOSTRING(BeginHistoryReadRawModifiedInvocationError)
                 UAF_STATUSCODES_TOSTRING(ServerCouldNotHistoryReadError)
                 UAF_STATUSCODES_TOSTRING(MethodCallInvocationError)
                 UAF_STATUSCODES_TOSTRING(AsyncMethodCallInvocationError)
@@ -135,11 +137,16 @@ namespace uaf
                 UAF_STATUSCODES_TOSTRING(InputArgumentError)
                 UAF_STATUSCODES_TOSTRING(ReadCompleteError)
                 UAF_STATUSCODES_TOSTRING(WriteCompleteError)
+                UAF_STATUSCODES_TOSTRING(HistoryReadRawModifiedCompleteError)
+                UAF_STATUSCODES_TOSTRING(AsyncResultNotAvailableError)
                 UAF_STATUSCODES_TOSTRING(SubscriptionError)
                 UAF_STATUSCODES_TOSTRING(SetPublishingModeInvocationError)
                 UAF_STATUSCODES_TOSTRING(ServerCouldNotSetMonitoringModeError)
+                UAF_STATUSCODES_TOSTRING(ModifyMonitoredItemsInvocationError)
+                UAF_STATUSCODES_TOSTRING(ServerCouldNotModifyMonitoredItemError)
                 UAF_STATUSCODES_TOSTRING(CreateSubscriptionError)
                 UAF_STATUSCODES_TOSTRING(DeleteSubscriptionError)
+                UAF_STATUSCODES_TOSTRING(TransferSubscriptionError)
                 UAF_STATUSCODES_TOSTRING(SetMonitoringModeInvocationError)
                 UAF_STATUSCODES_TOSTRING(ConfigurationError)
                 UAF_STATUSCODES_TOSTRING(CouldNotCreateCertificateTrustListLocationError)
@@ -149,6 +156,7 @@ namespace uaf
                 UAF_STATUSCODES_TOSTRING(CouldNotCreateClientPrivateKeyLocationError)
                 UAF_STATUSCODES_TOSTRING(CouldNotCreateClientCertificateLocationError)
                 UAF_STATUSCODES_TOSTRING(DefinitionNotFoundError)
+                UAF_STATUSCODES_TOSTRING(InvalidContentFilterError)
                 // status codes kept for backwards compatibility:
                 UAF_STATUSCODES_TOSTRING(DataFormatError)
                 UAF_STATUSCODES_TOSTRING(DataSizeError)
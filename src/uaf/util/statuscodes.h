@@ -111,6 +111,7 @@ namespace uaf
             CouldNotManuallyUnsubscribeError,
             CouldNotManuallySubscribeError,
             SessionNotConnectedError,
+            ClientNotReadyError,
             SubscriptionHasBeenDeletedError,
             NoDiscoveryUrlsExposedByServerError,
             GetEndpointsError,
@@ -133,6 +134,7 @@ namespace uaf
             ServerCouldNotTranslateBrowsePathsToNodeIdsError,
             HistoryReadInvocationError,
             HistoryReadRawModifiedInvocationError,
+            BeginHistoryReadRawModifiedInvocationError,
             ServerCouldNotHistoryReadError,
             MethodCallInvocationError,
             AsyncMethodCallInvocationError,
@@ -146,11 +148,16 @@ namespace uaf
             InputArgumentError,
             ReadCompleteError,
             WriteCompleteError,
+            HistoryReadRawModifiedCompleteError,
+            AsyncResultNotAvailableError,
             SubscriptionError,
             SetPublishingModeInvocationError,
             ServerCouldNotSetMonitoringModeError,
+            ModifyMonitoredItemsInvocationError,
+            ServerCouldNotModifyMonitoredItemError,
             CreateSubscriptionError,
             DeleteSubscriptionError,
+            TransferSubscriptionError,
             SetMonitoringModeInvocationError,
             ConfigurationError,
             CouldNotCreateCertificateTrustListLocationError,
@@ -160,6 +167,7 @@ namespace uaf
             CouldNotCreateClientPrivateKeyLocationError,
             CouldNotCreateClientCertificateLocationError,
             DefinitionNotFoundError,
+            InvalidContentFilterError,
             // status codes kept for backwards compatibility:
             DataFormatError,
             DataSizeError,
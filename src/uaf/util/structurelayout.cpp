@@ -0,0 +1,427 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/util/structurelayout.h"
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+    using std::vector;
+    using std::map;
+    using std::size_t;
+
+
+    // Constructor
+    // =============================================================================================
+    StructureLayout::StructureLayout()
+    {}
+
+
+    // Constructor
+    // =============================================================================================
+    StructureLayout::StructureLayout(const StructureDefinition& definition)
+    {
+        definition.toSdk(uaDefinition_);
+
+        int noOfFields = uaDefinition_.childrenCount();
+
+        fieldNames_.resize(noOfFields);
+        fieldTypes_.resize(noOfFields);
+        fieldDefinitions_.resize(noOfFields);
+
+        for (int i = 0; i < noOfFields; i++)
+        {
+            UaStructureField uaField = uaDefinition_.child(i);
+
+            fieldNames_[i]       = uaField.name().toUtf8();
+            fieldTypes_[i]       = uaField.valueType();
+            fieldDefinitions_[i] = uaField.structureDefinition();
+
+            fieldIndexes_[fieldNames_[i]] = i;
+        }
+    }
+
+
+    // Get the definition
+    // =============================================================================================
+    StructureDefinition StructureLayout::definition() const
+    {
+        StructureDefinition ret;
+        ret.fromSdk(uaDefinition_);
+        return ret;
+    }
+
+
+    // Get the index of a field
+    // =============================================================================================
+    int StructureLayout::fieldIndex(const string& fieldName) const
+    {
+        map<string, int>::const_iterator iter = fieldIndexes_.find(fieldName);
+
+        if (iter == fieldIndexes_.end())
+            return -1;
+        else
+            return iter->second;
+    }
+
+
+    // Get the name of a field
+    // =============================================================================================
+    string StructureLayout::fieldName(int index) const
+    {
+        if (isValidIndex(index))
+            return fieldNames_[index];
+        else
+            return string();
+    }
+
+
+    // Get the type of a field
+    // =============================================================================================
+    opcuatypes::OpcUaType StructureLayout::fieldType(int index) const
+    {
+        if (isValidIndex(index))
+            return opcuatypes::fromSdkToUaf(fieldTypes_[index]);
+        else
+            return opcuatypes::Null;
+    }
+
+
+    // Check an index
+    // =============================================================================================
+    bool StructureLayout::isValidIndex(int index) const
+    {
+        return index >= 0 && size_t(index) < fieldNames_.size();
+    }
+
+
+    // Decode a number of extension objects
+    // =============================================================================================
+    SdkStatus StructureLayout::decode(
+            const vector<ExtensionObject>&  extensionObjects,
+            vector<GenericStructureValue>&  values,
+            vector<uint32_t>&               opcUaStatusCodes) const
+    {
+        OpcUa_StatusCode overallCode = OpcUa_Good;
+
+        values.resize(extensionObjects.size());
+        opcUaStatusCodes.resize(extensionObjects.size());
+
+        for (size_t i = 0; i < extensionObjects.size(); i++)
+        {
+            UaExtensionObject uaExt;
+            extensionObjects[i].toSdk(uaExt);
+
+            // the definition is already in SDK format, so it doesn't have to be converted again
+            UaStatus uaStatus = values[i].uaGenericStructureValue_.setGenericValue(
+                    uaExt,
+                    uaDefinition_);
+
+            opcUaStatusCodes[i] = uaStatus.statusCode();
+
+            if (uaStatus.isBad())
+                overallCode = uaStatus.statusCode();
+        }
+
+        return SdkStatus(overallCode);
+    }
+
+
+    // Read a column of variants
+    // =============================================================================================
+    SdkStatus StructureLayout::readVariants(
+            const vector<GenericStructureValue>&    values,
+            int                                     index,
+            vector<Variant>&                        column,
+            vector<uint32_t>&                       opcUaStatusCodes) const
+    {
+        if (!isValidIndex(index))
+            return SdkStatus(OpcUa_BadInvalidArgument);
+
+        column.resize(values.size());
+        opcUaStatusCodes.resize(values.size());
+
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            OpcUa_StatusCode uaCode;
+            column[i].fromSdk(values[i].uaGenericStructureValue_.value(index, &uaCode));
+            opcUaStatusCodes[i] = uaCode;
+        }
+
+        return SdkStatus(OpcUa_Good);
+    }
+
+
+    // Read a column of doubles
+    // =============================================================================================
+    SdkStatus StructureLayout::readDoubles(
+            const vector<GenericStructureValue>&    values,
+            int                                     index,
+            vector<double>&                         column,
+            vector<uint32_t>&                       opcUaStatusCodes) const
+    {
+        if (!isValidIndex(index))
+            return SdkStatus(OpcUa_BadInvalidArgument);
+
+        column.resize(values.size());
+        opcUaStatusCodes.resize(values.size());
+
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            OpcUa_StatusCode uaCode;
+            OpcUa_Double     uaDouble = 0.0;
+
+            UaVariant uaValue = values[i].uaGenericStructureValue_.value(index, &uaCode);
+
+            if (OpcUa_IsGood(uaCode))
+                uaCode = UaStatus(uaValue.toDouble(uaDouble)).statusCode();
+
+            column[i]           = uaDouble;
+            opcUaStatusCodes[i] = uaCode;
+        }
+
+        return SdkStatus(OpcUa_Good);
+    }
+
+
+    // Read a column of int64s
+    // =============================================================================================
+    SdkStatus StructureLayout::readInt64s(
+            const vector<GenericStructureValue>&    values,
+            int                                     index,
+            vector<int64_t>&                        column,
+            vector<uint32_t>&                       opcUaStatusCodes) const
+    {
+        if (!isValidIndex(index))
+            return SdkStatus(OpcUa_BadInvalidArgument);
+
+        column.resize(values.size());
+        opcUaStatusCodes.resize(values.size());
+
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            OpcUa_StatusCode uaCode;
+            OpcUa_Int64      uaInt64 = 0;
+
+            UaVariant uaValue = values[i].uaGenericStructureValue_.value(index, &uaCode);
+
+            if (OpcUa_IsGood(uaCode))
+                uaCode = UaStatus(uaValue.toInt64(uaInt64)).statusCode();
+
+            column[i]           = uaInt64;
+            opcUaStatusCodes[i] = uaCode;
+        }
+
+        return SdkStatus(OpcUa_Good);
+    }
+
+
+    // Read a column of strings
+    // =============================================================================================
+    SdkStatus StructureLayout::readStrings(
+            const vector<GenericStructureValue>&    values,
+            int                                     index,
+            vector<string>&                         column,
+            vector<uint32_t>&                       opcUaStatusCodes) const
+    {
+        if (!isValidIndex(index))
+            return SdkStatus(OpcUa_BadInvalidArgument);
+
+        column.resize(values.size());
+        opcUaStatusCodes.resize(values.size());
+
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            OpcUa_StatusCode uaCode;
+
+            UaVariant uaValue = values[i].uaGenericStructureValue_.value(index, &uaCode);
+
+            if (OpcUa_IsGood(uaCode))
+                column[i] = uaValue.toString().toUtf8();
+            else
+                column[i].clear();
+
+            opcUaStatusCodes[i] = uaCode;
+        }
+
+        return SdkStatus(OpcUa_Good);
+    }
+
+
+    // Convert a value to the type of a field, and set it
+    // =============================================================================================
+    SdkStatus StructureLayout::writeField(
+            GenericStructureValue&  value,
+            int                     index,
+            UaVariant&              uaValue) const
+    {
+        UaStatus uaStatus;
+
+        // fields of type Variant accept any value, the other fields need the exact type
+        if (fieldTypes_[index] != OpcUaType_Variant && uaValue.type() != fieldTypes_[index])
+            uaStatus = uaValue.changeType(fieldTypes_[index], OpcUa_False);
+
+        if (uaStatus.isGood())
+            uaStatus = value.uaGenericStructureValue_.setField(index, uaValue);
+
+        return uaStatus.isGood() ? SdkStatus(OpcUa_Good) : SdkStatus(uaStatus);
+    }
+
+
+    // Write a column of variants
+    // =============================================================================================
+    SdkStatus StructureLayout::writeVariants(
+            vector<GenericStructureValue>&  values,
+            int                             index,
+            const vector<Variant>&          column) const
+    {
+        SdkStatus ret(OpcUa_Good);
+
+        if (!isValidIndex(index) || column.size() != values.size())
+            ret = SdkStatus(OpcUa_BadInvalidArgument);
+
+        for (size_t i = 0; i < values.size() && ret.isGood(); i++)
+        {
+            UaVariant uaValue;
+            column[i].toSdk(uaValue);
+            ret = writeField(values[i], index, uaValue);
+        }
+
+        return ret;
+    }
+
+
+    // Write a column of doubles
+    // =============================================================================================
+    SdkStatus StructureLayout::writeDoubles(
+            vector<GenericStructureValue>&  values,
+            int                             index,
+            const vector<double>&           column) const
+    {
+        SdkStatus ret(OpcUa_Good);
+
+        if (!isValidIndex(index) || column.size() != values.size())
+            ret = SdkStatus(OpcUa_BadInvalidArgument);
+
+        for (size_t i = 0; i < values.size() && ret.isGood(); i++)
+        {
+            UaVariant uaValue;
+            uaValue.setDouble(column[i]);
+            ret = writeField(values[i], index, uaValue);
+        }
+
+        return ret;
+    }
+
+
+    // Write a column of int64s
+    // =============================================================================================
+    SdkStatus StructureLayout::writeInt64s(
+            vector<GenericStructureValue>&  values,
+            int                             index,
+            const vector<int64_t>&          column) const
+    {
+        SdkStatus ret(OpcUa_Good);
+
+        if (!isValidIndex(index) || column.size() != values.size())
+            ret = SdkStatus(OpcUa_BadInvalidArgument);
+
+        for (size_t i = 0; i < values.size() && ret.isGood(); i++)
+        {
+            UaVariant uaValue;
+            uaValue.setInt64(column[i]);
+            ret = writeField(values[i], index, uaValue);
+        }
+
+        return ret;
+    }
+
+
+    // Write a column of strings
+    // =============================================================================================
+    SdkStatus StructureLayout::writeStrings(
+            vector<GenericStructureValue>&  values,
+            int                             index,
+            const vector<string>&           column) const
+    {
+        SdkStatus ret(OpcUa_Good);
+
+        if (!isValidIndex(index) || column.size() != values.size())
+            ret = SdkStatus(OpcUa_BadInvalidArgument);
+
+        for (size_t i = 0; i < values.size() && ret.isGood(); i++)
+        {
+            UaVariant uaValue;
+            uaValue.setString(UaString(column[i].c_str()));
+            ret = writeField(values[i], index, uaValue);
+        }
+
+        return ret;
+    }
+
+
+    // Set a structure array field
+    // =============================================================================================
+    SdkStatus StructureLayout::setStructureArray(
+            GenericStructureValue&                  value,
+            int                                     index,
+            const vector<GenericStructureValue>&    array) const
+    {
+        if (!isValidIndex(index))
+            return SdkStatus(OpcUa_BadInvalidArgument);
+
+        UaGenericStructureArray uaArray(fieldDefinitions_[index]);
+        uaArray.create(array.size());
+        for (size_t i = 0; i < array.size(); i++)
+            uaArray[i] = array[i].uaGenericStructureValue_;
+
+        return SdkStatus(value.uaGenericStructureValue_.setField(index, uaArray));
+    }
+
+
+    // Get a string representation
+    // =============================================================================================
+    string StructureLayout::toString(const string& indent, size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - definition";
+        ss << fillToPos(ss, colon);
+        ss << ": " << definition().name() << "\n";
+
+        ss << indent << " - fields";
+        ss << fillToPos(ss, colon);
+        ss << ": " << fieldNames_.size();
+
+        for (size_t i = 0; i < fieldNames_.size(); i++)
+        {
+            ss << "\n";
+            ss << indent << "    - field(" << i << ")";
+            ss << fillToPos(ss, colon);
+            ss << ": " << fieldNames_[i]
+               << " (" << opcuatypes::toString(opcuatypes::fromSdkToUaf(fieldTypes_[i])) << ")";
+        }
+
+        return ss.str();
+    }
+
+}
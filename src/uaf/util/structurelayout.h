@@ -0,0 +1,308 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_STRUCTURELAYOUT_H_
+#define UAF_STRUCTURELAYOUT_H_
+
+
+// STD
+#include <string>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <stdint.h>
+
+// SDK
+#include "uabase/uastructuredefinition.h"
+#include "uabase/uagenericstructurevalue.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/opcuatypes.h"
+#include "uaf/util/stringifiable.h"
+#include "uaf/util/sdkstatus.h"
+#include "uaf/util/variant.h"
+#include "uaf/util/extensionobject.h"
+#include "uaf/util/structuredefinition.h"
+#include "uaf/util/genericstructurevalue.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+     * A StructureLayout is a "compiled" StructureDefinition: it resolves the names, value types
+     * and nested definitions of the fields once, so that many structured values of the same
+     * DataType can be decoded, read and written without looking up the fields again.
+     *
+     * The bulk methods process a whole column at once: field i of a vector of values is read
+     * into (or written from) a vector of doubles, integers, strings or Variants, converting
+     * the SDK values directly instead of via an intermediate uaf::Variant per field.
+     *
+     * @ingroup Util
+     **********************************************************************************************/
+    class UAF_EXPORT StructureLayout
+    {
+    public:
+
+
+        /**
+         * Construct an empty layout.
+         */
+        StructureLayout();
+
+
+        /**
+         * Construct the layout of a structure definition.
+         *
+         * @param definition    The definition of the structured DataType.
+         */
+        StructureLayout(const uaf::StructureDefinition& definition);
+
+
+        /**
+         * Get the definition of the layout.
+         */
+        uaf::StructureDefinition definition() const;
+
+
+        /**
+         * Get the number of fields.
+         */
+        int fieldCount() const { return int(fieldNames_.size()); }
+
+
+        /**
+         * Get the index of a field.
+         *
+         * @param fieldName The name of the field.
+         * @return          The index of the field, or -1 if the structure has no such field.
+         */
+        int fieldIndex(const std::string& fieldName) const;
+
+
+        /**
+         * Get the name of a field.
+         *
+         * @param index The index of the field.
+         * @return      The name of the field, or an empty string if the index is invalid.
+         */
+        std::string fieldName(int index) const;
+
+
+        /**
+         * Get the value type of a field.
+         *
+         * @param index The index of the field.
+         * @return      The built-in type of the field (Null if the index is invalid).
+         */
+        uaf::opcuatypes::OpcUaType fieldType(int index) const;
+
+
+        /**
+         * Decode a number of ExtensionObjects into GenericStructureValues.
+         *
+         * @param extensionObjects  The encoded structures.
+         * @param values            Output parameter: the decoded structures (resized if needed).
+         * @param opcUaStatusCodes  Output parameter: the status of the decoding, per structure.
+         * @return                  Good if all structures could be decoded.
+         */
+        uaf::SdkStatus decode(
+                const std::vector<uaf::ExtensionObject>&    extensionObjects,
+                std::vector<uaf::GenericStructureValue>&    values,
+                std::vector<uint32_t>&                      opcUaStatusCodes) const;
+
+
+        /**
+         * Read a field of a number of structures as Variants.
+         *
+         * @param values            The structures.
+         * @param index             The index of the field.
+         * @param column            Output parameter: the value of the field, per structure.
+         * @param opcUaStatusCodes  Output parameter: Good if the field was read, per structure.
+         * @return                  Bad if the index is invalid, Good otherwise.
+         */
+        uaf::SdkStatus readVariants(
+                const std::vector<uaf::GenericStructureValue>&  values,
+                int                                             index,
+                std::vector<uaf::Variant>&                      column,
+                std::vector<uint32_t>&                          opcUaStatusCodes) const;
+
+
+        /**
+         * Read a numerical field of a number of structures as doubles.
+         *
+         * @param values            The structures.
+         * @param index             The index of the field.
+         * @param column            Output parameter: the value of the field, per structure.
+         * @param opcUaStatusCodes  Output parameter: Good if the field could be converted to a
+         *                          double, per structure.
+         * @return                  Bad if the index is invalid, Good otherwise.
+         */
+        uaf::SdkStatus readDoubles(
+                const std::vector<uaf::GenericStructureValue>&  values,
+                int                                             index,
+                std::vector<double>&                            column,
+                std::vector<uint32_t>&                          opcUaStatusCodes) const;
+
+
+        /**
+         * Read an integer field of a number of structures as 64-bit signed integers.
+         *
+         * @param values            The structures.
+         * @param index             The index of the field.
+         * @param column            Output parameter: the value of the field, per structure.
+         * @param opcUaStatusCodes  Output parameter: Good if the field could be converted to an
+         *                          int64, per structure.
+         * @return                  Bad if the index is invalid, Good otherwise.
+         */
+        uaf::SdkStatus readInt64s(
+                const std::vector<uaf::GenericStructureValue>&  values,
+                int                                             index,
+                std::vector<int64_t>&                           column,
+                std::vector<uint32_t>&                          opcUaStatusCodes) const;
+
+
+        /**
+         * Read a field of a number of structures as strings.
+         *
+         * @param values            The structures.
+         * @param index             The index of the field.
+         * @param column            Output parameter: the value of the field, per structure.
+         * @param opcUaStatusCodes  Output parameter: Good if the field was read, per structure.
+         * @return                  Bad if the index is invalid, Good otherwise.
+         */
+        uaf::SdkStatus readStrings(
+                const std::vector<uaf::GenericStructureValue>&  values,
+                int                                             index,
+                std::vector<std::string>&                       column,
+                std::vector<uint32_t>&                          opcUaStatusCodes) const;
+
+
+        /**
+         * Write a field of a number of structures from Variants.
+         *
+         * @param values    The structures (they must have the definition of this layout).
+         * @param index     The index of the field.
+         * @param column    The new value of the field, per structure (same size as values).
+         * @return          Bad if the index or sizes are invalid, or if a value could not be set.
+         */
+        uaf::SdkStatus writeVariants(
+                std::vector<uaf::GenericStructureValue>&    values,
+                int                                         index,
+                const std::vector<uaf::Variant>&            column) const;
+
+
+        /**
+         * Write a numerical field of a number of structures from doubles (converted to the
+         * value type of the field).
+         *
+         * @param values    The structures (they must have the definition of this layout).
+         * @param index     The index of the field.
+         * @param column    The new value of the field, per structure (same size as values).
+         * @return          Bad if the index or sizes are invalid, or if a value could not be set.
+         */
+        uaf::SdkStatus writeDoubles(
+                std::vector<uaf::GenericStructureValue>&    values,
+                int                                         index,
+                const std::vector<double>&                  column) const;
+
+
+        /**
+         * Write an integer field of a number of structures from 64-bit signed integers
+         * (converted to the value type of the field).
+         *
+         * @param values    The structures (they must have the definition of this layout).
+         * @param index     The index of the field.
+         * @param column    The new value of the field, per structure (same size as values).
+         * @return          Bad if the index or sizes are invalid, or if a value could not be set.
+         */
+        uaf::SdkStatus writeInt64s(
+                std::vector<uaf::GenericStructureValue>&    values,
+                int                                         index,
+                const std::vector<int64_t>&                 column) const;
+
+
+        /**
+         * Write a field of a number of structures from strings (converted to the value type of
+         * the field).
+         *
+         * @param values    The structures (they must have the definition of this layout).
+         * @param index     The index of the field.
+         * @param column    The new value of the field, per structure (same size as values).
+         * @return          Bad if the index or sizes are invalid, or if a value could not be set.
+         */
+        uaf::SdkStatus writeStrings(
+                std::vector<uaf::GenericStructureValue>&    values,
+                int                                         index,
+                const std::vector<std::string>&             column) const;
+
+
+        /**
+         * Set a structure array field of a structure, using the nested definition of the layout
+         * (instead of looking it up in the definition of the structure).
+         *
+         * @param value     The structure (it must have the definition of this layout).
+         * @param index     The index of the field.
+         * @param array     The new value of the field.
+         * @return          Bad if the index is invalid or if the array could not be set.
+         */
+        uaf::SdkStatus setStructureArray(
+                uaf::GenericStructureValue&                     value,
+                int                                             index,
+                const std::vector<uaf::GenericStructureValue>&  array) const;
+
+
+        /**
+         * Get a string representation.
+         *
+         * @return The string representation.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=23) const;
+
+
+    private:
+
+        // the compiled definition
+        UaStructureDefinition                   uaDefinition_;
+        // the names of the fields
+        std::vector<std::string>                fieldNames_;
+        // the built-in types of the fields
+        std::vector<OpcUa_BuiltInType>          fieldTypes_;
+        // the definitions of the structured fields (null for the other fields)
+        std::vector<UaStructureDefinition>      fieldDefinitions_;
+        // the indexes of the fields, by name
+        std::map<std::string, int>              fieldIndexes_;
+
+        // check if an index refers to a field
+        bool isValidIndex(int index) const;
+
+        // convert a value to the type of a field, and set it
+        uaf::SdkStatus writeField(
+                uaf::GenericStructureValue& value,
+                int                         index,
+                UaVariant&                  uaValue) const;
+    };
+
+}
+
+
+
+#endif /* UAF_STRUCTURELAYOUT_H_ */
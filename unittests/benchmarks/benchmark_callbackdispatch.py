@@ -0,0 +1,97 @@
+"""
+Benchmark comparing two ways of calling the notification callbacks of a pyuaf Client:
+
+ - "thread-per-notification": the way pyuaf used to do it (a new threading.Thread is started
+   for every notification that has a registered callback)
+ - "worker pool": the way pyuaf does it now (the callbacks are queued to a fixed number of 
+   worker threads, with all callbacks for the same ClientHandle handled by the same thread).
+
+No server is needed: the notifications are created locally and dispatched in batches, in the same
+way as the Client dispatches the notifications it receives from a subscription.
+
+Usage: python benchmark_callbackdispatch.py [--notifications N] [--batch B] [--items I] [--threads T]
+"""
+
+import argparse
+import threading
+import time
+
+import pyuaf
+from pyuaf.client import DataChangeNotification
+
+
+class Counter:
+    def __init__(self, expected):
+        self.lock     = threading.Lock()
+        self.count    = 0
+        self.expected = expected
+        self.done     = threading.Event()
+    
+    def callback(self, notification):
+        self.lock.acquire()
+        try:
+            self.count += 1
+            if self.count == self.expected:
+                self.done.set()
+        finally:
+            self.lock.release()
+
+
+def createBatches(noOfNotifications, batchSize, noOfItems):
+    batches = []
+    batch = []
+    for i in range(noOfNotifications):
+        notification = DataChangeNotification()
+        notification.clientHandle = i % noOfItems
+        notification.data = pyuaf.util.primitives.Double(float(i))
+        batch.append(notification)
+        if len(batch) == batchSize:
+            batches.append(batch)
+            batch = []
+    if len(batch) > 0:
+        batches.append(batch)
+    return batches
+
+
+def threadPerNotification(batches, counter):
+    for batch in batches:
+        for notification in batch:
+            t = threading.Thread(target=counter.callback, args=[notification])
+            t.start()
+    counter.done.wait()
+
+
+def workerPool(batches, counter, noOfThreads):
+    dispatcher = pyuaf.client.__CallbackDispatcher__(noOfThreads)
+    for batch in batches:
+        for notification in batch:
+            dispatcher.dispatch(notification.clientHandle, counter.callback, [notification])
+    counter.done.wait()
+    dispatcher.stop()
+
+
+def measure(function, *args):
+    t0 = time.time()
+    function(*args)
+    return time.time() - t0
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description="Benchmark the dispatching of pyuaf callbacks")
+    parser.add_argument("--notifications", type=int, default=20000)
+    parser.add_argument("--batch", type=int, default=100)
+    parser.add_argument("--items", type=int, default=500)
+    parser.add_argument("--threads", type=int, default=4)
+    args = parser.parse_args()
+    
+    batches = createBatches(args.notifications, args.batch, args.items)
+    
+    t1 = measure(threadPerNotification, batches, Counter(args.notifications))
+    t2 = measure(workerPool, batches, Counter(args.notifications), args.threads)
+    
+    print("%d notifications (batches of %d, %d ClientHandles):" 
+          %(args.notifications, args.batch, args.items))
+    print(" - thread-per-notification   : %8.3f s (%10.0f notifications/s)" 
+          %(t1, args.notifications / t1))
+    print(" - worker pool (%2d threads)  : %8.3f s (%10.0f notifications/s)" 
+          %(args.threads, t2, args.notifications / t2))
@@ -10,6 +10,7 @@ ALL_MODULES = [ "client_client",
                 "client_discovery",
                 "client_manualconnection",
                 "client_manualconnectiontoendpoint",
+                "client_preconnection",
                 "client_read",
                 "client_asyncread",
                 "client_write",
@@ -21,19 +22,25 @@ ALL_MODULES = [ "client_client",
                 "client_monitorevents",
                 "client_setpublishingmode",
                 "client_browse",
+                "client_asyncbrowse",
+                "client_asyncio",
                 "client_browsenext",
                 "client_historyreadrawmodified",
                 "client_connectionstatus",
                 "client_subscriptionstatus",
                 "client_keepalive",
+                "client_callbackdispatch",
                 "client_setmonitoringmode",
+                "client_modifymonitoreditems",
                 "client_kwargs",
                 "client_structures",
                 "subscriptioninformation",
                 "sessioninformation",
                 "monitorediteminformation",
                 "datachangenotification",
+                "datachangenotificationbatch",
                 "eventnotification",
+                "eventnotificationbatch",
                 "requests.browserequesttarget",
                 "requests.browsenextrequesttarget",
                 "requests.createmonitoreddatarequesttarget",
@@ -22,6 +22,7 @@ ALL_MODULES = [ "primitives",
                 "applicationdescription",
                 "modificationinfo",
                 "simpleattributeoperand",
+                "contentfilter",
                 "usertokenpolicy",
                 "endpointdescription",
                 "referencedescription",
@@ -31,6 +32,8 @@ ALL_MODULES = [ "primitives",
                 "pkipublickey",
                 "pkirsakeypair",
                 "pkicertificate",
+                "structurelayout",
+                "structgen",
                 "version"
               ]
 
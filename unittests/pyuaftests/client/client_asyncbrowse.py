@@ -0,0 +1,160 @@
+import pyuaf
+import time
+import thread, threading
+import unittest
+from pyuaf.util.unittesting import parseArgs
+
+from pyuaf.util import NodeId, Address, ExpandedNodeId, BrowsePath, \
+                       RelativePathElement, QualifiedName, opcuaidentifiers
+from pyuaf.client.requests import AsyncBrowseRequest, BrowseRequestTarget, \
+                                  AsyncTranslateBrowsePathsToNodeIdsRequest, \
+                                  TranslateBrowsePathsToNodeIdsRequestTarget
+from pyuaf.client.results  import AsyncBrowseResult, AsyncTranslateBrowsePathsToNodeIdsResult
+
+
+ARGS = parseArgs()
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+    
+    return unittest.TestLoader().loadTestsFromTestCase(ClientAsyncBrowseTest)
+
+
+class MyClient(pyuaf.client.Client):
+
+    def __init__(self, settings):
+        pyuaf.client.Client.__init__(self, settings)
+        self.lock = threading.Lock()
+        self.browseResults = []
+        self.translateResults = []
+            
+    def browseComplete(self, result):
+        self.lock.acquire()
+        self.browseResults.append(result)
+        self.lock.release()
+            
+    def translateBrowsePathsToNodeIdsComplete(self, result):
+        self.lock.acquire()
+        self.translateResults.append(result)
+        self.lock.release()
+
+
+# define a TestClass with a callback
+class TestClass:
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.results = []
+    
+    def myCallback(self, result):
+        self.lock.acquire()
+        self.results.append(result)
+        self.lock.release()
+
+
+class ClientAsyncBrowseTest(unittest.TestCase):
+    
+    
+    def setUp(self):
+        
+        # create a new ClientSettings instance and add the localhost to the URLs to discover
+        settings = pyuaf.client.settings.ClientSettings()
+        settings.discoveryUrls.append(ARGS.demo_url)
+        settings.applicationName = "client"
+        settings.logToStdOutLevel = ARGS.loglevel
+    
+        self.client = MyClient(settings)
+        
+        serverUri    = ARGS.demo_server_uri
+        demoNsUri    = ARGS.demo_ns_uri
+        
+        self.address_Demo          = Address(ExpandedNodeId("Demo"               , demoNsUri, serverUri))
+        self.address_StaticScalar  = Address(ExpandedNodeId("Demo.Static.Scalar" , demoNsUri, serverUri))
+        self.address_DynamicScalar = Address(ExpandedNodeId("Demo.Dynamic.Scalar", demoNsUri, serverUri))
+        
+        self.browseRequest = AsyncBrowseRequest([BrowseRequestTarget(self.address_Demo),
+                                                 BrowseRequestTarget(self.address_StaticScalar),
+                                                 BrowseRequestTarget(self.address_DynamicScalar)])
+        
+        self.browsePath = BrowsePath(ExpandedNodeId("Demo.Static.Scalar", demoNsUri, serverUri),
+                                     [RelativePathElement(QualifiedName("Byte", demoNsUri))])
+        self.translateRequest = AsyncTranslateBrowsePathsToNodeIdsRequest(
+                                    [TranslateBrowsePathsToNodeIdsRequestTarget(self.browsePath)])
+    
+    
+    def test_client_Client_processRequest_for_an_async_browse_request(self):
+        asyncResult = self.client.processRequest(self.browseRequest)
+        
+        self.assertTrue( type(asyncResult) == AsyncBrowseResult )
+        self.assertTrue( asyncResult.overallStatus.isGood() )
+        
+        # wait for the result
+        t_timeout = time.time() + 5.0
+        while time.time() < t_timeout and len(self.client.browseResults) == 0:
+            time.sleep(0.01)
+        
+        # assert if the browse result was received
+        self.assertEqual( len(self.client.browseResults) , 1 )
+        result = self.client.browseResults[0]
+        self.assertEqual( result.requestHandle , asyncResult.requestHandle )
+        self.assertTrue( result.overallStatus.isGood() )
+        self.assertGreaterEqual( len(result.targets[0].references) , 5 )
+        self.assertGreaterEqual( len(result.targets[1].references) , 5 )
+        self.assertGreaterEqual( len(result.targets[2].references) , 5 )
+    
+    
+    def test_client_Client_processRequest_for_an_async_browse_request_with_callback(self):
+        t = TestClass()
+        asyncResult = self.client.processRequest(self.browseRequest, t.myCallback)
+        
+        t_timeout = time.time() + 5.0
+        while time.time() < t_timeout and len(t.results) == 0:
+            time.sleep(0.01)
+        
+        # assert if only the callback function was called
+        self.assertEqual( len(t.results) , 1 )
+        self.assertEqual( len(self.client.browseResults) , 0 )
+        self.assertTrue( t.results[0].overallStatus.isGood() )
+    
+    
+    def test_client_Client_processRequest_for_an_async_translate_request(self):
+        asyncResult = self.client.processRequest(self.translateRequest)
+        
+        t_timeout = time.time() + 5.0
+        while time.time() < t_timeout and len(self.client.translateResults) == 0:
+            time.sleep(0.01)
+        
+        self.assertEqual( len(self.client.translateResults) , 1 )
+        result = self.client.translateResults[0]
+        self.assertTrue( result.overallStatus.isGood() )
+        self.assertEqual( result.targets[0].expandedNodeIds[0].nodeId.identifier.stringId , 
+                          "Demo.Static.Scalar.Byte" )
+    
+    
+    def test_client_Client_processRequest_for_many_async_browse_requests_in_parallel(self):
+        t = TestClass()
+        
+        for i in range(30):
+            self.client.processRequest(self.browseRequest, t.myCallback)
+        
+        t_timeout = time.time() + 10.0
+        while time.time() < t_timeout and len(t.results) < 30:
+            time.sleep(0.01)
+        
+        # assert if all results were received, each with a unique request handle
+        self.assertEqual( len(t.results) , 30 )
+        self.assertEqual( len(set([r.requestHandle for r in t.results])) , 30 )
+    
+    
+    def tearDown(self):
+        # delete the client instances manually (now!) instead of letting them be garbage collected 
+        # automatically (which may happen during a another test, and which may cause logging output
+        # of the destruction to be mixed with the logging output of the other test).
+        del self.client
+    
+        
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
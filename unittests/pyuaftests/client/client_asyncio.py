@@ -0,0 +1,118 @@
+import pyuaf
+import sys
+import unittest
+from pyuaf.util.unittesting import parseArgs
+
+from pyuaf.util import Address, ExpandedNodeId, RelativePathElement, QualifiedName
+from pyuaf.util.primitives import Int32
+
+if sys.version_info >= (3, 5):
+    import asyncio
+    import pyuaf.client.aio
+
+
+ARGS = parseArgs()
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+    
+    return unittest.TestLoader().loadTestsFromTestCase(ClientAsyncioTest)
+
+
+@unittest.skipIf(sys.version_info < (3, 5), "asyncio support requires Python >= 3.5")
+class ClientAsyncioTest(unittest.TestCase):
+    
+    
+    def setUp(self):
+        
+        # create a new ClientSettings instance and add the localhost to the URLs to discover
+        settings = pyuaf.client.settings.ClientSettings()
+        settings.discoveryUrls.append(ARGS.demo_url)
+        settings.applicationName = "client"
+        settings.logToStdOutLevel = ARGS.loglevel
+    
+        self.client = pyuaf.client.Client(settings)
+        
+        serverUri    = ARGS.demo_server_uri
+        demoNsUri    = ARGS.demo_ns_uri
+        
+        self.address_Demo   = Address(ExpandedNodeId("Demo", demoNsUri, serverUri))
+        self.address_Scalar = Address(ExpandedNodeId("Demo.Static.Scalar", demoNsUri, serverUri))
+        self.address_Int32  = Address(self.address_Scalar, [RelativePathElement(QualifiedName("Int32", demoNsUri))] )
+        self.address_StartSimulation = Address(self.address_Demo, [RelativePathElement(QualifiedName("StartSimulation", demoNsUri))])
+        self.address_Dynamic = Address(self.address_Demo, [RelativePathElement(QualifiedName("Dynamic", demoNsUri)),
+                                                           RelativePathElement(QualifiedName("Scalar", demoNsUri)),
+                                                           RelativePathElement(QualifiedName("Double", demoNsUri))] )
+        
+        self.loop = asyncio.new_event_loop()
+        self.aioClient = pyuaf.client.aio.AsyncioClient(self.client, self.loop)
+    
+    
+    def test_client_aio_AsyncioClient_read(self):
+        result = self.loop.run_until_complete(self.aioClient.read([self.address_Int32]))
+        
+        self.assertTrue( result.overallStatus.isGood() )
+        self.assertEqual( type(result.targets[0].data) , Int32 )
+    
+    
+    def test_client_aio_AsyncioClient_write_and_read(self):
+        result = self.loop.run_until_complete(
+                    self.aioClient.write([self.address_Int32], [Int32(-123)]))
+        self.assertTrue( result.overallStatus.isGood() )
+        
+        result = self.loop.run_until_complete(self.aioClient.read([self.address_Int32]))
+        self.assertEqual( result.targets[0].data , Int32(-123) )
+    
+    
+    def test_client_aio_AsyncioClient_many_reads_in_parallel(self):
+        coroutines = [ self.aioClient.read([self.address_Int32]) for i in range(100) ]
+        results = self.loop.run_until_complete(asyncio.gather(*coroutines))
+        
+        self.assertEqual( len(results) , 100 )
+        self.assertEqual( len(set([r.requestHandle for r in results])) , 100 )
+        for result in results:
+            self.assertTrue( result.overallStatus.isGood() )
+    
+    
+    def test_client_aio_AsyncioClient_browse(self):
+        result = self.loop.run_until_complete(self.aioClient.browse([self.address_Demo]))
+        
+        self.assertTrue( result.overallStatus.isGood() )
+        self.assertGreaterEqual( len(result.targets[0].references) , 5 )
+    
+    
+    def test_client_aio_AsyncioClient_monitorData(self):
+        # start the simulation (otherwise the dynamic variables won't change)
+        self.client.call(self.address_Demo, self.address_StartSimulation)
+        
+        stream = self.aioClient.monitorData([self.address_Dynamic])
+        
+        # wait for a few notifications
+        notifications = []
+        for i in range(3):
+            notification = self.loop.run_until_complete(
+                                asyncio.wait_for(stream.__anext__(), 5.0))
+            notifications.append(notification)
+        
+        stream.close()
+        
+        self.assertEqual( len(stream.clientHandles) , 1 )
+        for notification in notifications:
+            self.assertEqual( notification.clientHandle , stream.clientHandles[0] )
+    
+    
+    def tearDown(self):
+        # delete the client instances manually (now!) instead of letting them be garbage collected 
+        # automatically (which may happen during a another test, and which may cause logging output
+        # of the destruction to be mixed with the logging output of the other test).
+        self.loop.close()
+        del self.aioClient
+        del self.client
+    
+        
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
@@ -0,0 +1,83 @@
+import pyuaf
+import time
+import threading
+import unittest
+from pyuaf.util.unittesting import parseArgs
+
+
+ARGS = parseArgs()
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+    
+    return unittest.TestLoader().loadTestsFromTestCase(ClientCallbackDispatchTest)
+
+
+class CallbackClass:
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.received = {}
+        self.threadNames = {}
+    
+    def callback(self, key, value):
+        try:
+            self.lock.acquire()
+            self.received.setdefault(key, []).append(value)
+            self.threadNames.setdefault(key, set()).add(threading.current_thread().name)
+        finally:
+            self.lock.release()
+
+
+class ClientCallbackDispatchTest(unittest.TestCase):
+    
+    
+    def setUp(self):
+        self.dispatcher = pyuaf.client.__CallbackDispatcher__(4)
+        self.cbc = CallbackClass()
+    
+    
+    def test_client_CallbackDispatcher_noOfThreads(self):
+        self.assertEqual( self.dispatcher.noOfThreads(), 4 )
+        
+        # at least one thread is always needed 
+        d = pyuaf.client.__CallbackDispatcher__(0)
+        self.assertEqual( d.noOfThreads(), 1 )
+        d.stop()
+    
+    
+    def test_client_CallbackDispatcher_order_per_key(self):
+        keys = range(10)
+        noOfValues = 1000
+        
+        for i in range(noOfValues):
+            for key in keys:
+                self.dispatcher.dispatch(key, self.cbc.callback, [key, i])
+        
+        # stop() returns when all queued callbacks have been called
+        self.dispatcher.stop()
+        
+        for key in keys:
+            self.assertEqual( self.cbc.received[key], list(range(noOfValues)) )
+            self.assertEqual( len(self.cbc.threadNames[key]), 1 )
+    
+    
+    def test_client_CallbackDispatcher_survives_exceptions(self):
+        def badCallback():
+            raise Exception("This exception is raised on purpose by the unit test")
+        
+        self.dispatcher.dispatch(1, badCallback, [])
+        self.dispatcher.dispatch(1, self.cbc.callback, [1, 1])
+        self.dispatcher.stop()
+        
+        self.assertEqual( self.cbc.received[1], [1] )
+    
+    
+    def tearDown(self):
+        self.dispatcher.stop()
+        
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
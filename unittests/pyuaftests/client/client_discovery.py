@@ -71,6 +71,41 @@ class ClientDiscoveryTest(unittest.TestCase):
             
         self.assertEqual( testResults.failed() , 0 )
 
+    def test_client_Client_findServersNow_with_unreachable_discoveryUrls(self):
+        # add some URLs that will time out, they should be invoked in parallel
+        for i in range(20):
+            self.settings.discoveryUrls.append("opc.tcp://10.255.255.%d:4840" %(i + 1))
+        self.settings.discoveryFindServersTimeoutSec = 1.0
+        self.settings.discoveryMaxParallelRequests = 21
+        self.client.setClientSettings(self.settings)
+        
+        t_start = time.time()
+        self.client.findServersNow()
+        t_elapsed = time.time() - t_start
+        
+        self.assertTrue( t_elapsed < 10.0 )
+        self.assertTrue( isDemoServerFound(self.client.serversFound()) )
+
+    def test_client_Client_serversChanged(self):
+        appeared = []
+        self.client.registerServersChangedCallback(
+                lambda a, d, c: appeared.extend([desc.applicationUri for desc in a]))
+        
+        self.client.setClientSettings(self.settings)
+        
+        # the callbacks are called by the callback threads
+        t_timeout = time.time() + 5.0
+        while time.time() < t_timeout and ARGS.demo_server_uri not in appeared:
+            time.sleep(0.1)
+        
+        self.assertTrue( ARGS.demo_server_uri in appeared )
+        
+        # discovering the same servers again does not report them again
+        del appeared[:]
+        self.client.findServersNow()
+        time.sleep(0.5)
+        self.assertFalse( ARGS.demo_server_uri in appeared )
+
     def test_client_Client_setClientSettings_without_discoveryUrls(self):
         self.assertFalse( isDemoServerFound(self.client.serversFound()) )
     
@@ -85,6 +85,29 @@ class ClientKeepAliveTest(unittest.TestCase):
         for source in [self.client, cbc]:
             self.assertTrue( len(source.notificationList) >= 1 )
             self.assertEqual( source.notificationList[0].subscriptionState, pyuaf.client.subscriptionstates.Created )
+            self.assertEqual( len(source.notificationList[0].clientHandles), 1 )
+    
+    
+    def test_client_Client_keepalive_without_clientHandles(self):
+        cbc = CallbackClass()
+        self.client.registerKeepAliveCallback(cbc.callback)
+        
+        subSettings = pyuaf.client.settings.SubscriptionSettings()
+        subSettings.publishingIntervalSec = 1.0
+        subSettings.maxKeepAliveCount = 5
+        subSettings.keepAliveClientHandles = False
+        
+        result = self.client.createMonitoredData([self.address], subscriptionSettings = subSettings)
+        self.assertTrue( result.targets[0].status.isGood() )
+        
+        # wait some time
+        time.sleep(7.0)
+        
+        # the callbacks should have been called at least once, but without any client handles:
+        for source in [self.client, cbc]:
+            self.assertTrue( len(source.notificationList) >= 1 )
+            self.assertEqual( source.notificationList[0].subscriptionState, pyuaf.client.subscriptionstates.Created )
+            self.assertEqual( len(source.notificationList[0].clientHandles), 0 )
      
 
     def tearDown(self):
@@ -54,6 +54,15 @@ class ClientManualSubscriptionTest(unittest.TestCase):
         self.assertEqual( self.clientSubscriptionHandle0 , 0 )
         self.assertEqual( self.client.subscriptionInformation(0).subscriptionState , pyuaf.client.subscriptionstates.Created )
     
+    def test_client_Client_manualsubscription_publishRequestCount(self):
+        self.sessionSettings.publishRequestCount = 3
+        self.connect()
+        self.subscribe()
+        
+        infos = self.client.allSubscriptionInformations()
+        self.assertEqual( len(infos), 1 )
+        self.assertEqual( infos[0].publishRequestCount, 3 )
+    
     def test_client_Client_manualunsubscription(self):
         self.connect()
         self.subscribe()
@@ -0,0 +1,107 @@
+import pyuaf
+import time
+import threading
+import sys
+import unittest
+from pyuaf.util.unittesting import parseArgs
+
+
+from pyuaf.util import NodeId, Address, ExpandedNodeId, RelativePathElement, QualifiedName
+from pyuaf.client.settings import MonitoredItemSettings
+
+
+ARGS = parseArgs()
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+    
+    return unittest.TestLoader().loadTestsFromTestCase(ClientModifyMonitoredItemsTest)
+
+
+
+class ClientModifyMonitoredItemsTest(unittest.TestCase):
+    
+    
+    def setUp(self):
+        
+        # create a new ClientSettings instance and add the localhost to the URLs to discover
+        settings = pyuaf.client.settings.ClientSettings()
+        settings.discoveryUrls.append(ARGS.demo_url)
+        settings.applicationName = "client"
+        settings.logToStdOutLevel = ARGS.loglevel
+    
+        self.client = pyuaf.client.Client(settings)
+
+        serverUri    = ARGS.demo_server_uri
+        demoNsUri    = ARGS.demo_ns_uri
+        
+        self.address_Demo   = Address(ExpandedNodeId("Demo", demoNsUri, serverUri))
+        self.address_Scalar = Address(self.address_Demo, [RelativePathElement(QualifiedName("Dynamic", demoNsUri)),
+                                                          RelativePathElement(QualifiedName("Scalar", demoNsUri))] )
+        self.address_Int32  = Address(self.address_Scalar, [RelativePathElement(QualifiedName("Int32", demoNsUri))] )
+        self.address_Double = Address(self.address_Scalar, [RelativePathElement(QualifiedName("Double", demoNsUri))] )
+        
+        res = self.client.createMonitoredData([self.address_Int32, self.address_Double])
+        self.assertTrue( res.overallStatus.isGood() )
+        
+        self.clientHandles = [ target.clientHandle for target in res.targets ]
+    
+    
+    def test_client_Client_modifyMonitoredItems(self):
+        settings = []
+        for clientHandle in self.clientHandles:
+            s = self.client.monitoredItemInformation(clientHandle).settings
+            s.samplingIntervalSec = 2.0
+            s.queueSize = 5
+            settings.append(s)
+        
+        statuses = self.client.modifyMonitoredItems(self.clientHandles, settings)
+        
+        self.assertEqual( len(statuses), len(self.clientHandles) )
+        for status in statuses:
+            self.assertTrue( status.isGood() )
+        
+        # the settings of the monitored items must have been updated
+        for clientHandle in self.clientHandles:
+            info = self.client.monitoredItemInformation(clientHandle)
+            self.assertEqual( info.settings.samplingIntervalSec, 2.0 )
+            self.assertEqual( info.settings.queueSize, 5 )
+    
+    
+    def test_client_Client_modifyMonitoredItems_unknown_handle(self):
+        unknownHandle = max(self.clientHandles) + 1000
+        statuses = self.client.modifyMonitoredItems([unknownHandle], [MonitoredItemSettings()])
+        
+        self.assertEqual( len(statuses), 1 )
+        self.assertTrue( statuses[0].isBad() )
+    
+    
+    def test_client_Client_modifyMonitoredItems_wrong_kind(self):
+        statuses = self.client.modifyMonitoredItems(self.clientHandles[:1], 
+                                                    [MonitoredItemSettings(MonitoredItemSettings.Event)])
+        
+        self.assertEqual( len(statuses), 1 )
+        self.assertTrue( statuses[0].isBad() )
+    
+    
+    def test_client_Client_modifyMonitoredItems_size_mismatch(self):
+        self.assertRaises(pyuaf.util.errors.InvalidRequestError,
+                          self.client.modifyMonitoredItems, 
+                          self.clientHandles, 
+                          [MonitoredItemSettings()])
+    
+    
+    def tearDown(self):
+        # delete the client instances manually (now!) instead of letting them be garbage collected 
+        # automatically (which may happen during a another test, and which may cause logging output
+        # of the destruction to be mixed with the logging output of the other test).
+        del self.client
+
+
+
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
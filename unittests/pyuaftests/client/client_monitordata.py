@@ -107,6 +107,34 @@ class ClientMonitorDataTest(unittest.TestCase):
     
         self.assertGreaterEqual( t.noOfSuccessFullyReceivedNotifications , 2 )
     
+    
+    def test_client_Client_createMonitoredData_spread_over_subscriptions(self):
+        subscriptionSettings = pyuaf.client.settings.SubscriptionSettings()
+        subscriptionSettings.maxMonitoredItemsPerSubscription = 2
+        
+        result = self.client.createMonitoredData([self.address_Byte, self.address_Int32, self.address_Float], 
+                                                 subscriptionSettings = subscriptionSettings)
+        
+        self.assertTrue( result.overallStatus.isGood() )
+        
+        # 3 items with max 2 per subscription --> 2 subscriptions
+        handles = set([ target.clientSubscriptionHandle for target in result.targets ])
+        self.assertEqual( len(handles), 2 )
+        
+        # a next item must be placed in the subscription that has room for it
+        result2 = self.client.createMonitoredData([self.address_Byte], 
+                                                  subscriptionSettings = subscriptionSettings)
+        
+        self.assertTrue( result2.overallStatus.isGood() )
+        self.assertTrue( result2.targets[0].clientSubscriptionHandle in handles )
+        
+        # the notifications of all items must still be received
+        t_timeout = time.time() + 5.0
+        while time.time() < t_timeout and self.client.noOfSuccessFullyReceivedNotifications < 4:
+            time.sleep(0.01)
+        
+        self.assertGreaterEqual( self.client.noOfSuccessFullyReceivedNotifications , 4 )
+    
 
     def tearDown(self):
         # stop the simulation
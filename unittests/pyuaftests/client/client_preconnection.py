@@ -0,0 +1,88 @@
+import pyuaf
+import unittest
+from pyuaf.util.unittesting import parseArgs
+import time
+
+
+
+ARGS = parseArgs()
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+    
+    return unittest.TestLoader().loadTestsFromTestCase(ClientPreConnectionTest)
+
+
+
+class ClientPreConnectionTest(unittest.TestCase):
+    
+    def setUp(self):
+        # create a new ClientSettings instance and add the localhost to the URLs to discover
+        self.settings = pyuaf.client.settings.ClientSettings()
+        self.settings.discoveryUrls.append(ARGS.demo_url)
+        self.settings.applicationName = "client"
+        self.settings.logToStdOutLevel = ARGS.loglevel
+        
+        self.address = pyuaf.util.Address(pyuaf.util.ExpandedNodeId(
+                            pyuaf.util.NodeId(pyuaf.util.opcuaidentifiers.OpcUaId_Server_Auditing, 0),
+                            ARGS.demo_server_uri))
+    
+    def test_client_Client_waitUntilReady_without_preConnectServerUris(self):
+        self.client = pyuaf.client.Client(self.settings)
+        
+        # nothing needs to be connected, so the client is ready immediately
+        self.client.waitUntilReady(5.0)
+        self.assertEqual( len(self.client.allSessionInformations()) , 0 )
+    
+    def test_client_Client_waitUntilReady_with_preConnectServerUris(self):
+        self.settings.preConnectServerUris.append(ARGS.demo_server_uri)
+        self.client = pyuaf.client.Client(self.settings)
+        
+        self.client.waitUntilReady(10.0)
+        
+        infos = self.client.allSessionInformations()
+        self.assertEqual( len(infos) , 1 )
+        self.assertEqual( infos[0].serverUri , ARGS.demo_server_uri )
+        self.assertEqual( infos[0].sessionState , pyuaf.client.sessionstates.Connected )
+    
+    def test_client_Client_read_uses_preconnected_session(self):
+        self.settings.preConnectServerUris.append(ARGS.demo_server_uri)
+        self.client = pyuaf.client.Client(self.settings)
+        self.client.waitUntilReady(10.0)
+        
+        clientConnectionId = self.client.allSessionInformations()[0].clientConnectionId
+        
+        result = self.client.read([self.address])
+        
+        self.assertTrue( result.overallStatus.isGood() )
+        self.assertEqual( result.targets[0].clientConnectionId , clientConnectionId )
+        self.assertEqual( len(self.client.allSessionInformations()) , 1 )
+    
+    def test_client_Client_preConnectAllDiscoveredServers(self):
+        self.settings.preConnectAllDiscoveredServers = True
+        self.client = pyuaf.client.Client(self.settings)
+        
+        self.client.waitUntilReady(10.0)
+        
+        serverUris = [info.serverUri for info in self.client.allSessionInformations()]
+        self.assertTrue( ARGS.demo_server_uri in serverUris )
+    
+    def test_client_Client_waitUntilReady_timeout(self):
+        self.settings.preConnectServerUris.append("urn:some:unknown:server")
+        self.client = pyuaf.client.Client(self.settings)
+        
+        t_start = time.time()
+        self.assertRaises(pyuaf.util.errors.ClientNotReadyError, self.client.waitUntilReady, 0.5)
+        self.assertTrue( time.time() - t_start < 5.0 )
+    
+    def tearDown(self):
+        # delete the client instances manually (now!) instead of letting them be garbage collected 
+        # automatically (which may happen during a another test, and which may cause logging output
+        # of the destruction to be mixed with the logging output of the other test).
+        del self.client
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
@@ -145,6 +145,55 @@ class ClientStructuresTest(unittest.TestCase):
         self.assertEquals(union.value(), primitives.Float(111.222))
         
         
+    def test_client_Client_structureDefinition_of_server(self):
+        result = self.client.read( [self.address_vector] , attributeId = attributeids.DataType)
+        
+        dataTypeId = result.targets[0].data
+        
+        # the first call caches the definition, the second call must give the same definition
+        definition0 = self.client.structureDefinition(dataTypeId)
+        definition1 = self.client.structureDefinition(dataTypeId)
+        self.assertEqual( definition0.childrenCount(), definition1.childrenCount() )
+        self.assertEqual( definition0.child(0).name(), definition1.child(0).name() )
+        
+        # the same definition can be asked to the server that owns it
+        definition2 = self.client.structureDefinition(ExpandedNodeId(dataTypeId, ARGS.demo_server_uri))
+        self.assertEqual( definition0.child(0).name(), definition2.child(0).name() )
+        
+        # but not to a server that is unknown
+        self.assertRaises(pyuaf.util.errors.DefinitionNotFoundError,
+                          self.client.structureDefinition, 
+                          ExpandedNodeId(dataTypeId, "urn:some:unknown:server"))
+        
+        
+    def test_client_Client_prefetchStructureDefinitions(self):
+        settings = self.client.clientSettings()
+        settings.prefetchStructureDefinitions = True
+        self.client.setClientSettings(settings)
+        
+        result = self.client.read( [self.address_union] , attributeId = attributeids.DataType)
+        
+        # the definitions are fetched in the background, so wait until the cache stops growing
+        noOfPrefetched = 0
+        t_timeout = time.time() + 10.0
+        while time.time() < t_timeout:
+            time.sleep(0.5)
+            n = self.client.noOfCachedStructureDefinitions(ARGS.demo_server_uri)
+            if n > 0 and n == noOfPrefetched:
+                break
+            noOfPrefetched = n
+        
+        # no definition was asked yet, so the cached definitions must have been prefetched
+        self.assertTrue( noOfPrefetched > 1 )
+        
+        # the definition is found in the cache, so the cache doesn't grow anymore
+        definition = self.client.structureDefinition(result.targets[0].data)
+        self.assertEqual( definition.isUnion(), True )
+        self.assertEqual( definition.child(0).name(), 'Temperature' )
+        self.assertEqual( self.client.noOfCachedStructureDefinitions(ARGS.demo_server_uri),
+                          noOfPrefetched )
+        
+        
         
         
 
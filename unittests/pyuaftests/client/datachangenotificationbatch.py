@@ -0,0 +1,89 @@
+import pyuaf
+import unittest
+import math
+from pyuaf.util.unittesting import parseArgs
+
+
+ARGS = parseArgs()
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+    
+    return unittest.TestLoader().loadTestsFromTestCase(DataChangeNotificationBatchTest)
+
+
+
+class DataChangeNotificationBatchTest(unittest.TestCase):
+    
+    def setUp(self):
+        self.cppBatch = pyuaf.client.DataChangeNotificationBatch()
+        self.cppBatch.clientConnectionId       = 1
+        self.cppBatch.clientSubscriptionHandle = 2
+        
+        clientHandles = pyuaf.util.UInt32Vector()
+        statusCodes   = pyuaf.util.UInt32Vector()
+        timestamps    = pyuaf.util.DoubleVector()
+        numbers       = pyuaf.util.DoubleVector()
+        values        = pyuaf.util.VariantVector()
+        
+        for i in range(3):
+            clientHandles.append(10 + i)
+            statusCodes.append(0)
+            timestamps.append(1000.0 + i)
+            numbers.append(0.5 * i)
+            values.append(pyuaf.util.primitives.Double(0.5 * i))
+        
+        # a non-numeric value:
+        clientHandles.append(13)
+        statusCodes.append(pyuaf.util.opcuastatuscodes.OpcUa_BadNodeIdUnknown)
+        timestamps.append(0.0)
+        numbers.append(float("nan"))
+        values.append(pyuaf.util.LocalizedText("en", "text"))
+        
+        self.cppBatch.clientHandles    = clientHandles
+        self.cppBatch.statusCodes      = statusCodes
+        self.cppBatch.sourceTimestamps = timestamps
+        self.cppBatch.serverTimestamps = timestamps
+        self.cppBatch.numericValues    = numbers
+        self.cppBatch.values           = values
+        
+        self.batch = pyuaf.client.DataChangeBatch(self.cppBatch)
+    
+    def test_client_DataChangeNotificationBatch_size(self):
+        self.assertEqual( self.cppBatch.size() , 4 )
+        self.assertEqual( len(self.batch) , 4 )
+    
+    def test_client_DataChangeBatch_ids(self):
+        self.assertEqual( self.batch.clientConnectionId , 1 )
+        self.assertEqual( self.batch.clientSubscriptionHandle , 2 )
+    
+    def test_client_DataChangeBatch_clientHandles(self):
+        self.assertEqual( list(self.batch.clientHandles) , [10, 11, 12, 13] )
+    
+    def test_client_DataChangeBatch_statusCodes(self):
+        self.assertEqual( list(self.batch.statusCodes) , 
+                          [0, 0, 0, pyuaf.util.opcuastatuscodes.OpcUa_BadNodeIdUnknown] )
+    
+    def test_client_DataChangeBatch_timestamps(self):
+        self.assertEqual( list(self.batch.sourceTimestamps) , [1000.0, 1001.0, 1002.0, 0.0] )
+        self.assertEqual( list(self.batch.serverTimestamps) , [1000.0, 1001.0, 1002.0, 0.0] )
+    
+    def test_client_DataChangeBatch_numericValues(self):
+        numbers = list(self.batch.numericValues)
+        self.assertEqual( numbers[:3] , [0.0, 0.5, 1.0] )
+        self.assertTrue( math.isnan(numbers[3]) )
+    
+    def test_client_DataChangeBatch_values(self):
+        self.assertEqual( self.batch.values[1] , pyuaf.util.primitives.Double(0.5) )
+        self.assertEqual( self.batch.values[3] , pyuaf.util.LocalizedText("en", "text") )
+    
+    def test_client_DataChangeBatch_columns_are_cached(self):
+        self.assertTrue( self.batch.clientHandles is self.batch.clientHandles )
+    
+
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
@@ -0,0 +1,127 @@
+import pyuaf
+import unittest
+import math
+from pyuaf.util.unittesting import parseArgs
+from pyuaf.util import EventFilter, QualifiedName, NodeId, LocalizedText
+from pyuaf.util import attributeids, opcuaidentifiers, opcuatypes
+from pyuaf.client import EventSchema
+
+
+ARGS = parseArgs()
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+    
+    return unittest.TestLoader().loadTestsFromTestCase(EventNotificationBatchTest)
+
+
+
+class EventNotificationBatchTest(unittest.TestCase):
+    
+    def setUp(self):
+        eventFilter = EventFilter()
+        eventFilter.selectClauses.resize(5)
+        for i, name in enumerate(["Severity", "Time", "Message", "EventType"]):
+            eventFilter.selectClauses[i].attributeId = attributeids.Value
+            eventFilter.selectClauses[i].browsePath.append(QualifiedName(name, 0))
+            eventFilter.selectClauses[i].typeId = NodeId(opcuaidentifiers.OpcUaId_BaseEventType, 0)
+        # a non-standard field:
+        eventFilter.selectClauses[4].attributeId = attributeids.Value
+        eventFilter.selectClauses[4].browsePath.append(QualifiedName("Temperature", 2))
+        
+        self.schema = EventSchema(eventFilter)
+        
+        self.cppBatch = pyuaf.client.EventNotificationBatch()
+        self.cppBatch.clientConnectionId       = 1
+        self.cppBatch.clientSubscriptionHandle = 2
+        self.cppBatch.clientHandle             = 3
+        self.cppBatch.schema                   = self.schema
+        self.cppBatch.resize(2)
+        
+        # the columns are stored one after the other
+        numbers = pyuaf.util.DoubleVector()
+        for number in [100.0, 500.0, 1000.0, 1001.0]:
+            numbers.append(number)
+        
+        strings = pyuaf.util.StringVector()
+        strings.append("first")
+        strings.append("second")
+        
+        values = pyuaf.util.VariantVector()
+        values.append(NodeId(opcuaidentifiers.OpcUaId_BaseEventType, 0))
+        values.append(NodeId(opcuaidentifiers.OpcUaId_AlarmConditionType, 0))
+        values.append(pyuaf.util.primitives.Double(20.5))
+        values.append(pyuaf.util.primitives.Double(21.5))
+        
+        self.cppBatch.numericValues = numbers
+        self.cppBatch.stringValues  = strings
+        self.cppBatch.values        = values
+        
+        self.batch = pyuaf.client.EventBatch(self.cppBatch)
+    
+    def test_client_EventSchema_fields(self):
+        self.assertEqual( self.schema.fieldCount() , 5 )
+        self.assertEqual( self.schema.fieldName(2) , "Message" )
+        self.assertEqual( self.schema.fieldIndex("EventType") , 3 )
+        self.assertEqual( self.schema.fieldIndex("Unknown") , -1 )
+    
+    def test_client_EventSchema_types(self):
+        self.assertEqual( self.schema.fieldType(0) , opcuatypes.UInt16 )
+        self.assertEqual( self.schema.fieldType(4) , opcuatypes.Null )
+        self.assertEqual( self.schema.columnType(0) , EventSchema.ColumnType_Numeric )
+        self.assertEqual( self.schema.columnType(1) , EventSchema.ColumnType_Numeric )
+        self.assertEqual( self.schema.columnType(2) , EventSchema.ColumnType_String )
+        self.assertEqual( self.schema.columnType(3) , EventSchema.ColumnType_Variant )
+        self.assertEqual( self.schema.columnType(4) , EventSchema.ColumnType_Variant )
+    
+    def test_client_EventSchema_columns(self):
+        self.assertEqual( self.schema.columnIndex(1) , 1 )
+        self.assertEqual( self.schema.columnIndex(4) , 1 )
+        self.assertEqual( self.schema.columnCount(EventSchema.ColumnType_Numeric) , 2 )
+        self.assertEqual( self.schema.columnCount(EventSchema.ColumnType_String) , 1 )
+    
+    def test_client_EventNotificationBatch_size(self):
+        self.assertEqual( self.cppBatch.size() , 2 )
+        self.assertEqual( len(self.batch) , 2 )
+    
+    def test_client_EventNotificationBatch_accessors(self):
+        self.assertEqual( self.cppBatch.numericValue(1, 1) , 1001.0 )
+        self.assertEqual( self.cppBatch.stringValue(0, 2) , "first" )
+        self.assertEqual( self.cppBatch.value(1, 4) , pyuaf.util.primitives.Double(21.5) )
+    
+    def test_client_EventBatch_ids(self):
+        self.assertEqual( self.batch.clientConnectionId , 1 )
+        self.assertEqual( self.batch.clientSubscriptionHandle , 2 )
+        self.assertEqual( self.batch.clientHandle , 3 )
+    
+    def test_client_EventBatch_fieldNames(self):
+        self.assertEqual( self.batch.fieldNames , 
+                          ["Severity", "Time", "Message", "EventType", "Temperature"] )
+    
+    def test_client_EventBatch_numeric_columns(self):
+        self.assertEqual( list(self.batch.column("Severity")) , [100.0, 500.0] )
+        self.assertEqual( list(self.batch["Time"]) , [1000.0, 1001.0] )
+    
+    def test_client_EventBatch_string_columns(self):
+        self.assertEqual( self.batch.column(2) , ["first", "second"] )
+    
+    def test_client_EventBatch_variant_columns(self):
+        self.assertEqual( self.batch["EventType"][1] , 
+                          NodeId(opcuaidentifiers.OpcUaId_AlarmConditionType, 0) )
+        self.assertEqual( self.batch["Temperature"] , 
+                          [pyuaf.util.primitives.Double(20.5), pyuaf.util.primitives.Double(21.5)] )
+    
+    def test_client_EventBatch_unknown_field(self):
+        self.assertRaises( KeyError, self.batch.column, "Unknown" )
+        self.assertRaises( KeyError, self.batch.column, 5 )
+    
+    def test_client_EventBatch_columns_are_cached(self):
+        self.assertTrue( self.batch["Message"] is self.batch["Message"] )
+    
+
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
@@ -29,6 +29,8 @@ class SessionInformationTest(unittest.TestCase):
         self.info1.serverState = pyuaf.util.serverstates.Running
         self.info1.lastConnectionAttemptStatus.setGood();
         self.info1.lastConnectionAttemptTime = self.now
+        self.info1.nextConnectionAttemptTime = self.now
+        self.info1.failedConnectionAttempts = 3
     
     def test_client_SessionInformation_clientConnectionId(self):
         self.assertEqual( self.info1.clientConnectionId , 123 )
@@ -48,6 +50,14 @@ class SessionInformationTest(unittest.TestCase):
     def test_client_SessionInformation_lastConnectionAttemptStatus(self):
         self.assertTrue( self.info1.lastConnectionAttemptStatus.isGood() )
     
+    def test_client_SessionInformation_nextConnectionAttemptTime(self):
+        self.assertTrue( self.info0.nextConnectionAttemptTime.isNull() )
+        self.assertEqual( self.info1.nextConnectionAttemptTime , self.now )
+    
+    def test_client_SessionInformation_failedConnectionAttempts(self):
+        self.assertEqual( self.info0.failedConnectionAttempts , 0 )
+        self.assertEqual( self.info1.failedConnectionAttempts , 3 )
+    
     def test_client_SessionInformationVector(self):
         testVector(self, pyuaf.client.SessionInformationVector, [self.info0, self.info1])
     
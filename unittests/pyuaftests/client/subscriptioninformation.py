@@ -24,6 +24,10 @@ class SubscriptionInformationTest(unittest.TestCase):
         self.info1.clientConnectionId = 123
         self.info1.clientSubscriptionHandle = 456
         self.info1.subscriptionState = pyuaf.client.subscriptionstates.Created
+        self.info1.noOfNotificationGaps = 2
+        self.info1.noOfMissingNotifications = 5
+        self.info1.noOfRecoveredNotifications = 4
+        self.info1.publishRequestCount = 3
     
     def test_client_SubscriptionInformation_clientConnectionId(self):
         self.assertEqual( self.info1.clientConnectionId , 123 )
@@ -34,6 +38,18 @@ class SubscriptionInformationTest(unittest.TestCase):
     def test_client_SubscriptionInformation_subscriptionState(self):
         self.assertEqual( self.info1.subscriptionState , pyuaf.client.subscriptionstates.Created )
     
+    def test_client_SubscriptionInformation_notificationStatistics(self):
+        self.assertEqual( self.info0.noOfNotificationGaps , 0 )
+        self.assertEqual( self.info0.noOfMissingNotifications , 0 )
+        self.assertEqual( self.info0.noOfRecoveredNotifications , 0 )
+        self.assertEqual( self.info1.noOfNotificationGaps , 2 )
+        self.assertEqual( self.info1.noOfMissingNotifications , 5 )
+        self.assertEqual( self.info1.noOfRecoveredNotifications , 4 )
+    
+    def test_client_SubscriptionInformation_publishRequestCount(self):
+        self.assertEqual( self.info0.publishRequestCount , 0 )
+        self.assertEqual( self.info1.publishRequestCount , 3 )
+    
     def test_client_SubscriptionInformationVector(self):
         testVector(self, pyuaf.client.SubscriptionInformationVector, [self.info0, self.info1])
     
@@ -0,0 +1,88 @@
+import pyuaf
+import unittest
+from pyuaf.util.unittesting import parseArgs
+from pyuaf.util import ContentFilter, ContentFilterElement, FilterOperand, FilterOperandVector
+from pyuaf.util import EventFilter, SimpleAttributeOperand, QualifiedName, NodeId
+from pyuaf.util import filteroperators, primitives
+
+
+ARGS = parseArgs()
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+    
+    return unittest.TestLoader().loadTestsFromTestCase(ContentFilterTest)
+
+
+
+class ContentFilterTest(unittest.TestCase):
+    
+    def setUp(self):
+        self.severity = SimpleAttributeOperand()
+        self.severity.attributeId = pyuaf.util.attributeids.Value
+        self.severity.browsePath.append(QualifiedName("Severity", 0))
+        
+        self.filter = ContentFilter()
+        self.ofType = self.filter.ofType(NodeId(1234, 2))
+        self.severe = self.filter.greaterThan(FilterOperand.simpleAttribute(self.severity),
+                                              FilterOperand.literal(primitives.UInt16(500)))
+        self.root   = self.filter.andElements(self.ofType, self.severe)
+    
+    def test_util_FilterOperand_types(self):
+        self.assertEqual( FilterOperand().operandType , FilterOperand.OperandType_Literal )
+        
+        operand = FilterOperand.literal(primitives.Int32(3))
+        self.assertEqual( operand.operandType , FilterOperand.OperandType_Literal )
+        self.assertEqual( operand.value , primitives.Int32(3) )
+        
+        operand = FilterOperand.element(2)
+        self.assertEqual( operand.operandType , FilterOperand.OperandType_Element )
+        self.assertEqual( operand.elementIndex , 2 )
+        
+        operand = FilterOperand.simpleAttribute(self.severity)
+        self.assertEqual( operand.operandType , FilterOperand.OperandType_SimpleAttribute )
+        self.assertEqual( operand.simpleAttributeOperand , self.severity )
+    
+    def test_util_ContentFilter_elements(self):
+        self.assertEqual( (self.ofType, self.severe, self.root) , (0, 1, 2) )
+        self.assertEqual( len(self.filter.elements) , 3 )
+        self.assertEqual( self.filter.elements[0].filterOperator , filteroperators.OfType )
+        self.assertEqual( self.filter.elements[0].filterOperands[0].value , NodeId(1234, 2) )
+        self.assertEqual( self.filter.elements[1].filterOperator , filteroperators.GreaterThan )
+        self.assertEqual( self.filter.elements[2].filterOperator , filteroperators.And )
+        self.assertEqual( self.filter.elements[2].filterOperands[1].elementIndex , self.severe )
+    
+    def test_util_ContentFilter_inListAndNot(self):
+        values = FilterOperandVector([FilterOperand.literal(primitives.UInt16(100)),
+                                      FilterOperand.literal(primitives.UInt16(200))])
+        inList = self.filter.inList(FilterOperand.simpleAttribute(self.severity), values)
+        notInList = self.filter.notElement(inList)
+        
+        self.assertEqual( len(self.filter.elements[inList].filterOperands) , 3 )
+        self.assertEqual( self.filter.elements[notInList].filterOperator , filteroperators.Not )
+        self.assertEqual( filteroperators.toString(filteroperators.InList) , "InList" )
+    
+    def test_util_ContentFilter_comparison(self):
+        self.assertTrue( ContentFilter().isEmpty() )
+        self.assertFalse( self.filter.isEmpty() )
+        
+        other = ContentFilter(self.filter)
+        self.assertEqual( other , self.filter )
+        other.orElements(self.ofType, self.severe)
+        self.assertNotEqual( other , self.filter )
+    
+    def test_util_EventFilter_whereClause(self):
+        eventFilter = EventFilter()
+        self.assertTrue( eventFilter.whereClause.isEmpty() )
+        
+        eventFilter.whereClause = self.filter
+        self.assertEqual( eventFilter.whereClause , self.filter )
+        self.assertNotEqual( eventFilter , EventFilter() )
+
+
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
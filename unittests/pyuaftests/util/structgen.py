@@ -0,0 +1,150 @@
+import pyuaf
+import unittest
+from pyuaf.util.unittesting import parseArgs
+from pyuaf.util import structgen
+import os
+import shlex
+import shutil
+import subprocess
+import tempfile
+
+
+ARGS = parseArgs()
+
+
+# encodes a Path (with an empty ByteString) and decodes it again, and returns 0 if all went well
+ROUNDTRIP_PROGRAM = """
+#include "demo.h"
+
+int main()
+{
+    demo::Path path;
+    path.Name = "p";
+    path.Points.resize(2);
+    path.Points[1].X = 1.5;
+
+    uaf::ExtensionObject extensionObject;
+    path.toExtensionObject(extensionObject);
+
+    demo::Path decoded;
+    if (decoded.fromExtensionObject(extensionObject).isNotGood()
+            || decoded.Name != "p"
+            || decoded.Points.size() != 2
+            || decoded.Points[1].X != 1.5
+            || decoded.Tag.length() != 0)
+        return 1;
+
+    // a Path is not a Vector
+    demo::Vector vector;
+    if (vector.fromExtensionObject(extensionObject).isGood())
+        return 2;
+
+    // a body with trailing bytes is rejected
+    std::vector<uint8_t> buffer;
+    uaf::BinaryEncoder encoder(buffer);
+    path.encode(encoder);
+    encoder.write(uint8_t(0));
+    if (decoded.decode(&buffer[0], int32_t(buffer.size())).isGood())
+        return 3;
+
+    return 0;
+}
+"""
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+    
+    return unittest.TestLoader().loadTestsFromTestCase(StructGenTest)
+
+
+
+class StructGenTest(unittest.TestCase):
+    
+    def setUp(self):
+        self.vector = { "name"             : "Vector",
+                        "namespaceUri"     : "urn:demo",
+                        "dataTypeId"       : { "namespaceIndex" : 2, "identifier" : 3002 },
+                        "binaryEncodingId" : { "namespaceIndex" : 2, "identifier" : 5054 },
+                        "fields"           : [ { "name" : "X", "valueType" : "Double" },
+                                               { "name" : "Y", "valueType" : "Double" } ] }
+        self.path   = { "name"             : "Path",
+                        "namespaceUri"     : "urn:demo",
+                        "dataTypeId"       : { "namespaceIndex" : 2, "identifier" : "Path" },
+                        "binaryEncodingId" : { "namespaceIndex" : 2, "identifier" : "Path.Binary" },
+                        "fields"           : [ { "name" : "Name", "valueType" : "String" },
+                                               { "name" : "Points", 
+                                                 "valueType" : "ExtensionObject",
+                                                 "isArray" : True,
+                                                 "dataTypeId" : self.vector["dataTypeId"] },
+                                               { "name" : "Tag", "valueType" : "ByteString" } ] }
+    
+    def test_util_structgen_parseNodeId(self):
+        self.assertEqual( structgen.parseNodeId("ns=2;i=3002") , 
+                          { "namespaceIndex" : 2, "identifier" : 3002 } )
+        self.assertEqual( structgen.parseNodeId("s=Path") , 
+                          { "namespaceIndex" : 0, "identifier" : "Path" } )
+        self.assertRaises( structgen.StructGenError, structgen.parseNodeId, "ns=2;g=x" )
+    
+    def test_util_structgen_sortDefinitions(self):
+        self.assertEqual( structgen.sortDefinitions([self.path, self.vector]) , 
+                          [self.vector, self.path] )
+        self.assertRaises( structgen.StructGenError, structgen.sortDefinitions, [self.path] )
+    
+    def test_util_structgen_generateHeader(self):
+        header = structgen.generateHeader([self.path, self.vector], "demo")
+        
+        self.assertTrue( "namespace demo" in header )
+        self.assertTrue( "#ifndef DEMO_STRUCTS_H_" in header )
+        self.assertTrue( header.index("struct Vector") < header.index("struct Path") )
+        self.assertTrue( "std::vector<Vector > Points;" in header )
+        self.assertTrue( "uaf::ByteString Tag;" in header )
+        
+        # the encoding is identified by the namespace URI, not by the index of the dump
+        self.assertTrue( "uaf::NodeId(uint32_t(5054), std::string(\"urn:demo\"))" in header )
+        self.assertTrue( "uaf::NodeId(std::string(\"Path.Binary\"), std::string(\"urn:demo\"))" 
+                         in header )
+        self.assertFalse( "NameSpaceIndex(2)" in header )
+        
+        # the encoding and the size of the body are checked while decoding
+        self.assertTrue( "if (!isBinaryEncodingId(extensionObject.encodingTypeId))" in header )
+        self.assertTrue( "else if (decoder.remaining() != 0)" in header )
+    
+    def test_util_structgen_cppNodeId(self):
+        self.assertEqual( structgen.cppNodeId({ "namespaceIndex" : 0, "identifier" : 296 }, None),
+                          "uaf::NodeId(uint32_t(296), uaf::NameSpaceIndex(0))" )
+        self.assertRaises( structgen.StructGenError, structgen.cppNodeId, 
+                           { "namespaceIndex" : 2, "identifier" : 5054 }, None )
+    
+    @unittest.skipIf(not os.environ.get("UAF_CXXFLAGS"), 
+                     "set UAF_CXXFLAGS to the compiler flags of the UAF (and SDK) to run this test")
+    def test_util_structgen_roundTrip(self):
+        # compile a program that encodes and decodes the generated structs
+        directory = tempfile.mkdtemp()
+        try:
+            with open(os.path.join(directory, "demo.h"), "w") as f:
+                f.write(structgen.generateHeader([self.path, self.vector], "demo"))
+            with open(os.path.join(directory, "main.cpp"), "w") as f:
+                f.write(ROUNDTRIP_PROGRAM)
+            
+            executable = os.path.join(directory, "roundtrip")
+            subprocess.check_call([os.environ.get("CXX", "c++"), "-I", directory, "-o", executable,
+                                   os.path.join(directory, "main.cpp")] 
+                                  + shlex.split(os.environ["UAF_CXXFLAGS"]))
+            self.assertEqual( subprocess.call([executable]) , 0 )
+        finally:
+            shutil.rmtree(directory)
+    
+    def test_util_structgen_unsupported(self):
+        self.vector["fields"][0]["valueType"] = "Variant"
+        self.assertRaises( structgen.StructGenError, structgen.generateHeader, [self.vector] )
+        
+        self.vector["fields"][0]["valueType"] = "Double"
+        self.vector["isUnion"] = True
+        self.assertRaises( structgen.StructGenError, structgen.generateHeader, [self.vector] )
+
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
@@ -0,0 +1,92 @@
+import pyuaf
+import unittest
+from pyuaf.util.unittesting import parseArgs
+from pyuaf.util import StructureDefinition, StructureField, StructureLayout, GenericStructureValue
+from pyuaf.util import GenericStructureVector, DoubleVector, Int64Vector, StringVector, UInt32Vector
+from pyuaf.util import opcuatypes, primitives
+
+
+ARGS = parseArgs()
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+    
+    return unittest.TestLoader().loadTestsFromTestCase(StructureLayoutTest)
+
+
+
+class StructureLayoutTest(unittest.TestCase):
+    
+    def setUp(self):
+        self.definition = StructureDefinition()
+        self.definition.setName("Measurement")
+        for name, valueType in [("Value", opcuatypes.Double), 
+                                ("Count", opcuatypes.Int32), 
+                                ("Unit", opcuatypes.String)]:
+            field = StructureField()
+            field.setName(name)
+            field.setValueType(valueType)
+            self.definition.addChild(field)
+        
+        self.layout = StructureLayout(self.definition)
+        
+        self.values = GenericStructureVector()
+        for i in range(5):
+            value = GenericStructureValue()
+            value.setDefinition(self.definition, True)
+            self.values.append(value)
+    
+    def test_util_StructureLayout_fieldIndex(self):
+        self.assertEqual( self.layout.fieldCount() , 3 )
+        self.assertEqual( self.layout.fieldIndex("Value") , 0 )
+        self.assertEqual( self.layout.fieldIndex("Unit") , 2 )
+        self.assertEqual( self.layout.fieldIndex("Unknown") , -1 )
+        self.assertEqual( self.layout.fieldName(1) , "Count" )
+        self.assertEqual( self.layout.fieldName(3) , "" )
+        self.assertEqual( self.layout.fieldType(1) , opcuatypes.Int32 )
+    
+    def test_util_StructureLayout_doubles(self):
+        status = self.layout.writeDoubles(self.values, 0, DoubleVector([0.5 * i for i in range(5)]))
+        self.assertTrue( status.isGood() )
+        
+        column, statusCodes = DoubleVector(), UInt32Vector()
+        self.assertTrue( self.layout.readDoubles(self.values, 0, column, statusCodes).isGood() )
+        self.assertEqual( list(column) , [0.5 * i for i in range(5)] )
+        self.assertEqual( list(statusCodes) , [0] * 5 )
+        
+        # the values are the same as those of the name-based access
+        value, statusCode = self.values[3].value("Value")
+        self.assertEqual( value , primitives.Double(1.5) )
+    
+    def test_util_StructureLayout_int64s(self):
+        # the integers are converted to the type of the field (Int32)
+        status = self.layout.writeInt64s(self.values, 1, Int64Vector(range(5)))
+        self.assertTrue( status.isGood() )
+        
+        value, statusCode = self.values[4].value(1)
+        self.assertEqual( value , primitives.Int32(4) )
+        
+        column, statusCodes = Int64Vector(), UInt32Vector()
+        self.assertTrue( self.layout.readInt64s(self.values, 1, column, statusCodes).isGood() )
+        self.assertEqual( list(column) , list(range(5)) )
+    
+    def test_util_StructureLayout_strings(self):
+        status = self.layout.writeStrings(self.values, 2, StringVector(["m", "s", "kg", "A", "K"]))
+        self.assertTrue( status.isGood() )
+        
+        column, statusCodes = StringVector(), UInt32Vector()
+        self.assertTrue( self.layout.readStrings(self.values, 2, column, statusCodes).isGood() )
+        self.assertEqual( list(column) , ["m", "s", "kg", "A", "K"] )
+    
+    def test_util_StructureLayout_invalid(self):
+        column, statusCodes = DoubleVector(), UInt32Vector()
+        self.assertTrue( self.layout.readDoubles(self.values, 3, column, statusCodes).isBad() )
+        self.assertTrue( self.layout.writeDoubles(self.values, 0, DoubleVector([1.0])).isBad() )
+
+
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
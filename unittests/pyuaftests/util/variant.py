@@ -1,5 +1,6 @@
 import pyuaf
 import unittest
+import array
 from pyuaf.util.unittesting import parseArgs, testVector
 
 
@@ -21,6 +22,9 @@ class VariantTest(unittest.TestCase):
         
         self.tester = pyuaf.util.__unittesthelper__.UnitTestHelper()
         
+    def tearDown(self):
+        pyuaf.util.setNumericArraysEnabled(False)
+        
         
         
         ######## output typemaps ########
@@ -518,6 +522,64 @@ class VariantTest(unittest.TestCase):
                                                      pyuaf.util.QualifiedName("name", "uri", 34),
                                                      pyuaf.util.LocalizedText("en", "text") ])
 
+    def test_buffer_Double_array_inputtypemap(self):
+        v = self.tester.testVariantTypemap_in( array.array("d", [1.5, -2.5, 3.5]) )
+        self.assertEqual( v , [pyuaf.util.primitives.Double(1.5),
+                               pyuaf.util.primitives.Double(-2.5),
+                               pyuaf.util.primitives.Double(3.5) ] )
+    
+    def test_buffer_UInt16_array_inputtypemap(self):
+        v = self.tester.testVariantTypemap_in( array.array("H", [1, 2, 3]) )
+        self.assertEqual( v , [pyuaf.util.primitives.UInt16(1),
+                               pyuaf.util.primitives.UInt16(2),
+                               pyuaf.util.primitives.UInt16(3) ] )
+    
+    def test_buffer_SByte_array_inputtypemap(self):
+        v = self.tester.testVariantTypemap_in( array.array("b", [-1, 2, -3]) )
+        self.assertEqual( v , [pyuaf.util.primitives.SByte(-1),
+                               pyuaf.util.primitives.SByte(2),
+                               pyuaf.util.primitives.SByte(-3) ] )
+    
+    def test_buffer_numericArrays_outputtypemap(self):
+        pyuaf.util.setNumericArraysEnabled(True)
+        self.assertTrue( pyuaf.util.numericArraysEnabled() )
+        
+        v = self.tester.testVariantTypemap_out(pyuaf.util.opcuatypes.Int32, True)
+        self.assertEqual( list(v) , [-1, 2, -3] )
+        
+        v = self.tester.testVariantTypemap_in( array.array("d", [1.5, -2.5, 3.5]) )
+        self.assertEqual( list(v) , [1.5, -2.5, 3.5] )
+        
+        # non-numeric arrays are not affected
+        v = self.tester.testVariantTypemap_out(pyuaf.util.opcuatypes.String, True)
+        self.assertEqual( type(v) , list )
+        
+        pyuaf.util.setNumericArraysEnabled(False)
+        self.assertFalse( pyuaf.util.numericArraysEnabled() )
+        
+        v = self.tester.testVariantTypemap_out(pyuaf.util.opcuatypes.Int32, True)
+        self.assertEqual( type(v) , list )
+    
+    def test_buffer_numpy_matrix_typemaps(self):
+        try:
+            import numpy
+        except ImportError:
+            return # numpy is optional
+        
+        pyuaf.util.setNumericArraysEnabled(True)
+        
+        m = numpy.arange(6, dtype=numpy.float64).reshape((2, 3))
+        v = self.tester.testVariantTypemap_in(m)
+        self.assertEqual( type(v) , numpy.ndarray )
+        self.assertEqual( v.shape , (2, 3) )
+        self.assertEqual( v.dtype , numpy.float64 )
+        self.assertTrue( (v == m).all() )
+        
+        a = numpy.array([1, 2, 3], dtype=numpy.uint32)
+        v = self.tester.testVariantTypemap_in(a)
+        self.assertEqual( v.dtype , numpy.uint32 )
+        self.assertTrue( (v == a).all() )
+    
     def test_util_VariantVector_recursive(self):
         def isEqual(a, b):
             """Compare 2 floats."""